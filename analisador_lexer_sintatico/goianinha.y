@@ -12,9 +12,16 @@ extern int yylex();
 
 NoAST *raiz_ast = NULL;
 
+// Com --stream, cada declaração global é entregue a esta função assim que é
+// reduzida e não entra na AST (raiz_ast->filho1 fica vazio); NULL monta a AST inteira.
+void (*tratar_declaracao_global)(NoAST *declaracao) = NULL;
+
 void yyerror(const char *s);
 %}
 
+// yyparse continua disponível; yypush_parse recebe um token por vez (--stream).
+%define api.push-pull both
+
 %code requires {
     #include "../tabela_simbolos/tabela_simbolos.h"
     #include "modulo_arvore_sintatica_abstrata.h"
@@ -49,7 +56,7 @@ void yyerror(const char *s);
 
 %type <type> Tipo
 %type <no_ast> Programa
-%type <no_ast> ListaDeclaracoes Declaracao RestoDeclaracao ListaDeVariaveis
+%type <no_ast> DeclaracoesGlobais GlobaisEmpilhadas ListaDeclaracoes DeclaracoesEmpilhadas Declaracao RestoDeclaracao ListaDeVariaveis
 %type <no_ast> ListaParametros Parametro ListaMaisParametros
 %type <no_ast> ListaComandos Comando ComandoSimples Bloco
 %type <no_ast> ChamadaFuncao ListaArgumentos ListaMaisArgumentos
@@ -61,7 +68,7 @@ void yyerror(const char *s);
 %%
 
 Programa:
-    ListaDeclaracoes
+    DeclaracoesGlobais
     KW_PROGRAMA LBRACE
         {
             printf("Iniciando analise de programa (main)\n");
@@ -72,15 +79,38 @@ Programa:
         {
             printf("Programa analisado com sucesso.\n");
             
-            NoAST* todas_declaracoes = adicionar_a_lista($1, $5);
-            
-            raiz_ast = criar_no(NO_PROGRAMA, todas_declaracoes, $6, NULL);
+            // filho1: declarações globais (variáveis e funções);
+            // filho2: comandos do programa; filho3: locais do programa.
+            raiz_ast = criar_no(NO_PROGRAMA, $1, $6, $5);
+        }
+;
+
+// As declarações são empilhadas (em ordem inversa) e desempilhadas no fim:
+// anexar cada uma ao fim da lista custaria tempo quadrático.
+DeclaracoesGlobais:
+    GlobaisEmpilhadas           { $$ = empilhar_lista(NULL, $1); }
+;
+
+GlobaisEmpilhadas:
+    /* empty */                 { $$ = NULL; }
+    | GlobaisEmpilhadas Declaracao
+        {
+            if (tratar_declaracao_global != NULL) {
+                tratar_declaracao_global($2);
+                $$ = $1;
+            } else {
+                $$ = empilhar_lista($1, $2);
+            }
         }
 ;
 
 ListaDeclaracoes:
+    DeclaracoesEmpilhadas       { $$ = empilhar_lista(NULL, $1); }
+;
+
+DeclaracoesEmpilhadas:
     /* empty */                 { $$ = NULL; }
-    | ListaDeclaracoes Declaracao { $$ = adicionar_a_lista($1, $2); }
+    | DeclaracoesEmpilhadas Declaracao { $$ = empilhar_lista($1, $2); }
 ;
 
 Declaracao:
@@ -0,0 +1,151 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "modulo_protocolo_servidor.h"
+
+/*
+ * Cliente do servidor de compilação: aceita as mesmas opções de goianinha,
+ * envia o fonte ao servidor e reproduz o que a compilação faria localmente
+ * (mensagens, status de término e saida.s/saida.c no diretório atual).
+ */
+
+static void imprimir_uso(const char *programa) {
+    fprintf(stderr, "Uso: %s [--server=SOCKET] [opcoes de goianinha] <arquivo_fonte_goianinha>\n", programa);
+    fprintf(stderr, "O servidor e iniciado com: goianinha --server[=SOCKET] [--workers=N]\n");
+}
+
+static char *ler_fonte(const char *caminho, size_t *tamanho) {
+    *tamanho = 0;
+    FILE *arquivo = strcmp(caminho, "-") == 0 ? stdin : fopen(caminho, "rb");
+    if (arquivo == NULL) return NULL;
+    size_t capacidade = 4096, lidos;
+    char *dados = malloc(capacidade);
+    while (dados != NULL && (lidos = fread(dados + *tamanho, 1, capacidade - *tamanho, arquivo)) > 0) {
+        *tamanho += lidos;
+        if (*tamanho == capacidade) {
+            char *novos = realloc(dados, capacidade *= 2);
+            if (novos == NULL) free(dados);
+            dados = novos;
+        }
+    }
+    if (arquivo != stdin) fclose(arquivo);
+    return dados;
+}
+
+static int escrever_tudo(int descritor, const char *dados, size_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t escritos = write(descritor, dados, tamanho);
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos <= 0) return 0;
+        dados += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 1;
+}
+
+static int conectar(const char *caminho) {
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) return -1;
+    strcpy(endereco.sun_path, caminho);
+    int conexao = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (conexao >= 0 && connect(conexao, (struct sockaddr *)&endereco, sizeof(endereco)) != 0) {
+        close(conexao);
+        conexao = -1;
+    }
+    return conexao;
+}
+
+int main(int argc, char *argv[]) {
+    char caminho_socket[256];
+    caminho_socket_padrao(caminho_socket, sizeof(caminho_socket));
+
+    // Os argumentos seguem para o servidor, exceto --server; o fonte é o
+    // último que não é opção (nem o valor de uma opção), como em goianinha,
+    // e '-' (com --stream) envia a entrada padrão.
+    const char **argumentos = calloc((size_t)argc, sizeof(char *));
+    int num_argumentos = 0;
+    const char *arquivo_fonte = NULL;
+    if (argumentos == NULL) return EXIT_FAILURE;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--server=", 9) == 0) {
+            snprintf(caminho_socket, sizeof(caminho_socket), "%s", argv[i] + 9);
+            continue;
+        }
+        argumentos[num_argumentos++] = argv[i];
+        if (opcao_com_valor(argv[i]) && i + 1 < argc) {
+            argumentos[num_argumentos++] = argv[++i];
+        } else if (argv[i][0] != '-' || argv[i][1] == '\0') {
+            arquivo_fonte = argv[i];
+        }
+    }
+    if (num_argumentos == 0) {
+        imprimir_uso(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int conexao = conectar(caminho_socket);
+    if (conexao < 0) {
+        fprintf(stderr, "Nao foi possivel conectar ao servidor de compilacao em %s.\n", caminho_socket);
+        imprimir_uso(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Um fonte que não pode ser lido não é enviado: o servidor o procura e
+    // informa o erro como goianinha.
+    size_t tamanho_fonte = 0;
+    char *fonte = arquivo_fonte != NULL ? ler_fonte(arquivo_fonte, &tamanho_fonte) : NULL;
+    char diretorio[PATH_MAX], contagem[16];
+    if (getcwd(diretorio, sizeof(diretorio)) == NULL) {
+        perror("Erro ao obter o diretorio atual");
+        return EXIT_FAILURE;
+    }
+    snprintf(contagem, sizeof(contagem), "%d", num_argumentos);
+    int ok = enviar_texto(conexao, VERSAO_PROTOCOLO_SERVIDOR) && enviar_texto(conexao, diretorio)
+             && enviar_texto(conexao, contagem);
+    for (int i = 0; i < num_argumentos && ok; i++) ok = enviar_texto(conexao, argumentos[i]);
+    ok = ok && enviar_texto(conexao, fonte != NULL ? "1" : "0")
+         && enviar_campo(conexao, fonte != NULL ? fonte : "", tamanho_fonte);
+    free(fonte);
+    free(argumentos);
+
+    char *versao = NULL, *status = NULL, *saida = NULL, *erro = NULL, *nome_gerado = NULL, *gerado = NULL;
+    size_t tamanho_saida = 0, tamanho_erro = 0, tamanho_gerado = 0;
+    ok = ok && (versao = receber_campo(conexao, NULL)) != NULL && strcmp(versao, VERSAO_PROTOCOLO_SERVIDOR) == 0
+         && (status = receber_campo(conexao, NULL)) != NULL
+         && (saida = receber_campo(conexao, &tamanho_saida)) != NULL
+         && (erro = receber_campo(conexao, &tamanho_erro)) != NULL
+         && (nome_gerado = receber_campo(conexao, NULL)) != NULL
+         && (gerado = receber_campo(conexao, &tamanho_gerado)) != NULL;
+    close(conexao);
+    if (!ok) {
+        fprintf(stderr, "Resposta invalida do servidor de compilacao em %s.\n", caminho_socket);
+        return EXIT_FAILURE;
+    }
+
+    escrever_tudo(STDOUT_FILENO, saida, tamanho_saida);
+    escrever_tudo(STDERR_FILENO, erro, tamanho_erro);
+    // Só os nomes que goianinha gera são aceitos do servidor.
+    if (strcmp(nome_gerado, "saida.s") == 0 || strcmp(nome_gerado, "saida.c") == 0) {
+        int descritor = open(nome_gerado, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (descritor < 0 || !escrever_tudo(descritor, gerado, tamanho_gerado) || close(descritor) != 0) {
+            perror(nome_gerado);
+            return EXIT_FAILURE;
+        }
+    }
+    int codigo = atoi(status);
+    free(versao);
+    free(status);
+    free(saida);
+    free(erro);
+    free(nome_gerado);
+    free(gerado);
+    return codigo;
+}
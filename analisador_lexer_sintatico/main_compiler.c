@@ -6,50 +6,475 @@ extern FILE *yyin;
 extern int yyparse();   
 extern int yylex();    
 extern int yylineno;   
+extern int yychar;
 
 #include "modulo_arvore_sintatica_abstrata.h"        
 #include "modulo_analisador_semantico.h" 
 #include "modulo_gerador_codigo.h"
+#include "modulo_gerador_x86.h"
+#include "modulo_gerador_c.h"
+#include "modulo_inliner.h"
+#include "modulo_especializacao.h"
+#include "modulo_grafo_chamadas.h"
+#include "modulo_bytecode.h"
+#include "modulo_maquina_virtual.h"
+#include "modulo_interpretador_ast.h"
+#include "modulo_avaliacao_parcial.h"
+#include "modulo_cache_compilacao.h"
+#include "modulo_jit_x86.h"
+#include "modulo_incremental.h"
+#include "modulo_servidor.h"
+#include "modulo_protocolo_servidor.h"
+#include "modulo_sha256.h"
+#include "goianinha.tab.h"
+#include <string.h>
+#include <unistd.h>
 
 extern NoAST *raiz_ast;
+extern void (*tratar_declaracao_global)(NoAST *declaracao);
 
-int main(int argc, char **argv) {
-    if (argc < 2) {
-        fprintf(stderr, "Uso: %s <arquivo_fonte_goianinha>\n", argv[0]);
+typedef enum ModoExecucao {
+    MODO_COMPILAR,              // Gera saida.s
+    MODO_BYTECODE,              // --run: executa na máquina virtual
+    MODO_AST,                   // --run-ast: executa percorrendo a AST
+    MODO_JIT                    // --jit: compila para código de máquina em memória e executa
+} ModoExecucao;
+
+typedef enum AlvoGeracao {
+    ALVO_MIPS,                  // saida.s em assembly MIPS (padrão)
+    ALVO_X86_64,                // saida.s em assembly x86-64
+    ALVO_C                      // saida.c
+} AlvoGeracao;
+
+static EntradaSaidaBuferizada es_programa;
+
+/**
+ * @brief Executa o programa diretamente. A saída do programa vai para o
+ * descritor dado; as mensagens do compilador já foram desviadas para stderr.
+ */
+static int executar_programa(NoAST *raiz, ModoExecucao modo, int mostrar_bytecode, int jit_preguicoso,
+                             int descritor_saida) {
+    iniciar_es_buferizada(&es_programa, STDIN_FILENO, descritor_saida);
+    if (modo == MODO_AST) return interpretar_ast(raiz, &es_programa);
+
+    ProgramaBytecode programa;
+    compilar_bytecode(raiz, &programa);
+    if (mostrar_bytecode) {
+        imprimir_bytecode(stdout, &programa);
+    } else {
+        printf("Bytecode: %d instrucao(oes), %d superinstrucao(oes).\n",
+               programa.tamanho, programa.num_superinstrucoes);
+    }
+    fflush(stdout);
+    int status = modo == MODO_JIT ? executar_jit(&programa, &es_programa, jit_preguicoso)
+                                  : executar_bytecode(&programa, &es_programa);
+    liberar_programa_bytecode(&programa);
+    return status;
+}
+
+// --stream: erros semânticos até aqui, funções vistas e o maior número de
+// nós da AST de uma declaração (o que fica em memória de cada vez).
+static int erros_em_fluxo = 0;
+static int funcoes_em_fluxo = 0;
+static int maior_declaracao_em_fluxo = 0;
+
+/**
+ * @brief Recebe cada declaração global assim que o analisador sintático a
+ * reduz: verifica, gera (enquanto não houver erros) e libera a sua AST.
+ */
+static void tratar_declaracao_em_fluxo(NoAST *declaracao) {
+    int nos = contar_nos_ast(declaracao);
+    if (nos > maior_declaracao_em_fluxo) maior_declaracao_em_fluxo = nos;
+    erros_em_fluxo += analisar_declaracao_global(declaracao);
+    // Depois de um erro as declarações só são verificadas, e saida.s não é escrito.
+    if (erros_em_fluxo == 0) gerar_declaracao_em_fluxo(declaracao);
+    if (declaracao->tipo_no == NO_DECL_FUNCAO) funcoes_em_fluxo++;
+    liberar_ast(declaracao);
+    liberar_entradas_descartadas();
+}
+
+/**
+ * @brief Análise sintática em fluxo: o analisador recebe um token por vez
+ * (yypush_parse) e entrega as declarações globais a tratar_declaracao_em_fluxo.
+ * @return O resultado de yyparse (0 = sem erros sintáticos).
+ */
+static int analisar_em_fluxo(const OpcoesGeracao *opcoes) {
+    erros_em_fluxo = 0;
+    funcoes_em_fluxo = 0;
+    maior_declaracao_em_fluxo = 0;
+    iniciar_analise_em_fluxo();
+    iniciar_geracao_em_fluxo(opcoes);
+    yypstate *estado = yypstate_new();
+    if (estado == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o analisador sintatico.\n");
+        exit(EXIT_FAILURE);
+    }
+    tratar_declaracao_global = tratar_declaracao_em_fluxo;
+    int status;
+    do {
+        yychar = yylex();
+        status = yypush_parse(estado);
+    } while (status == YYPUSH_MORE);
+    tratar_declaracao_global = NULL;
+    yypstate_delete(estado);
+    return status;
+}
+
+static void imprimir_uso(const char *programa) {
+    fprintf(stderr, "Uso: %s [opcoes] <arquivo_fonte_goianinha | - (com --stream)>\n", programa);
+    fprintf(stderr, "Opcoes:\n");
+    fprintf(stderr, "  --no-peephole   Desativa o otimizador peephole\n");
+    fprintf(stderr, "  --no-dispatch   Mantem as cadeias se/senao como testes sequenciais\n");
+    fprintf(stderr, "  --no-strength-reduction  Usa mult/div mesmo com operandos constantes\n");
+    fprintf(stderr, "  --no-licm       Mantem as expressoes invariantes dentro dos lacos\n");
+    fprintf(stderr, "  --no-loop-rotation  Gera 'enquanto' com o teste no inicio do laco\n");
+    fprintf(stderr, "  --no-iv-reduction   Recalcula \"i * k\" a cada iteracao\n");
+    fprintf(stderr, "  --no-unroll     Nao desenrola lacos com numero constante de iteracoes\n");
+    fprintf(stderr, "  --no-inline     Nao expande chamadas de funcoes pequenas\n");
+    fprintf(stderr, "  --inline-budget N   Custo maximo de uma chamada expandida (padrao %d)\n", ORCAMENTO_INLINE_PADRAO);
+    fprintf(stderr, "  --no-specialize Nao propaga constantes nem especializa funcoes\n");
+    fprintf(stderr, "  --specialize-growth N  Crescimento maximo (%%) por especializacoes (padrao %d)\n",
+            CRESCIMENTO_ESPECIALIZACAO_PADRAO);
+    fprintf(stderr, "  --reachable-only  Analisa e gera apenas as funcoes alcancaveis a partir de 'programa'\n");
+    fprintf(stderr, "  --no-io-buffer  Um syscall por item em escreva/leia, sem o runtime de E/S\n");
+    fprintf(stderr, "  --instrument    saida.s conta execucoes de blocos e chamadas e as escreve na saida de erro ao terminar\n");
+    fprintf(stderr, "  --profile-use=ARQ  Usa o perfil de um --instrument no layout, inline e registradores\n");
+    fprintf(stderr, "  --no-partial-eval  Nao executa em compilacao os comandos de 'programa' que nao leem a entrada\n");
+    fprintf(stderr, "  --eval-steps N  Passos maximos da execucao em compilacao (padrao %lld)\n", PASSOS_AVALIACAO_PADRAO);
+    fprintf(stderr, "  --eval-memory N Bytes maximos de variaveis e saida da execucao em compilacao (padrao %lld)\n",
+            MEMORIA_AVALIACAO_PADRAO);
+    fprintf(stderr, "  --cache-dir=DIR Reaproveita compilacoes identicas guardadas em DIR (cache por conteudo)\n");
+    fprintf(stderr, "  --cache-size=N  Tamanho maximo do cache em bytes (padrao %lld)\n", LIMITE_CACHE_PADRAO);
+    fprintf(stderr, "  --cache-stats   Mostra os acertos e faltas acumulados do cache e termina\n");
+    fprintf(stderr, "  --incremental=DIR  Gera de novo so as funcoes alteradas desde a compilacao anterior\n");
+    fprintf(stderr, "                  (estado em DIR; desliga inline, especializacao e avaliacao parcial)\n");
+    fprintf(stderr, "  --stream        Verifica e gera cada funcao assim que ela e lida e libera a sua AST (memoria\n");
+    fprintf(stderr, "                  limitada pela maior funcao; fonte '-' le a entrada padrao; desliga inline,\n");
+    fprintf(stderr, "                  especializacao e avaliacao parcial)\n");
+    fprintf(stderr, "  --threads=N     Gera as funcoes MIPS em N threads (padrao: numero de processadores; o\n");
+    fprintf(stderr, "                  codigo gerado e o mesmo)\n");
+    fprintf(stderr, "  --target=ALVO   mips (padrao) ou x86_64 geram saida.s; c gera saida.c\n");
+    fprintf(stderr, "  --run           Executa o programa numa maquina virtual de bytecode (sem gerar saida.s)\n");
+    fprintf(stderr, "  --run-ast       Executa o programa percorrendo a AST (referencia para o --run)\n");
+    fprintf(stderr, "  --jit           Executa o programa compilando-o para codigo x86-64 em memoria\n");
+    fprintf(stderr, "  --no-lazy-jit   Compila todas as funcoes antes de executar (padrao: na primeira chamada)\n");
+    fprintf(stderr, "  --dump-bytecode Lista o bytecode do programa\n");
+    fprintf(stderr, "  --server[=SOCKET]  Atende pedidos de goianinha_cliente num socket Unix (padrao: $GOIANINHA_SERVIDOR\n");
+    fprintf(stderr, "                  ou /tmp/goianinha-<uid>.sock)\n");
+    fprintf(stderr, "  --workers=N     Pedidos compilados em paralelo pelo servidor (padrao: numero de processadores)\n");
+}
+
+/**
+ * @brief Compila (ou executa) conforme a linha de comando. Pelo servidor,
+ * o fonte vem da memória e o arquivo gerado vai para 'diretorio_saida'.
+ */
+static int compilar_requisicao(const RequisicaoCompilacao *requisicao) {
+    int argc = requisicao->argc;
+    char **argv = requisicao->argv;
+    OpcoesGeracao opcoes;
+    iniciar_opcoes_geracao(&opcoes);
+    const char *arquivo_fonte = NULL;
+    ModoExecucao modo = MODO_COMPILAR;
+    int mostrar_bytecode = 0;
+    int jit_preguicoso = 1;
+    AlvoGeracao alvo = ALVO_MIPS;
+    const char *diretorio_cache = NULL;
+    long long limite_cache = LIMITE_CACHE_PADRAO;
+    int estatisticas_cache = 0;
+    const char *diretorio_incremental = NULL;
+    int em_fluxo = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--no-peephole") == 0) {
+            opcoes.otimizar_peephole = 0;
+        } else if (strcmp(argv[i], "--no-dispatch") == 0) {
+            opcoes.otimizar_despacho = 0;
+        } else if (strcmp(argv[i], "--no-strength-reduction") == 0) {
+            opcoes.reduzir_forca = 0;
+        } else if (strcmp(argv[i], "--no-licm") == 0) {
+            opcoes.mover_invariantes = 0;
+        } else if (strcmp(argv[i], "--no-loop-rotation") == 0) {
+            opcoes.rotacionar_lacos = 0;
+        } else if (strcmp(argv[i], "--no-iv-reduction") == 0) {
+            opcoes.reduzir_inducao = 0;
+        } else if (strcmp(argv[i], "--no-unroll") == 0) {
+            opcoes.desenrolar_lacos = 0;
+        } else if (strcmp(argv[i], "--no-inline") == 0) {
+            opcoes.expandir_chamadas = 0;
+        } else if (strcmp(argv[i], "--inline-budget") == 0) {
+            char *fim;
+            if (i + 1 >= argc || (opcoes.orcamento_inline = (int)strtol(argv[i + 1], &fim, 10), *fim != '\0')) {
+                fprintf(stderr, "Opcao --inline-budget requer um numero inteiro\n");
+                imprimir_uso(argv[0]);
+                return EXIT_FAILURE;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--no-specialize") == 0) {
+            opcoes.especializar_funcoes = 0;
+        } else if (strcmp(argv[i], "--specialize-growth") == 0) {
+            char *fim;
+            if (i + 1 >= argc || (opcoes.crescimento_especializacao = (int)strtol(argv[i + 1], &fim, 10), *fim != '\0')) {
+                fprintf(stderr, "Opcao --specialize-growth requer um numero inteiro\n");
+                imprimir_uso(argv[0]);
+                return EXIT_FAILURE;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--reachable-only") == 0) {
+            opcoes.apenas_alcancaveis = 1;
+        } else if (strcmp(argv[i], "--no-io-buffer") == 0) {
+            opcoes.saida_bufferizada = 0;
+        } else if (strcmp(argv[i], "--instrument") == 0) {
+            opcoes.instrumentar = 1;
+        } else if (strncmp(argv[i], "--profile-use=", 14) == 0) {
+            opcoes.arquivo_perfil = argv[i] + 14;
+        } else if (strcmp(argv[i], "--no-partial-eval") == 0) {
+            opcoes.avaliar_em_compilacao = 0;
+        } else if (strcmp(argv[i], "--eval-steps") == 0) {
+            char *fim;
+            if (i + 1 >= argc || (opcoes.passos_avaliacao = strtoll(argv[i + 1], &fim, 10), *fim != '\0')) {
+                fprintf(stderr, "Opcao --eval-steps requer um numero inteiro\n");
+                imprimir_uso(argv[0]);
+                return EXIT_FAILURE;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--eval-memory") == 0) {
+            char *fim;
+            if (i + 1 >= argc || (opcoes.memoria_avaliacao = strtoll(argv[i + 1], &fim, 10), *fim != '\0')) {
+                fprintf(stderr, "Opcao --eval-memory requer um numero inteiro\n");
+                imprimir_uso(argv[0]);
+                return EXIT_FAILURE;
+            }
+            i++;
+        } else if (strncmp(argv[i], "--cache-dir=", 12) == 0) {
+            diretorio_cache = argv[i] + 12;
+        } else if (strncmp(argv[i], "--cache-size=", 13) == 0) {
+            char *fim;
+            limite_cache = strtoll(argv[i] + 13, &fim, 10);
+            if (*fim != '\0' || fim == argv[i] + 13) {
+                fprintf(stderr, "Opcao --cache-size requer um numero inteiro\n");
+                imprimir_uso(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--cache-stats") == 0) {
+            estatisticas_cache = 1;
+        } else if (strncmp(argv[i], "--incremental=", 14) == 0) {
+            diretorio_incremental = argv[i] + 14;
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            em_fluxo = 1;
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            char *fim;
+            long num_threads = strtol(argv[i] + 10, &fim, 10);
+            if (*fim != '\0' || fim == argv[i] + 10 || num_threads < 1 || num_threads > 1024) {
+                fprintf(stderr, "Opcao --threads requer um numero entre 1 e 1024\n");
+                imprimir_uso(argv[0]);
+                return EXIT_FAILURE;
+            }
+            opcoes.num_threads = (int)num_threads;
+        } else if (strncmp(argv[i], "--target=", 9) == 0) {
+            if (strcmp(argv[i] + 9, "x86_64") == 0) {
+                alvo = ALVO_X86_64;
+            } else if (strcmp(argv[i] + 9, "mips") == 0) {
+                alvo = ALVO_MIPS;
+            } else if (strcmp(argv[i] + 9, "c") == 0) {
+                alvo = ALVO_C;
+            } else {
+                fprintf(stderr, "Alvo desconhecido: %s (use mips, x86_64 ou c)\n", argv[i] + 9);
+                imprimir_uso(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if (strcmp(argv[i], "--run") == 0) {
+            modo = MODO_BYTECODE;
+        } else if (strcmp(argv[i], "--run-ast") == 0) {
+            modo = MODO_AST;
+        } else if (strcmp(argv[i], "--jit") == 0) {
+            modo = MODO_JIT;
+        } else if (strcmp(argv[i], "--no-lazy-jit") == 0) {
+            jit_preguicoso = 0;
+        } else if (strcmp(argv[i], "--dump-bytecode") == 0) {
+            mostrar_bytecode = 1;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "Opcao desconhecida: %s\n", argv[i]);
+            imprimir_uso(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            arquivo_fonte = argv[i];
+        }
+    }
+
+    if (estatisticas_cache) {
+        if (diretorio_cache == NULL) {
+            fprintf(stderr, "--cache-stats requer --cache-dir=DIR.\n");
+            return EXIT_FAILURE;
+        }
+        imprimir_estatisticas_cache(diretorio_cache);
+        return 0;
+    }
+    if (arquivo_fonte == NULL) {
+        imprimir_uso(argv[0]);
+        return EXIT_FAILURE;
+    }
+    if ((opcoes.instrumentar || opcoes.arquivo_perfil != NULL) && (modo != MODO_COMPILAR || alvo != ALVO_MIPS)) {
+        fprintf(stderr, "--instrument e --profile-use so se aplicam a geracao de codigo MIPS.\n");
         return EXIT_FAILURE;
     }
+    if (diretorio_incremental != NULL) {
+        if (modo != MODO_COMPILAR || alvo != ALVO_MIPS || opcoes.instrumentar || opcoes.arquivo_perfil != NULL
+            || *diretorio_incremental == '\0') {
+            fprintf(stderr, "--incremental=DIR so se aplica a geracao de codigo MIPS, sem --instrument e --profile-use.\n");
+            return EXIT_FAILURE;
+        }
+        // O código de cada função passa a depender só dela e das assinaturas que chama.
+        opcoes.expandir_chamadas = 0;
+        opcoes.especializar_funcoes = 0;
+        opcoes.avaliar_em_compilacao = 0;
+    }
 
-    yyin = fopen(argv[1], "r");
+    int entrada_padrao = strcmp(arquivo_fonte, "-") == 0 && requisicao->fonte == NULL;
+    if (em_fluxo) {
+        if (modo != MODO_COMPILAR || alvo != ALVO_MIPS || opcoes.instrumentar || opcoes.arquivo_perfil != NULL
+            || opcoes.apenas_alcancaveis || mostrar_bytecode || diretorio_incremental != NULL) {
+            fprintf(stderr, "--stream so se aplica a geracao de codigo MIPS, sem --instrument, --profile-use, "
+                            "--reachable-only, --dump-bytecode e --incremental.\n");
+            return EXIT_FAILURE;
+        }
+        // Cada função é gerada antes de as seguintes serem lidas.
+        opcoes.expandir_chamadas = 0;
+        opcoes.especializar_funcoes = 0;
+        opcoes.avaliar_em_compilacao = 0;
+    }
+    if (entrada_padrao && (!em_fluxo || diretorio_cache != NULL)) {
+        fprintf(stderr, "O fonte '-' (entrada padrao) requer --stream e nao pode ser usado com --cache-dir.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (requisicao->fonte != NULL && modo != MODO_COMPILAR) {
+        fprintf(stderr, "--run, --run-ast e --jit leem a entrada do terminal e nao sao atendidos pelo servidor.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Só a geração de código é guardada: os modos de execução dependem da entrada.
+    const char *nome_saida = alvo == ALVO_C ? "saida.c" : "saida.s";
+    char caminho_saida[4200];
+    const char *arquivo_saida = nome_saida;
+    if (requisicao->diretorio_saida != NULL) {
+        snprintf(caminho_saida, sizeof(caminho_saida), "%s/%s", requisicao->diretorio_saida, nome_saida);
+        arquivo_saida = caminho_saida;
+    }
+    int usar_cache = diretorio_cache != NULL && modo == MODO_COMPILAR;
+    int gerou_saida = 0;
+    if (usar_cache) {
+        int status_cache;
+        if (consultar_cache(diretorio_cache, limite_cache, argc, argv, arquivo_fonte, opcoes.arquivo_perfil,
+                            arquivo_saida, &status_cache)) {
+            return status_cache;
+        }
+    }
+
+    if (requisicao->fonte != NULL) {
+        yyin = requisicao->tamanho_fonte > 0 ? fmemopen((void *)requisicao->fonte, requisicao->tamanho_fonte, "r")
+                                             : fopen("/dev/null", "r");
+    } else if (entrada_padrao) {
+        yyin = stdin;
+    } else {
+        yyin = fopen(arquivo_fonte, "r");
+    }
     if (yyin == NULL) {
         perror("Erro ao abrir o arquivo de entrada");
         return EXIT_FAILURE;
     }
 
-    printf("Iniciando compilacao do arquivo: %s\n", argv[1]);
+    // Ao executar, stdout fica só com a saída do programa.
+    int descritor_saida = STDOUT_FILENO;
+    if (modo != MODO_COMPILAR) {
+        descritor_saida = dup(STDOUT_FILENO);
+        if (descritor_saida < 0 || dup2(STDERR_FILENO, STDOUT_FILENO) < 0) {
+            perror("Erro ao preparar a saida do programa");
+            return EXIT_FAILURE;
+        }
+    }
+    int status = 0;
+    // Os modos de execução precisam de todas as funções analisadas.
+    if (modo != MODO_COMPILAR) opcoes.apenas_alcancaveis = 0;
+
+    printf("Iniciando compilacao do arquivo: %s\n", arquivo_fonte);
 
     iniciar_pilha_tabela_simbolos();
 
-    int parse_result = yyparse();
+    int parse_result = em_fluxo ? analisar_em_fluxo(&opcoes) : yyparse();
 
     fclose(yyin);
 
     if (parse_result == 0) {
-        printf("Analise sintatica concluida com sucesso! AST construida.\n");
+        if (em_fluxo) {
+            printf("Analise sintatica concluida com sucesso! %d funcao(oes) verificada(s) durante a leitura "
+                   "(maior declaracao com %d no(s) da AST).\n", funcoes_em_fluxo, maior_declaracao_em_fluxo);
+        } else {
+            printf("Analise sintatica concluida com sucesso! AST construida.\n");
+        }
         printf("Iniciando analise semantica...\n");
-        int erros_semanticos = analisar_semantica(raiz_ast);
+        int erros_semanticos;
+        EstadoIncremental *estado_incremental = NULL;
+        if (em_fluxo) {
+            erros_semanticos = concluir_analise_em_fluxo(raiz_ast);
+        } else if (diretorio_incremental != NULL) {
+            // Só os corpos que mudaram desde a compilação anterior são analisados.
+            estado_incremental = abrir_estado_incremental(diretorio_incremental, arquivo_fonte, raiz_ast, &opcoes);
+            int num_alcancaveis;
+            char *alcancaveis = opcoes.apenas_alcancaveis ? marcar_funcoes_alcancaveis(raiz_ast, &num_alcancaveis)
+                                                          : NULL;
+            char *analisar = funcoes_a_analisar(estado_incremental, alcancaveis);
+            erros_semanticos = analisar_semantica_alcancavel(raiz_ast, analisar);
+            free(analisar);
+            free(alcancaveis);
+        } else if (opcoes.apenas_alcancaveis) {
+            int num_alcancaveis;
+            char *alcancaveis = marcar_funcoes_alcancaveis(raiz_ast, &num_alcancaveis);
+            erros_semanticos = analisar_semantica_alcancavel(raiz_ast, alcancaveis);
+            free(alcancaveis);
+        } else {
+            erros_semanticos = analisar_semantica(raiz_ast);
+        }
         
         if (erros_semanticos == 0) {
             printf("Analise semantica concluida com sucesso!\n");
             
-            char *arquivo_saida = "saida.s";
-            
-            printf("Iniciando geracao de codigo para '%s'...\n", arquivo_saida);
-            gerar_codigo(raiz_ast, arquivo_saida);
-            printf("Geracao de codigo concluida.\n");
+            if (modo != MODO_COMPILAR) {
+                status = executar_programa(raiz_ast, modo, mostrar_bytecode, jit_preguicoso,
+                                           descritor_saida);
+            } else {
+                if (mostrar_bytecode) {
+                    ProgramaBytecode programa;
+                    compilar_bytecode(raiz_ast, &programa);
+                    imprimir_bytecode(stdout, &programa);
+                    liberar_programa_bytecode(&programa);
+                }
+                // Sem 'leia' na frente, a saída é calculada aqui e o código só a escreve.
+                if (opcoes.avaliar_em_compilacao
+                    && avaliar_parcialmente(raiz_ast, opcoes.passos_avaliacao, opcoes.memoria_avaliacao)) {
+                    opcoes.apenas_alcancaveis = 1;
+                }
+                printf("Iniciando geracao de codigo para '%s'...\n", nome_saida);
+                if (em_fluxo) {
+                    concluir_geracao_em_fluxo(raiz_ast, arquivo_saida);
+                } else if (alvo == ALVO_X86_64) {
+                    gerar_codigo_x86(raiz_ast, arquivo_saida, &opcoes);
+                } else if (alvo == ALVO_C) {
+                    gerar_codigo_c(raiz_ast, arquivo_saida, &opcoes);
+                } else {
+                    opcoes.incremental = estado_incremental;
+                    gerar_codigo(raiz_ast, arquivo_saida, &opcoes);
+                    opcoes.incremental = NULL;
+                }
+                printf("Geracao de codigo concluida.\n");
+                gerou_saida = 1;
+            }
             
         } else {
             printf("Compilacao terminada devido a %d erros semanticos.\n", erros_semanticos);
+            if (modo != MODO_COMPILAR) status = EXIT_FAILURE;
+            if (em_fluxo) descartar_geracao_em_fluxo();
         }
+        if (estado_incremental != NULL) concluir_estado_incremental(estado_incremental, erros_semanticos == 0);
 
         if (raiz_ast != NULL) {
             liberar_ast(raiz_ast);
@@ -58,6 +483,7 @@ int main(int argc, char **argv) {
 
     } else {
         printf("Compilacao concluida com erros sintaticos.\n");
+        if (em_fluxo) descartar_geracao_em_fluxo();
         if (raiz_ast != NULL) {
             liberar_ast(raiz_ast);
             raiz_ast = NULL;
@@ -66,5 +492,37 @@ int main(int argc, char **argv) {
 
     eliminar_pilha_tabela_simbolos();
 
-    return (parse_result != 0);
+    if (parse_result != 0) status = 1;
+    if (usar_cache) concluir_cache(status, gerou_saida);
+    return status;
+}
+
+int main(int argc, char **argv) {
+    const char *caminho_socket = NULL;
+    char socket_padrao[256];
+    long num_trabalhadores = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--server") == 0) {
+            caminho_socket_padrao(socket_padrao, sizeof(socket_padrao));
+            caminho_socket = socket_padrao;
+        } else if (strncmp(argv[i], "--server=", 9) == 0) {
+            caminho_socket = argv[i] + 9;
+        } else if (strncmp(argv[i], "--workers=", 10) == 0) {
+            char *fim;
+            num_trabalhadores = strtol(argv[i] + 10, &fim, 10);
+            if (*fim != '\0' || num_trabalhadores < 1 || num_trabalhadores > 1024) {
+                fprintf(stderr, "Opcao --workers requer um numero entre 1 e 1024\n");
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    if (caminho_socket != NULL) {
+        // Estado caro que não depende do pedido é calculado antes do fork dos trabalhadores.
+        resumo_executavel();
+        return executar_servidor(caminho_socket, num_trabalhadores > 0 ? (int)num_trabalhadores : 1,
+                                 compilar_requisicao);
+    }
+
+    RequisicaoCompilacao requisicao = { argc, argv, NULL, 0, NULL };
+    return compilar_requisicao(&requisicao);
 }
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "modulo_simulador_mips.h"
+
+static void imprimir_uso(const char *programa) {
+    fprintf(stderr, "Uso: %s [--estatisticas] [--limite N] <arquivo.s>\n", programa);
+}
+
+int main(int argc, char *argv[]) {
+    int estatisticas = 0;
+    long long limite = 0;
+    const char *arquivo_entrada = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--estatisticas") == 0) {
+            estatisticas = 1;
+        } else if (strcmp(argv[i], "--limite") == 0 && i + 1 < argc) {
+            limite = atoll(argv[++i]);
+        } else if (argv[i][0] == '-' || arquivo_entrada != NULL) {
+            imprimir_uso(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            arquivo_entrada = argv[i];
+        }
+    }
+    if (arquivo_entrada == NULL) {
+        imprimir_uso(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *arquivo = fopen(arquivo_entrada, "r");
+    if (arquivo == NULL) {
+        perror(arquivo_entrada);
+        return EXIT_FAILURE;
+    }
+    ProgramaMIPS *programa = carregar_programa_mips(arquivo, arquivo_entrada);
+    fclose(arquivo);
+    if (programa == NULL) return EXIT_FAILURE;
+
+    EstatisticasSimulador est;
+    int codigo = executar_programa_mips(programa, stdin, stdout, limite, &est);
+    if (estatisticas) imprimir_estatisticas_simulador(stderr, programa, &est);
+    liberar_programa_mips(programa);
+    return codigo;
+}
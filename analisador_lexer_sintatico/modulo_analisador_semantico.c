@@ -10,6 +10,12 @@ static int contador_erros_semanticos = 0;
 // Ponteiro para a função que está sendo analisada no momento (essencial para o 'retorne')
 static NoAST *funcao_atual = NULL;
 
+// Análise sob demanda: funções alcançáveis (na ordem de declaração), ou NULL
+// para analisar todas. Das demais, apenas a assinatura é registrada.
+static const char *funcoes_alcancaveis = NULL;
+static int indice_funcao = 0;
+static int funcoes_nao_analisadas = 0;
+
 static void percorrer_ast(NoAST *no);
 
 /**
@@ -51,6 +57,7 @@ static void percorrer_ast(NoAST *no) {
             criar_novo_escopo_e_empilhar();
 
             percorrer_lista(no->filho1);
+            percorrer_lista(no->filho3);
             percorrer_lista(no->filho2); 
             remover_escopo_atual();
             break;
@@ -61,6 +68,7 @@ static void percorrer_ast(NoAST *no) {
                 no->tipo_dado_computado,
                 0
             );
+            no->filho1->entrada_tabela = nova_func;
             
             funcao_atual = no; 
 
@@ -86,7 +94,12 @@ static void percorrer_ast(NoAST *no) {
             }
             nova_func->num_argumentos = num_args;
             
-            percorrer_ast(no->filho3); 
+            if (funcoes_alcancaveis == NULL || funcoes_alcancaveis[indice_funcao]) {
+                percorrer_ast(no->filho3); 
+            } else {
+                funcoes_nao_analisadas++;
+            }
+            indice_funcao++;
             
             remover_escopo_atual(); 
             funcao_atual = NULL; 
@@ -338,11 +351,57 @@ static void percorrer_ast(NoAST *no) {
  * @brief Função principal (pública) do analisador semântico.
  */
 int analisar_semantica(NoAST *raiz) {
+    return analisar_semantica_alcancavel(raiz, NULL);
+}
+
+/**
+ * @brief Análise semântica restrita às funções alcançáveis.
+ */
+int analisar_semantica_alcancavel(NoAST *raiz, const char *alcancaveis) {
 
     contador_erros_semanticos = 0;
     funcao_atual = NULL;
+    funcoes_alcancaveis = alcancaveis;
+    indice_funcao = 0;
+    funcoes_nao_analisadas = 0;
     
     percorrer_ast(raiz);
+
+    if (funcoes_nao_analisadas > 0) {
+        printf("Analise sob demanda: corpo de %d funcao(oes) nao verificado (nao alcancavel(is) ou sem alteracoes).\n",
+               funcoes_nao_analisadas);
+    }
+    funcoes_alcancaveis = NULL;
     
     return contador_erros_semanticos;
-}
\ No newline at end of file
+}
+/**
+ * @brief Início da análise em fluxo: o mesmo estado de analisar_semantica e o escopo global.
+ */
+void iniciar_analise_em_fluxo() {
+    contador_erros_semanticos = 0;
+    funcao_atual = NULL;
+    funcoes_alcancaveis = NULL;
+    indice_funcao = 0;
+    funcoes_nao_analisadas = 0;
+    criar_novo_escopo_e_empilhar();
+}
+
+/**
+ * @brief Verifica uma declaração global, como o caso NO_PROGRAMA faria com 'filho1'.
+ */
+int analisar_declaracao_global(NoAST *declaracao) {
+    int erros_antes = contador_erros_semanticos;
+    percorrer_lista(declaracao);
+    return contador_erros_semanticos - erros_antes;
+}
+
+/**
+ * @brief Termina a análise em fluxo com as locais e os comandos de 'programa'.
+ */
+int concluir_analise_em_fluxo(NoAST *programa) {
+    percorrer_lista(programa->filho3);
+    percorrer_lista(programa->filho2);
+    remover_escopo_atual();
+    return contador_erros_semanticos;
+}
@@ -18,5 +18,37 @@
  */
 int analisar_semantica(NoAST *raiz);
 
+/**
+ * @brief Variante sob demanda de analisar_semantica.
+ * * Todas as assinaturas de funções são registradas, mas só o corpo das
+ * funções alcançáveis a partir de 'programa' é verificado; as demais já
+ * passaram pela análise sintática e não terão código gerado.
+ * * @param alcancaveis Uma posição por função, na ordem de declaração
+ * (ver marcar_funcoes_alcancaveis), ou NULL para analisar todas.
+ * @return O número total de erros semânticos encontrados.
+ */
+int analisar_semantica_alcancavel(NoAST *raiz, const char *alcancaveis);
+
+/**
+ * @brief Início da análise em fluxo (--stream): abre o escopo global.
+ * * As declarações globais são verificadas uma a uma, à medida que são
+ * reduzidas pelo analisador sintático, e 'programa' no fim. Como todo nome
+ * precisa ser declarado antes do uso, as mensagens são as de analisar_semantica.
+ */
+void iniciar_analise_em_fluxo();
+
+/**
+ * @brief Verifica uma declaração global (lista de variáveis ou uma função)
+ * no escopo global.
+ * @return O número de erros semânticos encontrados nela.
+ */
+int analisar_declaracao_global(NoAST *declaracao);
+
+/**
+ * @brief Verifica as locais e os comandos de 'programa' e fecha o escopo global.
+ * @return O total de erros semânticos da análise em fluxo.
+ */
+int concluir_analise_em_fluxo(NoAST *programa);
+
 
 #endif // SEMANTICA_H
\ No newline at end of file
@@ -102,6 +102,19 @@ NoAST *adicionar_a_lista(NoAST *lista, NoAST *no_para_adicionar) {
     return lista; 
 }
 
+/**
+ * @brief Empilha os nós de uma lista sobre outra, em ordem inversa.
+ */
+NoAST *empilhar_lista(NoAST *pilha, NoAST *lista) {
+    while (lista != NULL) {
+        NoAST *proximo = lista->proximo;
+        lista->proximo = pilha;
+        pilha = lista;
+        lista = proximo;
+    }
+    return pilha;
+}
+
 /**
  * @brief Libera recursivamente toda a memória alocada para a AST.
  */
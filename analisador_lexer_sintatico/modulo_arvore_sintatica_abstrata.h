@@ -126,6 +126,15 @@ NoAST *criar_no_string(char *str);
  */
 NoAST *adicionar_a_lista(NoAST *lista, NoAST *no_para_adicionar);
 
+/**
+ * @brief Empilha os nós de 'lista' sobre 'pilha', um a um (a lista fica
+ * invertida no topo). Sem percorrer a pilha, acumular as declarações de um
+ * programa grande custa tempo linear; a ordem é restaurada empilhando a
+ * pilha final sobre NULL.
+ * @return O novo topo da pilha.
+ */
+NoAST *empilhar_lista(NoAST *pilha, NoAST *lista);
+
 /**
  * @brief Libera recursivamente toda a memória alocada para a AST.
  * @param raiz A raiz da árvore (ou sub-árvore) a ser liberada.
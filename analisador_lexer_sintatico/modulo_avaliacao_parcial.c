@@ -0,0 +1,443 @@
+#include "modulo_avaliacao_parcial.h"
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    PARADA_NENHUMA,
+    PARADA_LEITURA,     // 'leia': o resultado depende da entrada
+    PARADA_PASSOS,
+    PARADA_MEMORIA,
+    PARADA_ERRO,        // Erro de execução: fica para o programa gerado
+    PARADA_BYTE_NULO    // A saída não cabe numa string terminada em zero
+} MotivoParada;
+
+static const char *descricoes_parada[] = {
+    "", "le a entrada", "excede o orcamento de passos", "excede o orcamento de memoria",
+    "chega a um erro de execucao", "escreve um byte nulo"
+};
+
+typedef struct VariavelAvaliada {
+    const EntradaTabela *entrada;   // NULL nos parâmetros
+    int32_t valor;
+} VariavelAvaliada;
+
+static const NoAST *programa_avaliado = NULL;
+static jmp_buf ponto_parada;
+static volatile MotivoParada motivo_parada;
+
+// Globais, locais de 'programa' e, acima delas, os quadros das chamadas.
+static VariavelAvaliada *variaveis = NULL;
+static int num_variaveis = 0;
+static int capacidade_variaveis = 0;
+static int num_globais = 0;
+static int num_persistentes = 0;       // Globais + locais de 'programa'
+static char *alteradas = NULL;         // Persistentes que o prefixo alterou
+static int inicio_quadro = 0;
+static int num_parametros_quadro = 0;
+static int profundidade = 0;
+static int retornando = 0;
+static int32_t valor_retorno = 0;
+
+static char *saida = NULL;
+static int tamanho_saida = 0;
+static int capacidade_saida = 0;
+
+static long long passos = 0;
+static long long limite_passos = 0;
+static long long limite_memoria = 0;
+
+static void parar(MotivoParada motivo) {
+    motivo_parada = motivo;
+    longjmp(ponto_parada, 1);
+}
+
+static void contar_passo() {
+    if (++passos > limite_passos) parar(PARADA_PASSOS);
+}
+
+static void verificar_memoria() {
+    if ((long long)num_variaveis * (long long)sizeof(int32_t) + tamanho_saida > limite_memoria) {
+        parar(PARADA_MEMORIA);
+    }
+}
+
+static void *realocar(void *memoria, size_t tamanho) {
+    void *nova = realloc(memoria, tamanho > 0 ? tamanho : 1);
+    if (nova == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a avaliacao parcial.\n");
+        exit(EXIT_FAILURE);
+    }
+    return nova;
+}
+
+static void empilhar_variavel(const EntradaTabela *entrada, int32_t valor) {
+    if (num_variaveis == capacidade_variaveis) {
+        capacidade_variaveis = capacidade_variaveis == 0 ? 64 : capacidade_variaveis * 2;
+        variaveis = realocar(variaveis, capacidade_variaveis * sizeof(VariavelAvaliada));
+    }
+    variaveis[num_variaveis].entrada = entrada;
+    variaveis[num_variaveis].valor = valor;
+    num_variaveis++;
+    verificar_memoria();
+}
+
+static void empilhar_declaracoes(const NoAST *declaracoes) {
+    for (const NoAST *decl = declaracoes; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_VARIAVEL) empilhar_variavel(decl->filho1->entrada_tabela, 0);
+    }
+}
+
+/**
+ * @brief Posição da variável na pilha, na ordem de busca do interpretador
+ * da AST: locais do quadro, parâmetros e globais.
+ */
+static int indice_variavel(const EntradaTabela *entrada) {
+    for (int i = num_variaveis - 1; i >= inicio_quadro + num_parametros_quadro; i--) {
+        if (variaveis[i].entrada == entrada) return i;
+    }
+    if (entrada->tipo != TIPO_FUNCAO && entrada->posicao >= 0 && entrada->posicao < num_parametros_quadro) {
+        return inicio_quadro + entrada->posicao;
+    }
+    for (int i = 0; i < num_globais; i++) {
+        if (variaveis[i].entrada == entrada) return i;
+    }
+    fprintf(stderr, "Erro interno: variavel '%s' nao encontrada pela avaliacao parcial.\n", entrada->lexema);
+    exit(EXIT_FAILURE);
+}
+
+static void atribuir(const EntradaTabela *entrada, int32_t valor) {
+    int indice = indice_variavel(entrada);
+    variaveis[indice].valor = valor;
+    if (indice < num_persistentes) alteradas[indice] = 1;
+}
+
+static void escrever_byte(int valor) {
+    if ((char)valor == '\0') parar(PARADA_BYTE_NULO);
+    if (tamanho_saida == capacidade_saida) {
+        capacidade_saida = capacidade_saida == 0 ? 256 : capacidade_saida * 2;
+        saida = realocar(saida, capacidade_saida);
+    }
+    saida[tamanho_saida++] = (char)valor;
+    verificar_memoria();
+}
+
+static int32_t avaliar(const NoAST *no);
+static void executar_comando(const NoAST *no);
+
+static int32_t chamar_funcao(const NoAST *chamada) {
+    const NoAST *declaracao = programa_avaliado->filho1;
+    while (declaracao->tipo_no != NO_DECL_FUNCAO
+           || declaracao->filho1->entrada_tabela != chamada->filho1->entrada_tabela) {
+        declaracao = declaracao->proximo;
+    }
+    if (profundidade == MAX_PROFUNDIDADE_AVALIACAO) parar(PARADA_MEMORIA);
+
+    // Os argumentos são empilhados à medida que são avaliados e viram os
+    // primeiros valores do quadro da função.
+    int topo_anterior = num_variaveis;
+    int num_argumentos = 0;
+    for (const NoAST *arg = chamada->filho2; arg != NULL; arg = arg->proximo) {
+        int32_t valor = avaliar(arg);
+        empilhar_variavel(NULL, valor);
+        num_argumentos++;
+    }
+
+    int inicio_anterior = inicio_quadro;
+    int parametros_anteriores = num_parametros_quadro;
+    inicio_quadro = topo_anterior;
+    num_parametros_quadro = num_argumentos;
+    profundidade++;
+
+    executar_comando(declaracao->filho3);
+    int32_t resultado = retornando ? valor_retorno : 0;
+    retornando = 0;
+
+    profundidade--;
+    num_variaveis = topo_anterior;
+    inicio_quadro = inicio_anterior;
+    num_parametros_quadro = parametros_anteriores;
+    return resultado;
+}
+
+static int32_t avaliar(const NoAST *no) {
+    contar_passo();
+    switch (no->tipo_no) {
+        case NO_LITERAL_INT: return no->ival;
+        case NO_LITERAL_CAR: return no->cval;
+        case NO_ID: return variaveis[indice_variavel(no->entrada_tabela)].valor;
+        case NO_CHAMADA_FUNCAO: return chamar_funcao(no);
+        case NO_COMANDO_ATRIBUICAO: {
+            int32_t valor = avaliar(no->filho2);
+            atribuir(no->filho1->entrada_tabela, valor);
+            return valor;
+        }
+        case NO_OP_E: return avaliar(no->filho1) && avaliar(no->filho2);
+        case NO_OP_OU: return avaliar(no->filho1) || avaliar(no->filho2);
+        case NO_OP_NEGACAO: return !avaliar(no->filho1);
+        case NO_OP_UNARIO_MENOS: {
+            int32_t valor = avaliar(no->filho1);
+            if (valor == INT32_MIN) parar(PARADA_ERRO);
+            return -valor;
+        }
+        default: break;
+    }
+
+    int32_t esquerdo = avaliar(no->filho1);
+    int32_t direito = avaliar(no->filho2);
+    int64_t resultado;
+    switch (no->tipo_no) {
+        // 'add' e 'sub' do MIPS geram exceção no estouro: o erro fica para o programa.
+        case NO_OP_SOMA:
+            resultado = (int64_t)esquerdo + direito;
+            if (resultado < INT32_MIN || resultado > INT32_MAX) parar(PARADA_ERRO);
+            return (int32_t)resultado;
+        case NO_OP_SUB:
+            resultado = (int64_t)esquerdo - direito;
+            if (resultado < INT32_MIN || resultado > INT32_MAX) parar(PARADA_ERRO);
+            return (int32_t)resultado;
+        case NO_OP_MULT: return (int32_t)((uint32_t)esquerdo * (uint32_t)direito);
+        case NO_OP_DIV:
+            if (direito == 0 || (direito == -1 && esquerdo == INT32_MIN)) parar(PARADA_ERRO);
+            return esquerdo / direito;
+        case NO_OP_IGUAL: return esquerdo == direito;
+        case NO_OP_DIFERENTE: return esquerdo != direito;
+        case NO_OP_MENOR: return esquerdo < direito;
+        case NO_OP_MENOR_IGUAL: return esquerdo <= direito;
+        case NO_OP_MAIOR: return esquerdo > direito;
+        case NO_OP_MAIOR_IGUAL: return esquerdo >= direito;
+        default:
+            fprintf(stderr, "Erro interno: expressao sem avaliacao (linha %d).\n", no->linha);
+            exit(EXIT_FAILURE);
+    }
+}
+
+static void escrever_string(const char *texto) {
+    for (const char *c = texto; *c != '\0'; c++) {
+        if (*c == '\\' && c[1] != '\0') {
+            c++;
+            switch (*c) {
+                case 'n': escrever_byte('\n'); break;
+                case 't': escrever_byte('\t'); break;
+                case 'r': escrever_byte('\r'); break;
+                case '0': escrever_byte('\0'); break;
+                default:  escrever_byte(*c); break;
+            }
+        } else {
+            escrever_byte(*c);
+        }
+    }
+}
+
+static void escrever_int(int32_t valor) {
+    char digitos[12];
+    snprintf(digitos, sizeof(digitos), "%d", valor);
+    for (const char *c = digitos; *c != '\0'; c++) escrever_byte(*c);
+}
+
+static void executar_lista(const NoAST *no) {
+    for (; no != NULL && !retornando; no = no->proximo) executar_comando(no);
+}
+
+static void executar_comando(const NoAST *no) {
+    contar_passo();
+    switch (no->tipo_no) {
+        case NO_BLOCO: {
+            int topo = num_variaveis;
+            empilhar_declaracoes(no->filho1);
+            executar_lista(no->filho2);
+            num_variaveis = topo;
+            break;
+        }
+        case NO_COMANDO_SE:
+            if (avaliar(no->filho1)) {
+                if (no->filho2 != NULL) executar_comando(no->filho2);
+            } else if (no->filho3 != NULL) {
+                executar_comando(no->filho3);
+            }
+            break;
+        case NO_COMANDO_ENQUANTO:
+            while (!retornando && avaliar(no->filho1)) {
+                if (no->filho2 != NULL) executar_comando(no->filho2);
+            }
+            break;
+        case NO_COMANDO_LEIA:
+            parar(PARADA_LEITURA);
+            break;
+        case NO_COMANDO_ESCREVA:
+            if (no->filho1->tipo_no == NO_LITERAL_STRING) {
+                escrever_string(no->filho1->lexema);
+            } else if (no->filho1->tipo_dado_computado == TIPO_CAR) {
+                escrever_byte(avaliar(no->filho1));
+            } else {
+                escrever_int(avaliar(no->filho1));
+            }
+            break;
+        case NO_COMANDO_NOVALINHA:
+            escrever_byte('\n');
+            break;
+        case NO_COMANDO_RETORNE:
+            valor_retorno = no->filho1 != NULL ? avaliar(no->filho1) : 0;
+            retornando = 1;
+            break;
+        default:
+            avaliar(no);
+            break;
+    }
+}
+
+/**
+ * @brief Executa um comando de 'programa'.
+ * @return PARADA_NENHUMA se ele terminou, ou o motivo da parada.
+ */
+static MotivoParada executar_protegido(const NoAST *comando) {
+    motivo_parada = PARADA_NENHUMA;
+    if (setjmp(ponto_parada) == 0) executar_comando(comando);
+    return motivo_parada;
+}
+
+/**
+ * @brief Texto da saída com os escapes de um literal da linguagem.
+ */
+static char *texto_literal() {
+    char *texto = realocar(NULL, 2 * (size_t)tamanho_saida + 1);
+    int n = 0;
+    for (int i = 0; i < tamanho_saida; i++) {
+        char c = saida[i];
+        switch (c) {
+            case '\n': texto[n++] = '\\'; texto[n++] = 'n'; break;
+            case '\t': texto[n++] = '\\'; texto[n++] = 't'; break;
+            case '\r': texto[n++] = '\\'; texto[n++] = 'r'; break;
+            case '"':
+            case '\\': texto[n++] = '\\'; texto[n++] = c; break;
+            default:   texto[n++] = c; break;
+        }
+    }
+    texto[n] = '\0';
+    return texto;
+}
+
+/**
+ * @brief Cria "variavel = valor" para uma global ou local de 'programa'.
+ */
+static NoAST *criar_atribuicao(const EntradaTabela *entrada, int32_t valor, int linha) {
+    NoAST *id = criar_no_id(entrada->lexema);
+    id->entrada_tabela = (EntradaTabela *)entrada;
+    id->tipo_dado_computado = entrada->tipo;
+    NoAST *literal = entrada->tipo == TIPO_CAR ? criar_no_car((char)valor) : criar_no_int(valor);
+    literal->tipo_dado_computado = entrada->tipo;
+    NoAST *atribuicao = criar_no(NO_COMANDO_ATRIBUICAO, id, literal, NULL);
+    atribuicao->tipo_dado_computado = entrada->tipo;
+    id->linha = literal->linha = atribuicao->linha = linha;
+    return atribuicao;
+}
+
+int avaliar_parcialmente(NoAST *raiz, long long max_passos, long long max_memoria) {
+    if (raiz == NULL || raiz->tipo_no != NO_PROGRAMA || raiz->filho2 == NULL) return 0;
+
+    programa_avaliado = raiz;
+    limite_passos = max_passos;
+    limite_memoria = max_memoria;
+    passos = 0;
+    num_variaveis = 0;
+    tamanho_saida = 0;
+    profundidade = 0;
+    retornando = 0;
+    inicio_quadro = 0;
+    num_parametros_quadro = 0;
+
+    int total = 0;
+    for (NoAST *comando = raiz->filho2; comando != NULL; comando = comando->proximo) total++;
+
+    int executados = 0;
+    MotivoParada motivo = PARADA_NENHUMA;
+    NoAST *anterior = NULL, *restante = raiz->filho2;
+    motivo_parada = PARADA_NENHUMA;
+    if (setjmp(ponto_parada) == 0) {
+        empilhar_declaracoes(raiz->filho1);
+        num_globais = num_variaveis;
+        inicio_quadro = num_variaveis;
+        empilhar_declaracoes(raiz->filho3);
+    }
+    // Se as próprias variáveis não cabem no orçamento de memória, nada é executado.
+    motivo = motivo_parada;
+    num_persistentes = num_variaveis;
+    alteradas = calloc(num_persistentes > 0 ? num_persistentes : 1, 1);
+    VariavelAvaliada *copia = realocar(NULL, (num_persistentes > 0 ? num_persistentes : 1) * sizeof(VariavelAvaliada));
+    char *copia_alteradas = realocar(NULL, num_persistentes > 0 ? num_persistentes : 1);
+    if (alteradas == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a avaliacao parcial.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Cada comando é executado sobre uma cópia do estado; o que para é desfeito.
+    for (; restante != NULL && motivo == PARADA_NENHUMA; anterior = restante, restante = restante->proximo) {
+        memcpy(copia, variaveis, num_persistentes * sizeof(VariavelAvaliada));
+        memcpy(copia_alteradas, alteradas, num_persistentes);
+        int saida_anterior = tamanho_saida;
+        motivo = executar_protegido(restante);
+        if (motivo != PARADA_NENHUMA) {
+            memcpy(variaveis, copia, num_persistentes * sizeof(VariavelAvaliada));
+            memcpy(alteradas, copia_alteradas, num_persistentes);
+            tamanho_saida = saida_anterior;
+            num_variaveis = num_persistentes;
+            inicio_quadro = num_globais;
+            num_parametros_quadro = 0;
+            profundidade = 0;
+            retornando = 0;
+            break;
+        }
+        executados++;
+    }
+
+    int completo = executados == total;
+    if (completo) {
+        printf("Avaliacao parcial: programa executado em compilacao (%lld passos); o codigo gerado so escreve "
+               "os %d bytes da saida.\n", passos, tamanho_saida);
+    } else if (executados > 0) {
+        printf("Avaliacao parcial: %d de %d comando(s) de 'programa' executado(s) em compilacao "
+               "(%lld passos, %d bytes de saida); o comando da linha %d %s.\n",
+               executados, total, passos, tamanho_saida, restante->linha, descricoes_parada[motivo]);
+    } else if (restante != NULL) {
+        printf("Avaliacao parcial: nenhum comando executado em compilacao; o comando da linha %d %s.\n",
+               restante->linha, descricoes_parada[motivo]);
+    }
+
+    if (executados > 0) {
+        // O prefixo executado vira a escrita da saída e, se o programa
+        // continua, as atribuições das variáveis que ele alterou.
+        int linha = raiz->filho2->linha;
+        NoAST *prefixo = raiz->filho2;
+        anterior->proximo = NULL;
+        liberar_ast(prefixo);
+
+        NoAST *comandos = NULL;
+        if (tamanho_saida > 0) {
+            char *texto = texto_literal();
+            NoAST *escreva = criar_no(NO_COMANDO_ESCREVA, criar_no_string(texto), NULL, NULL);
+            escreva->linha = escreva->filho1->linha = linha;
+            comandos = adicionar_a_lista(comandos, escreva);
+            free(texto);
+        }
+        for (int i = 0; i < num_persistentes && !completo; i++) {
+            if (alteradas[i]) {
+                comandos = adicionar_a_lista(comandos, criar_atribuicao(variaveis[i].entrada, variaveis[i].valor, linha));
+            }
+        }
+        raiz->filho2 = adicionar_a_lista(comandos, restante);
+    }
+
+    free(copia);
+    free(copia_alteradas);
+    free(alteradas);
+    free(variaveis);
+    free(saida);
+    alteradas = NULL;
+    variaveis = NULL;
+    saida = NULL;
+    capacidade_variaveis = 0;
+    capacidade_saida = 0;
+    programa_avaliado = NULL;
+    return completo;
+}
@@ -0,0 +1,36 @@
+#ifndef AVALIACAO_PARCIAL_H
+#define AVALIACAO_PARCIAL_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+
+/*
+ * Avaliação parcial em compilação.
+ *
+ * Os comandos do bloco 'programa' são executados, um a um, sobre a AST já
+ * verificada, até o primeiro que lê a entrada, que excede o orçamento de
+ * passos ou de memória ou que chega a um erro de execução (divisão por
+ * zero, estouro do 'add'/'sub' do MIPS). Esse comando é desfeito e o prefixo
+ * executado é substituído, na AST, por um único 'escreva' com a saída
+ * produzida, seguido de atribuições com os valores finais das globais e das
+ * locais de 'programa' que o prefixo alterou. O restante do programa é
+ * gerado normalmente. Um programa executado por completo vira só a escrita
+ * da sua saída.
+ */
+
+#define PASSOS_AVALIACAO_PADRAO 10000000LL
+#define MEMORIA_AVALIACAO_PADRAO (1LL << 20)
+
+// Chamadas aninhadas aceitas (o avaliador é recursivo e usa a pilha do compilador).
+#define MAX_PROFUNDIDADE_AVALIACAO 2000
+
+/**
+ * @brief Executa em compilação o maior prefixo de comandos de 'programa' que
+ * não depende da entrada e cabe no orçamento, e reescreve a AST.
+ * @param raiz O nó NO_PROGRAMA (já validado semanticamente).
+ * @param max_passos Nós avaliados e comandos executados aceitos.
+ * @param max_memoria Bytes aceitos para as variáveis e a saída produzida.
+ * @return 1 se o programa inteiro foi executado, 0 caso contrário.
+ */
+int avaliar_parcialmente(NoAST *raiz, long long max_passos, long long max_memoria);
+
+#endif
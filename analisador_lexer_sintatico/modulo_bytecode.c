@@ -0,0 +1,673 @@
+#include "modulo_bytecode.h"
+#include "modulo_constantes.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SEM_DESTINO (-1)        // O valor pode ficar em qualquer registrador
+#define DESCARTAR (-2)          // O valor não é usado (expressão como comando)
+#define MAX_REGISTRADORES 65535
+
+typedef enum TipoSimboloBytecode {
+    SIMBOLO_LOCAL,              // Registrador do quadro
+    SIMBOLO_GLOBAL,             // Índice no vetor de globais
+    SIMBOLO_FUNCAO              // Índice da função
+} TipoSimboloBytecode;
+
+typedef struct SimboloBytecode {
+    const EntradaTabela *entrada;
+    TipoSimboloBytecode tipo;
+    int indice;
+} SimboloBytecode;
+
+/* Desvios ainda sem destino: o campo 'c' é corrigido quando o alvo é conhecido. */
+typedef struct ListaSaltos {
+    int *indices;
+    int tamanho;
+    int capacidade;
+} ListaSaltos;
+
+static ProgramaBytecode *programa_atual = NULL;
+static SimboloBytecode *simbolos = NULL;          // Espalhamento por endereço da entrada
+static int capacidade_simbolos = 0;
+static int num_simbolos = 0;
+static int proximo_registrador = 0;
+static int maximo_registradores = 0;
+
+static void *alocar_bytecode(void *memoria, size_t tamanho) {
+    void *nova = realloc(memoria, tamanho > 0 ? tamanho : 1);
+    if (nova == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o bytecode.\n");
+        exit(EXIT_FAILURE);
+    }
+    return nova;
+}
+
+/* ---------- Símbolos ---------- */
+
+static unsigned espalhar_entrada(const EntradaTabela *entrada, int capacidade) {
+    uintptr_t valor = (uintptr_t)entrada;
+    return (unsigned)((valor >> 3) * 2654435761u) & (unsigned)(capacidade - 1);
+}
+
+static void inserir_simbolo(const SimboloBytecode *simbolo);
+
+static void reindexar_simbolos() {
+    SimboloBytecode *antigos = simbolos;
+    int capacidade_antiga = capacidade_simbolos;
+    capacidade_simbolos = capacidade_simbolos == 0 ? 64 : capacidade_simbolos * 2;
+    simbolos = calloc(capacidade_simbolos, sizeof(SimboloBytecode));
+    if (simbolos == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o bytecode.\n");
+        exit(EXIT_FAILURE);
+    }
+    num_simbolos = 0;
+    for (int i = 0; i < capacidade_antiga; i++) {
+        if (antigos[i].entrada != NULL) inserir_simbolo(&antigos[i]);
+    }
+    free(antigos);
+}
+
+static void inserir_simbolo(const SimboloBytecode *simbolo) {
+    if (2 * (num_simbolos + 1) > capacidade_simbolos) reindexar_simbolos();
+    unsigned h = espalhar_entrada(simbolo->entrada, capacidade_simbolos);
+    while (simbolos[h].entrada != NULL && simbolos[h].entrada != simbolo->entrada) {
+        h = (h + 1) & (unsigned)(capacidade_simbolos - 1);
+    }
+    if (simbolos[h].entrada == NULL) num_simbolos++;
+    simbolos[h] = *simbolo;
+}
+
+static void registrar_simbolo(const EntradaTabela *entrada, TipoSimboloBytecode tipo, int indice) {
+    SimboloBytecode simbolo;
+    simbolo.entrada = entrada;
+    simbolo.tipo = tipo;
+    simbolo.indice = indice;
+    inserir_simbolo(&simbolo);
+}
+
+/**
+ * @brief Procura o símbolo de uma entrada. Os parâmetros não são declarados
+ * por nós com entrada na AST: são reconhecidos pela posição (>= 0), que é o
+ * próprio registrador.
+ */
+static SimboloBytecode buscar_simbolo(const EntradaTabela *entrada) {
+    if (entrada != NULL && capacidade_simbolos > 0) {
+        unsigned h = espalhar_entrada(entrada, capacidade_simbolos);
+        while (simbolos[h].entrada != NULL) {
+            if (simbolos[h].entrada == entrada) return simbolos[h];
+            h = (h + 1) & (unsigned)(capacidade_simbolos - 1);
+        }
+    }
+    if (entrada != NULL && entrada->tipo != TIPO_FUNCAO && entrada->posicao >= 0) {
+        SimboloBytecode parametro = {entrada, SIMBOLO_LOCAL, entrada->posicao};
+        return parametro;
+    }
+    fprintf(stderr, "Erro interno: simbolo '%s' sem registrador no bytecode.\n",
+            entrada != NULL ? entrada->lexema : "?");
+    exit(EXIT_FAILURE);
+}
+
+/* ---------- Emissão ---------- */
+
+static int emitir_bc(OpBytecode op, int a, int b, int c) {
+    ProgramaBytecode *p = programa_atual;
+    if (p->tamanho == p->capacidade) {
+        p->capacidade = p->capacidade == 0 ? 256 : p->capacidade * 2;
+        p->codigo = alocar_bytecode(p->codigo, p->capacidade * sizeof(InstrucaoBytecode));
+    }
+    InstrucaoBytecode *instrucao = &p->codigo[p->tamanho];
+    instrucao->op = (uint16_t)op;
+    instrucao->a = (uint16_t)a;
+    instrucao->b = b;
+    instrucao->c = c;
+    return p->tamanho++;
+}
+
+static void adicionar_salto(ListaSaltos *lista, int indice) {
+    if (lista->tamanho == lista->capacidade) {
+        lista->capacidade = lista->capacidade == 0 ? 4 : lista->capacidade * 2;
+        lista->indices = alocar_bytecode(lista->indices, lista->capacidade * sizeof(int));
+    }
+    lista->indices[lista->tamanho++] = indice;
+}
+
+/**
+ * @brief Aponta os desvios da lista para 'alvo' e libera a lista.
+ */
+static void corrigir_saltos(ListaSaltos *lista, int alvo) {
+    for (int i = 0; i < lista->tamanho; i++) programa_atual->codigo[lista->indices[i]].c = alvo;
+    free(lista->indices);
+    lista->indices = NULL;
+    lista->tamanho = 0;
+    lista->capacidade = 0;
+}
+
+static int novo_registrador() {
+    if (proximo_registrador >= MAX_REGISTRADORES) {
+        fprintf(stderr, "Erro: funcao com mais de %d registradores no bytecode.\n", MAX_REGISTRADORES);
+        exit(EXIT_FAILURE);
+    }
+    int registrador = proximo_registrador++;
+    if (proximo_registrador > maximo_registradores) maximo_registradores = proximo_registrador;
+    return registrador;
+}
+
+static int registrador_destino(int destino) {
+    return destino >= 0 ? destino : novo_registrador();
+}
+
+/* ---------- Expressões ---------- */
+
+static int compilar_expressao(const NoAST *no, int destino);
+static void compilar_desvio(const NoAST *no, int desviar_se_verdadeira, ListaSaltos *saltos);
+
+static int contem_atribuicao(const NoAST *no) {
+    if (no == NULL) return 0;
+    if (no->tipo_no == NO_COMANDO_ATRIBUICAO) return 1;
+    if (no->tipo_no == NO_CHAMADA_FUNCAO) {
+        for (const NoAST *arg = no->filho2; arg != NULL; arg = arg->proximo) {
+            if (contem_atribuicao(arg)) return 1;
+        }
+        return 0;
+    }
+    return contem_atribuicao(no->filho1) || contem_atribuicao(no->filho2);
+}
+
+/**
+ * @brief Avalia o operando esquerdo de um operador binário. Se ele é uma
+ * variável e o direito a altera ("x + (x = 1)"), o valor é copiado antes.
+ */
+static int compilar_operando_esquerdo(const NoAST *esquerdo, const NoAST *direito, int marca) {
+    int registrador = compilar_expressao(esquerdo, SEM_DESTINO);
+    if (registrador < marca && contem_atribuicao(direito)) {
+        int copia = novo_registrador();
+        emitir_bc(BC_MOVE, copia, registrador, 0);
+        return copia;
+    }
+    return registrador;
+}
+
+static OpBytecode op_comparacao(TipoNoAST tipo, OpBytecode base) {
+    switch (tipo) {
+        case NO_OP_IGUAL:       return base;
+        case NO_OP_DIFERENTE:   return base + 1;
+        case NO_OP_MENOR:       return base + 2;
+        case NO_OP_MENOR_IGUAL: return base + 3;
+        case NO_OP_MAIOR:       return base + 4;
+        default:                return base + 5;
+    }
+}
+
+static int e_comparacao(TipoNoAST tipo) {
+    return tipo == NO_OP_IGUAL || tipo == NO_OP_DIFERENTE || tipo == NO_OP_MENOR
+        || tipo == NO_OP_MENOR_IGUAL || tipo == NO_OP_MAIOR || tipo == NO_OP_MAIOR_IGUAL;
+}
+
+/* Desvios na ordem EQ, NE, LT, LE, GT, GE: negação e troca dos operandos. */
+static const int inversa_comparacao[6] = {1, 0, 5, 4, 3, 2};
+static const int espelho_comparacao[6] = {0, 1, 4, 5, 2, 3};
+
+static int compilar_binaria(const NoAST *no, int destino) {
+    int marca = proximo_registrador;
+    int k;
+    int constante_direita = avaliar_constante(no->filho2, NULL, &k);
+    int constante_esquerda = !constante_direita && avaliar_constante(no->filho1, NULL, &k);
+
+    OpBytecode op_imediato = NUM_OPS_BYTECODE;
+    const NoAST *operando = NULL;
+    switch (no->tipo_no) {
+        case NO_OP_SOMA:
+            if (constante_direita || constante_esquerda) {
+                op_imediato = BC_ADDK;
+                operando = constante_direita ? no->filho1 : no->filho2;
+            }
+            break;
+        case NO_OP_SUB:
+            if (constante_direita) {
+                op_imediato = BC_ADDK;
+                operando = no->filho1;
+                k = (int32_t)(0u - (uint32_t)k);
+            }
+            break;
+        case NO_OP_MULT:
+            if (constante_direita || constante_esquerda) {
+                op_imediato = BC_MULK;
+                operando = constante_direita ? no->filho1 : no->filho2;
+            }
+            break;
+        case NO_OP_DIV:
+            if (constante_direita && k != 0) {
+                op_imediato = BC_DIVK;
+                operando = no->filho1;
+            }
+            break;
+        default:
+            break;
+    }
+    if (op_imediato != NUM_OPS_BYTECODE) {
+        int registrador = compilar_expressao(operando, SEM_DESTINO);
+        proximo_registrador = marca;
+        int resultado = registrador_destino(destino);
+        emitir_bc(op_imediato, resultado, registrador, k);
+        return resultado;
+    }
+
+    int esquerdo = compilar_operando_esquerdo(no->filho1, no->filho2, marca);
+    int direito = compilar_expressao(no->filho2, SEM_DESTINO);
+    proximo_registrador = marca;
+    int resultado = registrador_destino(destino);
+    OpBytecode op;
+    switch (no->tipo_no) {
+        case NO_OP_SOMA: op = BC_ADD; break;
+        case NO_OP_SUB:  op = BC_SUB; break;
+        case NO_OP_MULT: op = BC_MUL; break;
+        case NO_OP_DIV:  op = BC_DIV; break;
+        default:         op = op_comparacao(no->tipo_no, BC_EQ); break;
+    }
+    emitir_bc(op, resultado, esquerdo, direito);
+    return resultado;
+}
+
+static int compilar_chamada(const NoAST *no, int destino) {
+    SimboloBytecode funcao = buscar_simbolo(no->filho1->entrada_tabela);
+    int base = proximo_registrador;
+    int num_argumentos = 0;
+    for (const NoAST *arg = no->filho2; arg != NULL; arg = arg->proximo) {
+        proximo_registrador = base + num_argumentos;
+        compilar_expressao(arg, novo_registrador());
+        num_argumentos++;
+    }
+    // O resultado volta em R[base], mesmo sem argumentos.
+    proximo_registrador = base;
+    novo_registrador();
+    emitir_bc(BC_CALL, base, funcao.indice, 0);
+    if (destino >= 0 && destino != base) {
+        emitir_bc(BC_MOVE, destino, base, 0);
+        proximo_registrador = base;
+        return destino;
+    }
+    return base;
+}
+
+/**
+ * @brief Reconhece "g = g + k" e "g = g - k" (k constante).
+ */
+static int incremento_constante(const NoAST *atribuicao, int *incremento) {
+    const NoAST *valor = atribuicao->filho2;
+    const EntradaTabela *variavel = atribuicao->filho1->entrada_tabela;
+    if (valor->tipo_no != NO_OP_SOMA && valor->tipo_no != NO_OP_SUB) return 0;
+    int k;
+    if (valor->filho1->tipo_no == NO_ID && valor->filho1->entrada_tabela == variavel
+        && avaliar_constante(valor->filho2, NULL, &k)) {
+        *incremento = valor->tipo_no == NO_OP_SOMA ? k : (int32_t)(0u - (uint32_t)k);
+        return 1;
+    }
+    if (valor->tipo_no == NO_OP_SOMA && valor->filho2->tipo_no == NO_ID && valor->filho2->entrada_tabela == variavel
+        && avaliar_constante(valor->filho1, NULL, &k)) {
+        *incremento = k;
+        return 1;
+    }
+    return 0;
+}
+
+static int compilar_atribuicao(const NoAST *no, int destino) {
+    SimboloBytecode variavel = buscar_simbolo(no->filho1->entrada_tabela);
+    if (variavel.tipo == SIMBOLO_LOCAL) {
+        compilar_expressao(no->filho2, variavel.indice);
+        if (destino >= 0 && destino != variavel.indice) {
+            emitir_bc(BC_MOVE, destino, variavel.indice, 0);
+            return destino;
+        }
+        return variavel.indice;
+    }
+
+    int incremento;
+    if (incremento_constante(no, &incremento)) {
+        emitir_bc(BC_INCG, 0, variavel.indice, incremento);
+        programa_atual->num_superinstrucoes++;
+        if (destino == DESCARTAR) return SEM_DESTINO;
+        int resultado = registrador_destino(destino);
+        emitir_bc(BC_LOADG, resultado, variavel.indice, 0);
+        return resultado;
+    }
+    int registrador = compilar_expressao(no->filho2, destino >= 0 ? destino : SEM_DESTINO);
+    emitir_bc(BC_STOREG, registrador, variavel.indice, 0);
+    return registrador;
+}
+
+/**
+ * @brief Compila uma expressão.
+ * @param destino Registrador em que o valor deve ficar, SEM_DESTINO ou DESCARTAR.
+ * @return O registrador com o valor (pode ser o da própria variável).
+ */
+static int compilar_expressao(const NoAST *no, int destino) {
+    int valor;
+    if (no->tipo_no != NO_COMANDO_ATRIBUICAO && no->tipo_no != NO_CHAMADA_FUNCAO
+        && avaliar_constante(no, NULL, &valor)) {
+        int resultado = registrador_destino(destino);
+        emitir_bc(BC_CONST, resultado, valor, 0);
+        return resultado;
+    }
+
+    switch (no->tipo_no) {
+        case NO_ID: {
+            SimboloBytecode variavel = buscar_simbolo(no->entrada_tabela);
+            if (variavel.tipo == SIMBOLO_GLOBAL) {
+                int resultado = registrador_destino(destino);
+                emitir_bc(BC_LOADG, resultado, variavel.indice, 0);
+                return resultado;
+            }
+            if (destino >= 0 && destino != variavel.indice) {
+                emitir_bc(BC_MOVE, destino, variavel.indice, 0);
+                return destino;
+            }
+            return variavel.indice;
+        }
+        case NO_COMANDO_ATRIBUICAO:
+            return compilar_atribuicao(no, destino);
+        case NO_CHAMADA_FUNCAO:
+            return compilar_chamada(no, destino);
+        case NO_OP_SOMA: case NO_OP_SUB: case NO_OP_MULT: case NO_OP_DIV:
+        case NO_OP_IGUAL: case NO_OP_DIFERENTE: case NO_OP_MENOR:
+        case NO_OP_MENOR_IGUAL: case NO_OP_MAIOR: case NO_OP_MAIOR_IGUAL:
+            return compilar_binaria(no, destino);
+        case NO_OP_NEGACAO:
+        case NO_OP_UNARIO_MENOS: {
+            int marca = proximo_registrador;
+            int operando = compilar_expressao(no->filho1, SEM_DESTINO);
+            proximo_registrador = marca;
+            int resultado = registrador_destino(destino);
+            emitir_bc(no->tipo_no == NO_OP_NEGACAO ? BC_NOT : BC_NEG, resultado, operando, 0);
+            return resultado;
+        }
+        case NO_OP_E:
+        case NO_OP_OU: {
+            // O valor (0 ou 1) é montado com os desvios do curto-circuito.
+            int marca = proximo_registrador;
+            ListaSaltos falsos = {NULL, 0, 0};
+            compilar_desvio(no, 0, &falsos);
+            proximo_registrador = marca;
+            int resultado = registrador_destino(destino);
+            emitir_bc(BC_CONST, resultado, 1, 0);
+            int salto_fim = emitir_bc(BC_JMP, 0, 0, 0);
+            corrigir_saltos(&falsos, programa_atual->tamanho);
+            emitir_bc(BC_CONST, resultado, 0, 0);
+            programa_atual->codigo[salto_fim].c = programa_atual->tamanho;
+            return resultado;
+        }
+        default:
+            fprintf(stderr, "Erro interno: expressao sem traducao para bytecode (linha %d).\n", no->linha);
+            exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Desvia para os alvos de 'saltos' quando a condição tem o valor
+ * 'desviar_se_verdadeira'; caso contrário, segue para a próxima instrução.
+ */
+static void compilar_desvio(const NoAST *no, int desviar_se_verdadeira, ListaSaltos *saltos) {
+    int valor;
+    if (no->tipo_no != NO_COMANDO_ATRIBUICAO && no->tipo_no != NO_CHAMADA_FUNCAO
+        && avaliar_constante(no, NULL, &valor)) {
+        if ((valor != 0) == desviar_se_verdadeira) adicionar_salto(saltos, emitir_bc(BC_JMP, 0, 0, 0));
+        return;
+    }
+
+    if (no->tipo_no == NO_OP_NEGACAO) {
+        compilar_desvio(no->filho1, !desviar_se_verdadeira, saltos);
+        return;
+    }
+    if (no->tipo_no == NO_OP_E || no->tipo_no == NO_OP_OU) {
+        // "a e b" desvia se falsa quando qualquer um é falso; "a ou b", o simétrico.
+        int curto_circuito = no->tipo_no == NO_OP_OU;
+        if (desviar_se_verdadeira == curto_circuito) {
+            compilar_desvio(no->filho1, desviar_se_verdadeira, saltos);
+            compilar_desvio(no->filho2, desviar_se_verdadeira, saltos);
+        } else {
+            ListaSaltos segue = {NULL, 0, 0};
+            compilar_desvio(no->filho1, curto_circuito, &segue);
+            compilar_desvio(no->filho2, desviar_se_verdadeira, saltos);
+            corrigir_saltos(&segue, programa_atual->tamanho);
+        }
+        return;
+    }
+
+    int marca = proximo_registrador;
+    if (e_comparacao(no->tipo_no)) {
+        int indice = op_comparacao(no->tipo_no, 0);
+        if (!desviar_se_verdadeira) indice = inversa_comparacao[indice];
+        int k;
+        if (avaliar_constante(no->filho2, NULL, &k)) {
+            int esquerdo = compilar_expressao(no->filho1, SEM_DESTINO);
+            adicionar_salto(saltos, emitir_bc(BC_JEQK + indice, esquerdo, k, 0));
+        } else if (avaliar_constante(no->filho1, NULL, &k)) {
+            int direito = compilar_expressao(no->filho2, SEM_DESTINO);
+            adicionar_salto(saltos, emitir_bc(BC_JEQK + espelho_comparacao[indice], direito, k, 0));
+        } else {
+            int esquerdo = compilar_operando_esquerdo(no->filho1, no->filho2, marca);
+            int direito = compilar_expressao(no->filho2, SEM_DESTINO);
+            adicionar_salto(saltos, emitir_bc(BC_JEQ + indice, esquerdo, direito, 0));
+        }
+        programa_atual->num_superinstrucoes++;
+    } else {
+        int registrador = compilar_expressao(no, SEM_DESTINO);
+        adicionar_salto(saltos, emitir_bc(desviar_se_verdadeira ? BC_JNZ : BC_JZ, registrador, 0, 0));
+    }
+    proximo_registrador = marca;
+}
+
+/* ---------- Comandos ---------- */
+
+static void compilar_comando(const NoAST *no);
+
+static void compilar_lista_comandos(const NoAST *no) {
+    for (; no != NULL; no = no->proximo) compilar_comando(no);
+}
+
+/**
+ * @brief Dá um registrador a cada variável declarada na lista.
+ */
+static void declarar_locais(const NoAST *declaracoes) {
+    for (const NoAST *decl = declaracoes; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_VARIAVEL || decl->filho1->entrada_tabela == NULL) continue;
+        registrar_simbolo(decl->filho1->entrada_tabela, SIMBOLO_LOCAL, novo_registrador());
+    }
+}
+
+static int registrar_string_bytecode(const char *texto) {
+    ProgramaBytecode *p = programa_atual;
+    p->strings = alocar_bytecode(p->strings, (p->num_strings + 1) * sizeof(StringBytecode));
+    StringBytecode *string = &p->strings[p->num_strings];
+    string->bytes = alocar_bytecode(NULL, strlen(texto) + 1);
+    int n = 0;
+    for (const char *c = texto; *c != '\0'; c++) {
+        if (*c == '\\' && c[1] != '\0') {
+            c++;
+            switch (*c) {
+                case 'n': string->bytes[n++] = '\n'; break;
+                case 't': string->bytes[n++] = '\t'; break;
+                case 'r': string->bytes[n++] = '\r'; break;
+                case '0': string->bytes[n++] = '\0'; break;
+                default:  string->bytes[n++] = *c; break;
+            }
+        } else {
+            string->bytes[n++] = *c;
+        }
+    }
+    string->tamanho = n;
+    return p->num_strings++;
+}
+
+static void compilar_comando(const NoAST *no) {
+    int marca = proximo_registrador;
+    switch (no->tipo_no) {
+        case NO_BLOCO:
+            declarar_locais(no->filho1);
+            compilar_lista_comandos(no->filho2);
+            break;
+
+        case NO_COMANDO_SE: {
+            ListaSaltos falsos = {NULL, 0, 0};
+            compilar_desvio(no->filho1, 0, &falsos);
+            if (no->filho2 != NULL) compilar_comando(no->filho2);
+            if (no->filho3 != NULL) {
+                int salto_fim = emitir_bc(BC_JMP, 0, 0, 0);
+                corrigir_saltos(&falsos, programa_atual->tamanho);
+                compilar_comando(no->filho3);
+                programa_atual->codigo[salto_fim].c = programa_atual->tamanho;
+            } else {
+                corrigir_saltos(&falsos, programa_atual->tamanho);
+            }
+            break;
+        }
+
+        case NO_COMANDO_ENQUANTO: {
+            // Teste no fim: um único desvio por iteração.
+            int valor;
+            if (avaliar_constante(no->filho1, NULL, &valor) && valor == 0) break;
+            int salto_teste = emitir_bc(BC_JMP, 0, 0, 0);
+            int inicio = programa_atual->tamanho;
+            if (no->filho2 != NULL) compilar_comando(no->filho2);
+            programa_atual->codigo[salto_teste].c = programa_atual->tamanho;
+            ListaSaltos repete = {NULL, 0, 0};
+            compilar_desvio(no->filho1, 1, &repete);
+            corrigir_saltos(&repete, inicio);
+            break;
+        }
+
+        case NO_COMANDO_LEIA: {
+            SimboloBytecode variavel = buscar_simbolo(no->filho1->entrada_tabela);
+            int registrador = variavel.tipo == SIMBOLO_LOCAL ? variavel.indice : novo_registrador();
+            emitir_bc(BC_LEIA, registrador, 0, 0);
+            // Como o 'sb' do código MIPS: uma variável 'car' guarda só o byte lido.
+            if (no->filho1->entrada_tabela->tipo == TIPO_CAR) emitir_bc(BC_TRUNCA_CAR, registrador, 0, 0);
+            if (variavel.tipo == SIMBOLO_GLOBAL) emitir_bc(BC_STOREG, registrador, variavel.indice, 0);
+            break;
+        }
+
+        case NO_COMANDO_ESCREVA:
+            if (no->filho1->tipo_no == NO_LITERAL_STRING) {
+                emitir_bc(BC_ESCREVA_STR, 0, registrar_string_bytecode(no->filho1->lexema), 0);
+            } else {
+                int registrador = compilar_expressao(no->filho1, SEM_DESTINO);
+                emitir_bc(no->filho1->tipo_dado_computado == TIPO_CAR ? BC_ESCREVA_CAR : BC_ESCREVA_INT,
+                          registrador, 0, 0);
+            }
+            break;
+
+        case NO_COMANDO_NOVALINHA:
+            emitir_bc(BC_NOVALINHA, 0, 0, 0);
+            break;
+
+        case NO_COMANDO_RETORNE:
+            if (no->filho1 != NULL) {
+                emitir_bc(BC_RET, compilar_expressao(no->filho1, SEM_DESTINO), 0, 0);
+            } else {
+                emitir_bc(BC_RET0, 0, 0, 0);
+            }
+            break;
+
+        default:
+            compilar_expressao(no, DESCARTAR);
+            break;
+    }
+    proximo_registrador = marca;
+}
+
+/* ---------- Funções e programa ---------- */
+
+static void iniciar_quadro(FuncaoBytecode *funcao, int num_parametros) {
+    funcao->inicio = programa_atual->tamanho;
+    funcao->num_parametros = num_parametros;
+    proximo_registrador = num_parametros;
+    maximo_registradores = num_parametros;
+}
+
+static void compilar_funcao(const NoAST *declaracao, FuncaoBytecode *funcao) {
+    int num_parametros = 0;
+    for (const NoAST *param = declaracao->filho2; param != NULL; param = param->proximo) {
+        if (param->tipo_no == NO_PARAMETRO) num_parametros++;
+    }
+    iniciar_quadro(funcao, num_parametros);
+    compilar_comando(declaracao->filho3);
+    emitir_bc(BC_RET0, 0, 0, 0);
+    funcao->num_registradores = maximo_registradores;
+}
+
+void compilar_bytecode(const NoAST *raiz, ProgramaBytecode *programa) {
+    memset(programa, 0, sizeof(ProgramaBytecode));
+    programa_atual = programa;
+    simbolos = NULL;
+    capacidade_simbolos = 0;
+    num_simbolos = 0;
+
+    // Primeiro as globais e os índices das funções (chamadas podem vir antes da declaração).
+    int num_funcoes = 0;
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_FUNCAO) {
+            registrar_simbolo(decl->filho1->entrada_tabela, SIMBOLO_FUNCAO, num_funcoes++);
+        } else if (decl->tipo_no == NO_DECL_VARIAVEL && decl->filho1->entrada_tabela != NULL) {
+            registrar_simbolo(decl->filho1->entrada_tabela, SIMBOLO_GLOBAL, programa->num_globais++);
+        }
+    }
+    programa->num_funcoes = num_funcoes + 1;
+    programa->funcoes = alocar_bytecode(NULL, programa->num_funcoes * sizeof(FuncaoBytecode));
+
+    // O bloco 'programa' vem primeiro no código: a execução começa no índice 0.
+    FuncaoBytecode *principal = &programa->funcoes[num_funcoes];
+    principal->nome = strdup("programa");
+    iniciar_quadro(principal, 0);
+    declarar_locais(raiz->filho3);
+    compilar_lista_comandos(raiz->filho2);
+    emitir_bc(BC_FIM, 0, 0, 0);
+    principal->num_registradores = maximo_registradores;
+
+    int indice = 0;
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        FuncaoBytecode *funcao = &programa->funcoes[indice++];
+        funcao->nome = strdup(decl->filho1->lexema);
+        compilar_funcao(decl, funcao);
+    }
+
+    free(simbolos);
+    simbolos = NULL;
+    capacidade_simbolos = 0;
+    programa_atual = NULL;
+}
+
+/* ---------- Listagem ---------- */
+
+#define NOME_OP_BYTECODE(nome) #nome,
+static const char *nomes_ops[NUM_OPS_BYTECODE] = { LISTA_OPS_BYTECODE(NOME_OP_BYTECODE) };
+#undef NOME_OP_BYTECODE
+
+const char *nome_op_bytecode(OpBytecode op) {
+    return op < NUM_OPS_BYTECODE ? nomes_ops[op] : "?";
+}
+
+void imprimir_bytecode(FILE *arquivo, const ProgramaBytecode *programa) {
+    for (int i = 0; i < programa->tamanho; i++) {
+        for (int f = 0; f < programa->num_funcoes; f++) {
+            const FuncaoBytecode *funcao = &programa->funcoes[f];
+            if (funcao->inicio == i) {
+                fprintf(arquivo, "%s: (%d parametro(s), %d registrador(es))\n",
+                        funcao->nome, funcao->num_parametros, funcao->num_registradores);
+            }
+        }
+        const InstrucaoBytecode *instrucao = &programa->codigo[i];
+        fprintf(arquivo, "  %5d  %-16s %5d %11d %11d\n", i, nome_op_bytecode(instrucao->op),
+                instrucao->a, instrucao->b, instrucao->c);
+    }
+    fprintf(arquivo, "Bytecode: %d instrucao(oes) em %d funcao(oes), %d superinstrucao(oes), %d global(is).\n",
+            programa->tamanho, programa->num_funcoes, programa->num_superinstrucoes, programa->num_globais);
+}
+
+void liberar_programa_bytecode(ProgramaBytecode *programa) {
+    for (int i = 0; i < programa->num_funcoes; i++) free(programa->funcoes[i].nome);
+    for (int i = 0; i < programa->num_strings; i++) free(programa->strings[i].bytes);
+    free(programa->funcoes);
+    free(programa->strings);
+    free(programa->codigo);
+    memset(programa, 0, sizeof(ProgramaBytecode));
+}
@@ -0,0 +1,126 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "modulo_arvore_sintatica_abstrata.h"
+
+/*
+ * Bytecode de registradores para a execução direta da AST verificada.
+ *
+ * Cada função tem um quadro de registradores: os parâmetros ocupam os
+ * primeiros, depois vêm as locais (blocos irmãos reaproveitam os mesmos) e os
+ * temporários. As globais ficam num vetor à parte. Uma chamada monta os
+ * argumentos em registradores consecutivos no topo do quadro de quem chama,
+ * que passam a ser os primeiros registradores do quadro da função chamada; o
+ * valor de retorno volta no registrador do primeiro argumento.
+ *
+ * Além das instruções simples, há superinstruções para as sequências mais
+ * comuns: comparação seguida de desvio (com registrador ou constante) e
+ * carga-soma-armazenamento de uma global ("g = g + k").
+ */
+
+/* Operandos: R[] são registradores do quadro, G[] são globais. */
+#define LISTA_OPS_BYTECODE(X) \
+    X(BC_CONST)         /* R[a] = b */ \
+    X(BC_MOVE)          /* R[a] = R[b] */ \
+    X(BC_LOADG)         /* R[a] = G[b] */ \
+    X(BC_STOREG)        /* G[b] = R[a] */ \
+    X(BC_INCG)          /* G[b] = G[b] + c */ \
+    X(BC_ADD)           /* R[a] = R[b] + R[c] */ \
+    X(BC_SUB)           /* R[a] = R[b] - R[c] */ \
+    X(BC_MUL)           /* R[a] = R[b] * R[c] */ \
+    X(BC_DIV)           /* R[a] = R[b] / R[c] */ \
+    X(BC_ADDK)          /* R[a] = R[b] + c */ \
+    X(BC_MULK)          /* R[a] = R[b] * c */ \
+    X(BC_DIVK)          /* R[a] = R[b] / c (c != 0) */ \
+    X(BC_NEG)           /* R[a] = -R[b] */ \
+    X(BC_NOT)           /* R[a] = !R[b] */ \
+    X(BC_EQ)            /* R[a] = R[b] == R[c] */ \
+    X(BC_NE) \
+    X(BC_LT) \
+    X(BC_LE) \
+    X(BC_GT) \
+    X(BC_GE) \
+    X(BC_TRUNCA_CAR)    /* R[a] = (signed char)R[a] */ \
+    X(BC_JMP)           /* pc = c */ \
+    X(BC_JZ)            /* se R[a] == 0: pc = c */ \
+    X(BC_JNZ)           /* se R[a] != 0: pc = c */ \
+    X(BC_JEQ)           /* se R[a] == R[b]: pc = c */ \
+    X(BC_JNE) \
+    X(BC_JLT) \
+    X(BC_JLE) \
+    X(BC_JGT) \
+    X(BC_JGE) \
+    X(BC_JEQK)          /* se R[a] == b: pc = c */ \
+    X(BC_JNEK) \
+    X(BC_JLTK) \
+    X(BC_JLEK) \
+    X(BC_JGTK) \
+    X(BC_JGEK) \
+    X(BC_CALL)          /* Chama a função b com os argumentos em R[a]...; o resultado fica em R[a] */ \
+    X(BC_RET)           /* Retorna R[a] */ \
+    X(BC_RET0)          /* Retorna 0 (fim de função sem 'retorne' ou 'retorne;') */ \
+    X(BC_LEIA)          /* R[a] = inteiro lido */ \
+    X(BC_ESCREVA_INT)   /* Escreve R[a] */ \
+    X(BC_ESCREVA_CAR) \
+    X(BC_ESCREVA_STR)   /* Escreve a string b */ \
+    X(BC_NOVALINHA) \
+    X(BC_FIM)           /* Fim do programa */
+
+#define DECLARAR_OP_BYTECODE(nome) nome,
+typedef enum OpBytecode {
+    LISTA_OPS_BYTECODE(DECLARAR_OP_BYTECODE)
+    NUM_OPS_BYTECODE
+} OpBytecode;
+#undef DECLARAR_OP_BYTECODE
+
+typedef struct InstrucaoBytecode {
+    uint16_t op;
+    uint16_t a;
+    int32_t b;
+    int32_t c;
+} InstrucaoBytecode;
+
+typedef struct FuncaoBytecode {
+    char *nome;
+    int inicio;                 // Índice da primeira instrução
+    int num_parametros;
+    int num_registradores;      // Tamanho do quadro (parâmetros, locais e temporários)
+} FuncaoBytecode;
+
+typedef struct StringBytecode {
+    char *bytes;                // Já sem os escapes
+    int tamanho;
+} StringBytecode;
+
+typedef struct ProgramaBytecode {
+    InstrucaoBytecode *codigo;
+    int tamanho;
+    int capacidade;
+    FuncaoBytecode *funcoes;    // A última é o bloco 'programa'
+    int num_funcoes;
+    StringBytecode *strings;
+    int num_strings;
+    int num_globais;
+    int num_superinstrucoes;    // Superinstruções emitidas (para o relatório)
+} ProgramaBytecode;
+
+/**
+ * @brief Compila a AST (já verificada pela análise semântica) para bytecode.
+ */
+void compilar_bytecode(const NoAST *raiz, ProgramaBytecode *programa);
+
+/**
+ * @brief Lista o bytecode, uma instrução por linha.
+ */
+void imprimir_bytecode(FILE *arquivo, const ProgramaBytecode *programa);
+
+/**
+ * @brief Nome de uma instrução (ex: "BC_JLTK").
+ */
+const char *nome_op_bytecode(OpBytecode op);
+
+void liberar_programa_bytecode(ProgramaBytecode *programa);
+
+#endif
@@ -0,0 +1,456 @@
+#include "modulo_cache_compilacao.h"
+#include "modulo_sha256.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SUFIXO_ENTRADA ".cache"
+#define PREFIXO_TEMPORARIO ".tmp-"
+// Temporários mais antigos que isso foram deixados por compilações interrompidas.
+#define IDADE_TEMPORARIO_ABANDONADO 3600
+
+// ---------------------------------------------------------------------------
+// Arquivos
+// ---------------------------------------------------------------------------
+
+static char *ler_arquivo(const char *caminho, size_t *tamanho) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return NULL;
+    size_t capacidade = 4096, n = 0;
+    char *dados = malloc(capacidade);
+    while (dados != NULL) {
+        if (n == capacidade) {
+            char *novos = realloc(dados, capacidade *= 2);
+            if (novos == NULL) { free(dados); dados = NULL; break; }
+            dados = novos;
+        }
+        ssize_t lidos = read(fd, dados + n, capacidade - n);
+        if (lidos < 0) { free(dados); dados = NULL; break; }
+        if (lidos == 0) break;
+        n += (size_t)lidos;
+    }
+    close(fd);
+    *tamanho = n;
+    return dados;
+}
+
+static int escrever_tudo(int fd, const char *dados, size_t tamanho) {
+    while (tamanho > 0) {
+        ssize_t escritos = write(fd, dados, tamanho);
+        if (escritos <= 0) return 0;
+        dados += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 1;
+}
+
+/**
+ * @brief Escreve 'caminho' de uma vez: num temporário do mesmo diretório,
+ * renomeado sobre o destino.
+ */
+static int escrever_atomicamente(const char *caminho, const char *temporario,
+                                 const char *const *partes, const size_t *tamanhos, int num_partes) {
+    int fd = open(temporario, O_WRONLY | O_CREAT | O_TRUNC | O_EXCL, 0644);
+    if (fd < 0) return 0;
+    int ok = 1;
+    for (int i = 0; i < num_partes && ok; i++) ok = escrever_tudo(fd, partes[i], tamanhos[i]);
+    if (close(fd) != 0) ok = 0;
+    if (ok && rename(temporario, caminho) != 0) ok = 0;
+    if (!ok) unlink(temporario);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Estado da compilação atual
+// ---------------------------------------------------------------------------
+
+static int cache_ativo = 0;
+static char diretorio_cache[4096];
+static long long limite_cache = LIMITE_CACHE_PADRAO;
+static char chave_cache[65];
+static char caminho_entrada[4200];
+static const char *saida_cache = NULL;
+
+static int capturando = 0;
+static FILE *captura_saida = NULL;
+static FILE *captura_erro = NULL;
+static int descritor_saida = -1;
+static int descritor_erro = -1;
+static char *mensagens_saida = NULL, *mensagens_erro = NULL;
+static size_t tamanho_mensagens_saida = 0, tamanho_mensagens_erro = 0;
+
+static char *ler_captura(FILE *captura, size_t *tamanho) {
+    int fd = fileno(captura);
+    off_t fim = lseek(fd, 0, SEEK_END);
+    char *dados = malloc(fim > 0 ? (size_t)fim : 1);
+    *tamanho = 0;
+    if (dados == NULL || fim < 0) return dados;
+    while (*tamanho < (size_t)fim) {
+        ssize_t lidos = pread(fd, dados + *tamanho, (size_t)fim - *tamanho, (off_t)*tamanho);
+        if (lidos <= 0) break;
+        *tamanho += (size_t)lidos;
+    }
+    return dados;
+}
+
+/**
+ * @brief Devolve a saída padrão e a de erro aos descritores originais e
+ * escreve nelas o que foi capturado.
+ */
+static void encerrar_captura() {
+    if (!capturando) return;
+    capturando = 0;
+    fflush(stdout);
+    fflush(stderr);
+    mensagens_saida = ler_captura(captura_saida, &tamanho_mensagens_saida);
+    mensagens_erro = ler_captura(captura_erro, &tamanho_mensagens_erro);
+    dup2(descritor_saida, STDOUT_FILENO);
+    dup2(descritor_erro, STDERR_FILENO);
+    close(descritor_saida);
+    close(descritor_erro);
+    fclose(captura_saida);
+    fclose(captura_erro);
+    if (mensagens_saida != NULL) escrever_tudo(STDOUT_FILENO, mensagens_saida, tamanho_mensagens_saida);
+    if (mensagens_erro != NULL) escrever_tudo(STDERR_FILENO, mensagens_erro, tamanho_mensagens_erro);
+}
+
+// Um exit() no meio da compilação ainda mostra as mensagens (mas não grava a entrada).
+static void encerrar_captura_na_saida(void) {
+    encerrar_captura();
+}
+
+static void iniciar_captura() {
+    static int registrado = 0;
+    captura_saida = tmpfile();
+    captura_erro = tmpfile();
+    fflush(stdout);
+    fflush(stderr);
+    descritor_saida = dup(STDOUT_FILENO);
+    descritor_erro = dup(STDERR_FILENO);
+    if (captura_saida == NULL || captura_erro == NULL || descritor_saida < 0 || descritor_erro < 0
+        || dup2(fileno(captura_saida), STDOUT_FILENO) < 0 || dup2(fileno(captura_erro), STDERR_FILENO) < 0) {
+        if (descritor_saida >= 0) dup2(descritor_saida, STDOUT_FILENO);
+        if (descritor_erro >= 0) dup2(descritor_erro, STDERR_FILENO);
+        fprintf(stderr, "Aviso: cache desativado (nao foi possivel capturar as mensagens).\n");
+        if (captura_saida != NULL) fclose(captura_saida);
+        if (captura_erro != NULL) fclose(captura_erro);
+        if (descritor_saida >= 0) close(descritor_saida);
+        if (descritor_erro >= 0) close(descritor_erro);
+        cache_ativo = 0;
+        return;
+    }
+    capturando = 1;
+    if (!registrado) {
+        atexit(encerrar_captura_na_saida);
+        registrado = 1;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Estatísticas e remoção (LRU)
+// ---------------------------------------------------------------------------
+
+typedef struct EstatisticasCache {
+    unsigned long long acertos;
+    unsigned long long faltas;
+    unsigned long long remocoes;
+} EstatisticasCache;
+
+/**
+ * @brief Soma 'delta' às estatísticas do diretório (sob flock) e devolve os totais.
+ */
+static EstatisticasCache atualizar_estatisticas(const char *diretorio, EstatisticasCache delta) {
+    EstatisticasCache totais = {0, 0, 0};
+    char caminho[4200], texto[256];
+    snprintf(caminho, sizeof(caminho), "%s/estatisticas", diretorio);
+    int fd = open(caminho, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return totais;
+    flock(fd, LOCK_EX);
+    ssize_t lidos = pread(fd, texto, sizeof(texto) - 1, 0);
+    texto[lidos > 0 ? lidos : 0] = '\0';
+    sscanf(texto, "acertos %llu faltas %llu remocoes %llu", &totais.acertos, &totais.faltas, &totais.remocoes);
+    totais.acertos += delta.acertos;
+    totais.faltas += delta.faltas;
+    totais.remocoes += delta.remocoes;
+    if (delta.acertos || delta.faltas || delta.remocoes) {
+        int n = snprintf(texto, sizeof(texto), "acertos %llu\nfaltas %llu\nremocoes %llu\n",
+                         totais.acertos, totais.faltas, totais.remocoes);
+        if (ftruncate(fd, 0) == 0 && pwrite(fd, texto, (size_t)n, 0) != n) {
+            fprintf(stderr, "Aviso: nao foi possivel atualizar '%s'.\n", caminho);
+        }
+    }
+    close(fd);  // Libera o flock
+    return totais;
+}
+
+typedef struct EntradaDiretorio {
+    char nome[80];
+    long long tamanho;
+    long long modificacao;      // Em nanossegundos
+} EntradaDiretorio;
+
+static int comparar_por_uso(const void *a, const void *b) {
+    const EntradaDiretorio *x = a, *y = b;
+    if (x->modificacao != y->modificacao) return x->modificacao < y->modificacao ? -1 : 1;
+    return strcmp(x->nome, y->nome);
+}
+
+/**
+ * @brief Lista as entradas do cache (e apaga temporários abandonados).
+ */
+static EntradaDiretorio *listar_entradas(const char *diretorio, int *num_entradas, long long *total) {
+    EntradaDiretorio *entradas = NULL;
+    int n = 0, capacidade = 0;
+    *total = 0;
+    DIR *dir = opendir(diretorio);
+    if (dir != NULL) {
+        time_t agora = time(NULL);
+        struct dirent *item;
+        while ((item = readdir(dir)) != NULL) {
+            char caminho[4200];
+            struct stat info;
+            size_t tamanho_nome = strlen(item->d_name);
+            snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, item->d_name);
+            if (strncmp(item->d_name, PREFIXO_TEMPORARIO, strlen(PREFIXO_TEMPORARIO)) == 0) {
+                if (stat(caminho, &info) == 0 && agora - info.st_mtime > IDADE_TEMPORARIO_ABANDONADO) unlink(caminho);
+                continue;
+            }
+            if (tamanho_nome != 64 + strlen(SUFIXO_ENTRADA) || strcmp(item->d_name + 64, SUFIXO_ENTRADA) != 0
+                || stat(caminho, &info) != 0) {
+                continue;
+            }
+            if (n == capacidade) {
+                capacidade = capacidade == 0 ? 64 : capacidade * 2;
+                EntradaDiretorio *novas = realloc(entradas, capacidade * sizeof(EntradaDiretorio));
+                if (novas == NULL) break;
+                entradas = novas;
+            }
+            memcpy(entradas[n].nome, item->d_name, tamanho_nome + 1);
+            entradas[n].tamanho = (long long)info.st_size;
+            entradas[n].modificacao = (long long)info.st_mtim.tv_sec * 1000000000LL + info.st_mtim.tv_nsec;
+            *total += entradas[n].tamanho;
+            n++;
+        }
+        closedir(dir);
+    }
+    *num_entradas = n;
+    return entradas;
+}
+
+/**
+ * @brief Remove as entradas usadas há mais tempo até o cache caber no limite.
+ * @return O número de entradas removidas.
+ */
+static int remover_excedentes() {
+    int n, removidas = 0;
+    long long total;
+    EntradaDiretorio *entradas = listar_entradas(diretorio_cache, &n, &total);
+    if (total > limite_cache) {
+        qsort(entradas, n, sizeof(EntradaDiretorio), comparar_por_uso);
+        for (int i = 0; i < n && total > limite_cache; i++) {
+            char caminho[4200];
+            snprintf(caminho, sizeof(caminho), "%s/%s", diretorio_cache, entradas[i].nome);
+            // Outro processo pode ter removido a mesma entrada.
+            if (unlink(caminho) == 0) removidas++;
+            total -= entradas[i].tamanho;
+        }
+    }
+    free(entradas);
+    return removidas;
+}
+
+// ---------------------------------------------------------------------------
+// Entradas
+// ---------------------------------------------------------------------------
+
+/*
+ * Formato de uma entrada:
+ *
+ *     goianinha-cache 1
+ *     status <status>
+ *     saida <nome do arquivo ou -> <bytes>
+ *     mensagens <bytes da saida padrao> <bytes da saida de erro>
+ *
+ * seguido dos bytes do arquivo gerado, da saída padrão e da de erro.
+ */
+
+typedef struct EntradaCache {
+    char *dados;
+    int status;
+    char nome_saida[256];
+    const char *saida, *mensagens_saida, *mensagens_erro;
+    size_t tamanho_saida, tamanho_mensagens_saida, tamanho_mensagens_erro;
+} EntradaCache;
+
+static int ler_entrada(const char *caminho, EntradaCache *entrada) {
+    size_t tamanho;
+    entrada->dados = ler_arquivo(caminho, &tamanho);
+    if (entrada->dados == NULL) return 0;
+    char texto[512];
+    size_t tamanho_texto = tamanho < sizeof(texto) - 1 ? tamanho : sizeof(texto) - 1;
+    memcpy(texto, entrada->dados, tamanho_texto);
+    texto[tamanho_texto] = '\0';
+    int cabecalho = 0;
+    if (sscanf(texto, "goianinha-cache 1\nstatus %d\nsaida %255s %zu\nmensagens %zu %zu%n",
+               &entrada->status, entrada->nome_saida, &entrada->tamanho_saida,
+               &entrada->tamanho_mensagens_saida, &entrada->tamanho_mensagens_erro, &cabecalho) != 5
+        || strncmp(texto + cabecalho, "\n\n", 2) != 0
+        || cabecalho + 2 + entrada->tamanho_saida + entrada->tamanho_mensagens_saida
+           + entrada->tamanho_mensagens_erro != tamanho) {
+        free(entrada->dados);
+        entrada->dados = NULL;
+        return 0;
+    }
+    entrada->saida = entrada->dados + cabecalho + 2;
+    entrada->mensagens_saida = entrada->saida + entrada->tamanho_saida;
+    entrada->mensagens_erro = entrada->mensagens_saida + entrada->tamanho_mensagens_saida;
+    return 1;
+}
+
+static int calcular_chave(int argc, char **argv, const char *arquivo_fonte, const char *arquivo_perfil) {
+    Sha256 sha;
+    size_t tamanho;
+    iniciar_sha(&sha);
+    atualizar_campo_sha(&sha, VERSAO_COMPILADOR, strlen(VERSAO_COMPILADOR));
+
+    // O próprio executável: uma recompilação do compilador invalida o cache.
+    atualizar_campo_sha(&sha, resumo_executavel(), strlen(resumo_executavel()));
+
+    for (int i = 1; i < argc; i++) {
+        // --threads não muda o código gerado nem as mensagens.
+        if (argv[i] == arquivo_fonte || strncmp(argv[i], "--cache-", 8) == 0
+            || strncmp(argv[i], "--threads=", 10) == 0) {
+            continue;
+        }
+        atualizar_campo_sha(&sha, argv[i], strlen(argv[i]));
+    }
+
+    // O caminho do fonte aparece nas mensagens repetidas num acerto.
+    atualizar_campo_sha(&sha, arquivo_fonte, strlen(arquivo_fonte));
+    char *fonte = ler_arquivo(arquivo_fonte, &tamanho);
+    if (fonte == NULL) return 0;
+    atualizar_campo_sha(&sha, fonte, tamanho);
+    free(fonte);
+
+    if (arquivo_perfil != NULL) {
+        char *perfil = ler_arquivo(arquivo_perfil, &tamanho);
+        if (perfil == NULL) return 0;
+        atualizar_campo_sha(&sha, perfil, tamanho);
+        free(perfil);
+    }
+    finalizar_sha(&sha, chave_cache);
+    return 1;
+}
+
+int consultar_cache(const char *diretorio, long long limite_bytes, int argc, char **argv,
+                    const char *arquivo_fonte, const char *arquivo_perfil,
+                    const char *arquivo_saida, int *status) {
+    cache_ativo = 0;
+    if (strlen(diretorio) >= sizeof(diretorio_cache)) {
+        fprintf(stderr, "Aviso: cache desativado (caminho '%s' muito longo).\n", diretorio);
+        return 0;
+    }
+    struct stat info;
+    if (mkdir(diretorio, 0755) != 0 && (stat(diretorio, &info) != 0 || !S_ISDIR(info.st_mode))) {
+        fprintf(stderr, "Aviso: cache desativado (nao foi possivel criar o diretorio '%s').\n", diretorio);
+        return 0;
+    }
+    // Sem o fonte (ou o perfil) a compilação falha por conta própria.
+    if (!calcular_chave(argc, argv, arquivo_fonte, arquivo_perfil)) return 0;
+
+    snprintf(diretorio_cache, sizeof(diretorio_cache), "%s", diretorio);
+    limite_cache = limite_bytes;
+    saida_cache = arquivo_saida;
+    snprintf(caminho_entrada, sizeof(caminho_entrada), "%s/%s" SUFIXO_ENTRADA, diretorio_cache, chave_cache);
+    cache_ativo = 1;
+
+    EntradaCache entrada;
+    if (ler_entrada(caminho_entrada, &entrada)) {
+        int ok = 1;
+        if (strcmp(entrada.nome_saida, "-") != 0) {
+            char temporario[300];
+            snprintf(temporario, sizeof(temporario), "%s" PREFIXO_TEMPORARIO "%ld", arquivo_saida, (long)getpid());
+            ok = strcmp(entrada.nome_saida, arquivo_saida) == 0
+                 && escrever_atomicamente(arquivo_saida, temporario, &entrada.saida, &entrada.tamanho_saida, 1);
+        }
+        if (ok) {
+            utimensat(AT_FDCWD, caminho_entrada, NULL, 0);  // Entrada usada agora (LRU)
+            fflush(stdout);
+            fflush(stderr);
+            escrever_tudo(STDOUT_FILENO, entrada.mensagens_saida, entrada.tamanho_mensagens_saida);
+            escrever_tudo(STDERR_FILENO, entrada.mensagens_erro, entrada.tamanho_mensagens_erro);
+            EstatisticasCache acerto = {1, 0, 0};
+            atualizar_estatisticas(diretorio_cache, acerto);
+            printf("Cache: acerto (%.16s).\n", chave_cache);
+            *status = entrada.status;
+            free(entrada.dados);
+            cache_ativo = 0;
+            return 1;
+        }
+        free(entrada.dados);
+    } else if (access(caminho_entrada, F_OK) == 0) {
+        unlink(caminho_entrada);  // Entrada corrompida
+    }
+
+    iniciar_captura();
+    return 0;
+}
+
+void concluir_cache(int status, int gerou_saida) {
+    if (!cache_ativo) return;
+    cache_ativo = 0;
+    encerrar_captura();
+    if (mensagens_saida == NULL || mensagens_erro == NULL) return;
+
+    size_t tamanho_saida = 0;
+    char *saida = NULL;
+    if (gerou_saida) {
+        saida = ler_arquivo(saida_cache, &tamanho_saida);
+        if (saida == NULL) {
+            fprintf(stderr, "Aviso: '%s' nao foi guardado no cache.\n", saida_cache);
+            return;
+        }
+    }
+
+    char cabecalho[512], temporario[4300];
+    int tamanho_cabecalho = snprintf(cabecalho, sizeof(cabecalho),
+                                     "goianinha-cache 1\nstatus %d\nsaida %s %zu\nmensagens %zu %zu\n\n",
+                                     status, gerou_saida ? saida_cache : "-", tamanho_saida,
+                                     tamanho_mensagens_saida, tamanho_mensagens_erro);
+    snprintf(temporario, sizeof(temporario), "%s/" PREFIXO_TEMPORARIO "%ld-%.16s",
+             diretorio_cache, (long)getpid(), chave_cache);
+    const char *partes[4] = {cabecalho, saida != NULL ? saida : "", mensagens_saida, mensagens_erro};
+    size_t tamanhos[4] = {(size_t)tamanho_cabecalho, tamanho_saida, tamanho_mensagens_saida, tamanho_mensagens_erro};
+    int gravada = escrever_atomicamente(caminho_entrada, temporario, partes, tamanhos, 4);
+
+    EstatisticasCache falta = {0, 1, 0};
+    if (gravada) falta.remocoes = (unsigned long long)remover_excedentes();
+    atualizar_estatisticas(diretorio_cache, falta);
+    printf("Cache: falta (%.16s)%s", chave_cache, gravada ? "; entrada gravada" : "; entrada nao gravada");
+    if (falta.remocoes > 0) printf(", %llu entrada(s) antiga(s) removida(s)", falta.remocoes);
+    printf(".\n");
+
+    free(saida);
+    free(mensagens_saida);
+    free(mensagens_erro);
+    mensagens_saida = mensagens_erro = NULL;
+}
+
+void imprimir_estatisticas_cache(const char *diretorio) {
+    EstatisticasCache nenhuma = {0, 0, 0};
+    EstatisticasCache totais = atualizar_estatisticas(diretorio, nenhuma);
+    int n;
+    long long total;
+    free(listar_entradas(diretorio, &n, &total));
+    unsigned long long consultas = totais.acertos + totais.faltas;
+    printf("Cache '%s': %llu acerto(s), %llu falta(s)", diretorio, totais.acertos, totais.faltas);
+    if (consultas > 0) printf(" (%.1f%% de acertos)", 100.0 * (double)totais.acertos / (double)consultas);
+    printf(", %llu entrada(s) removida(s); %d entrada(s), %lld bytes.\n", totais.remocoes, n, total);
+}
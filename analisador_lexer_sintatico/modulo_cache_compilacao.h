@@ -0,0 +1,48 @@
+#ifndef CACHE_COMPILACAO_H
+#define CACHE_COMPILACAO_H
+
+/*
+ * Cache de compilação endereçado por conteúdo.
+ *
+ * Com --cache-dir=DIR, cada compilação é identificada pelo SHA-256 da
+ * versão e do executável do compilador, das opções da linha de comando, do
+ * caminho e do conteúdo do fonte e, com --profile-use, do conteúdo do
+ * perfil. A entrada DIR/<chave>.cache guarda o arquivo gerado (saida.s ou
+ * saida.c), o que a compilação escreveu na saída padrão e na de erro e o
+ * status de término. Num acerto, o arquivo é copiado e as mensagens são
+ * repetidas sem analisar o fonte.
+ *
+ * As entradas são escritas num arquivo temporário do diretório e renomeadas,
+ * de modo que compilações concorrentes nunca leem uma entrada incompleta. O
+ * tamanho do diretório é limitado (--cache-size); as entradas menos usadas
+ * recentemente (pela data de modificação, atualizada a cada acerto) são
+ * removidas. Os acertos, faltas e remoções são acumulados em
+ * DIR/estatisticas (--cache-stats).
+ */
+
+#define VERSAO_COMPILADOR "goianinha 1.0"
+#define LIMITE_CACHE_PADRAO (64LL << 20)
+
+/**
+ * @brief Procura a compilação no cache.
+ * Num acerto, escreve 'arquivo_saida', repete as mensagens guardadas e
+ * devolve o status em 'status'. Numa falta, passa a capturar a saída padrão
+ * e a de erro até concluir_cache().
+ * @return 1 num acerto, 0 numa falta (ou se o fonte não pôde ser lido).
+ */
+int consultar_cache(const char *diretorio, long long limite_bytes, int argc, char **argv,
+                    const char *arquivo_fonte, const char *arquivo_perfil,
+                    const char *arquivo_saida, int *status);
+
+/**
+ * @brief Termina a captura iniciada por uma falta, repete as mensagens e
+ * grava a entrada (com o arquivo gerado, se 'gerou_saida').
+ */
+void concluir_cache(int status, int gerou_saida);
+
+/**
+ * @brief Imprime as estatísticas acumuladas e o tamanho atual do cache.
+ */
+void imprimir_estatisticas_cache(const char *diretorio);
+
+#endif
@@ -0,0 +1,190 @@
+#include "modulo_cadeias_se.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+// Critérios para usar tabela de saltos em vez de busca binária.
+#define MIN_TESTES_TABELA 4
+#define MAX_ENTRADAS_TABELA 1024
+#define FATOR_DENSIDADE_TABELA 3
+
+/**
+ * @brief Lê o valor de um literal inteiro ou caractere.
+ */
+static int valor_constante(const NoAST *no, long long *valor) {
+    if (no->tipo_no == NO_LITERAL_INT) { *valor = no->ival; return 1; }
+    if (no->tipo_no == NO_LITERAL_CAR) { *valor = no->cval; return 1; }
+    return 0;
+}
+
+/**
+ * @brief Espelha um operador relacional (c < x  ==  x > c).
+ */
+static TipoNoAST espelhar_operador(TipoNoAST operador) {
+    switch (operador) {
+        case NO_OP_MENOR:       return NO_OP_MAIOR;
+        case NO_OP_MAIOR:       return NO_OP_MENOR;
+        case NO_OP_MENOR_IGUAL: return NO_OP_MAIOR_IGUAL;
+        case NO_OP_MAIOR_IGUAL: return NO_OP_MENOR_IGUAL;
+        default:                return operador;
+    }
+}
+
+/**
+ * @brief Converte "x OP c" no intervalo de valores de x que satisfazem o teste.
+ * @return 0 se a condição não tem essa forma (ou se o intervalo é vazio).
+ */
+static int intervalo_do_teste(const NoAST *condicao, NoAST **variavel, long long *inicio, long long *fim) {
+    TipoNoAST operador = condicao->tipo_no;
+    if (operador != NO_OP_IGUAL && operador != NO_OP_MENOR && operador != NO_OP_MAIOR
+        && operador != NO_OP_MENOR_IGUAL && operador != NO_OP_MAIOR_IGUAL) {
+        return 0;
+    }
+
+    NoAST *id = condicao->filho1;
+    long long c;
+    if (id->tipo_no == NO_ID && valor_constante(condicao->filho2, &c)) {
+        // x OP c
+    } else if (condicao->filho2->tipo_no == NO_ID && valor_constante(condicao->filho1, &c)) {
+        id = condicao->filho2;
+        operador = espelhar_operador(operador);
+    } else {
+        return 0;
+    }
+    if (id->entrada_tabela == NULL) return 0;
+
+    *variavel = id;
+    *inicio = INT_MIN;
+    *fim = INT_MAX;
+    switch (operador) {
+        case NO_OP_IGUAL:       *inicio = *fim = c; break;
+        case NO_OP_MENOR:       *fim = c - 1; break;
+        case NO_OP_MENOR_IGUAL: *fim = c; break;
+        case NO_OP_MAIOR:       *inicio = c + 1; break;
+        default:                *inicio = c; break;
+    }
+    return *inicio <= *fim;
+}
+
+/**
+ * @brief Devolve o próximo 'se' da cadeia a partir do ramo 'senao', ou NULL.
+ */
+static NoAST *proximo_se_da_cadeia(NoAST *senao) {
+    if (senao == NULL) return NULL;
+    if (senao->tipo_no == NO_COMANDO_SE) return senao;
+    if (senao->tipo_no == NO_BLOCO && senao->filho1 == NULL && senao->filho2 != NULL
+        && senao->filho2->proximo == NULL && senao->filho2->tipo_no == NO_COMANDO_SE) {
+        return senao->filho2;
+    }
+    return NULL;
+}
+
+static int comparar_pontos(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Monta a partição dos inteiros em intervalos, cada um associado ao
+ * primeiro teste da cadeia que o contém.
+ */
+static void montar_intervalos(CadeiaDespacho *cadeia, const long long *inicios, const long long *fins) {
+    int n = cadeia->num_bracos;
+    long long *pontos = malloc((2 * n + 1) * sizeof(long long));
+    int num_pontos = 0;
+
+    // Os pontos de corte são os inícios de cada segmento elementar.
+    pontos[num_pontos++] = INT_MIN;
+    for (int i = 0; i < n; i++) {
+        pontos[num_pontos++] = inicios[i];
+        if (fins[i] < INT_MAX) pontos[num_pontos++] = fins[i] + 1;
+    }
+    qsort(pontos, num_pontos, sizeof(long long), comparar_pontos);
+
+    cadeia->intervalos = malloc(num_pontos * sizeof(IntervaloDespacho));
+    cadeia->num_intervalos = 0;
+    for (int p = 0; p < num_pontos; p++) {
+        if (p > 0 && pontos[p] == pontos[p - 1]) continue;
+        long long inicio = pontos[p];
+        int braco = -1;
+        for (int i = 0; i < n; i++) {
+            if (inicios[i] <= inicio && inicio <= fins[i]) { braco = i; break; }
+        }
+
+        IntervaloDespacho *ultimo = cadeia->num_intervalos > 0 ? &cadeia->intervalos[cadeia->num_intervalos - 1] : NULL;
+        if (ultimo != NULL && ultimo->braco == braco) continue;
+        if (ultimo != NULL) ultimo->fim = inicio - 1;
+
+        cadeia->intervalos[cadeia->num_intervalos].inicio = inicio;
+        cadeia->intervalos[cadeia->num_intervalos].fim = INT_MAX;
+        cadeia->intervalos[cadeia->num_intervalos].braco = braco;
+        cadeia->num_intervalos++;
+    }
+    free(pontos);
+}
+
+int reconhecer_cadeia_se(NoAST *no_se, CadeiaDespacho *cadeia) {
+    int capacidade = 8;
+    long long *inicios = malloc(capacidade * sizeof(long long));
+    long long *fins = malloc(capacidade * sizeof(long long));
+    cadeia->bracos = malloc(capacidade * sizeof(NoAST *));
+    cadeia->num_bracos = 0;
+    cadeia->variavel = NULL;
+    cadeia->senao = NULL;
+    cadeia->intervalos = NULL;
+    cadeia->num_intervalos = 0;
+
+    NoAST *atual = no_se;
+    while (atual != NULL) {
+        NoAST *variavel;
+        long long inicio, fim;
+        if (!intervalo_do_teste(atual->filho1, &variavel, &inicio, &fim)
+            || (cadeia->variavel != NULL && variavel->entrada_tabela != cadeia->variavel->entrada_tabela)) {
+            // Teste fora do padrão: ele e o resto da cadeia viram o 'senao' final.
+            cadeia->senao = atual;
+            break;
+        }
+        if (cadeia->variavel == NULL) cadeia->variavel = variavel;
+
+        if (cadeia->num_bracos == capacidade) {
+            capacidade *= 2;
+            inicios = realloc(inicios, capacidade * sizeof(long long));
+            fins = realloc(fins, capacidade * sizeof(long long));
+            cadeia->bracos = realloc(cadeia->bracos, capacidade * sizeof(NoAST *));
+        }
+        inicios[cadeia->num_bracos] = inicio;
+        fins[cadeia->num_bracos] = fim;
+        cadeia->bracos[cadeia->num_bracos] = atual->filho2;
+        cadeia->num_bracos++;
+
+        NoAST *proximo = proximo_se_da_cadeia(atual->filho3);
+        if (proximo == NULL) cadeia->senao = atual->filho3;
+        atual = proximo;
+    }
+
+    int reconhecida = cadeia->num_bracos >= MIN_TESTES_DESPACHO;
+    if (reconhecida) montar_intervalos(cadeia, inicios, fins);
+    free(inicios);
+    free(fins);
+    if (!reconhecida) liberar_cadeia_despacho(cadeia);
+    return reconhecida;
+}
+
+int cadeia_e_densa(const CadeiaDespacho *cadeia, long long *menor, long long *maior) {
+    // Os intervalos extremos (que vão até INT_MIN e INT_MAX) são tratados com
+    // dois testes de faixa; a tabela cobre apenas os intervalos do meio.
+    if (cadeia->num_bracos < MIN_TESTES_TABELA || cadeia->num_intervalos < 3) return 0;
+    *menor = cadeia->intervalos[1].inicio;
+    *maior = cadeia->intervalos[cadeia->num_intervalos - 2].fim;
+    long long entradas = *maior - *menor + 1;
+    return entradas <= MAX_ENTRADAS_TABELA && entradas <= (long long)FATOR_DENSIDADE_TABELA * cadeia->num_intervalos;
+}
+
+void liberar_cadeia_despacho(CadeiaDespacho *cadeia) {
+    free(cadeia->bracos);
+    free(cadeia->intervalos);
+    cadeia->bracos = NULL;
+    cadeia->intervalos = NULL;
+    cadeia->num_bracos = 0;
+    cadeia->num_intervalos = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef CADEIAS_SE_H
+#define CADEIAS_SE_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+
+// Número mínimo de testes para que uma cadeia se/senao seja convertida.
+#define MIN_TESTES_DESPACHO 3
+
+/**
+ * @brief Faixa [inicio, fim] de valores da variável que leva a um mesmo braço.
+ */
+typedef struct IntervaloDespacho {
+    long long inicio;
+    long long fim;
+    int braco;              // Índice em 'bracos', ou -1 para o 'senao' final
+} IntervaloDespacho;
+
+/**
+ * @brief Cadeia "se (x OP c1) ... senao se (x OP c2) ... senao ..." reconhecida.
+ *
+ * Os intervalos são disjuntos, estão em ordem crescente e cobrem todos os
+ * valores inteiros: cada valor de 'x' leva ao braço do primeiro teste que
+ * ele satisfaz, como na cadeia original.
+ */
+typedef struct CadeiaDespacho {
+    NoAST *variavel;        // Nó ID da variável comparada
+    int num_bracos;
+    NoAST **bracos;         // Comando 'entao' de cada teste, na ordem da cadeia
+    NoAST *senao;           // Comando do 'senao' final (ou NULL)
+    int num_intervalos;
+    IntervaloDespacho *intervalos;
+} CadeiaDespacho;
+
+/**
+ * @brief Reconhece uma cadeia de despacho a partir de um nó 'se'.
+ *
+ * Cada teste deve comparar a mesma variável com uma constante (==, <, <=,
+ * >, >=, em qualquer ordem dos operandos) e o 'senao' de cada teste deve
+ * ser o próximo 'se' (diretamente ou num bloco sem declarações).
+ *
+ * @param no_se O nó NO_COMANDO_SE inicial.
+ * @param cadeia Preenchida em caso de sucesso (liberar com liberar_cadeia_despacho).
+ * @return 1 se a cadeia tem pelo menos MIN_TESTES_DESPACHO testes, 0 caso contrário.
+ */
+int reconhecer_cadeia_se(NoAST *no_se, CadeiaDespacho *cadeia);
+
+/**
+ * @brief Indica se a cadeia é densa o bastante para uma tabela de saltos.
+ * @param menor Recebe o primeiro valor coberto pela tabela.
+ * @param maior Recebe o último valor coberto pela tabela.
+ */
+int cadeia_e_densa(const CadeiaDespacho *cadeia, long long *menor, long long *maior);
+
+/**
+ * @brief Libera a memória alocada por reconhecer_cadeia_se.
+ */
+void liberar_cadeia_despacho(CadeiaDespacho *cadeia);
+
+#endif
@@ -0,0 +1,108 @@
+#include "modulo_constantes.h"
+#include <stdint.h>
+#include <limits.h>
+
+int avaliar_constante(const NoAST *no, const ConstantesParametros *constantes, int *valor) {
+    int a, b;
+    long long resultado;
+    if (no == NULL) return 0;
+
+    switch (no->tipo_no) {
+        case NO_LITERAL_INT:
+            *valor = no->ival;
+            return 1;
+        case NO_LITERAL_CAR:
+            *valor = no->cval;
+            return 1;
+        case NO_ID: {
+            const EntradaTabela *entrada = no->entrada_tabela;
+            if (constantes == NULL || entrada == NULL || entrada->tipo == TIPO_FUNCAO) return 0;
+            int posicao = entrada->posicao;
+            if (posicao < 0 || posicao >= constantes->num_parametros || !constantes->conhecido[posicao]) return 0;
+            *valor = constantes->valor[posicao];
+            return 1;
+        }
+
+        case NO_OP_SOMA:
+        case NO_OP_SUB:
+            if (!avaliar_constante(no->filho1, constantes, &a) || !avaliar_constante(no->filho2, constantes, &b)) return 0;
+            resultado = no->tipo_no == NO_OP_SOMA ? (long long)a + b : (long long)a - b;
+            if (resultado < INT_MIN || resultado > INT_MAX) return 0;
+            *valor = (int)resultado;
+            return 1;
+        case NO_OP_MULT:
+            if (!avaliar_constante(no->filho1, constantes, &a) || !avaliar_constante(no->filho2, constantes, &b)) return 0;
+            *valor = (int)((uint32_t)a * (uint32_t)b);
+            return 1;
+        case NO_OP_DIV:
+            if (!avaliar_constante(no->filho1, constantes, &a) || !avaliar_constante(no->filho2, constantes, &b)) return 0;
+            if (b == 0 || (a == INT_MIN && b == -1)) return 0;
+            *valor = a / b;
+            return 1;
+
+        case NO_OP_IGUAL: case NO_OP_DIFERENTE: case NO_OP_MENOR:
+        case NO_OP_MAIOR: case NO_OP_MENOR_IGUAL: case NO_OP_MAIOR_IGUAL:
+            if (!avaliar_constante(no->filho1, constantes, &a) || !avaliar_constante(no->filho2, constantes, &b)) return 0;
+            switch (no->tipo_no) {
+                case NO_OP_IGUAL:       *valor = a == b; break;
+                case NO_OP_DIFERENTE:   *valor = a != b; break;
+                case NO_OP_MENOR:       *valor = a < b; break;
+                case NO_OP_MAIOR:       *valor = a > b; break;
+                case NO_OP_MENOR_IGUAL: *valor = a <= b; break;
+                default:                *valor = a >= b; break;
+            }
+            return 1;
+
+        case NO_OP_E:
+        case NO_OP_OU:
+            // O operando esquerdo pode decidir sozinho (o direito não seria avaliado).
+            if (!avaliar_constante(no->filho1, constantes, &a)) return 0;
+            if ((no->tipo_no == NO_OP_E) == (a == 0)) {
+                *valor = a != 0;
+                return 1;
+            }
+            if (!avaliar_constante(no->filho2, constantes, &b)) return 0;
+            *valor = b != 0;
+            return 1;
+        case NO_OP_NEGACAO:
+            if (!avaliar_constante(no->filho1, constantes, &a)) return 0;
+            *valor = a == 0;
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+int parametro_alterado(const NoAST *corpo, int posicao) {
+    for (const NoAST *no = corpo; no != NULL; no = no->proximo) {
+        if (no->tipo_no == NO_COMANDO_ATRIBUICAO || no->tipo_no == NO_COMANDO_LEIA) {
+            const EntradaTabela *entrada = no->filho1->entrada_tabela;
+            if (entrada != NULL && entrada->tipo != TIPO_FUNCAO && entrada->posicao == posicao) return 1;
+        }
+        if (parametro_alterado(no->filho1, posicao) || parametro_alterado(no->filho2, posicao)
+            || parametro_alterado(no->filho3, posicao)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int argumentos_constantes(const NoAST *chamada, const NoAST *corpo_chamada,
+                          const ConstantesParametros *escopo, ConstantesParametros *argumentos) {
+    int num_args = chamada->filho1->entrada_tabela->num_argumentos;
+    int total = 0;
+    argumentos->num_parametros = num_args < MAX_PARAMETROS_CONSTANTES ? num_args : MAX_PARAMETROS_CONSTANTES;
+
+    const NoAST *arg = chamada->filho2;
+    for (int i = 0; i < argumentos->num_parametros; i++, arg = arg != NULL ? arg->proximo : NULL) {
+        argumentos->conhecido[i] = 0;
+        argumentos->valor[i] = 0;
+        if (arg != NULL && avaliar_constante(arg, escopo, &argumentos->valor[i])
+            && !parametro_alterado(corpo_chamada, i)) {
+            argumentos->conhecido[i] = 1;
+            total++;
+        }
+    }
+    return total;
+}
@@ -0,0 +1,50 @@
+#ifndef CONSTANTES_H
+#define CONSTANTES_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+
+// Apenas os primeiros parâmetros de uma função podem receber valor constante.
+#define MAX_PARAMETROS_CONSTANTES 16
+
+/**
+ * @brief Valores conhecidos (constantes) dos parâmetros da função em análise.
+ * Os parâmetros são indexados pela sua posição (EntradaTabela.posicao).
+ */
+typedef struct ConstantesParametros {
+    int num_parametros;
+    int conhecido[MAX_PARAMETROS_CONSTANTES];
+    int valor[MAX_PARAMETROS_CONSTANTES];
+} ConstantesParametros;
+
+/**
+ * @brief Avalia uma expressão em tempo de compilação.
+ *
+ * A expressão é constante quando só usa literais e parâmetros de valor
+ * conhecido. O resultado é o mesmo que o código gerado produziria em
+ * execução; somas e subtrações com overflow (que geram exceção no 'add' e
+ * no 'sub') e divisões por zero ou de INT_MIN por -1 não são avaliadas.
+ *
+ * @param constantes Parâmetros conhecidos (NULL se nenhum).
+ * @param valor Recebe o valor da expressão.
+ * @return 1 se a expressão é constante.
+ */
+int avaliar_constante(const NoAST *no, const ConstantesParametros *constantes, int *valor);
+
+/**
+ * @brief Indica se o parâmetro na posição dada recebe atribuição ou 'leia'
+ * no corpo da função (e portanto não pode ser substituído por uma constante).
+ */
+int parametro_alterado(const NoAST *corpo, int posicao);
+
+/**
+ * @brief Calcula os argumentos constantes de uma chamada.
+ * @param chamada O nó NO_CHAMADA_FUNCAO.
+ * @param corpo_chamada Corpo da função chamada (para excluir parâmetros alterados).
+ * @param escopo Parâmetros conhecidos no local da chamada (ou NULL).
+ * @param argumentos Recebe os valores conhecidos dos parâmetros da função chamada.
+ * @return O número de argumentos constantes.
+ */
+int argumentos_constantes(const NoAST *chamada, const NoAST *corpo_chamada,
+                          const ConstantesParametros *escopo, ConstantesParametros *argumentos);
+
+#endif
@@ -0,0 +1,90 @@
+#include "modulo_es_buferizada.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+void iniciar_es_buferizada(EntradaSaidaBuferizada *es, int descritor_entrada, int descritor_saida) {
+    es->descritor_entrada = descritor_entrada;
+    es->descritor_saida = descritor_saida;
+    es->tamanho_saida = 0;
+    es->posicao_entrada = 0;
+    es->tamanho_entrada = 0;
+}
+
+void descarregar_es(EntradaSaidaBuferizada *es) {
+    int escritos = 0;
+    while (escritos < es->tamanho_saida) {
+        ssize_t n = write(es->descritor_saida, es->saida + escritos, es->tamanho_saida - escritos);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            perror("Erro ao escrever a saida do programa");
+            exit(EXIT_FAILURE);
+        }
+        escritos += (int)n;
+    }
+    es->tamanho_saida = 0;
+}
+
+void escrever_texto_es(EntradaSaidaBuferizada *es, const char *texto, int tamanho) {
+    while (tamanho > 0) {
+        if (es->tamanho_saida == TAMANHO_BUFFER_ES) descarregar_es(es);
+        int cabe = TAMANHO_BUFFER_ES - es->tamanho_saida;
+        int n = tamanho < cabe ? tamanho : cabe;
+        memcpy(es->saida + es->tamanho_saida, texto, n);
+        es->tamanho_saida += n;
+        texto += n;
+        tamanho -= n;
+    }
+}
+
+void escrever_int_es(EntradaSaidaBuferizada *es, int32_t valor) {
+    char digitos[12];
+    int n = sizeof(digitos);
+    // O módulo é calculado sem sinal, o que também vale para INT_MIN.
+    uint32_t modulo = valor < 0 ? 0u - (uint32_t)valor : (uint32_t)valor;
+    do {
+        digitos[--n] = (char)('0' + modulo % 10);
+        modulo /= 10;
+    } while (modulo != 0);
+    if (valor < 0) digitos[--n] = '-';
+    escrever_texto_es(es, digitos + n, (int)sizeof(digitos) - n);
+}
+
+/**
+ * @brief Próximo caractere da entrada (-1 no fim), lendo um bloco quando o buffer acaba.
+ */
+static int proximo_caractere(EntradaSaidaBuferizada *es) {
+    if (es->posicao_entrada == es->tamanho_entrada) {
+        ssize_t n;
+        do {
+            n = read(es->descritor_entrada, es->entrada, TAMANHO_BUFFER_ES);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) return -1;
+        es->posicao_entrada = 0;
+        es->tamanho_entrada = (int)n;
+    }
+    return (unsigned char)es->entrada[es->posicao_entrada++];
+}
+
+int32_t ler_int_es(EntradaSaidaBuferizada *es) {
+    descarregar_es(es);
+    int c;
+    do {
+        c = proximo_caractere(es);
+    } while (c >= 0 && c <= ' ');
+    if (c < 0) return 0;
+
+    int negativo = 0;
+    if (c == '-') {
+        negativo = 1;
+        c = proximo_caractere(es);
+    }
+    uint32_t valor = 0;
+    while (c >= '0' && c <= '9') {
+        valor = valor * 10 + (uint32_t)(c - '0');
+        c = proximo_caractere(es);
+    }
+    return (int32_t)(negativo ? 0u - valor : valor);
+}
@@ -0,0 +1,45 @@
+#ifndef ES_BUFERIZADA_H
+#define ES_BUFERIZADA_H
+
+#include <stdint.h>
+
+/*
+ * Entrada e saída buferizadas dos modos de execução direta (--run e
+ * --run-ast), com a mesma semântica do runtime emitido no assembly: a saída
+ * só é escrita quando o buffer enche, antes de cada 'leia' e no fim; 'leia'
+ * pula espaços, aceita um '-' e devolve 0 no fim da entrada.
+ */
+
+#define TAMANHO_BUFFER_ES 65536
+
+typedef struct EntradaSaidaBuferizada {
+    int descritor_entrada;
+    int descritor_saida;
+    char saida[TAMANHO_BUFFER_ES];
+    int tamanho_saida;
+    char entrada[TAMANHO_BUFFER_ES];
+    int posicao_entrada;
+    int tamanho_entrada;
+} EntradaSaidaBuferizada;
+
+void iniciar_es_buferizada(EntradaSaidaBuferizada *es, int descritor_entrada, int descritor_saida);
+
+/**
+ * @brief Escreve o conteúdo do buffer de saída.
+ */
+void descarregar_es(EntradaSaidaBuferizada *es);
+
+void escrever_int_es(EntradaSaidaBuferizada *es, int32_t valor);
+void escrever_texto_es(EntradaSaidaBuferizada *es, const char *texto, int tamanho);
+
+static inline void escrever_car_es(EntradaSaidaBuferizada *es, int32_t valor) {
+    if (es->tamanho_saida == TAMANHO_BUFFER_ES) descarregar_es(es);
+    es->saida[es->tamanho_saida++] = (char)valor;
+}
+
+/**
+ * @brief Lê um inteiro (descarrega a saída antes, para os prompts aparecerem).
+ */
+int32_t ler_int_es(EntradaSaidaBuferizada *es);
+
+#endif
@@ -0,0 +1,197 @@
+#include "modulo_especializacao.h"
+
+/**
+ * @brief Conta os nós de uma subárvore (sem seguir o 'proximo' da raiz).
+ */
+static int tamanho_subarvore(const NoAST *no) {
+    if (no == NULL) return 0;
+    return 1 + contar_nos_ast(no->filho1) + contar_nos_ast(no->filho2) + contar_nos_ast(no->filho3);
+}
+
+static int beneficio_lista(const NoAST *no, const ConstantesParametros *constantes);
+
+static int beneficio_no(const NoAST *no, const ConstantesParametros *constantes) {
+    int valor;
+    switch (no->tipo_no) {
+        case NO_LITERAL_INT:
+        case NO_LITERAL_CAR:
+            return 0;
+        case NO_ID:
+            return avaliar_constante(no, constantes, &valor) ? 1 : 0;
+        case NO_OP_SOMA: case NO_OP_SUB: case NO_OP_MULT: case NO_OP_DIV:
+        case NO_OP_IGUAL: case NO_OP_DIFERENTE: case NO_OP_MENOR: case NO_OP_MAIOR:
+        case NO_OP_MENOR_IGUAL: case NO_OP_MAIOR_IGUAL: case NO_OP_E: case NO_OP_OU:
+        case NO_OP_NEGACAO:
+            if (avaliar_constante(no, constantes, &valor)) return tamanho_subarvore(no);
+            break;
+        case NO_COMANDO_SE:
+            if (avaliar_constante(no->filho1, constantes, &valor)) {
+                const NoAST *vivo = valor ? no->filho2 : no->filho3;
+                const NoAST *morto = valor ? no->filho3 : no->filho2;
+                return tamanho_subarvore(no->filho1) + tamanho_subarvore(morto) + beneficio_lista(vivo, constantes);
+            }
+            break;
+        case NO_COMANDO_ENQUANTO:
+            if (avaliar_constante(no->filho1, constantes, &valor) && valor == 0) return tamanho_subarvore(no);
+            break;
+        default:
+            break;
+    }
+    return beneficio_lista(no->filho1, constantes) + beneficio_lista(no->filho2, constantes)
+         + beneficio_lista(no->filho3, constantes);
+}
+
+static int beneficio_lista(const NoAST *no, const ConstantesParametros *constantes) {
+    int total = 0;
+    for (; no != NULL; no = no->proximo) total += beneficio_no(no, constantes);
+    return total;
+}
+
+int estimar_beneficio(const NoAST *corpo, const ConstantesParametros *constantes) {
+    return beneficio_lista(corpo, constantes);
+}
+
+static int mesmas_constantes(const ConstantesParametros *a, const ConstantesParametros *b) {
+    if (a->num_parametros != b->num_parametros) return 0;
+    for (int i = 0; i < a->num_parametros; i++) {
+        if (a->conhecido[i] != b->conhecido[i]) return 0;
+        if (a->conhecido[i] && a->valor[i] != b->valor[i]) return 0;
+    }
+    return 1;
+}
+
+Especializacao *buscar_especializacao(const PlanoEspecializacao *plano, const FuncaoGrafo *funcao,
+                                      const ConstantesParametros *argumentos) {
+    for (int i = 0; i < plano->num_especializacoes; i++) {
+        Especializacao *especializacao = &plano->especializacoes[i];
+        if (especializacao->funcao == funcao && mesmas_constantes(&especializacao->constantes, argumentos)) {
+            return especializacao;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Monta o nome da especialização: parâmetros constantes pelo valor
+ * ('m' para negativos) e os demais como 'x'. Ex: "soma__x_m3".
+ */
+static void montar_nome(Especializacao *especializacao, int indice) {
+    char *nome = especializacao->nome;
+    size_t tamanho = sizeof(especializacao->nome);
+    int usado = snprintf(nome, tamanho, "%s_", especializacao->funcao->entrada->lexema);
+    for (int i = 0; i < especializacao->constantes.num_parametros && usado < (int)tamanho; i++) {
+        if (especializacao->constantes.conhecido[i]) {
+            long long valor = especializacao->constantes.valor[i];
+            usado += snprintf(nome + usado, tamanho - usado, valor < 0 ? "_m%lld" : "_%lld", valor < 0 ? -valor : valor);
+        } else {
+            usado += snprintf(nome + usado, tamanho - usado, "_x");
+        }
+    }
+    if (usado >= (int)tamanho) {
+        snprintf(nome, tamanho, "%.60s__e%d", especializacao->funcao->entrada->lexema, indice);
+    }
+}
+
+static void imprimir_constantes(const ConstantesParametros *constantes) {
+    printf("(");
+    for (int i = 0; i < constantes->num_parametros; i++) {
+        if (i > 0) printf(", ");
+        if (constantes->conhecido[i]) printf("%d", constantes->valor[i]);
+        else printf("_");
+    }
+    printf(")");
+}
+
+typedef struct ContextoPlano {
+    const GrafoChamadas *grafo;
+    PlanoEspecializacao *plano;
+    int limite;
+} ContextoPlano;
+
+static void adicionar_especializacao(ContextoPlano *ctx, FuncaoGrafo *funcao, const ConstantesParametros *argumentos,
+                                     int beneficio) {
+    PlanoEspecializacao *plano = ctx->plano;
+    if (plano->num_especializacoes == plano->capacidade) {
+        plano->capacidade = plano->capacidade == 0 ? 8 : plano->capacidade * 2;
+        Especializacao *novas = realloc(plano->especializacoes, plano->capacidade * sizeof(Especializacao));
+        if (novas == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para as especializacoes.\n");
+            exit(EXIT_FAILURE);
+        }
+        plano->especializacoes = novas;
+    }
+    Especializacao *especializacao = &plano->especializacoes[plano->num_especializacoes];
+    especializacao->funcao = funcao;
+    especializacao->constantes = *argumentos;
+    especializacao->beneficio = beneficio;
+    montar_nome(especializacao, plano->num_especializacoes);
+    plano->num_especializacoes++;
+    plano->crescimento += funcao->tamanho;
+
+    printf("Especializacao: '%s' especializada para ", funcao->entrada->lexema);
+    imprimir_constantes(argumentos);
+    printf(" como 'func_%s' (%d nos dobrados).\n", especializacao->nome, beneficio);
+}
+
+/**
+ * @brief Visita as chamadas de um corpo, criando as especializações que valem a pena.
+ */
+static void planejar_chamadas(ContextoPlano *ctx, const NoAST *no, const ConstantesParametros *escopo) {
+    for (; no != NULL; no = no->proximo) {
+        if (no->tipo_no == NO_CHAMADA_FUNCAO) {
+            FuncaoGrafo *funcao = buscar_funcao_grafo(ctx->grafo, no->filho1->entrada_tabela);
+            ConstantesParametros argumentos;
+            if (funcao != NULL
+                && argumentos_constantes(no, funcao->declaracao->filho3, escopo, &argumentos) > 0
+                && buscar_especializacao(ctx->plano, funcao, &argumentos) == NULL
+                && ctx->plano->crescimento + funcao->tamanho <= ctx->limite) {
+                int existentes = 0;
+                for (int i = 0; i < ctx->plano->num_especializacoes; i++) {
+                    existentes += ctx->plano->especializacoes[i].funcao == funcao;
+                }
+                int beneficio = estimar_beneficio(funcao->declaracao->filho3, &argumentos);
+                if (existentes < MAX_ESPECIALIZACOES_POR_FUNCAO && beneficio >= BENEFICIO_MINIMO_ESPECIALIZACAO) {
+                    adicionar_especializacao(ctx, funcao, &argumentos, beneficio);
+                }
+            }
+        }
+        planejar_chamadas(ctx, no->filho1, escopo);
+        planejar_chamadas(ctx, no->filho2, escopo);
+        planejar_chamadas(ctx, no->filho3, escopo);
+    }
+}
+
+void planejar_especializacoes(NoAST *raiz, const GrafoChamadas *grafo, int limite_percentual,
+                              PlanoEspecializacao *plano) {
+    plano->num_especializacoes = 0;
+    plano->capacidade = 0;
+    plano->especializacoes = NULL;
+    plano->crescimento = 0;
+
+    int total = 0;
+    for (int i = 0; i < grafo->num_funcoes; i++) total += grafo->funcoes[i].tamanho;
+    ContextoPlano ctx;
+    ctx.grafo = grafo;
+    ctx.plano = plano;
+    ctx.limite = (int)((long long)total * limite_percentual / 100);
+    if (ctx.limite < CRESCIMENTO_MINIMO_ESPECIALIZACAO) ctx.limite = CRESCIMENTO_MINIMO_ESPECIALIZACAO;
+
+    planejar_chamadas(&ctx, raiz->filho2, NULL);
+    for (int i = 0; i < grafo->num_funcoes; i++) {
+        planejar_chamadas(&ctx, grafo->funcoes[i].declaracao->filho3, NULL);
+    }
+    // As especializações criadas também são visitadas, com seus parâmetros
+    // constantes: é assim que as constantes se propagam pelo grafo de chamadas.
+    for (int i = 0; i < plano->num_especializacoes; i++) {
+        ConstantesParametros escopo = plano->especializacoes[i].constantes;
+        planejar_chamadas(&ctx, plano->especializacoes[i].funcao->declaracao->filho3, &escopo);
+    }
+}
+
+void liberar_plano_especializacao(PlanoEspecializacao *plano) {
+    free(plano->especializacoes);
+    plano->especializacoes = NULL;
+    plano->num_especializacoes = 0;
+    plano->capacidade = 0;
+    plano->crescimento = 0;
+}
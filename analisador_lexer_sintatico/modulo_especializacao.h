@@ -0,0 +1,68 @@
+#ifndef ESPECIALIZACAO_H
+#define ESPECIALIZACAO_H
+
+#include "modulo_grafo_chamadas.h"
+#include "modulo_constantes.h"
+
+/*
+ * Especialização de funções por argumentos constantes.
+ *
+ * As chamadas com argumentos constantes (inclusive os que dependem de
+ * parâmetros constantes de uma versão especializada, propagados pelo grafo
+ * de chamadas) podem usar uma cópia da função em que esses parâmetros são
+ * substituídos pelos valores. A cópia só é criada quando a substituição
+ * permite dobrar pelo menos BENEFICIO_MINIMO_ESPECIALIZACAO nós da AST.
+ */
+#define BENEFICIO_MINIMO_ESPECIALIZACAO 3
+#define MAX_ESPECIALIZACOES_POR_FUNCAO 8
+
+// Crescimento máximo do programa (em % dos nós das funções), com um mínimo absoluto.
+#define CRESCIMENTO_ESPECIALIZACAO_PADRAO 50
+#define CRESCIMENTO_MINIMO_ESPECIALIZACAO 64
+
+#define TAM_NOME_ESPECIALIZACAO 128
+
+/**
+ * @brief Uma versão especializada de uma função.
+ */
+typedef struct Especializacao {
+    FuncaoGrafo *funcao;
+    ConstantesParametros constantes;
+    char nome[TAM_NOME_ESPECIALIZACAO];     // Ex: "checaOrd__10" (label "func_checaOrd__10")
+    int beneficio;                          // Nós da AST dobrados
+} Especializacao;
+
+typedef struct PlanoEspecializacao {
+    int num_especializacoes;
+    int capacidade;
+    Especializacao *especializacoes;
+    int crescimento;                        // Nós copiados pelas especializações
+} PlanoEspecializacao;
+
+/**
+ * @brief Escolhe as especializações a partir das chamadas do programa
+ * principal e das funções, propagando as constantes pelas cópias criadas.
+ * Imprime uma linha para cada especialização criada.
+ * @param limite_percentual Crescimento máximo em % dos nós das funções.
+ */
+void planejar_especializacoes(NoAST *raiz, const GrafoChamadas *grafo, int limite_percentual,
+                              PlanoEspecializacao *plano);
+
+/**
+ * @brief Procura a especialização de 'funcao' para os argumentos constantes dados.
+ * @return A especialização, ou NULL se não há uma (usar a função original).
+ */
+Especializacao *buscar_especializacao(const PlanoEspecializacao *plano, const FuncaoGrafo *funcao,
+                                      const ConstantesParametros *argumentos);
+
+/**
+ * @brief Estima quantos nós da AST são dobrados quando os parâmetros têm os valores dados.
+ */
+int estimar_beneficio(const NoAST *corpo, const ConstantesParametros *constantes);
+
+/**
+ * @brief Libera a memória do plano.
+ */
+void liberar_plano_especializacao(PlanoEspecializacao *plano);
+
+#endif
@@ -0,0 +1,478 @@
+#include "modulo_gerador_c.h"
+#include "modulo_constantes.h"
+#include "modulo_grafo_chamadas.h"
+#include "modulo_runtime_c.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+
+#define NOME_PRINCIPAL_C "goianinha_programa"
+
+/* Texto de uma função, montado antes de se saber quantos temporários ela usa. */
+typedef struct TextoC {
+    char *texto;
+    size_t tamanho;
+    size_t capacidade;
+} TextoC;
+
+static TextoC corpo_c;
+static int indentacao_c = 0;
+static int proximo_temporario_c = 0;
+static int max_temporarios_c = 0;
+
+static void gerar_expressao_c(const NoAST *no);
+static void gerar_comando_c(const NoAST *no);
+
+static void anexar_c(const char *formato, ...) {
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int n = vsnprintf(NULL, 0, formato, argumentos);
+    va_end(argumentos);
+    if (corpo_c.tamanho + n + 1 > corpo_c.capacidade) {
+        corpo_c.capacidade = (corpo_c.tamanho + n + 1) * 2;
+        corpo_c.texto = realloc(corpo_c.texto, corpo_c.capacidade);
+        if (corpo_c.texto == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para o gerador C.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    va_start(argumentos, formato);
+    vsnprintf(corpo_c.texto + corpo_c.tamanho, n + 1, formato, argumentos);
+    va_end(argumentos);
+    corpo_c.tamanho += n;
+}
+
+static void iniciar_linha_c(void) {
+    anexar_c("%*s", 4 * indentacao_c, "");
+}
+
+/* ---------- Nomes e tipos ---------- */
+
+/**
+ * @brief Nome C de uma variável. Os prefixos evitam colisões com palavras
+ * reservadas e com o runtime, e separam parâmetros das locais de mesmo nome.
+ */
+static void anexar_variavel_c(const EntradaTabela *entrada) {
+    if (entrada->endereco_global >= 0) {
+        anexar_c("g_%s", entrada->lexema);
+    } else if (entrada->posicao >= 0) {
+        anexar_c("p_%s", entrada->lexema);
+    } else {
+        anexar_c("v_%s", entrada->lexema);
+    }
+}
+
+static const char *tipo_c(TipoDado tipo) {
+    return tipo == TIPO_CAR ? "signed char" : "int32_t";
+}
+
+/* ---------- Expressões ---------- */
+
+static int constante_c(const NoAST *no, int *valor) {
+    return no->tipo_no != NO_CHAMADA_FUNCAO && no->tipo_no != NO_COMANDO_ATRIBUICAO
+        && avaliar_constante(no, NULL, valor);
+}
+
+/**
+ * @brief Indica se a expressão tem efeitos colaterais (chamada ou atribuição).
+ */
+static int impura_c(const NoAST *no) {
+    if (no == NULL) return 0;
+    if (no->tipo_no == NO_CHAMADA_FUNCAO || no->tipo_no == NO_COMANDO_ATRIBUICAO) return 1;
+    return impura_c(no->filho1) || impura_c(no->filho2);
+}
+
+static void anexar_literal_c(int valor) {
+    if (valor == INT32_MIN) {
+        anexar_c("INT32_MIN");
+    } else if (valor < 0) {
+        anexar_c("(%d)", valor);
+    } else {
+        anexar_c("%d", valor);
+    }
+}
+
+static int novo_temporario_c(void) {
+    int temporario = proximo_temporario_c++;
+    if (proximo_temporario_c > max_temporarios_c) max_temporarios_c = proximo_temporario_c;
+    return temporario;
+}
+
+/**
+ * @brief Operação binária, como chamada de rotina do runtime ou com operador
+ * infixo. Se algum operando tem efeitos colaterais, o esquerdo é avaliado
+ * antes, num temporário (o C não define a ordem entre os operandos).
+ */
+static void gerar_binaria_c(const NoAST *no, const char *rotina, const char *operador) {
+    int valor;
+    int temporario = -1;
+    int marca = proximo_temporario_c;
+    if ((impura_c(no->filho1) || impura_c(no->filho2))
+        && !constante_c(no->filho1, &valor) && !constante_c(no->filho2, &valor)) {
+        temporario = novo_temporario_c();
+        anexar_c("(gn_t%d = ", temporario);
+        gerar_expressao_c(no->filho1);
+        anexar_c(", ");
+    }
+    anexar_c("%s(", rotina != NULL ? rotina : "");
+    if (temporario >= 0) {
+        anexar_c("gn_t%d", temporario);
+    } else {
+        gerar_expressao_c(no->filho1);
+    }
+    if (rotina != NULL) {
+        anexar_c(", ");
+    } else {
+        anexar_c(" %s ", operador);
+    }
+    gerar_expressao_c(no->filho2);
+    anexar_c(")");
+    if (temporario >= 0) anexar_c(")");
+    proximo_temporario_c = marca;
+}
+
+/**
+ * @brief Chamada de função. Com mais de um argumento e algum efeito
+ * colateral, os argumentos (exceto o último) são avaliados antes, da
+ * esquerda para a direita, em temporários.
+ */
+static void gerar_chamada_c(const NoAST *no) {
+    int num_argumentos = 0, sequenciar = 0;
+    for (const NoAST *arg = no->filho2; arg != NULL; arg = arg->proximo) {
+        num_argumentos++;
+        if (impura_c(arg)) sequenciar = 1;
+    }
+    sequenciar = sequenciar && num_argumentos > 1;
+
+    int marca = proximo_temporario_c;
+    int primeiro = proximo_temporario_c;
+    if (sequenciar) {
+        anexar_c("(");
+        for (const NoAST *arg = no->filho2; arg->proximo != NULL; arg = arg->proximo) {
+            anexar_c("gn_t%d = ", novo_temporario_c());
+            gerar_expressao_c(arg);
+            anexar_c(", ");
+        }
+    }
+    anexar_c("f_%s(", no->filho1->lexema);
+    int i = 0;
+    for (const NoAST *arg = no->filho2; arg != NULL; arg = arg->proximo, i++) {
+        if (i > 0) anexar_c(", ");
+        if (sequenciar && arg->proximo != NULL) {
+            anexar_c("gn_t%d", primeiro + i);
+        } else {
+            gerar_expressao_c(arg);
+        }
+    }
+    anexar_c(")");
+    if (sequenciar) anexar_c(")");
+    proximo_temporario_c = marca;
+}
+
+static void gerar_expressao_c(const NoAST *no) {
+    int valor;
+    if (constante_c(no, &valor)) {
+        anexar_literal_c(valor);
+        return;
+    }
+
+    switch (no->tipo_no) {
+        case NO_ID:
+            anexar_variavel_c(no->entrada_tabela);
+            break;
+        case NO_LITERAL_INT:
+            anexar_literal_c(no->ival);
+            break;
+        case NO_LITERAL_CAR:
+            anexar_literal_c(no->cval);
+            break;
+        case NO_CHAMADA_FUNCAO:
+            gerar_chamada_c(no);
+            break;
+        case NO_COMANDO_ATRIBUICAO:
+            anexar_c("(");
+            anexar_variavel_c(no->filho1->entrada_tabela);
+            anexar_c(" = ");
+            gerar_expressao_c(no->filho2);
+            anexar_c(")");
+            break;
+        case NO_OP_SOMA: gerar_binaria_c(no, ROTINA_C_SOMA, NULL); break;
+        case NO_OP_SUB: gerar_binaria_c(no, ROTINA_C_SUB, NULL); break;
+        case NO_OP_MULT: gerar_binaria_c(no, ROTINA_C_MULT, NULL); break;
+        case NO_OP_DIV: gerar_binaria_c(no, ROTINA_C_DIVIDE, NULL); break;
+        case NO_OP_IGUAL: gerar_binaria_c(no, NULL, "=="); break;
+        case NO_OP_DIFERENTE: gerar_binaria_c(no, NULL, "!="); break;
+        case NO_OP_MENOR: gerar_binaria_c(no, NULL, "<"); break;
+        case NO_OP_MENOR_IGUAL: gerar_binaria_c(no, NULL, "<="); break;
+        case NO_OP_MAIOR: gerar_binaria_c(no, NULL, ">"); break;
+        case NO_OP_MAIOR_IGUAL: gerar_binaria_c(no, NULL, ">="); break;
+        case NO_OP_E:
+        case NO_OP_OU:
+            // && e || já avaliam da esquerda para a direita, com curto-circuito.
+            anexar_c("(");
+            gerar_expressao_c(no->filho1);
+            anexar_c(no->tipo_no == NO_OP_E ? " && " : " || ");
+            gerar_expressao_c(no->filho2);
+            anexar_c(")");
+            break;
+        case NO_OP_NEGACAO:
+            anexar_c("!");
+            gerar_expressao_c(no->filho1);
+            break;
+        case NO_OP_UNARIO_MENOS:
+            anexar_c("%s(0, ", ROTINA_C_SUB);
+            gerar_expressao_c(no->filho1);
+            anexar_c(")");
+            break;
+        default:
+            fprintf(stderr, "Erro de geracao C: No de expressao desconhecido (%d)\n", no->tipo_no);
+            break;
+    }
+}
+
+/**
+ * @brief String literal C com os bytes da string Goianinha (escapes já
+ * interpretados, como no pool de strings). Bytes não imprimíveis viram
+ * escapes octais de três dígitos.
+ */
+static int anexar_string_c(const char *texto) {
+    int tamanho = 0;
+    anexar_c("\"");
+    for (const char *c = texto; *c != '\0'; c++) {
+        unsigned char byte = (unsigned char)*c;
+        if (*c == '\\' && c[1] != '\0') {
+            c++;
+            switch (*c) {
+                case 'n': byte = '\n'; break;
+                case 't': byte = '\t'; break;
+                case 'r': byte = '\r'; break;
+                case '0': byte = '\0'; break;
+                default:  byte = (unsigned char)*c; break;
+            }
+        }
+        if (byte >= ' ' && byte < 127 && byte != '"' && byte != '\\' && byte != '?') {
+            anexar_c("%c", byte);
+        } else {
+            anexar_c("\\%03o", byte);
+        }
+        tamanho++;
+    }
+    anexar_c("\"");
+    return tamanho;
+}
+
+/* ---------- Comandos ---------- */
+
+static void gerar_declaracoes_c(const NoAST *declaracoes) {
+    for (const NoAST *decl = declaracoes; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_VARIAVEL) continue;
+        const EntradaTabela *entrada = decl->filho1->entrada_tabela;
+        iniciar_linha_c();
+        anexar_c("%s ", tipo_c(entrada->tipo));
+        anexar_variavel_c(entrada);
+        anexar_c(" = 0;\n");
+    }
+}
+
+static void gerar_lista_comandos_c(const NoAST *no) {
+    for (; no != NULL; no = no->proximo) gerar_comando_c(no);
+}
+
+/* Corpo de um comando composto, entre chaves já abertas. */
+static void gerar_ramo_c(const NoAST *no) {
+    indentacao_c++;
+    if (no != NULL) gerar_comando_c(no);
+    indentacao_c--;
+}
+
+static void gerar_comando_c(const NoAST *no) {
+    switch (no->tipo_no) {
+        case NO_BLOCO:
+            iniciar_linha_c();
+            anexar_c("{\n");
+            indentacao_c++;
+            gerar_declaracoes_c(no->filho1);
+            gerar_lista_comandos_c(no->filho2);
+            indentacao_c--;
+            iniciar_linha_c();
+            anexar_c("}\n");
+            break;
+
+        case NO_COMANDO_SE:
+            iniciar_linha_c();
+            anexar_c("if (");
+            gerar_expressao_c(no->filho1);
+            anexar_c(") {\n");
+            gerar_ramo_c(no->filho2);
+            if (no->filho3 != NULL) {
+                iniciar_linha_c();
+                anexar_c("} else {\n");
+                gerar_ramo_c(no->filho3);
+            }
+            iniciar_linha_c();
+            anexar_c("}\n");
+            break;
+
+        case NO_COMANDO_ENQUANTO:
+            iniciar_linha_c();
+            anexar_c("while (");
+            gerar_expressao_c(no->filho1);
+            anexar_c(") {\n");
+            gerar_ramo_c(no->filho2);
+            iniciar_linha_c();
+            anexar_c("}\n");
+            break;
+
+        case NO_COMANDO_LEIA: {
+            const EntradaTabela *entrada = no->filho1->entrada_tabela;
+            iniciar_linha_c();
+            anexar_variavel_c(entrada);
+            // Uma variável 'car' guarda só o byte lido (como o 'sb' do MIPS).
+            anexar_c(entrada->tipo == TIPO_CAR ? " = (signed char)%s();\n" : " = %s();\n", ROTINA_C_LEIA_INT);
+            break;
+        }
+
+        case NO_COMANDO_ESCREVA:
+            iniciar_linha_c();
+            if (no->filho1->tipo_no == NO_LITERAL_STRING) {
+                anexar_c("%s(", ROTINA_C_ESCREVA_TEXTO);
+                int tamanho = anexar_string_c(no->filho1->lexema);
+                anexar_c(", %d);\n", tamanho);
+            } else {
+                anexar_c("%s(", no->filho1->tipo_dado_computado == TIPO_CAR ? ROTINA_C_ESCREVA_CAR
+                                                                           : ROTINA_C_ESCREVA_INT);
+                gerar_expressao_c(no->filho1);
+                anexar_c(");\n");
+            }
+            break;
+
+        case NO_COMANDO_NOVALINHA:
+            iniciar_linha_c();
+            anexar_c("%s('\\n');\n", ROTINA_C_ESCREVA_CAR);
+            break;
+
+        case NO_COMANDO_RETORNE:
+            iniciar_linha_c();
+            anexar_c("return ");
+            if (no->filho1 != NULL) {
+                gerar_expressao_c(no->filho1);
+            } else {
+                anexar_c("0");
+            }
+            anexar_c(";\n");
+            break;
+
+        case NO_COMANDO_ATRIBUICAO:
+            iniciar_linha_c();
+            anexar_variavel_c(no->filho1->entrada_tabela);
+            anexar_c(" = ");
+            gerar_expressao_c(no->filho2);
+            anexar_c(";\n");
+            break;
+
+        default:
+            iniciar_linha_c();
+            if (no->tipo_no != NO_CHAMADA_FUNCAO) anexar_c("(void)");
+            gerar_expressao_c(no);
+            anexar_c(";\n");
+            break;
+    }
+}
+
+/* ---------- Funções e programa ---------- */
+
+static void escrever_assinatura_c(FILE *arquivo, const NoAST *decl) {
+    fprintf(arquivo, "static int32_t f_%s(", decl->filho1->lexema);
+    int num_parametros = 0;
+    for (const NoAST *param = decl->filho2; param != NULL; param = param->proximo) {
+        if (param->tipo_no != NO_PARAMETRO) continue;
+        fprintf(arquivo, "%s%s p_%s", num_parametros++ > 0 ? ", " : "",
+                tipo_c(param->tipo_dado_computado), param->filho1->lexema);
+    }
+    fprintf(arquivo, "%s)", num_parametros == 0 ? "void" : "");
+}
+
+/**
+ * @brief Escreve o corpo já montado em corpo_c, precedido dos temporários
+ * que ele usa, e termina com 'return 0' (função sem 'retorne').
+ */
+static void escrever_corpo_c(FILE *arquivo) {
+    fprintf(arquivo, " {\n");
+    if (max_temporarios_c > 0) {
+        fprintf(arquivo, "    int32_t");
+        for (int t = 0; t < max_temporarios_c; t++) fprintf(arquivo, "%s gn_t%d", t > 0 ? "," : "", t);
+        fprintf(arquivo, ";\n");
+    }
+    if (corpo_c.tamanho > 0) fwrite(corpo_c.texto, 1, corpo_c.tamanho, arquivo);
+    fprintf(arquivo, "    return 0;\n}\n\n");
+}
+
+static void iniciar_corpo_c(void) {
+    corpo_c.tamanho = 0;
+    indentacao_c = 1;
+    proximo_temporario_c = 0;
+    max_temporarios_c = 0;
+}
+
+void gerar_codigo_c(NoAST *raiz, const char *nome_arquivo_saida, const OpcoesGeracao *opcoes) {
+    FILE *arquivo = fopen(nome_arquivo_saida, "w");
+    if (arquivo == NULL) {
+        perror("Erro ao abrir arquivo de saida C");
+        exit(EXIT_FAILURE);
+    }
+
+    int num_alcancaveis = 0;
+    char *alcancaveis = NULL;
+    if (opcoes != NULL && opcoes->apenas_alcancaveis) alcancaveis = marcar_funcoes_alcancaveis(raiz, &num_alcancaveis);
+
+    fprintf(arquivo, "/* Gerado pelo compilador Goianinha (--target=c). */\n");
+    emitir_runtime_c(arquivo);
+
+    int num_globais = 0;
+    for (NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_VARIAVEL || decl->filho1->entrada_tabela == NULL) continue;
+        EntradaTabela *entrada = decl->filho1->entrada_tabela;
+        entrada->endereco_global = num_globais++;
+        fprintf(arquivo, "static %s g_%s;\n", tipo_c(entrada->tipo), entrada->lexema);
+    }
+    if (num_globais > 0) fprintf(arquivo, "\n");
+
+    // Protótipos: as chamadas podem vir antes da declaração.
+    int indice = 0, funcoes_geradas = 0;
+    for (NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        if (alcancaveis != NULL && !alcancaveis[indice++]) continue;
+        escrever_assinatura_c(arquivo, decl);
+        fprintf(arquivo, ";\n");
+        funcoes_geradas++;
+    }
+    if (funcoes_geradas > 0) fprintf(arquivo, "\n");
+
+    indice = 0;
+    for (NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        if (alcancaveis != NULL && !alcancaveis[indice++]) continue;
+        iniciar_corpo_c();
+        gerar_comando_c(decl->filho3);
+        escrever_assinatura_c(arquivo, decl);
+        escrever_corpo_c(arquivo);
+    }
+    free(alcancaveis);
+
+    iniciar_corpo_c();
+    gerar_declaracoes_c(raiz->filho3);
+    gerar_lista_comandos_c(raiz->filho2);
+    fprintf(arquivo, "static int32_t %s(void)", NOME_PRINCIPAL_C);
+    escrever_corpo_c(arquivo);
+
+    fprintf(arquivo, "int main(void) {\n");
+    fprintf(arquivo, "    %s();\n", NOME_PRINCIPAL_C);
+    fprintf(arquivo, "    %s();\n", ROTINA_C_DESCARREGAR);
+    fprintf(arquivo, "    return 0;\n}\n");
+
+    free(corpo_c.texto);
+    corpo_c.texto = NULL;
+    corpo_c.capacidade = 0;
+    printf("C: %d funcao(oes) e %d global(is) geradas.\n", funcoes_geradas, num_globais);
+    fclose(arquivo);
+}
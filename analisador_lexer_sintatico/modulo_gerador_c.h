@@ -0,0 +1,27 @@
+#ifndef GERADOR_C_H
+#define GERADOR_C_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+#include "modulo_gerador_codigo.h"
+
+/*
+ * Backend C (--target=c): gera um único arquivo C autocontido, para ser
+ * otimizado por gcc ou clang (ex: gcc -O2 saida.c). As funções viram funções
+ * 'static int32_t', 'car' vira 'signed char' (como o 'lb' do MIPS) e a
+ * semântica inteira da Goianinha fica explícita no runtime: aritmética de
+ * 32 bits em complemento de dois e divisão truncada, com INT_MIN / -1 igual
+ * a INT_MIN e erro de execução na divisão por zero. Onde a ordem de
+ * avaliação do C não é definida (operandos e argumentos com chamadas ou
+ * atribuições), os valores passam por temporários, mantendo a avaliação da
+ * esquerda para a direita.
+ */
+
+/**
+ * @brief Gera o programa C.
+ * @param raiz O nó raiz da AST (já validada semanticamente).
+ * @param nome_arquivo_saida Arquivo onde o código C será escrito.
+ * @param opcoes Opções de geração (só 'apenas_alcancaveis' é usada; NULL usa os padrões).
+ */
+void gerar_codigo_c(NoAST *raiz, const char *nome_arquivo_saida, const OpcoesGeracao *opcoes);
+
+#endif
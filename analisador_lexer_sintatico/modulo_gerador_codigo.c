@@ -1,66 +1,293 @@
 #include "modulo_gerador_codigo.h"
+#include "modulo_instrucoes_mips.h"
+#include "modulo_otimizador_peephole.h"
+#include "modulo_cadeias_se.h"
+#include "modulo_reducao_forca.h"
+#include "modulo_otimizador_lacos.h"
+#include "modulo_grafo_chamadas.h"
+#include "modulo_inliner.h"
+#include "modulo_constantes.h"
+#include "modulo_especializacao.h"
+#include "modulo_quadro.h"
+#include "modulo_tabela_strings.h"
+#include "modulo_runtime_es.h"
+#include "modulo_perfil.h"
+#include "modulo_avaliacao_parcial.h"
+#include "modulo_incremental.h"
+#include "modulo_pool_threads.h"
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 static FILE *arquivo_saida;
 
-static int contador_label_se = 0;
-static int contador_label_enquanto = 0;
-static int contador_label_string = 0;
+// As unidades (funções e programa) são geradas em paralelo (--threads): o
+// estado de uma unidade em geração é _Thread_local, e o do programa fica na
+// thread principal. Os dados compartilhados (AST, tabela de símbolos, grafo,
+// plano de especialização, perfil) só são lidos durante a geração.
 
-static int offset_pilha_local = 0;
+// O código é montado em memória e só é escrito no arquivo depois das otimizações.
+static _Thread_local ListaInstrucoes codigo_gerado;
 
-static NoAST *funcao_sendo_gerada = NULL;
+// Os labels internos são numerados por unidade (função ou programa) e
+// prefixados com o nome dela: "<prefixo>.se_fim_0" (ver nomear_label).
+#define TAM_LABEL 256
+
+static _Thread_local int contador_label_se = 0;
+static _Thread_local int contador_label_enquanto = 0;
+static _Thread_local int contador_label_logico = 0;
+static _Thread_local int contador_despacho = 0;
+
+static _Thread_local int offset_pilha_local = 0;
+
+// Variáveis globais: as primeiras ficam na área de dados pequenos (.extern),
+// a até 32 KiB de $gp para os dois lados, acessadas com uma única instrução;
+// as demais ficam em .data e são endereçadas com 'la'.
+#define TAMANHO_AREA_GP 65536
+#define DESLOCAMENTO_AREA_GP (-32768)
+
+// Bytes abaixo de $fp ocupados pelas locais do quadro atual (incluindo as
+// variáveis das chamadas expandidas em andamento) e o maior valor atingido.
+static _Thread_local int espaco_quadro_em_uso = 0;
+static _Thread_local int espaco_quadro_maximo = 0;
+
+static _Thread_local NoAST *funcao_sendo_gerada = NULL;
+
+static const OpcoesGeracao *opcoes_atuais = NULL;
+
+// Laços em geração (do mais externo ao mais interno) cujos valores estão em $sN.
+#define MAX_LACOS_ATIVOS 32
+static _Thread_local const AnaliseLaco *lacos_ativos[MAX_LACOS_ATIVOS];
+static _Thread_local int num_lacos_ativos = 0;
+
+// $sN ocupados pelos laços ativos e maior quantidade usada na função atual.
+static _Thread_local int registradores_laco_em_uso = 0;
+static _Thread_local int registradores_laco_usados = 0;
+
+static GrafoChamadas grafo_chamadas;
+// Literais, rotinas de E/S (com a saída bufferizada) e aplicações do peephole
+// do programa inteiro: a soma das unidades (ver anexar_unidade).
+static TabelaStrings tabela_strings;
+static RuntimeES runtime_es;
+static EstatisticasPeephole peephole_programa;
+static PlanoEspecializacao plano_especializacao;
+// Pontos de perfil do programa (--instrument) e contagens lidas (--profile-use).
+static PerfilPrograma perfil;
+static int perfil_carregado = 0;
+// Braços frios da função em geração, colocados depois do seu epílogo.
+static _Thread_local ListaInstrucoes codigo_frio;
+static _Thread_local int contador_label_frio = 0;
+
+/**
+ * @brief Código de uma função (original ou especializada) ou do programa
+ * principal. As funções são geradas sob demanda, a partir das chamadas do
+ * código já gerado (ver gerar_unidades_necessarias). Cada unidade tem os próprios labels, literais e rotinas de
+ * E/S e passa pelo peephole sozinha: o seu código não depende das outras
+ * unidades e pode ser guardado e reaproveitado (--incremental), ou gerado
+ * numa thread à parte (--threads).
+ */
+typedef struct UnidadeGerada {
+    int necessaria;
+    int gerada;
+    int propagada;                  // As unidades chamadas já foram marcadas como necessárias
+    int *chamadas;                  // Unidades chamadas (ver acrescentar_chamada)
+    int num_chamadas;
+    int capacidade_chamadas;
+    char prefixo[TAM_LABEL];        // "main" ou "func_<nome>"
+    ListaInstrucoes codigo;
+    TabelaStrings strings;          // Literais usados (labels "<prefixo>.str_<k>")
+    RuntimeES runtime;              // Rotinas de E/S chamadas
+    EstatisticasPeephole peephole;
+    char *relatorio;                // Mensagens da geração, impressas na ordem das unidades
+    size_t tamanho_relatorio;
+    const FragmentoIncremental *reaproveitado; // Código de uma compilação anterior (NULL = gerado agora)
+} UnidadeGerada;
+
+static UnidadeGerada *unidades_funcoes = NULL;          // Índices de grafo_chamadas.funcoes
+static UnidadeGerada *unidades_especializadas = NULL;   // Índices de plano_especializacao
+static UnidadeGerada unidade_principal;
+static _Thread_local UnidadeGerada *unidade_atual = NULL;
+// Mensagens da unidade em geração ('relatorio' dela), em vez da saída padrão.
+static _Thread_local FILE *relatorio_unidade = NULL;
+
+// Função em geração: nome usado nos labels e parâmetros constantes (NULL na original).
+static _Thread_local const char *nome_funcao_atual = NULL;
+static _Thread_local const ConstantesParametros *constantes_funcao_atual = NULL;
+
+/**
+ * @brief Chamada expandida (inline) em geração: os parâmetros e as locais da
+ * função chamada ganham posições próprias no quadro da função que chama.
+ */
+typedef struct ExpansaoInline {
+    int *posicoes_parametros;   // Posição (offset de $fp) de cada parâmetro
+    LayoutQuadro locais;        // Locais declaradas no corpo da função chamada
+    char label_fim[TAM_LABEL];  // Destino dos 'retorne' (valor em $v0)
+    ConstantesParametros constantes; // Parâmetros que receberam argumentos constantes
+} ExpansaoInline;
+
+static _Thread_local ExpansaoInline expansoes[MAX_PROFUNDIDADE_INLINE];
+static _Thread_local int num_expansoes = 0;
+static _Thread_local int contador_inline = 0;
+
+// Geração em fluxo (--stream): código das funções já geradas (num arquivo
+// temporário), diretivas das globais e contagens das globais e das funções.
+static FILE *funcoes_em_fluxo = NULL;
+static ListaInstrucoes globais_em_fluxo;
+static int num_globais_em_fluxo = 0;
+static int globais_na_area_gp_em_fluxo = 0;
+static int num_funcoes_em_fluxo = 0;
 
 static void percorrer_geracao(NoAST *no);
 
 static void gerar_programa(NoAST *no);
+static void gerar_principal(NoAST *no);
 static void gerar_bloco(NoAST *no);
 static void gerar_lista_declaracoes(NoAST *no);
 static void gerar_lista_comandos(NoAST *no);
-static void gerar_declaracao_funcao(NoAST *no);
+static void gerar_declaracao_funcao(NoAST *no, const Especializacao *especializacao);
 static void gerar_declaracao_variavel(NoAST *no);
 static void gerar_comando_atribuicao(NoAST *no);
 static void gerar_comando_se(NoAST *no);
-static void gerar_comando_enquanto(NoAST *no);
+static void gerar_comando_enquanto(NoAST *no, NoAST *comando_anterior);
+static void atualizar_valores_de_inducao(NoAST *atribuicao);
 static void gerar_comando_leia(NoAST *no);
 static void gerar_comando_escreva(NoAST *no);
 static void gerar_comando_retorne(NoAST *no);
 static void gerar_chamada_funcao(NoAST *no);
+static void gerar_chamada_expandida(NoAST *no, NoAST *funcao);
 static void gerar_novalinha();
 
 static void gerar_expressao(NoAST *no);
 static void gerar_op_binaria(NoAST *no, const char *mnemonico_mips);
 static void gerar_op_logica(NoAST *no, const char *mnemonico_mips);
+static void gerar_op_multiplicativa(NoAST *no);
+static void gerar_desvio_condicional(NoAST *condicao, int desviar_se_verdadeira, const char *label);
+static void gerar_op_curto_circuito(NoAST *no);
+static int gerar_despacho_cadeia_se(NoAST *no);
 static void gerar_id(NoAST *no);
 
 static void gerar_endereco_variavel(NoAST *no_id);
 
 static void emitir(const char *codigo_mips);
 static void emitir_comentario(const char *comentario);
+static void gerar_contador_perfil(const NoAST *no, int deslocamento);
 
 /**
- * @brief Função principal (pública) que inicia a geração de código.
+ * @brief Preenche as opções com os valores padrão.
  */
-void gerar_codigo(NoAST *raiz, const char *nome_arquivo_saida) {
+void iniciar_opcoes_geracao(OpcoesGeracao *opcoes) {
+    opcoes->otimizar_peephole = 1;
+    opcoes->otimizar_despacho = 1;
+    opcoes->reduzir_forca = 1;
+    opcoes->mover_invariantes = 1;
+    opcoes->rotacionar_lacos = 1;
+    opcoes->reduzir_inducao = 1;
+    opcoes->desenrolar_lacos = 1;
+    opcoes->expandir_chamadas = 1;
+    opcoes->orcamento_inline = ORCAMENTO_INLINE_PADRAO;
+    opcoes->especializar_funcoes = 1;
+    opcoes->crescimento_especializacao = CRESCIMENTO_ESPECIALIZACAO_PADRAO;
+    opcoes->apenas_alcancaveis = 0;
+    opcoes->saida_bufferizada = 1;
+    opcoes->instrumentar = 0;
+    opcoes->arquivo_perfil = NULL;
+    opcoes->avaliar_em_compilacao = 1;
+    opcoes->passos_avaliacao = PASSOS_AVALIACAO_PADRAO;
+    opcoes->memoria_avaliacao = MEMORIA_AVALIACAO_PADRAO;
+    opcoes->incremental = NULL;
+    opcoes->num_threads = processadores_disponiveis();
+}
+
+/**
+ * @brief Zera o estado da geração e abre o arquivo de saída.
+ */
+static void iniciar_geracao(const OpcoesGeracao *opcoes) {
+    contador_label_se = 0;
+    contador_label_enquanto = 0;
+    iniciar_tabela_strings(&tabela_strings);
+    iniciar_runtime_es(&runtime_es);
+    contador_label_logico = 0;
+    contador_despacho = 0;
+    opcoes_atuais = opcoes;
+    funcao_sendo_gerada = NULL;
+    offset_pilha_local = 0;
+    num_lacos_ativos = 0;
+    registradores_laco_em_uso = 0;
+    registradores_laco_usados = 0;
+    espaco_quadro_em_uso = 0;
+    espaco_quadro_maximo = 0;
+    num_expansoes = 0;
+    contador_inline = 0;
+    contador_label_frio = 0;
+    memset(&peephole_programa, 0, sizeof(peephole_programa));
+    iniciar_lista_instrucoes(&codigo_gerado);
+}
+
+static void abrir_arquivo_saida(const char *nome_arquivo_saida) {
     arquivo_saida = fopen(nome_arquivo_saida, "w");
     if (arquivo_saida == NULL) {
         perror("Erro ao abrir arquivo de saida MIPS");
         exit(EXIT_FAILURE);
     }
+}
 
-    contador_label_se = 0;
-    contador_label_enquanto = 0;
-    contador_label_string = 0;
-    funcao_sendo_gerada = NULL;
-    offset_pilha_local = 0;
+/**
+ * @brief Termina o programa (runtimes de E/S e de perfil) e o escreve.
+ */
+static void concluir_geracao() {
+    liberar_tabela_strings(&tabela_strings);
+    liberar_grafo_chamadas(&grafo_chamadas);
 
-    percorrer_geracao(raiz);
+    // O peephole já passou por cada unidade; o runtime é escrito à mão e fica fora dele.
+    if (opcoes_atuais->otimizar_peephole) {
+        imprimir_estatisticas_peephole(stdout, &peephole_programa);
+    }
+    emitir_runtime_es(&runtime_es, &codigo_gerado);
+    if (opcoes_atuais->instrumentar) {
+        emitir_runtime_perfil(&perfil, &codigo_gerado);
+    }
+    liberar_perfil(&perfil);
+
+    imprimir_lista_instrucoes(arquivo_saida, &codigo_gerado);
+    liberar_lista_instrucoes(&codigo_gerado);
 
     fclose(arquivo_saida);
 }
 
+/**
+ * @brief Função principal (pública) que inicia a geração de código.
+ */
+void gerar_codigo(NoAST *raiz, const char *nome_arquivo_saida, const OpcoesGeracao *opcoes) {
+    OpcoesGeracao opcoes_padrao;
+    if (opcoes == NULL) {
+        iniciar_opcoes_geracao(&opcoes_padrao);
+        opcoes = &opcoes_padrao;
+    }
+
+    abrir_arquivo_saida(nome_arquivo_saida);
+    iniciar_geracao(opcoes);
+    construir_grafo_chamadas(raiz, &grafo_chamadas);
+    perfil_carregado = 0;
+    if (opcoes->instrumentar || opcoes->arquivo_perfil != NULL) {
+        numerar_pontos_perfil(raiz, &grafo_chamadas, &perfil);
+        if (opcoes->arquivo_perfil != NULL) {
+            carregar_perfil(opcoes->arquivo_perfil, &perfil);
+            relatar_perfil(stdout, &perfil, &grafo_chamadas);
+            perfil_carregado = 1;
+        }
+    }
+    plano_especializacao.num_especializacoes = 0;
+    plano_especializacao.especializacoes = NULL;
+    if (opcoes->especializar_funcoes && raiz != NULL && raiz->tipo_no == NO_PROGRAMA) {
+        planejar_especializacoes(raiz, &grafo_chamadas, opcoes->crescimento_especializacao, &plano_especializacao);
+    }
+
+    percorrer_geracao(raiz);
+    liberar_plano_especializacao(&plano_especializacao);
+    concluir_geracao();
+}
+
 /**
  * @brief Função "dispatcher" que chama o gerador correto para cada nó.
  */
@@ -72,11 +299,11 @@ static void percorrer_geracao(NoAST *no) {
         case NO_BLOCO:              gerar_bloco(no); break;
         case NO_LISTA_DECLARACOES:  gerar_lista_declaracoes(no); break;
         case NO_LISTA_COMANDOS:     gerar_lista_comandos(no); break;
-        case NO_DECL_FUNCAO:        gerar_declaracao_funcao(no); break;
+        case NO_DECL_FUNCAO:        gerar_declaracao_funcao(no, NULL); break;
         case NO_DECL_VARIAVEL:      gerar_declaracao_variavel(no); break;
         case NO_COMANDO_ATRIBUICAO: gerar_comando_atribuicao(no); break;
         case NO_COMANDO_SE:         gerar_comando_se(no); break;
-        case NO_COMANDO_ENQUANTO:   gerar_comando_enquanto(no); break;
+        case NO_COMANDO_ENQUANTO:   gerar_comando_enquanto(no, NULL); break;
         case NO_COMANDO_LEIA:       gerar_comando_leia(no); break;
         case NO_COMANDO_ESCREVA:    gerar_comando_escreva(no); break;
         case NO_COMANDO_RETORNE:    gerar_comando_retorne(no); break;
@@ -120,72 +347,663 @@ static void percorrer_geracao(NoAST *no) {
 
 
 static void emitir(const char *codigo_mips) {
-    fprintf(arquivo_saida, "\t%s\n", codigo_mips);
+    adicionar_instrucao(&codigo_gerado, codigo_mips);
 }
 
 static void emitir_com_valor(const char *codigo_mips, int valor) {
-    fprintf(arquivo_saida, "\t%s %d\n", codigo_mips, valor);
+    char instrucao[128];
+    snprintf(instrucao, sizeof(instrucao), "%s %d", codigo_mips, valor);
+    emitir(instrucao);
 }
 
 static void emitir_com_label(const char *codigo_mips, const char *label) {
-    fprintf(arquivo_saida, "\t%s %s\n", codigo_mips, label);
+    char instrucao[256];
+    snprintf(instrucao, sizeof(instrucao), "%s %s", codigo_mips, label);
+    emitir(instrucao);
 }
 
 static void emitir_label(const char *label) {
-    fprintf(arquivo_saida, "%s:\n", label);
+    adicionar_label(&codigo_gerado, label);
 }
 
 static void emitir_comentario(const char *comentario) {
-    fprintf(arquivo_saida, "\n\t# %s\n", comentario);
+    adicionar_comentario(&codigo_gerado, comentario);
 }
 
 /**
- * @brief Configura o MIPS com as seções .data e .text.
+ * @brief Monta um label interno da unidade em geração: "<prefixo>.<formato>".
+ * Um '.' não aparece em identificadores, então os labels de unidades
+ * diferentes nunca colidem, por mais que a numeração se repita.
  */
-static void gerar_programa(NoAST *no) {
-    emitir(".data");
-    emitir_label("newline");
-    emitir(".asciiz \"\\n\"");
-    emitir("\n.text");
-    emitir(".globl main");
-    
-    emitir_comentario("--- Declaracoes de Funcoes ---");
-    percorrer_geracao(no->filho1);
+static void nomear_label(char *destino, const char *formato, ...) {
+    int usado = snprintf(destino, TAM_LABEL, "%s.", unidade_atual->prefixo);
+    if (usado >= TAM_LABEL) usado = TAM_LABEL - 1;
+    va_list argumentos;
+    va_start(argumentos, formato);
+    vsnprintf(destino + usado, TAM_LABEL - usado, formato, argumentos);
+    va_end(argumentos);
+}
+
+/**
+ * @brief Prefixo dos labels da unidade: "main" para o programa principal
+ * (nome NULL) e o label da função ("func_<nome>") para as demais.
+ */
+static void nomear_unidade(UnidadeGerada *unidade, const char *nome) {
+    if (nome == NULL) {
+        snprintf(unidade->prefixo, sizeof(unidade->prefixo), "main");
+    } else {
+        snprintf(unidade->prefixo, sizeof(unidade->prefixo), "func_%s", nome);
+    }
+}
+
+/**
+ * @brief Começa a gerar uma unidade: os labels voltam a ser numerados do zero.
+ */
+static void iniciar_unidade(UnidadeGerada *unidade) {
+    unidade_atual = unidade;
+    relatorio_unidade = open_memstream(&unidade->relatorio, &unidade->tamanho_relatorio);
+    if (relatorio_unidade == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para as mensagens da geracao.\n");
+        exit(EXIT_FAILURE);
+    }
+    iniciar_tabela_strings(&unidade->strings);
+    iniciar_runtime_es(&unidade->runtime);
+    memset(&unidade->peephole, 0, sizeof(unidade->peephole));
+    contador_label_se = 0;
+    contador_label_enquanto = 0;
+    contador_label_logico = 0;
+    contador_despacho = 0;
+    contador_inline = 0;
+    contador_label_frio = 0;
+}
+
+/**
+ * @brief Termina uma unidade (já em 'unidade->codigo'): aplica o peephole e,
+ * com --incremental, guarda o código para as próximas compilações.
+ * @param indice Índice da função, ou UNIDADE_PRINCIPAL.
+ */
+static void concluir_unidade(UnidadeGerada *unidade, int indice, int guardar) {
+    if (opcoes_atuais->otimizar_peephole) {
+        otimizar_peephole(&unidade->codigo, &unidade->peephole);
+    }
+    if (guardar && opcoes_atuais->incremental != NULL) {
+        guardar_fragmento(opcoes_atuais->incremental, indice, &unidade->codigo, &unidade->strings,
+                          &unidade->runtime, &unidade->peephole);
+    }
+    fclose(relatorio_unidade);
+    relatorio_unidade = NULL;
+    unidade->gerada = 1;
+    unidade_atual = NULL;
+}
+
+/**
+ * @brief Imprime (e libera) as mensagens de uma unidade gerada. Chamada na
+ * thread principal, na mesma ordem qualquer que seja o número de threads.
+ */
+static void publicar_relatorio(UnidadeGerada *unidade) {
+    if (unidade->relatorio == NULL) return;
+    fwrite(unidade->relatorio, 1, unidade->tamanho_relatorio, stdout);
+    free(unidade->relatorio);
+    unidade->relatorio = NULL;
+}
+
+/**
+ * @brief Registra que 'unidade' chama a função de índice 'chamada' em
+ * grafo_chamadas, ou a especialização de índice 'chamada - num_funcoes'.
+ * Só a thread que gera a unidade escreve na lista; as unidades chamadas
+ * passam a ser necessárias em propagar_necessidade, se esta também for.
+ */
+static void acrescentar_chamada(UnidadeGerada *unidade, int chamada) {
+    if (unidade->num_chamadas == unidade->capacidade_chamadas) {
+        unidade->capacidade_chamadas = unidade->capacidade_chamadas == 0 ? 4 : 2 * unidade->capacidade_chamadas;
+        int *chamadas = realloc(unidade->chamadas, (size_t)unidade->capacidade_chamadas * sizeof(int));
+        if (chamadas == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para as chamadas geradas.\n");
+            exit(EXIT_FAILURE);
+        }
+        unidade->chamadas = chamadas;
+    }
+    unidade->chamadas[unidade->num_chamadas++] = chamada;
+}
+
+/**
+ * @brief Com --incremental, usa o código guardado da unidade quando nada de
+ * que ele depende mudou; as chamadas guardadas dela são registradas.
+ * @return 1 se a unidade foi reaproveitada.
+ */
+static int reaproveitar_unidade(UnidadeGerada *unidade, int indice) {
+    if (opcoes_atuais->incremental == NULL) return 0;
+    const FragmentoIncremental *fragmento = fragmento_reaproveitavel(opcoes_atuais->incremental, indice);
+    if (fragmento == NULL) return 0;
+    const int *chamadas;
+    int num_chamadas = chamadas_da_unidade(opcoes_atuais->incremental, indice, &chamadas);
+    for (int i = 0; i < num_chamadas; i++) acrescentar_chamada(unidade, chamadas[i]);
+    unidade->reaproveitado = fragmento;
+    unidade->gerada = 1;
+    return 1;
+}
+
+/**
+ * @brief Acrescenta o código de uma unidade gerada (ou reaproveitada) ao
+ * programa e soma os seus literais, rotinas de E/S e aplicações do peephole
+ * aos do programa.
+ */
+static void anexar_unidade(UnidadeGerada *unidade) {
+    const TabelaStrings *strings = &unidade->strings;
+    const RuntimeES *runtime = &unidade->runtime;
+    const EstatisticasPeephole *peephole = &unidade->peephole;
+    if (unidade->reaproveitado != NULL) {
+        adicionar_texto(&codigo_gerado, unidade->reaproveitado->texto);
+        strings = &unidade->reaproveitado->strings;
+        runtime = &unidade->reaproveitado->runtime;
+        peephole = &unidade->reaproveitado->peephole;
+    } else {
+        anexar_lista_instrucoes(&codigo_gerado, &unidade->codigo);
+    }
+
+    juntar_tabela_strings(&tabela_strings, strings, unidade->prefixo);
+    for (int i = 0; i < NUM_ROTINAS_ES; i++) runtime_es.chamadas[i] += runtime->chamadas[i];
+    for (int i = 0; i < NUM_REGRAS_PEEPHOLE; i++) peephole_programa.aplicacoes[i] += peephole->aplicacoes[i];
+    if (peephole->passadas > peephole_programa.passadas) peephole_programa.passadas = peephole->passadas;
+    peephole_programa.instrucoes_antes += peephole->instrucoes_antes;
+    peephole_programa.instrucoes_depois += peephole->instrucoes_depois;
+    if (unidade->reaproveitado == NULL) liberar_tabela_strings(&unidade->strings);
+}
+
+/**
+ * @brief Com --instrument, soma 1 a um contador do perfil: o primeiro do nó
+ * mais 'deslocamento'. Usa $t8 e $t9, que o código gerado não mantém
+ * entre comandos nem antes de uma chamada.
+ */
+static void gerar_contador_perfil(const NoAST *no, int deslocamento) {
+    if (!opcoes_atuais->instrumentar) return;
+    int contador = contador_perfil(&perfil, no);
+    if (contador < 0) return;
+    int offset = 4 * (contador + deslocamento);
+    char instrucao[64];
+    emitir("la $t8, perfil_contadores");
+    if (offset > 32767) {
+        emitir_com_valor("li $t9,", offset);
+        emitir("addu $t8, $t8, $t9");
+        offset = 0;
+    }
+    snprintf(instrucao, sizeof(instrucao), "lw $t9, %d($t8)", offset);
+    emitir(instrucao);
+    emitir("addiu $t9, $t9, 1");
+    snprintf(instrucao, sizeof(instrucao), "sw $t9, %d($t8)", offset);
+    emitir(instrucao);
+}
+
+/**
+ * @brief Gera o corpo de uma função (ou do programa principal) numa lista à parte.
+ * Só depois do corpo se sabe quantos bytes as chamadas expandidas ocuparam no
+ * quadro e quantos $sN os laços usaram, o que o prólogo precisa reservar.
+ * O tamanho final das locais fica em 'espaco_quadro_maximo'.
+ */
+static void gerar_corpo_separado(NoAST *corpo, int espaco_locais, ListaInstrucoes *destino) {
+    ListaInstrucoes codigo_externo = codigo_gerado;
+    iniciar_lista_instrucoes(&codigo_gerado);
+    espaco_quadro_em_uso = espaco_locais;
+    espaco_quadro_maximo = espaco_locais;
+
+    if (corpo != NULL && corpo->tipo_no == NO_BLOCO) {
+        emitir_comentario("Corpo da Funcao");
+        percorrer_geracao(corpo);
+    } else {
+        gerar_lista_comandos(corpo);
+    }
+
+    *destino = codigo_gerado;
+    codigo_gerado = codigo_externo;
+}
+
+/**
+ * @brief Parâmetros de valor constante no escopo atual: os da chamada
+ * expandida mais interna ou, fora delas, os da versão especializada em geração.
+ */
+static const ConstantesParametros *constantes_do_escopo() {
+    if (num_expansoes > 0) return &expansoes[num_expansoes - 1].constantes;
+    return constantes_funcao_atual;
+}
+
+/**
+ * @brief Reserva uma palavra no quadro atual, abaixo das locais em uso.
+ * @return O offset da palavra em relação a $fp.
+ */
+static int reservar_posicao_quadro() {
+    espaco_quadro_em_uso += 4;
+    if (espaco_quadro_em_uso > espaco_quadro_maximo) espaco_quadro_maximo = espaco_quadro_em_uso;
+    return -espaco_quadro_em_uso;
+}
+
+/**
+ * @brief Gera uma função (original ou especializada) numa lista própria.
+ * @param indice Índice da função em grafo_chamadas.
+ */
+static void gerar_unidade(NoAST *declaracao, const Especializacao *especializacao, UnidadeGerada *unidade,
+                          int indice) {
+    nomear_unidade(unidade, especializacao != NULL ? especializacao->nome : declaracao->filho1->lexema);
+    if (especializacao == NULL && reaproveitar_unidade(unidade, indice)) return;
+
+    ListaInstrucoes codigo_externo = codigo_gerado;
+    iniciar_lista_instrucoes(&codigo_gerado);
+    iniciar_unidade(unidade);
+    gerar_declaracao_funcao(declaracao, especializacao);
+    unidade->codigo = codigo_gerado;
+    codigo_gerado = codigo_externo;
+    concluir_unidade(unidade, indice, especializacao == NULL);
+}
+
+/**
+ * @brief Uma unidade a gerar numa rodada de gerar_unidades_necessarias.
+ */
+typedef struct TarefaUnidade {
+    NoAST *declaracao;                      // A função, ou o programa (UNIDADE_PRINCIPAL)
+    const Especializacao *especializacao;
+    UnidadeGerada *unidade;
+    int indice;                             // Índice da função, ou UNIDADE_PRINCIPAL
+} TarefaUnidade;
+
+static void executar_tarefa_unidade(void *contexto, int indice) {
+    TarefaUnidade *tarefa = (TarefaUnidade *)contexto + indice;
+    if (tarefa->indice == UNIDADE_PRINCIPAL) {
+        gerar_principal(tarefa->declaracao);
+    } else {
+        gerar_unidade(tarefa->declaracao, tarefa->especializacao, tarefa->unidade, tarefa->indice);
+    }
+}
+
+/**
+ * @brief Acrescenta a 'tarefas' as funções e as especializações necessárias
+ * ainda não geradas, nessa ordem. Com 'antecipar', entram todas as
+ * especializações ainda não geradas, necessárias ou não.
+ * @return O novo número de tarefas.
+ */
+static int listar_unidades_pendentes(TarefaUnidade *tarefas, int num_tarefas, int antecipar) {
+    for (int i = 0; i < grafo_chamadas.num_funcoes; i++) {
+        if (unidades_funcoes[i].necessaria && !unidades_funcoes[i].gerada) {
+            tarefas[num_tarefas++] = (TarefaUnidade){ grafo_chamadas.funcoes[i].declaracao, NULL,
+                                                      &unidades_funcoes[i], i };
+        }
+    }
+    for (int i = 0; i < plano_especializacao.num_especializacoes; i++) {
+        const Especializacao *especializacao = &plano_especializacao.especializacoes[i];
+        if ((antecipar || unidades_especializadas[i].necessaria) && !unidades_especializadas[i].gerada) {
+            tarefas[num_tarefas++] = (TarefaUnidade){ especializacao->funcao->declaracao, especializacao,
+                                                      &unidades_especializadas[i],
+                                                      (int)(especializacao->funcao - grafo_chamadas.funcoes) };
+        }
+    }
+    return num_tarefas;
+}
+
+static UnidadeGerada *unidade_chamada(int chamada) {
+    if (chamada < grafo_chamadas.num_funcoes) return &unidades_funcoes[chamada];
+    return &unidades_especializadas[chamada - grafo_chamadas.num_funcoes];
+}
+
+/**
+ * @brief Marca como necessárias as unidades chamadas pelas unidades
+ * necessárias já geradas, até que nenhuma nova seja marcada.
+ */
+static void propagar_necessidade() {
+    int num_unidades = grafo_chamadas.num_funcoes + plano_especializacao.num_especializacoes;
+    int progresso = 1;
+    while (progresso) {
+        progresso = 0;
+        for (int u = -1; u < num_unidades; u++) {
+            UnidadeGerada *unidade = u < 0 ? &unidade_principal : unidade_chamada(u);
+            if (!unidade->necessaria || !unidade->gerada || unidade->propagada) continue;
+            for (int i = 0; i < unidade->num_chamadas; i++) unidade_chamada(unidade->chamadas[i])->necessaria = 1;
+            unidade->propagada = 1;
+            progresso = 1;
+        }
+    }
+}
+
+/**
+ * @brief Imprime as mensagens de uma unidade necessária; o código e as
+ * mensagens de uma especialização gerada sem ser usada são descartados.
+ */
+static void encerrar_unidade(UnidadeGerada *unidade) {
+    if (unidade->gerada && !unidade->necessaria) {
+        liberar_lista_instrucoes(&unidade->codigo);
+        liberar_tabela_strings(&unidade->strings);
+        free(unidade->relatorio);
+        unidade->relatorio = NULL;
+        unidade->gerada = 0;
+    }
+    publicar_relatorio(unidade);
+    free(unidade->chamadas);
+    unidade->chamadas = NULL;
+}
+
+/**
+ * @brief Gera o programa principal e as funções necessárias até que nenhuma
+ * nova seja chamada.
+ *
+ * Gerar uma unidade pode tornar necessárias as que ela chama, e por isso a
+ * geração é feita em rodadas: cada rodada gera em paralelo, no 'pool', as
+ * unidades pendentes, e depois a thread principal propaga a necessidade
+ * pelas chamadas registradas. As especializações entram todas na primeira
+ * rodada: descobertas uma a uma, uma cadeia delas (f especializada chamando
+ * g especializada...) viraria uma rodada por especialização. As mensagens
+ * são impressas no fim, na ordem das unidades (programa, funções,
+ * especializações), que não depende de quantas threads há.
+ */
+static void gerar_unidades_necessarias(NoAST *programa, PoolThreads *pool) {
+    int num_funcoes = grafo_chamadas.num_funcoes;
+    int num_especializacoes = plano_especializacao.num_especializacoes;
+    TarefaUnidade *tarefas = malloc((size_t)(1 + num_funcoes + num_especializacoes) * sizeof(TarefaUnidade));
+    if (tarefas == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para as funcoes geradas.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    unidade_principal.necessaria = 1;
+    tarefas[0] = (TarefaUnidade){ programa, NULL, &unidade_principal, UNIDADE_PRINCIPAL };
+    int num_tarefas = listar_unidades_pendentes(tarefas, 1, 1);
+    while (num_tarefas > 0) {
+        executar_tarefas(pool, num_tarefas, executar_tarefa_unidade, tarefas);
+        propagar_necessidade();
+        num_tarefas = listar_unidades_pendentes(tarefas, 0, 0);
+    }
+    free(tarefas);
+
+    encerrar_unidade(&unidade_principal);
+    for (int i = 0; i < num_funcoes; i++) encerrar_unidade(&unidades_funcoes[i]);
+    for (int i = 0; i < num_especializacoes; i++) encerrar_unidade(&unidades_especializadas[i]);
+}
+
+/**
+ * @brief Calcula o layout do quadro de uma função (ou do programa) e grava
+ * a posição de cada local na sua entrada da tabela de símbolos.
+ */
+static void aplicar_layout(const NoAST *declaracoes, const NoAST *comandos) {
+    LayoutQuadro layout;
+    calcular_layout_quadro(declaracoes, comandos, 0, &layout);
+    aplicar_layout_quadro(&layout);
+    liberar_layout_quadro(&layout);
+}
+
+/**
+ * @brief Informa o tamanho do quadro de uma função (ou do main).
+ * @param total Bytes do quadro, incluindo $ra/$fp, os $sN salvos e as
+ * posições das chamadas expandidas.
+ */
+static void relatar_quadro(const char *nome, int total, const LayoutQuadro *layout) {
+    fprintf(relatorio_unidade, "Quadro: '%s' com %d bytes (locais em %d bytes; seriam %d sem reuso nem bytes para 'car').\n",
+           nome, total, layout->tamanho, layout->tamanho_sem_reuso);
+}
+
+/**
+ * @brief Gera o programa principal (main).
+ */
+static void gerar_principal(NoAST *no) {
+    nomear_unidade(&unidade_principal, NULL);
+    if (reaproveitar_unidade(&unidade_principal, UNIDADE_PRINCIPAL)) return;
+    ListaInstrucoes codigo_externo = codigo_gerado;
+    iniciar_lista_instrucoes(&codigo_gerado);
+    iniciar_unidade(&unidade_principal);
 
     emitir_comentario("--- Programa Principal (main) ---");
     emitir_label("main");
     offset_pilha_local = 0;
-    NoAST* decls_main = no->filho1;
+    iniciar_lista_instrucoes(&codigo_frio);
+    nome_funcao_atual = NULL;
+    constantes_funcao_atual = NULL;
+    NoAST* decls_main = no->filho3;
     NoAST* cmds_main = no->filho2;
     
-    int espaco_locais_main = 0;
-    NoAST* temp_decl = decls_main;
-    while(temp_decl != NULL) {
-        if(temp_decl->tipo_no == NO_DECL_VARIAVEL) {
-            espaco_locais_main += 4; 
-            temp_decl->filho1->entrada_tabela->posicao = -espaco_locais_main;
-        }
-        temp_decl = temp_decl->proximo;
-    }
+    LayoutQuadro layout;
+    calcular_layout_quadro(decls_main, cmds_main, 0, &layout);
+    int espaco_locais_main = layout.tamanho;
 
+    // $fp fica acima das locais, como nas funções: as locais ficam dentro do
+    // espaço reservado e não são sobrescritas pelos empilhamentos.
+    emitir("move $fp, $sp"); 
+
+    ListaInstrucoes corpo;
+    gerar_corpo_separado(cmds_main, espaco_locais_main, &corpo);
+    espaco_locais_main = espaco_quadro_maximo;
     if (espaco_locais_main > 0) {
         emitir_com_valor("addiu $sp, $sp,", -espaco_locais_main);
     }
-    emitir("move $fp, $sp"); 
-
-    gerar_lista_comandos(cmds_main); 
+    relatar_quadro("main", espaco_locais_main, &layout);
+    liberar_layout_quadro(&layout);
+    anexar_lista_instrucoes(&codigo_gerado, &corpo);
+    registradores_laco_usados = 0;
 
     emitir_comentario("--- Fim do Programa (exit) ---");
     if (espaco_locais_main > 0) {
         emitir_com_valor("addiu $sp, $sp,", espaco_locais_main); 
     }
+    if (opcoes_atuais->saida_bufferizada) {
+        emitir_com_label("jal", usar_rotina_es(&unidade_atual->runtime, ROTINA_DESCARREGAR));
+    }
+    if (opcoes_atuais->instrumentar) {
+        emitir_com_label("jal", "perfil_gravar");
+    }
     emitir("li $v0, 10");
     emitir("syscall");
+    anexar_lista_instrucoes(&codigo_gerado, &codigo_frio);
+
+    unidade_principal.codigo = codigo_gerado;
+    codigo_gerado = codigo_externo;
+    concluir_unidade(&unidade_principal, UNIDADE_PRINCIPAL, 1);
+}
+
+/**
+ * @brief Reserva uma variável global: uma palavra, na área de $gp enquanto
+ * couber e depois em .data. 'num_globais' e 'na_area_gp' contam as já reservadas.
+ */
+static void alocar_global(NoAST *decl, int *num_globais, int *na_area_gp) {
+    char diretiva[256];
+    EntradaTabela *entrada = decl->filho1->entrada_tabela;
+    entrada->endereco_global = 4 * (*num_globais)++;
+    if (entrada->endereco_global < TAMANHO_AREA_GP) {
+        snprintf(diretiva, sizeof(diretiva), ".extern glob_%s, 4", entrada->lexema);
+        adicionar_diretiva(&codigo_gerado, diretiva);
+        (*na_area_gp)++;
+    } else {
+        snprintf(diretiva, sizeof(diretiva), "glob_%s", entrada->lexema);
+        emitir(".align 2");
+        emitir_label(diretiva);
+        adicionar_diretiva(&codigo_gerado, ".word 0");
+    }
+}
+
+static void relatar_globais(int num_globais, int na_area_gp) {
+    if (num_globais > 0) {
+        printf("Globais: %d variavel(is) na area de $gp (%d bytes), %d em .data.\n",
+               na_area_gp, 4 * na_area_gp, num_globais - na_area_gp);
+    }
+}
+
+/**
+ * @brief Reserva as variáveis globais (declarações em 'declaracoes').
+ */
+static void alocar_globais(NoAST *declaracoes) {
+    int num_globais = 0, na_area_gp = 0;
+    for (NoAST *decl = declaracoes; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_VARIAVEL) alocar_global(decl, &num_globais, &na_area_gp);
+    }
+    relatar_globais(num_globais, na_area_gp);
+}
+
+/**
+ * @brief Início das seções do programa: .data (antes das globais) e .text.
+ */
+static void iniciar_secao_dados() {
+    emitir(".data");
+    emitir_label("newline");
+    emitir(".asciiz \"\\n\"");
+}
+
+static void iniciar_secao_texto() {
+    emitir("\n.text");
+    emitir(".globl main");
+}
+
+/**
+ * @brief Configura o MIPS com as seções .data e .text.
+ *
+ * O programa principal e as funções são gerados em paralelo, e as funções
+ * sob demanda, a partir das chamadas. Uma função com versões especializadas só é gerada se alguma
+ * chamada ainda usa a versão original; as demais funções são sempre geradas,
+ * exceto com 'apenas_alcancaveis', em que só são geradas as funções chamadas
+ * pelo código gerado.
+ */
+static void gerar_programa(NoAST *no) {
+    iniciar_secao_dados();
+    alocar_globais(no->filho1);
+    iniciar_secao_texto();
+
+    int num_funcoes = grafo_chamadas.num_funcoes;
+    int num_especializacoes = plano_especializacao.num_especializacoes;
+    unidades_funcoes = calloc(num_funcoes > 0 ? num_funcoes : 1, sizeof(UnidadeGerada));
+    unidades_especializadas = calloc(num_especializacoes > 0 ? num_especializacoes : 1, sizeof(UnidadeGerada));
+    if (unidades_funcoes == NULL || unidades_especializadas == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para as funcoes geradas.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < num_funcoes; i++) unidades_funcoes[i].necessaria = !opcoes_atuais->apenas_alcancaveis;
+    for (int i = 0; i < num_especializacoes; i++) {
+        unidades_funcoes[plano_especializacao.especializacoes[i].funcao - grafo_chamadas.funcoes].necessaria = 0;
+    }
+
+    // As posições das locais ficam nas entradas da tabela de símbolos, que
+    // as unidades (e as chamadas expandidas em outras unidades) só leem.
+    aplicar_layout(no->filho3, no->filho2);
+    for (int i = 0; i < num_funcoes; i++) {
+        NoAST *declaracao = grafo_chamadas.funcoes[i].declaracao;
+        aplicar_layout(declaracao->filho3->filho1, declaracao->filho3->filho2);
+    }
+
+    memset(&unidade_principal, 0, sizeof(unidade_principal));
+    PoolThreads *pool = criar_pool_threads(opcoes_atuais->num_threads);
+    gerar_unidades_necessarias(no, pool);
+    destruir_pool_threads(pool);
+
+    emitir_comentario("--- Declaracoes de Funcoes ---");
+    int funcoes_geradas = 0;
+    for (int i = 0; i < num_funcoes; i++) {
+        FuncaoGrafo *funcao = &grafo_chamadas.funcoes[i];
+        if (unidades_funcoes[i].gerada) {
+            anexar_unidade(&unidades_funcoes[i]);
+            funcoes_geradas++;
+        } else if (!opcoes_atuais->apenas_alcancaveis) {
+            printf("Especializacao: versao original de '%s' removida (nenhuma chamada restante a usa).\n",
+                   funcao->entrada->lexema);
+        }
+        for (int j = 0; j < num_especializacoes; j++) {
+            if (plano_especializacao.especializacoes[j].funcao == funcao && unidades_especializadas[j].gerada) {
+                anexar_unidade(&unidades_especializadas[j]);
+            }
+        }
+    }
+    anexar_unidade(&unidade_principal);
+    emitir_tabela_strings(&tabela_strings, &codigo_gerado);
+    if (opcoes_atuais->apenas_alcancaveis) {
+        printf("Funcoes: %d de %d declarada(s) gerada(s); as demais nao sao chamadas pelo codigo gerado.\n",
+               funcoes_geradas, num_funcoes);
+    }
+
+    free(unidades_funcoes);
+    free(unidades_especializadas);
+    unidades_funcoes = NULL;
+    unidades_especializadas = NULL;
+}
+
+/**
+ * @brief Início da geração em fluxo: sem grafo de chamadas nem plano de
+ * especialização, que dependem do programa inteiro.
+ */
+void iniciar_geracao_em_fluxo(const OpcoesGeracao *opcoes) {
+    iniciar_geracao(opcoes);
+    construir_grafo_chamadas(NULL, &grafo_chamadas);
+    perfil_carregado = 0;
+    plano_especializacao.num_especializacoes = 0;
+    plano_especializacao.especializacoes = NULL;
+    iniciar_lista_instrucoes(&globais_em_fluxo);
+    num_globais_em_fluxo = 0;
+    globais_na_area_gp_em_fluxo = 0;
+    num_funcoes_em_fluxo = 0;
+    funcoes_em_fluxo = tmpfile();
+    if (funcoes_em_fluxo == NULL) {
+        perror("Erro ao criar o arquivo temporario da geracao em fluxo");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief As globais reservam o endereço na ordem de declaração, como em
+ * alocar_globais; cada função é gerada como em gerar_unidade e o seu código
+ * vai direto para o arquivo temporário.
+ */
+void gerar_declaracao_em_fluxo(NoAST *declaracao) {
+    for (NoAST *decl = declaracao; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_VARIAVEL) {
+            ListaInstrucoes codigo_externo = codigo_gerado;
+            codigo_gerado = globais_em_fluxo;
+            alocar_global(decl, &num_globais_em_fluxo, &globais_na_area_gp_em_fluxo);
+            globais_em_fluxo = codigo_gerado;
+            codigo_gerado = codigo_externo;
+        } else if (decl->tipo_no == NO_DECL_FUNCAO) {
+            UnidadeGerada unidade;
+            memset(&unidade, 0, sizeof(unidade));
+            aplicar_layout(decl->filho3->filho1, decl->filho3->filho2);
+            gerar_unidade(decl, NULL, &unidade, num_funcoes_em_fluxo++);
+            publicar_relatorio(&unidade);
+            anexar_unidade(&unidade);
+            imprimir_lista_instrucoes(funcoes_em_fluxo, &codigo_gerado);
+            liberar_lista_instrucoes(&codigo_gerado);
+        }
+    }
+}
+
+/**
+ * @brief Escreve .data e o início de .text, copia as funções já geradas e
+ * termina com 'programa', os literais e os runtimes, na ordem de gerar_programa.
+ */
+void concluir_geracao_em_fluxo(NoAST *programa, const char *nome_arquivo_saida) {
+    abrir_arquivo_saida(nome_arquivo_saida);
+    iniciar_secao_dados();
+    anexar_lista_instrucoes(&codigo_gerado, &globais_em_fluxo);
+    relatar_globais(num_globais_em_fluxo, globais_na_area_gp_em_fluxo);
+    iniciar_secao_texto();
+    emitir_comentario("--- Declaracoes de Funcoes ---");
+    imprimir_lista_instrucoes(arquivo_saida, &codigo_gerado);
+    liberar_lista_instrucoes(&codigo_gerado);
+
+    char bloco[65536];
+    size_t lidos;
+    rewind(funcoes_em_fluxo);
+    while ((lidos = fread(bloco, 1, sizeof(bloco), funcoes_em_fluxo)) > 0) fwrite(bloco, 1, lidos, arquivo_saida);
+    fclose(funcoes_em_fluxo);
+    funcoes_em_fluxo = NULL;
+
+    memset(&unidade_principal, 0, sizeof(unidade_principal));
+    aplicar_layout(programa->filho3, programa->filho2);
+    gerar_principal(programa);
+    publicar_relatorio(&unidade_principal);
+    anexar_unidade(&unidade_principal);
+    emitir_tabela_strings(&tabela_strings, &codigo_gerado);
+    concluir_geracao();
+}
+
+void descartar_geracao_em_fluxo() {
+    if (funcoes_em_fluxo != NULL) fclose(funcoes_em_fluxo);
+    funcoes_em_fluxo = NULL;
+    liberar_lista_instrucoes(&globais_em_fluxo);
+    liberar_lista_instrucoes(&codigo_gerado);
+    liberar_tabela_strings(&tabela_strings);
+    liberar_grafo_chamadas(&grafo_chamadas);
 }
 
 /**
  * @brief Gera código para um bloco (lista de comandos).
- * As declarações já foram tratadas pelo 'pai' (função ou programa).
+ * As posições das declarações já foram calculadas no layout do quadro.
  */
 static void gerar_bloco(NoAST *no) {
     gerar_lista_comandos(no->filho2);
@@ -202,27 +1020,115 @@ static void gerar_lista_declaracoes(NoAST *no) {
     }
 }
 
+/**
+ * @brief Texto que um 'escreva' ou 'novalinha' escreve, quando é conhecido
+ * em compilação. O texto fica com os escapes de um literal ("\n").
+ * @param destino Recebe o texto (NULL para só medir).
+ * @return O tamanho do texto, ou -1 se o comando não escreve um texto constante.
+ */
+static int texto_escrita_constante(const NoAST *no, char *destino) {
+    char texto[16];
+    const char *resultado = texto;
+    if (no->tipo_no == NO_COMANDO_NOVALINHA) {
+        resultado = "\\n";
+    } else if (no->tipo_no != NO_COMANDO_ESCREVA) {
+        return -1;
+    } else if (no->filho1->tipo_no == NO_LITERAL_STRING) {
+        resultado = no->filho1->lexema;
+    } else {
+        int valor;
+        if (!avaliar_constante(no->filho1, constantes_do_escopo(), &valor)) return -1;
+        if (no->filho1->tipo_dado_computado != TIPO_CAR) {
+            snprintf(texto, sizeof(texto), "%d", valor);
+        } else if (valor == '\n' || valor == '\t' || valor == '"' || valor == '\\') {
+            snprintf(texto, sizeof(texto), "\\%c", valor == '\n' ? 'n' : valor == '\t' ? 't' : valor);
+        } else if (valor >= 32 && valor < 127) {
+            snprintf(texto, sizeof(texto), "%c", valor);
+        } else {
+            return -1;
+        }
+    }
+    int tamanho = (int)strlen(resultado);
+    if (destino != NULL) memcpy(destino, resultado, tamanho);
+    return tamanho;
+}
+
+/**
+ * @brief Junta os 'escreva'/'novalinha' constantes consecutivos a partir de
+ * 'inicio' numa única string, escrita com uma chamada ao runtime.
+ * @return O último comando agrupado.
+ */
+static NoAST *gerar_escritas_agrupadas(NoAST *inicio) {
+    int tamanho = 0, num_comandos = 0;
+    NoAST *fim = inicio;
+    for (NoAST *no = inicio; no != NULL; no = no->proximo) {
+        int tamanho_no = texto_escrita_constante(no, NULL);
+        if (tamanho_no < 0) break;
+        tamanho += tamanho_no;
+        num_comandos++;
+        fim = no;
+    }
+
+    char *texto = malloc((size_t)tamanho + 1);
+    if (texto == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a string agrupada.\n");
+        exit(EXIT_FAILURE);
+    }
+    int usado = 0;
+    for (NoAST *no = inicio; ; no = no->proximo) {
+        usado += texto_escrita_constante(no, texto + usado);
+        if (no == fim) break;
+    }
+    texto[usado] = '\0';
+
+    char comentario[64], label_str[TAM_LABEL];
+    snprintf(comentario, sizeof(comentario), "%d ESCREVA/NOVALINHA constante(s) agrupado(s)", num_comandos);
+    emitir_comentario(comentario);
+    nomear_label(label_str, "str_%d", registrar_string(&unidade_atual->strings, texto));
+    emitir_com_label("la $a0,", label_str);
+    emitir_com_label("jal", usar_rotina_es(&unidade_atual->runtime, ROTINA_ESCREVA_STR));
+    free(texto);
+    return fim;
+}
+
 /**
  * @brief Percorre uma lista de comandos.
+ * O comando anterior é repassado aos laços (inicialização do contador). Com
+ * a saída bufferizada, escritas constantes consecutivas viram uma só string.
  */
 static void gerar_lista_comandos(NoAST *no) {
+    NoAST *anterior = NULL;
     NoAST *temp = no;
     while (temp != NULL) {
-        percorrer_geracao(temp);
+        if (opcoes_atuais->saida_bufferizada && texto_escrita_constante(temp, NULL) >= 0) {
+            temp = gerar_escritas_agrupadas(temp);
+        } else if (temp->tipo_no == NO_COMANDO_ENQUANTO) {
+            gerar_comando_enquanto(temp, anterior);
+        } else {
+            percorrer_geracao(temp);
+        }
+        anterior = temp;
         temp = temp->proximo;
     }
 }
 
 /**
  * @brief Gera o prólogo, corpo e epílogo de uma função.
+ * @param especializacao Versão especializada a gerar (NULL para a original):
+ * os parâmetros constantes não são passados na pilha e viram constantes.
  */
-static void gerar_declaracao_funcao(NoAST *no) {
-    char label_funcao[100];
-    sprintf(label_funcao, "func_%s", no->filho1->lexema);
+static void gerar_declaracao_funcao(NoAST *no, const Especializacao *especializacao) {
+    nome_funcao_atual = especializacao != NULL ? especializacao->nome : no->filho1->lexema;
+    constantes_funcao_atual = especializacao != NULL ? &especializacao->constantes : NULL;
+
+    char label_funcao[200];
+    sprintf(label_funcao, "func_%s", nome_funcao_atual);
     emitir_label(label_funcao);
 
     funcao_sendo_gerada = no;
     offset_pilha_local = 0; 
+    registradores_laco_usados = 0;
+    iniciar_lista_instrucoes(&codigo_frio);
 
     emitir_comentario("Prologo");
     emitir("addiu $sp, $sp, -8");
@@ -230,30 +1136,39 @@ static void gerar_declaracao_funcao(NoAST *no) {
     emitir("sw $fp, 0($sp)");
     emitir("move $fp, $sp");
 
-    int espaco_locais = 0;
-    NoAST *lista_decls_locais = no->filho3->filho1;
-    NoAST *temp_decl = lista_decls_locais;
-    while (temp_decl != NULL) {
-        if (temp_decl->tipo_no == NO_DECL_VARIAVEL) {
-            espaco_locais += 4; 
-            temp_decl->filho1->entrada_tabela->posicao = -espaco_locais;
-        }
-        temp_decl = temp_decl->proximo;
-    }
+    LayoutQuadro layout;
+    calcular_layout_quadro(no->filho3->filho1, no->filho3->filho2, 0, &layout);
+    int espaco_locais = layout.tamanho;
     
-    if (espaco_locais > 0) {
-        emitir_com_valor("addiu $sp, $sp,", -espaco_locais);
+    ListaInstrucoes corpo;
+    gerar_corpo_separado(no->filho3, espaco_locais, &corpo);
+    espaco_locais = espaco_quadro_maximo;
+
+    int salvos = registradores_laco_usados;
+    if (espaco_locais + 4 * salvos > 0) {
+        emitir_com_valor("addiu $sp, $sp,", -(espaco_locais + 4 * salvos));
+    }
+    char instrucao[64];
+    for (int i = 0; i < salvos; i++) {
+        snprintf(instrucao, sizeof(instrucao), "sw $s%d, %d($fp)", i, -(espaco_locais + 4 * (i + 1)));
+        emitir(instrucao);
     }
-    offset_pilha_local = espaco_locais; 
+    offset_pilha_local = espaco_locais + 4 * salvos; 
+    relatar_quadro(nome_funcao_atual, 8 + offset_pilha_local, &layout);
+    liberar_layout_quadro(&layout);
 
-    emitir_comentario("Corpo da Funcao");
-    percorrer_geracao(no->filho3); 
+    gerar_contador_perfil(no, 0);
+    anexar_lista_instrucoes(&codigo_gerado, &corpo);
 
     emitir_comentario("Epilogo");
-    char label_retorno[100];
-    sprintf(label_retorno, "ret_%s", no->filho1->lexema);
+    char label_retorno[200];
+    sprintf(label_retorno, "ret_%s", nome_funcao_atual);
     emitir_label(label_retorno);
 
+    for (int i = 0; i < salvos; i++) {
+        snprintf(instrucao, sizeof(instrucao), "lw $s%d, %d($fp)", i, -(espaco_locais + 4 * (i + 1)));
+        emitir(instrucao);
+    }
     if (offset_pilha_local > 0) {
         emitir_com_valor("addiu $sp, $sp,", offset_pilha_local);
     }
@@ -262,17 +1177,61 @@ static void gerar_declaracao_funcao(NoAST *no) {
     emitir("addiu $sp, $sp, 8");
     
     emitir("jr $ra");
+    anexar_lista_instrucoes(&codigo_gerado, &codigo_frio);
     
     funcao_sendo_gerada = NULL;
+    nome_funcao_atual = NULL;
+    constantes_funcao_atual = NULL;
+    registradores_laco_usados = 0;
 }
 
 /**
- * @brief Processa uma declaração de variável (calcula offset).
- * (Já feito em gerar_programa e gerar_declaracao_funcao)
+ * @brief Processa uma declaração de variável.
+ * (O offset já foi calculado pelo layout do quadro, em modulo_quadro.c)
  */
 static void gerar_declaracao_variavel(NoAST *no) {
 }
 
+/**
+ * @brief Dentro de uma chamada expandida, procura a posição no quadro de um
+ * parâmetro ou local da função expandida.
+ * @return 1 se a variável pertence à expansão mais interna.
+ */
+static int buscar_posicao_expandida(const EntradaTabela *entrada, int *posicao) {
+    if (num_expansoes == 0) return 0;
+    const ExpansaoInline *expansao = &expansoes[num_expansoes - 1];
+    if (entrada->tipo != TIPO_FUNCAO && entrada->posicao >= 0) {
+        *posicao = expansao->posicoes_parametros[entrada->posicao];
+        return 1;
+    }
+    for (int i = 0; i < expansao->locais.num_variaveis; i++) {
+        if (expansao->locais.variaveis[i] == entrada) {
+            *posicao = expansao->locais.posicoes[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Indica se a variável ocupa um único byte (local 'car', acessada
+ * com lb/sb). Os parâmetros são sempre passados em palavras.
+ */
+static int variavel_em_byte(const EntradaTabela *entrada) {
+    return entrada != NULL && entrada->tipo == TIPO_CAR && entrada->posicao < 0;
+}
+
+/**
+ * @brief Operando de memória "desloc($gp)" de uma variável global da área de
+ * dados pequenos.
+ * @return 1 se a variável está nessa área.
+ */
+static int operando_global(const EntradaTabela *entrada, char *operando, size_t tamanho) {
+    if (entrada == NULL || entrada->endereco_global < 0 || entrada->endereco_global >= TAMANHO_AREA_GP) return 0;
+    snprintf(operando, tamanho, "%d($gp)", DESLOCAMENTO_AREA_GP + entrada->endereco_global);
+    return 1;
+}
+
 /**
  * @brief Gera código para carregar o endereço de uma variável em $t0.
  */
@@ -286,10 +1245,38 @@ static void gerar_endereco_variavel(NoAST *no_id) {
     }
     
     
+    if (entrada->endereco_global >= 0) {
+        char operando[32];
+        if (operando_global(entrada, operando, sizeof(operando))) {
+            snprintf(operando, sizeof(operando), "%d", DESLOCAMENTO_AREA_GP + entrada->endereco_global);
+            emitir_com_label("addiu $t0, $gp,", operando);
+        } else {
+            char label[200];
+            snprintf(label, sizeof(label), "glob_%s", entrada->lexema);
+            emitir_com_label("la $t0,", label);
+        }
+        return;
+    }
+
+    int posicao;
+    if (buscar_posicao_expandida(entrada, &posicao)) {
+        emitir_com_valor("addiu $t0, $fp,", posicao);
+        return;
+    }
+    
     if (entrada->posicao >= 0) { 
         
-        int num_args = funcao_sendo_gerada->filho1->entrada_tabela->num_argumentos;
-        int offset = 8 + 4 * (num_args - 1 - entrada->posicao);
+        // Numa versão especializada, só os parâmetros não constantes estão na pilha.
+        int num_args = 0, indice = 0;
+        int total_parametros = funcao_sendo_gerada->filho1->entrada_tabela->num_argumentos;
+        for (int i = 0; i < total_parametros; i++) {
+            int constante = constantes_funcao_atual != NULL && i < constantes_funcao_atual->num_parametros
+                            && constantes_funcao_atual->conhecido[i];
+            if (constante) continue;
+            if (i < entrada->posicao) indice++;
+            num_args++;
+        }
+        int offset = 8 + 4 * (num_args - 1 - indice);
         emitir_com_valor("addiu $t0, $fp,", offset); 
         
     } else { 
@@ -302,6 +1289,13 @@ static void gerar_endereco_variavel(NoAST *no_id) {
  */
 static void gerar_comando_atribuicao(NoAST *no) {
     emitir_comentario("Atribuicao");
+    char operando[32];
+    if (operando_global(no->filho1->entrada_tabela, operando, sizeof(operando))) {
+        gerar_expressao(no->filho2);
+        emitir_com_label(variavel_em_byte(no->filho1->entrada_tabela) ? "sb $v0," : "sw $v0,", operando);
+        atualizar_valores_de_inducao(no);
+        return;
+    }
     gerar_endereco_variavel(no->filho1);
     
     emitir("addiu $sp, $sp, -4");
@@ -312,65 +1306,250 @@ static void gerar_comando_atribuicao(NoAST *no) {
     emitir("lw $t0, 0($sp)");
     emitir("addiu $sp, $sp, 4");
     
-    emitir("sw $v0, 0($t0)"); 
+    emitir(variavel_em_byte(no->filho1->entrada_tabela) ? "sb $v0, 0($t0)" : "sw $v0, 0($t0)"); 
+
+    atualizar_valores_de_inducao(no);
+}
+
+/**
+ * @brief Gera um dos braços de um 'se' (o 'entao' conta no perfil).
+ */
+static void gerar_braco_se(NoAST *no, int entao) {
+    if (entao) {
+        emitir_comentario("SE - Bloco THEN");
+        gerar_contador_perfil(no, 1);
+        percorrer_geracao(no->filho2);
+    } else {
+        emitir_comentario("SE - Bloco ELSE");
+        percorrer_geracao(no->filho3);
+    }
+}
+
+/**
+ * @brief Com um perfil carregado, escolhe o braço do 'se' a tirar do caminho:
+ * o menos executado, se executou menos vezes que o outro. Sem 'senao', o
+ * caminho que pula o 'entao' já não tem saltos e só o 'entao' pode sair.
+ * @return 1 para o 'entao', 0 para o 'senao' e -1 para manter o layout.
+ */
+static int braco_frio_perfil(const NoAST *no) {
+    if (!perfil_carregado) return -1;
+    int contador = contador_perfil(&perfil, no);
+    unsigned long long execucoes = contagem_perfil(&perfil, contador);
+    unsigned long long entao = contagem_perfil(&perfil, contador + 1);
+    if (execucoes == 0 || entao > execucoes) return -1;
+    unsigned long long senao = execucoes - entao;
+    int braco = entao < senao ? 1 : (senao < entao && no->filho3 != NULL ? 0 : -1);
+    if (braco >= 0) {
+        fprintf(relatorio_unidade, "Perfil: se da linha %d com o braco '%s' fora de linha (%llu de %llu execucoes).\n",
+               no->filho1->linha, braco ? "entao" : "senao", braco ? entao : senao, execucoes);
+    }
+    return braco;
+}
+
+/**
+ * @brief Gera um braço do 'se' na área fria da função (depois do epílogo),
+ * a partir de 'label', voltando para 'label_retorno'.
+ */
+static void gerar_braco_fora_de_linha(NoAST *no, int entao, const char *label, const char *label_retorno) {
+    ListaInstrucoes codigo_externo = codigo_gerado;
+    iniciar_lista_instrucoes(&codigo_gerado);
+    emitir_label(label);
+    gerar_braco_se(no, entao);
+    emitir_com_label("j", label_retorno);
+    // Os braços frios aninhados neste já foram para 'codigo_frio'.
+    anexar_lista_instrucoes(&codigo_frio, &codigo_gerado);
+    codigo_gerado = codigo_externo;
 }
 
 /**
  * @brief Gera código para um comando 'se' (if-then-else).
+ *
+ * Com um perfil, o braço frio sai do caminho: o teste desvia para ele, na
+ * área fria da função, e o braço quente segue sem nenhum salto tomado.
  */
 static void gerar_comando_se(NoAST *no) {
+    gerar_contador_perfil(no, 0);
+    int valor;
+    if (opcoes_atuais->especializar_funcoes && avaliar_constante(no->filho1, constantes_do_escopo(), &valor)) {
+        emitir_comentario("Comando SE (condicao constante)");
+        if (valor) gerar_contador_perfil(no, 1);
+        percorrer_geracao(valor ? no->filho2 : no->filho3);
+        return;
+    }
+
+    // Instrumentado, cada 'se' da cadeia precisa dos próprios contadores.
+    if (opcoes_atuais->otimizar_despacho && !opcoes_atuais->instrumentar && gerar_despacho_cadeia_se(no)) {
+        return;
+    }
+
     int label_id = contador_label_se++;
-    char label_else[20];
-    char label_fim[20];
-    sprintf(label_else, "se_else_%d", label_id);
-    sprintf(label_fim, "se_fim_%d", label_id);
+    char label_else[TAM_LABEL];
+    char label_fim[TAM_LABEL];
+    nomear_label(label_else, "se_else_%d", label_id);
+    nomear_label(label_fim, "se_fim_%d", label_id);
     
     emitir_comentario("Comando SE");
-    
-    gerar_expressao(no->filho1);
-    
-    if (no->filho3 != NULL) { 
-        emitir_com_label("beqz $v0,", label_else); 
-    } else { 
-        emitir_com_label("beqz $v0,", label_fim); 
+
+    int braco_frio = braco_frio_perfil(no);
+    if (braco_frio >= 0) {
+        char label_frio[TAM_LABEL];
+        nomear_label(label_frio, "se_frio_%d", contador_label_frio++);
+        gerar_desvio_condicional(no->filho1, braco_frio, label_frio);
+        if (!braco_frio || no->filho3 != NULL) gerar_braco_se(no, !braco_frio);
+        emitir_label(label_fim);
+        gerar_braco_fora_de_linha(no, braco_frio, label_frio, label_fim);
+        return;
     }
     
-
-    emitir_comentario("SE - Bloco THEN");
-    percorrer_geracao(no->filho2);
+    gerar_desvio_condicional(no->filho1, 0, no->filho3 != NULL ? label_else : label_fim);
+    
+    gerar_braco_se(no, 1);
     
     if (no->filho3 != NULL) { 
         emitir_com_label("j", label_fim); 
         emitir_label(label_else);
-        emitir_comentario("SE - Bloco ELSE");
-        percorrer_geracao(no->filho3); 
+        gerar_braco_se(no, 0);
     }
 
     emitir_label(label_fim);
 }
 
+/**
+ * @brief Procura, nos laços ativos (do mais interno ao mais externo), um
+ * registrador $sN que já contém o valor da expressão.
+ * @return O número do registrador, ou -1.
+ */
+static int buscar_valor_de_laco(const NoAST *expressao) {
+    if (expressao->tipo_no != NO_OP_SOMA && expressao->tipo_no != NO_OP_SUB
+        && expressao->tipo_no != NO_OP_MULT && expressao->tipo_no != NO_OP_DIV) {
+        return -1;
+    }
+    for (int i = num_lacos_ativos - 1; i >= 0; i--) {
+        const AnaliseLaco *analise = lacos_ativos[i];
+        for (int j = 0; j < analise->num_valores; j++) {
+            if (expressoes_iguais(analise->valores[j].expressao, expressao)) {
+                return analise->valores[j].registrador;
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Após "i = i ± c", soma o passo aos registradores que guardam "i * k".
+ */
+static void atualizar_valores_de_inducao(NoAST *atribuicao) {
+    char instrucao[64];
+    for (int i = 0; i < num_lacos_ativos; i++) {
+        const AnaliseLaco *analise = lacos_ativos[i];
+        for (int j = 0; j < analise->num_valores; j++) {
+            const ValorLaco *valor = &analise->valores[j];
+            if (valor->tipo != VALOR_INDUCAO || valor->atualizacao != atribuicao) continue;
+            if (valor->passo >= -32768 && valor->passo <= 32767) {
+                snprintf(instrucao, sizeof(instrucao), "addiu $s%d, $s%d, %d", valor->registrador, valor->registrador, valor->passo);
+            } else {
+                emitir_com_valor("li $t1,", valor->passo);
+                snprintf(instrucao, sizeof(instrucao), "addu $s%d, $s%d, $t1", valor->registrador, valor->registrador);
+            }
+            emitir(instrucao);
+        }
+    }
+}
+
 /**
  * @brief Gera código para um comando 'enquanto'.
+ *
+ * Conforme as opções, o laço é desenrolado por completo (número constante e
+ * pequeno de iterações), rotacionado (teste no fim, com um teste de guarda
+ * antes do laço) e tem invariantes e múltiplos de variáveis de indução
+ * mantidos em registradores $sN calculados no pré-cabeçalho.
+ *
+ * @param comando_anterior Comando que precede o laço na lista (ou NULL).
  */
-static void gerar_comando_enquanto(NoAST *no) {
+static void gerar_comando_enquanto(NoAST *no, NoAST *comando_anterior) {
+    gerar_contador_perfil(no, 0);
+    int linha = no->filho1->linha;
+    int valor;
+    if (opcoes_atuais->especializar_funcoes && avaliar_constante(no->filho1, constantes_do_escopo(), &valor)
+        && valor == 0) {
+        emitir_comentario("Comando ENQUANTO (condicao sempre falsa)");
+        return;
+    }
+
+    int iteracoes;
+    if (opcoes_atuais->desenrolar_lacos
+        && laco_pode_ser_desenrolado(no, comando_anterior, funcao_sendo_gerada, &iteracoes)) {
+        fprintf(relatorio_unidade, "Lacos: laco da linha %d desenrolado (%d iteracoes).\n", linha, iteracoes);
+        emitir_comentario("Comando ENQUANTO (desenrolado)");
+        for (int i = 0; i < iteracoes; i++) {
+            emitir_comentario("ENQUANTO - Iteracao");
+            gerar_contador_perfil(no, 1);
+            percorrer_geracao(no->filho2);
+        }
+        return;
+    }
+
+    int rotacionar = opcoes_atuais->rotacionar_lacos;
+    AnaliseLaco analise;
+    analise.num_valores = analise.num_invariantes = analise.num_inducao = 0;
+    // Os $sN ficam para os laços que executaram no perfil: um laço frio não
+    // faz a função salvar e restaurar registradores.
+    int laco_frio = perfil_carregado && contagem_perfil(&perfil, contador_perfil(&perfil, no) + 1) == 0;
+    if (laco_frio) {
+        fprintf(relatorio_unidade, "Perfil: laco da linha %d sem registradores $sN (corpo nao executado no perfil).\n", linha);
+    }
+    if ((opcoes_atuais->mover_invariantes || opcoes_atuais->reduzir_inducao) && num_lacos_ativos < MAX_LACOS_ATIVOS
+        && !laco_frio) {
+        analisar_laco(no, funcao_sendo_gerada, opcoes_atuais->mover_invariantes, opcoes_atuais->reduzir_inducao,
+                      rotacionar, registradores_laco_em_uso, &analise);
+    }
+    if (rotacionar || analise.num_valores > 0) {
+        fprintf(relatorio_unidade, "Lacos: laco da linha %d%s; %d invariante(s) movida(s), %d variavel(is) de inducao reduzida(s).\n",
+               linha, rotacionar ? " rotacionado" : "", analise.num_invariantes, analise.num_inducao);
+    }
+
     int label_id = contador_label_enquanto++;
-    char label_inicio[20];
-    char label_fim[20];
-    sprintf(label_inicio, "enquanto_inicio_%d", label_id);
-    sprintf(label_fim, "enquanto_fim_%d", label_id);
+    char label_inicio[TAM_LABEL];
+    char label_fim[TAM_LABEL];
+    nomear_label(label_inicio, "enquanto_inicio_%d", label_id);
+    nomear_label(label_fim, "enquanto_fim_%d", label_id);
     
     emitir_comentario("Comando ENQUANTO");
+    if (rotacionar) {
+        emitir_comentario("ENQUANTO - Teste de guarda");
+        gerar_desvio_condicional(no->filho1, 0, label_fim);
+    }
+
+    if (analise.num_valores > 0) {
+        emitir_comentario("ENQUANTO - Pre-cabecalho");
+        char instrucao[64];
+        for (int i = 0; i < analise.num_valores; i++) {
+            gerar_expressao(analise.valores[i].expressao);
+            snprintf(instrucao, sizeof(instrucao), "move $s%d, $v0", analise.valores[i].registrador);
+            emitir(instrucao);
+        }
+    }
+    registradores_laco_em_uso += analise.num_valores;
+    if (registradores_laco_em_uso > registradores_laco_usados) registradores_laco_usados = registradores_laco_em_uso;
+    lacos_ativos[num_lacos_ativos++] = &analise;
+
     emitir_label(label_inicio); 
-    
-    gerar_expressao(no->filho1); 
-    
-    emitir_com_label("beqz $v0,", label_fim); 
+    if (!rotacionar) {
+        gerar_desvio_condicional(no->filho1, 0, label_fim); 
+    }
     
     emitir_comentario("ENQUANTO - Corpo");
+    gerar_contador_perfil(no, 1);
     percorrer_geracao(no->filho2);
     
-    emitir_com_label("j", label_inicio);
-    
+    if (rotacionar) {
+        gerar_desvio_condicional(no->filho1, 1, label_inicio);
+    } else {
+        emitir_com_label("j", label_inicio);
+    }
+
+    num_lacos_ativos--;
+    registradores_laco_em_uso -= analise.num_valores;
     emitir_label(label_fim);
 }
 
@@ -379,11 +1558,20 @@ static void gerar_comando_enquanto(NoAST *no) {
  */
 static void gerar_comando_leia(NoAST *no) {
     emitir_comentario("Comando LEIA");
-    emitir("li $v0, 5");
-    emitir("syscall"); 
+    if (opcoes_atuais->saida_bufferizada) {
+        emitir_com_label("jal", usar_rotina_es(&unidade_atual->runtime, ROTINA_LEIA_INT));
+    } else {
+        emitir("li $v0, 5");
+        emitir("syscall"); 
+    }
     
+    char operando[32];
+    if (operando_global(no->filho1->entrada_tabela, operando, sizeof(operando))) {
+        emitir_com_label(variavel_em_byte(no->filho1->entrada_tabela) ? "sb $v0," : "sw $v0,", operando);
+        return;
+    }
     gerar_endereco_variavel(no->filho1); 
-    emitir("sw $v0, 0($t0)"); 
+    emitir(variavel_em_byte(no->filho1->entrada_tabela) ? "sb $v0, 0($t0)" : "sw $v0, 0($t0)"); 
 }
 
 /**
@@ -393,14 +1581,13 @@ static void gerar_comando_escreva(NoAST *no) {
     
     if (no->filho1->tipo_no == NO_LITERAL_STRING) {
         emitir_comentario("Comando ESCREVA (String)");
-        char label_str[20];
-        sprintf(label_str, "str_%d", contador_label_string++);
-        emitir(".data");
-        emitir_label(label_str);
-        fprintf(arquivo_saida, "\t.asciiz \"%s\"\n", no->filho1->lexema);
-        emitir(".text");
-        
+        char label_str[TAM_LABEL];
+        nomear_label(label_str, "str_%d", registrar_string(&unidade_atual->strings, no->filho1->lexema));
         emitir_com_label("la $a0,", label_str);
+        if (opcoes_atuais->saida_bufferizada) {
+            emitir_com_label("jal", usar_rotina_es(&unidade_atual->runtime, ROTINA_ESCREVA_STR));
+            return;
+        }
         emitir("li $v0, 4");
         emitir("syscall");
         
@@ -410,6 +1597,11 @@ static void gerar_comando_escreva(NoAST *no) {
         
         emitir("move $a0, $v0");
         
+        if (opcoes_atuais->saida_bufferizada) {
+            RotinaES rotina = no->filho1->tipo_dado_computado == TIPO_CAR ? ROTINA_ESCREVA_CAR : ROTINA_ESCREVA_INT;
+            emitir_com_label("jal", usar_rotina_es(&unidade_atual->runtime, rotina));
+            return;
+        }
         if (no->filho1->tipo_dado_computado == TIPO_CAR) {
             emitir("li $v0, 11");
         } else {
@@ -428,8 +1620,12 @@ static void gerar_comando_retorne(NoAST *no) {
         gerar_expressao(no->filho1);
     }
     
-    char label_retorno[100];
-    sprintf(label_retorno, "ret_%s", funcao_sendo_gerada->filho1->lexema);
+    if (num_expansoes > 0) {
+        emitir_com_label("j", expansoes[num_expansoes - 1].label_fim);
+        return;
+    }
+    char label_retorno[200];
+    sprintf(label_retorno, "ret_%s", nome_funcao_atual);
     emitir_com_label("j", label_retorno);
 }
 
@@ -438,6 +1634,11 @@ static void gerar_comando_retorne(NoAST *no) {
  */
 static void gerar_novalinha() {
     emitir_comentario("Comando NOVALINHA");
+    if (opcoes_atuais->saida_bufferizada) {
+        emitir("li $a0, 10");
+        emitir_com_label("jal", usar_rotina_es(&unidade_atual->runtime, ROTINA_ESCREVA_CAR));
+        return;
+    }
     emitir("la $a0, newline");
     emitir("li $v0, 4");
     emitir("syscall");
@@ -447,19 +1648,56 @@ static void gerar_novalinha() {
  * @brief Gera código para uma chamada de função.
  */
 static void gerar_chamada_funcao(NoAST *no) {
+    gerar_contador_perfil(no, 0);
+    if (opcoes_atuais->expandir_chamadas) {
+        FuncaoGrafo *funcao;
+        int custo;
+        // Com um perfil, as chamadas quentes têm orçamento maior e as que não executaram, nenhum.
+        int orcamento = perfil_carregado ? orcamento_inline_perfil(&perfil, no, opcoes_atuais->orcamento_inline)
+                                         : opcoes_atuais->orcamento_inline;
+        DecisaoInline decisao = decidir_inline(&grafo_chamadas, no, num_expansoes, orcamento, &funcao, &custo);
+        relatar_inline(relatorio_unidade, no, decisao, custo, orcamento);
+        if (decisao == INLINE_EXPANDIR) {
+            gerar_chamada_expandida(no, funcao->declaracao);
+            return;
+        }
+    }
+
+    // Usa a versão especializada para os argumentos constantes, se houver uma.
+    const Especializacao *especializacao = NULL;
+    FuncaoGrafo *chamada = buscar_funcao_grafo(&grafo_chamadas, no->filho1->entrada_tabela);
+    if (chamada != NULL && opcoes_atuais->especializar_funcoes) {
+        ConstantesParametros argumentos;
+        if (argumentos_constantes(no, chamada->declaracao->filho3, constantes_do_escopo(), &argumentos) > 0) {
+            especializacao = buscar_especializacao(&plano_especializacao, chamada, &argumentos);
+        }
+    }
+    if (especializacao != NULL) {
+        acrescentar_chamada(unidade_atual, grafo_chamadas.num_funcoes
+                                           + (int)(especializacao - plano_especializacao.especializacoes));
+    } else if (chamada != NULL && unidades_funcoes != NULL) {
+        acrescentar_chamada(unidade_atual, (int)(chamada - grafo_chamadas.funcoes));
+    }
+
     emitir_comentario("Chamada de Funcao");
     int num_args = 0;
+    int posicao = 0;
     NoAST *arg = no->filho2;
     while (arg != NULL) {
-        gerar_expressao(arg); 
-        emitir("addiu $sp, $sp, -4"); 
-        emitir("sw $v0, 0($sp)");
-        num_args++;
+        int constante = especializacao != NULL && posicao < especializacao->constantes.num_parametros
+                        && especializacao->constantes.conhecido[posicao];
+        if (!constante) {
+            gerar_expressao(arg); 
+            emitir("addiu $sp, $sp, -4"); 
+            emitir("sw $v0, 0($sp)");
+            num_args++;
+        }
+        posicao++;
         arg = arg->proximo;
     }
     
-    char label_funcao[100];
-    sprintf(label_funcao, "func_%s", no->filho1->lexema);
+    char label_funcao[200];
+    sprintf(label_funcao, "func_%s", especializacao != NULL ? especializacao->nome : no->filho1->lexema);
     emitir_com_label("jal", label_funcao);
     
     if (num_args > 0) {
@@ -468,6 +1706,58 @@ static void gerar_chamada_funcao(NoAST *no) {
     
 }
 
+/**
+ * @brief Substitui a chamada pelo corpo da função (inline).
+ *
+ * Cada argumento é avaliado e guardado diretamente na posição do parâmetro
+ * correspondente, no quadro atual; as locais da função também ganham
+ * posições novas, dispostas como no quadro da própria função. Os 'retorne' saltam para o fim da expansão com o valor em
+ * $v0, como depois de um 'jal'.
+ */
+static void gerar_chamada_expandida(NoAST *no, NoAST *funcao) {
+    emitir_comentario("Chamada de Funcao (expandida)");
+    int espaco_anterior = espaco_quadro_em_uso;
+    int num_args = funcao->filho1->entrada_tabela->num_argumentos;
+
+    ExpansaoInline expansao;
+    expansao.posicoes_parametros = malloc((num_args > 0 ? num_args : 1) * sizeof(int));
+    if (expansao.posicoes_parametros == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a expansao de chamada.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < num_args; i++) {
+        expansao.posicoes_parametros[i] = reservar_posicao_quadro();
+    }
+    calcular_layout_quadro(funcao->filho3->filho1, funcao->filho3->filho2, espaco_quadro_em_uso, &expansao.locais);
+    espaco_quadro_em_uso += expansao.locais.tamanho;
+    if (espaco_quadro_em_uso > espaco_quadro_maximo) espaco_quadro_maximo = espaco_quadro_em_uso;
+    expansao.constantes.num_parametros = 0;
+    if (opcoes_atuais->especializar_funcoes) {
+        argumentos_constantes(no, funcao->filho3, constantes_do_escopo(), &expansao.constantes);
+    }
+
+    // Os argumentos são avaliados no escopo de quem chama, antes de a expansão
+    // ficar ativa. Os constantes não precisam ser guardados.
+    char instrucao[64];
+    int i = 0;
+    for (NoAST *arg = no->filho2; arg != NULL && i < num_args; arg = arg->proximo, i++) {
+        if (i < expansao.constantes.num_parametros && expansao.constantes.conhecido[i]) continue;
+        gerar_expressao(arg);
+        snprintf(instrucao, sizeof(instrucao), "sw $v0, %d($fp)", expansao.posicoes_parametros[i]);
+        emitir(instrucao);
+    }
+    nomear_label(expansao.label_fim, "inline_fim_%d", contador_inline++);
+
+    expansoes[num_expansoes++] = expansao;
+    gerar_contador_perfil(funcao, 0);
+    percorrer_geracao(funcao->filho3);
+    num_expansoes--;
+    emitir_label(expansao.label_fim);
+
+    free(expansao.posicoes_parametros);
+    liberar_layout_quadro(&expansao.locais);
+    espaco_quadro_em_uso = espaco_anterior;
+}
 
 /**
  * @brief Função "dispatcher" para gerar código para qualquer expressão.
@@ -476,6 +1766,21 @@ static void gerar_chamada_funcao(NoAST *no) {
 static void gerar_expressao(NoAST *no) {
     if (no == NULL) return;
 
+    int registrador = buscar_valor_de_laco(no);
+    if (registrador >= 0) {
+        char instrucao[32];
+        snprintf(instrucao, sizeof(instrucao), "move $v0, $s%d", registrador);
+        emitir(instrucao);
+        return;
+    }
+
+    int valor;
+    if (opcoes_atuais->especializar_funcoes && no->tipo_no != NO_LITERAL_INT && no->tipo_no != NO_LITERAL_CAR
+        && avaliar_constante(no, constantes_do_escopo(), &valor)) {
+        emitir_com_valor("li $v0,", valor);
+        return;
+    }
+
     switch (no->tipo_no) {
         case NO_LITERAL_INT:
             emitir_com_valor("li $v0,", no->ival);
@@ -496,8 +1801,8 @@ static void gerar_expressao(NoAST *no) {
         // Operações Binárias
         case NO_OP_SOMA:    gerar_op_binaria(no, "add"); break;
         case NO_OP_SUB:     gerar_op_binaria(no, "sub"); break;
-        case NO_OP_MULT:    gerar_op_binaria(no, "mult"); break;
-        case NO_OP_DIV:     gerar_op_binaria(no, "div"); break; 
+        case NO_OP_MULT:
+        case NO_OP_DIV:     gerar_op_multiplicativa(no); break;
         
         case NO_OP_IGUAL:   gerar_op_logica(no, "seq"); break; 
         case NO_OP_DIFERENTE: gerar_op_logica(no, "sne"); break; 
@@ -506,8 +1811,8 @@ static void gerar_expressao(NoAST *no) {
         case NO_OP_MENOR_IGUAL: gerar_op_logica(no, "sle"); break; 
         case NO_OP_MAIOR_IGUAL: gerar_op_logica(no, "sge"); break; 
         
-        case NO_OP_E:       gerar_op_binaria(no, "and"); break; 
-        case NO_OP_OU:      gerar_op_binaria(no, "or"); break;  
+        case NO_OP_E:
+        case NO_OP_OU:      gerar_op_curto_circuito(no); break;
         
         case NO_OP_NEGACAO: 
             emitir_comentario("Expressao NOT");
@@ -525,8 +1830,13 @@ static void gerar_expressao(NoAST *no) {
  * @brief Gera código para carregar o valor de um ID em $v0.
  */
 static void gerar_id(NoAST *no) {
+    char operando[32];
+    if (operando_global(no->entrada_tabela, operando, sizeof(operando))) {
+        emitir_com_label(variavel_em_byte(no->entrada_tabela) ? "lb $v0," : "lw $v0,", operando);
+        return;
+    }
     gerar_endereco_variavel(no); 
-    emitir("lw $v0, 0($t0)"); 
+    emitir(variavel_em_byte(no->entrada_tabela) ? "lb $v0, 0($t0)" : "lw $v0, 0($t0)"); 
 }
 
 /**
@@ -543,6 +1853,13 @@ static void gerar_op_binaria(NoAST *no, const char *mnemonico_mips) {
     
     gerar_expressao(no->filho2); 
     
+    // Com a saída bufferizada, o divisor zero passa pelo runtime, que descarrega
+    // o buffer antes de o 'div' parar o programa. O desvio vem antes de $t1 ser
+    // carregado: o peephole considera os $t mortos em desvios.
+    if (strcmp(mnemonico_mips, "div") == 0 && opcoes_atuais->saida_bufferizada) {
+        emitir_com_label("beqz $v0,", usar_rotina_es(&unidade_atual->runtime, ROTINA_DIVISAO_ZERO));
+    }
+    
     emitir("lw $t1, 0($sp)");
     emitir("addiu $sp, $sp, 4");
     
@@ -559,6 +1876,44 @@ static void gerar_op_binaria(NoAST *no, const char *mnemonico_mips) {
     }
 }
 
+/**
+ * @brief Gera código para '*' e '/'.
+ * Quando um dos operandos é uma constante, usa a redução de força
+ * (modulo_reducao_forca.c) em vez de 'mult'/'div' e não empilha o operando.
+ */
+static void gerar_op_multiplicativa(NoAST *no) {
+    const char *mnemonico = no->tipo_no == NO_OP_MULT ? "mult" : "div";
+    NoAST *operando = NULL;
+    int constante = 0;
+
+    if (opcoes_atuais->reduzir_forca) {
+        if (no->filho2->tipo_no == NO_LITERAL_INT) {
+            operando = no->filho1;
+            constante = no->filho2->ival;
+        } else if (no->tipo_no == NO_OP_MULT && no->filho1->tipo_no == NO_LITERAL_INT) {
+            operando = no->filho2;
+            constante = no->filho1->ival;
+        }
+    }
+    // Divisão por zero literal mantém o 'div' para preservar o comportamento em execução.
+    if (operando == NULL || (no->tipo_no == NO_OP_DIV && constante == 0)) {
+        gerar_op_binaria(no, mnemonico);
+        return;
+    }
+
+    emitir_comentario("Expressao Binaria (constante)");
+    gerar_expressao(operando);
+    int reduzida = no->tipo_no == NO_OP_MULT ? gerar_multiplicacao_constante(&codigo_gerado, constante)
+                                             : gerar_divisao_constante(&codigo_gerado, constante);
+    if (!reduzida) {
+        char instrucao[50];
+        emitir_com_valor("li $t1,", constante);
+        sprintf(instrucao, "%s $v0, $t1", mnemonico);
+        emitir(instrucao);
+        emitir("mflo $v0");
+    }
+}
+
 /**
  * @brief Gera código para uma operação lógica/relacional (SEQ, SNE, SLT, ...).
  * Similar à binária, mas o mnemônico é diferente.
@@ -578,4 +1933,243 @@ static void gerar_op_logica(NoAST *no, const char *mnemonico_mips) {
     char instrucao[50];
     sprintf(instrucao, "%s $v0, $t1, $v0", mnemonico_mips);
     emitir(instrucao);
-}
\ No newline at end of file
+}
+/**
+ * @brief Desvios correspondentes a cada operador relacional: o que desvia
+ * quando a relação é verdadeira e o que desvia quando ela é falsa.
+ */
+static const struct {
+    TipoNoAST operador;
+    const char *desvio_verdadeiro;
+    const char *desvio_falso;
+} tabela_desvios_relacionais[] = {
+    {NO_OP_IGUAL,       "beq", "bne"},
+    {NO_OP_DIFERENTE,   "bne", "beq"},
+    {NO_OP_MENOR,       "blt", "bge"},
+    {NO_OP_MAIOR,       "bgt", "ble"},
+    {NO_OP_MENOR_IGUAL, "ble", "bgt"},
+    {NO_OP_MAIOR_IGUAL, "bge", "blt"},
+};
+
+/**
+ * @brief Indica se o nó é um literal que pode ser usado como imediato num desvio.
+ */
+static int e_literal_imediato(const NoAST *no) {
+    return no->tipo_no == NO_LITERAL_INT || no->tipo_no == NO_LITERAL_CAR;
+}
+
+/**
+ * @brief Gera código que desvia para 'label' quando a condição tem o valor
+ * indicado (1 = verdadeira, 0 = falsa) e segue para a próxima instrução
+ * caso contrário.
+ * Comparações relacionais viram um único desvio sobre os operandos (sem
+ * materializar 0/1 em $v0) e a negação apenas inverte o sentido do desvio.
+ * '&&' e '||' são avaliados em curto-circuito: o operando direito só é
+ * avaliado quando o esquerdo não decide o resultado.
+ */
+static void gerar_desvio_condicional(NoAST *condicao, int desviar_se_verdadeira, const char *label) {
+    int valor;
+    if (opcoes_atuais->especializar_funcoes && avaliar_constante(condicao, constantes_do_escopo(), &valor)) {
+        if ((valor != 0) == desviar_se_verdadeira) emitir_com_label("j", label);
+        return;
+    }
+
+    if (condicao->tipo_no == NO_OP_NEGACAO) {
+        gerar_desvio_condicional(condicao->filho1, !desviar_se_verdadeira, label);
+        return;
+    }
+
+    if (condicao->tipo_no == NO_OP_E || condicao->tipo_no == NO_OP_OU) {
+        // Valor do operando esquerdo que já decide a expressão: 0 para '&&', 1 para '||'.
+        int valor_decisivo = (condicao->tipo_no == NO_OP_OU);
+
+        if (desviar_se_verdadeira == valor_decisivo) {
+            // a && b desvia se falsa: desvia se a for falsa, ou se b for falsa (idem para ||).
+            gerar_desvio_condicional(condicao->filho1, desviar_se_verdadeira, label);
+            gerar_desvio_condicional(condicao->filho2, desviar_se_verdadeira, label);
+        } else {
+            // a && b desvia se verdadeira: se a for falsa, pula o teste de b.
+            char label_fim[TAM_LABEL];
+            nomear_label(label_fim, "logico_fim_%d", contador_label_logico++);
+            gerar_desvio_condicional(condicao->filho1, valor_decisivo, label_fim);
+            gerar_desvio_condicional(condicao->filho2, desviar_se_verdadeira, label);
+            emitir_label(label_fim);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(tabela_desvios_relacionais) / sizeof(tabela_desvios_relacionais[0]); i++) {
+        if (tabela_desvios_relacionais[i].operador != condicao->tipo_no) continue;
+
+        const char *desvio = desviar_se_verdadeira ? tabela_desvios_relacionais[i].desvio_verdadeiro
+                                                   : tabela_desvios_relacionais[i].desvio_falso;
+        char instrucao[256];
+        emitir_comentario("Desvio Relacional");
+        gerar_expressao(condicao->filho1);
+
+        if (e_literal_imediato(condicao->filho2)) {
+            int valor = condicao->filho2->tipo_no == NO_LITERAL_INT ? condicao->filho2->ival : condicao->filho2->cval;
+            snprintf(instrucao, sizeof(instrucao), "%s $v0, %d, %s", desvio, valor, label);
+        } else {
+            emitir("addiu $sp, $sp, -4");
+            emitir("sw $v0, 0($sp)");
+
+            gerar_expressao(condicao->filho2);
+
+            emitir("lw $t1, 0($sp)");
+            emitir("addiu $sp, $sp, 4");
+            snprintf(instrucao, sizeof(instrucao), "%s $t1, $v0, %s", desvio, label);
+        }
+        emitir(instrucao);
+        return;
+    }
+
+    gerar_expressao(condicao);
+    emitir_com_label(desviar_se_verdadeira ? "bnez $v0," : "beqz $v0,", label);
+}
+
+/**
+ * @brief Gera código para '&&' e '||' usados como valor.
+ * A expressão é avaliada em curto-circuito e o resultado em $v0 é sempre 0 ou 1.
+ */
+static void gerar_op_curto_circuito(NoAST *no) {
+    int label_id = contador_label_logico++;
+    char label_falso[TAM_LABEL];
+    char label_fim[TAM_LABEL];
+    nomear_label(label_falso, "logico_falso_%d", label_id);
+    nomear_label(label_fim, "logico_fim_%d", label_id);
+
+    emitir_comentario("Expressao Logica (curto-circuito)");
+    gerar_desvio_condicional(no, 0, label_falso);
+    emitir("li $v0, 1");
+    emitir_com_label("j", label_fim);
+    emitir_label(label_falso);
+    emitir("li $v0, 0");
+    emitir_label(label_fim);
+}
+
+/**
+ * @brief Gera a árvore de decisão (busca binária) sobre os intervalos [primeiro, ultimo].
+ * O valor da variável está em $v0.
+ */
+static void gerar_busca_binaria(const CadeiaDespacho *cadeia, int primeiro, int ultimo,
+                                char labels_bracos[][TAM_LABEL], const char *label_senao, int id) {
+    if (primeiro == ultimo) {
+        int braco = cadeia->intervalos[primeiro].braco;
+        emitir_com_label("j", braco >= 0 ? labels_bracos[braco] : label_senao);
+        return;
+    }
+
+    int meio = (primeiro + ultimo + 1) / 2;
+    char label_esquerda[TAM_LABEL];
+    char instrucao[TAM_LABEL + 64];
+    nomear_label(label_esquerda, "despacho_%d_abaixo_%d", id, meio);
+    snprintf(instrucao, sizeof(instrucao), "blt $v0, %lld, %s", cadeia->intervalos[meio].inicio, label_esquerda);
+    emitir(instrucao);
+    gerar_busca_binaria(cadeia, meio, ultimo, labels_bracos, label_senao, id);
+    emitir_label(label_esquerda);
+    gerar_busca_binaria(cadeia, primeiro, meio - 1, labels_bracos, label_senao, id);
+}
+
+/**
+ * @brief Gera uma tabela de saltos em .data para os valores [menor, maior].
+ * Valores fora da faixa caem nos intervalos extremos. O valor está em $v0.
+ */
+static void gerar_tabela_saltos(const CadeiaDespacho *cadeia, long long menor, long long maior,
+                                char labels_bracos[][TAM_LABEL], const char *label_senao, int id) {
+    char label_tabela[TAM_LABEL];
+    char instrucao[TAM_LABEL + 64];
+    nomear_label(label_tabela, "despacho_%d_tabela", id);
+
+    int braco_abaixo = cadeia->intervalos[0].braco;
+    int braco_acima = cadeia->intervalos[cadeia->num_intervalos - 1].braco;
+    snprintf(instrucao, sizeof(instrucao), "blt $v0, %lld, %s", menor, braco_abaixo >= 0 ? labels_bracos[braco_abaixo] : label_senao);
+    emitir(instrucao);
+    snprintf(instrucao, sizeof(instrucao), "bgt $v0, %lld, %s", maior, braco_acima >= 0 ? labels_bracos[braco_acima] : label_senao);
+    emitir(instrucao);
+
+    emitir_com_valor("li $t1,", (int)menor);
+    emitir("subu $t0, $v0, $t1");
+    emitir("sll $t0, $t0, 2");
+    emitir_com_label("la $t1,", label_tabela);
+    emitir("addu $t0, $t0, $t1");
+    emitir("lw $t0, 0($t0)");
+    emitir("jr $t0");
+
+    // Uma entrada por valor da faixa, oito por linha.
+    emitir(".data");
+    emitir(".align 2");
+    emitir_label(label_tabela);
+    char diretiva[8 * (TAM_LABEL + 2) + 16];
+    int na_linha = 0;
+    for (int i = 1; i < cadeia->num_intervalos - 1; i++) {
+        const IntervaloDespacho *intervalo = &cadeia->intervalos[i];
+        const char *destino = intervalo->braco >= 0 ? labels_bracos[intervalo->braco] : label_senao;
+        for (long long valor = intervalo->inicio; valor <= intervalo->fim; valor++) {
+            if (na_linha == 0) {
+                snprintf(diretiva, sizeof(diretiva), ".word %s", destino);
+            } else {
+                size_t usado = strlen(diretiva);
+                snprintf(diretiva + usado, sizeof(diretiva) - usado, ", %s", destino);
+            }
+            if (++na_linha == 8) {
+                adicionar_diretiva(&codigo_gerado, diretiva);
+                na_linha = 0;
+            }
+        }
+    }
+    if (na_linha > 0) adicionar_diretiva(&codigo_gerado, diretiva);
+    emitir(".text");
+}
+
+/**
+ * @brief Tenta gerar uma cadeia "se/senao se/..." sobre uma mesma variável
+ * como tabela de saltos (faixa densa) ou busca binária (faixa esparsa),
+ * com custo O(1) ou O(log n) em vez de um teste por braço.
+ * @return 1 se a cadeia foi gerada, 0 se o 'se' não forma uma cadeia.
+ */
+static int gerar_despacho_cadeia_se(NoAST *no) {
+    CadeiaDespacho cadeia;
+    if (!reconhecer_cadeia_se(no, &cadeia)) return 0;
+
+    int id = contador_despacho++;
+    char (*labels_bracos)[TAM_LABEL] = malloc(cadeia.num_bracos * sizeof(*labels_bracos));
+    char label_senao[TAM_LABEL];
+    char label_fim[TAM_LABEL];
+    for (int i = 0; i < cadeia.num_bracos; i++) {
+        nomear_label(labels_bracos[i], "despacho_%d_caso_%d", id, i);
+    }
+    nomear_label(label_senao, "despacho_%d_senao", id);
+    nomear_label(label_fim, "despacho_%d_fim", id);
+
+    long long menor, maior;
+    int densa = cadeia_e_densa(&cadeia, &menor, &maior);
+    if (densa) {
+        fprintf(relatorio_unidade, "Despacho: cadeia se/senao da linha %d (variavel '%s', %d testes) convertida em tabela de saltos com %lld entradas.\n",
+               no->filho1->linha, cadeia.variavel->lexema, cadeia.num_bracos, maior - menor + 1);
+    } else {
+        fprintf(relatorio_unidade, "Despacho: cadeia se/senao da linha %d (variavel '%s', %d testes) convertida em busca binaria sobre %d intervalos.\n",
+               no->filho1->linha, cadeia.variavel->lexema, cadeia.num_bracos, cadeia.num_intervalos);
+    }
+
+    emitir_comentario(densa ? "Comando SE (despacho por tabela de saltos)" : "Comando SE (despacho por busca binaria)");
+    gerar_id(cadeia.variavel);
+    if (densa) {
+        gerar_tabela_saltos(&cadeia, menor, maior, labels_bracos, label_senao, id);
+    } else {
+        gerar_busca_binaria(&cadeia, 0, cadeia.num_intervalos - 1, labels_bracos, label_senao, id);
+    }
+
+    for (int i = 0; i < cadeia.num_bracos; i++) {
+        emitir_label(labels_bracos[i]);
+        percorrer_geracao(cadeia.bracos[i]);
+        emitir_com_label("j", label_fim);
+    }
+    emitir_label(label_senao);
+    percorrer_geracao(cadeia.senao);
+    emitir_label(label_fim);
+
+    free(labels_bracos);
+    liberar_cadeia_despacho(&cadeia);
+    return 1;
+}
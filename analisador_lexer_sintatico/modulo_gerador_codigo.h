@@ -3,6 +3,39 @@
 
 #include "modulo_arvore_sintatica_abstrata.h"
 
+struct EstadoIncremental;
+
+/**
+ * @brief Opções que controlam a geração de código (definidas na linha de comando).
+ */
+typedef struct OpcoesGeracao {
+    int otimizar_peephole;      // Aplica o otimizador peephole sobre o código gerado
+    int otimizar_despacho;      // Converte cadeias se/senao em tabela de saltos ou busca binária
+    int reduzir_forca;          // Multiplicação/divisão por constante com deslocamentos e número mágico
+    int mover_invariantes;      // Calcula expressões invariantes dos laços uma vez, antes do laço
+    int rotacionar_lacos;       // Gera 'enquanto' com o teste no fim (teste de guarda antes do laço)
+    int reduzir_inducao;        // Mantém "i * k" em registrador, somando o passo a cada "i = i ± c"
+    int desenrolar_lacos;       // Desenrola laços com poucas iterações de número constante
+    int expandir_chamadas;      // Substitui chamadas a funções pequenas pelo corpo (inline)
+    int orcamento_inline;       // Custo máximo aceito para expandir uma chamada
+    int especializar_funcoes;   // Dobra constantes e cria versões de funções para argumentos constantes
+    int crescimento_especializacao; // Crescimento máximo (em %) causado pelas especializações
+    int apenas_alcancaveis;     // Gera só as funções chamadas (direta ou indiretamente) por 'programa'
+    int saida_bufferizada;      // 'escreva'/'leia' usam o runtime com buffer em vez de um syscall por item
+    int instrumentar;           // Conta as execuções de funções, braços, laços e chamadas (modulo_perfil.h)
+    const char *arquivo_perfil; // Perfil lido para guiar layout, inline e registradores (NULL = nenhum)
+    int avaliar_em_compilacao;  // Executa em compilação o prefixo de 'programa' que não lê a entrada
+    long long passos_avaliacao; // Orçamento de passos da avaliação parcial
+    long long memoria_avaliacao; // Orçamento de memória (bytes) da avaliação parcial
+    struct EstadoIncremental *incremental; // Código reaproveitado e guardado por --incremental (NULL = nenhum)
+    int num_threads;            // Threads que geram as funções em paralelo (o código não depende disso)
+} OpcoesGeracao;
+
+/**
+ * @brief Preenche as opções com os valores padrão.
+ */
+void iniciar_opcoes_geracao(OpcoesGeracao *opcoes);
+
 /**
  * @brief Função principal do Gerador de Código.
  * * Percorre a Árvore Sintática Abstrata (AST), que já foi validada
@@ -10,8 +43,36 @@
  * * @param raiz O nó raiz da AST.
  * @param nome_arquivo_saida O nome do arquivo (ex: "saida.s") onde
  * o código assembly MIPS será escrito.
+ * @param opcoes As opções de geração (NULL usa os valores padrão).
+ */
+void gerar_codigo(NoAST *raiz, const char *nome_arquivo_saida, const OpcoesGeracao *opcoes);
+
+/**
+ * @brief Início da geração em fluxo (--stream).
+ * * Cada declaração global é gerada assim que é verificada, e o código das
+ * funções vai para um arquivo temporário; em memória ficam só as diretivas
+ * das globais, os literais e as rotinas de E/S usadas. As opções não podem
+ * depender do programa inteiro (inline, especialização, avaliação parcial,
+ * perfil, 'apenas_alcancaveis'). O saida.s é o mesmo de gerar_codigo.
+ */
+void iniciar_geracao_em_fluxo(const OpcoesGeracao *opcoes);
+
+/**
+ * @brief Gera uma declaração global já verificada (lista de variáveis ou uma
+ * função). Depois disso a AST da declaração pode ser liberada.
+ */
+void gerar_declaracao_em_fluxo(NoAST *declaracao);
+
+/**
+ * @brief Gera 'programa' (sem as declarações globais, já geradas) e escreve
+ * o arquivo de saída completo.
+ */
+void concluir_geracao_em_fluxo(NoAST *programa, const char *nome_arquivo_saida);
+
+/**
+ * @brief Abandona a geração em fluxo (erros no fonte) sem escrever a saída.
  */
-void gerar_codigo(NoAST *raiz, const char *nome_arquivo_saida);
+void descartar_geracao_em_fluxo();
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,470 @@
+#include "modulo_gerador_x86.h"
+#include "modulo_instrucoes_mips.h"
+#include "modulo_constantes.h"
+#include "modulo_quadro.h"
+#include "modulo_tabela_strings.h"
+#include "modulo_runtime_x86.h"
+#include "modulo_grafo_chamadas.h"
+#include <stdarg.h>
+
+#define LABEL_PRINCIPAL_X86 "goianinha_programa"
+
+static ListaInstrucoes codigo_x86;
+static TabelaStrings strings_x86;
+static int contador_labels_x86 = 0;
+static const char *nome_funcao_x86 = NULL;     // NULL no bloco 'programa'
+static int num_parametros_x86 = 0;
+
+static void gerar_expressao_x86(const NoAST *no);
+static void gerar_comando_x86(const NoAST *no);
+
+static void emitir_x86(const char *formato, ...) {
+    char instrucao[256];
+    va_list argumentos;
+    va_start(argumentos, formato);
+    vsnprintf(instrucao, sizeof(instrucao), formato, argumentos);
+    va_end(argumentos);
+    adicionar_instrucao(&codigo_x86, instrucao);
+}
+
+static void emitir_label_numerado_x86(int numero) {
+    char label[32];
+    snprintf(label, sizeof(label), ".L%d", numero);
+    adicionar_label(&codigo_x86, label);
+}
+
+/* ---------- Variáveis ---------- */
+
+/**
+ * @brief Indica se a variável ocupa um único byte (local 'car', como no
+ * backend MIPS). Parâmetros e globais ocupam sempre 4 bytes.
+ */
+static int variavel_em_byte_x86(const EntradaTabela *entrada) {
+    return entrada->tipo == TIPO_CAR && entrada->posicao < 0 && entrada->endereco_global < 0;
+}
+
+/**
+ * @brief Operando de memória de uma variável. Os argumentos são empilhados
+ * da esquerda para a direita (8 bytes cada), acima do endereço de retorno e
+ * do %rbp salvo; as locais ficam abaixo de %rbp, nas posições do layout do quadro.
+ */
+static void operando_variavel_x86(const EntradaTabela *entrada, char *operando, size_t tamanho) {
+    if (entrada->endereco_global >= 0) {
+        snprintf(operando, tamanho, "glob_%s(%%rip)", entrada->lexema);
+    } else if (entrada->posicao >= 0) {
+        snprintf(operando, tamanho, "%d(%%rbp)", 16 + 8 * (num_parametros_x86 - 1 - entrada->posicao));
+    } else {
+        snprintf(operando, tamanho, "%d(%%rbp)", entrada->posicao);
+    }
+}
+
+static void carregar_variavel_x86(const EntradaTabela *entrada) {
+    char operando[256];
+    operando_variavel_x86(entrada, operando, sizeof(operando));
+    emitir_x86(variavel_em_byte_x86(entrada) ? "movsbl %s, %%eax" : "movl %s, %%eax", operando);
+}
+
+static void armazenar_variavel_x86(const EntradaTabela *entrada) {
+    char operando[256];
+    operando_variavel_x86(entrada, operando, sizeof(operando));
+    emitir_x86(variavel_em_byte_x86(entrada) ? "movb %%al, %s" : "movl %%eax, %s", operando);
+}
+
+/* ---------- Expressões ---------- */
+
+static int constante_x86(const NoAST *no, int *valor) {
+    return no->tipo_no != NO_CHAMADA_FUNCAO && no->tipo_no != NO_COMANDO_ATRIBUICAO
+        && avaliar_constante(no, NULL, valor);
+}
+
+/**
+ * @brief Operando que pode ser usado diretamente por uma instrução (imediato
+ * ou variável de 4 bytes), sem passar por um registrador.
+ */
+static int operando_simples_x86(const NoAST *no, char *operando, size_t tamanho) {
+    int valor;
+    if (constante_x86(no, &valor)) {
+        snprintf(operando, tamanho, "$%d", valor);
+        return 1;
+    }
+    if (no->tipo_no == NO_ID && !variavel_em_byte_x86(no->entrada_tabela)) {
+        operando_variavel_x86(no->entrada_tabela, operando, tamanho);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Deixa o operando esquerdo em %eax e descreve o direito em 'direito'
+ * (imediato, memória ou %ecx). O esquerdo é sempre avaliado primeiro.
+ */
+static void gerar_operandos_x86(const NoAST *no, char *direito, size_t tamanho) {
+    if (operando_simples_x86(no->filho2, direito, tamanho)) {
+        gerar_expressao_x86(no->filho1);
+        return;
+    }
+    gerar_expressao_x86(no->filho1);
+    emitir_x86("pushq %%rax");
+    gerar_expressao_x86(no->filho2);
+    emitir_x86("movl %%eax, %%ecx");
+    emitir_x86("popq %%rax");
+    snprintf(direito, tamanho, "%%ecx");
+}
+
+/**
+ * @brief Divisão de %eax pelo operando. Como no MIPS, INT_MIN / -1 resulta
+ * em INT_MIN (o idiv geraria uma exceção); a divisão por zero encerra o
+ * programa com uma mensagem.
+ */
+static void gerar_divisao_x86(const char *divisor) {
+    if (divisor[0] == '$') {
+        int valor = atoi(divisor + 1);
+        if (valor == 0) {
+            emitir_x86("call %s", ROTINA_X86_ERRO_DIVISAO);
+        } else if (valor == -1) {
+            emitir_x86("negl %%eax");
+        } else {
+            emitir_x86("movl %s, %%ecx", divisor);
+            emitir_x86("cltd");
+            emitir_x86("idivl %%ecx");
+        }
+        return;
+    }
+    if (strcmp(divisor, "%ecx") != 0) emitir_x86("movl %s, %%ecx", divisor);
+    int label_divide = contador_labels_x86++;
+    int label_fim = contador_labels_x86++;
+    emitir_x86("testl %%ecx, %%ecx");
+    emitir_x86("je %s", ROTINA_X86_ERRO_DIVISAO);
+    emitir_x86("cmpl $-1, %%ecx");
+    emitir_x86("jne .L%d", label_divide);
+    emitir_x86("negl %%eax");
+    emitir_x86("jmp .L%d", label_fim);
+    emitir_label_numerado_x86(label_divide);
+    emitir_x86("cltd");
+    emitir_x86("idivl %%ecx");
+    emitir_label_numerado_x86(label_fim);
+}
+
+/* Sufixos das condições (set<cc>/j<cc>) e das negações. */
+static const char *condicao_x86(TipoNoAST tipo, int negada) {
+    switch (tipo) {
+        case NO_OP_IGUAL:       return negada ? "ne" : "e";
+        case NO_OP_DIFERENTE:   return negada ? "e" : "ne";
+        case NO_OP_MENOR:       return negada ? "ge" : "l";
+        case NO_OP_MENOR_IGUAL: return negada ? "g" : "le";
+        case NO_OP_MAIOR:       return negada ? "le" : "g";
+        default:                return negada ? "l" : "ge";
+    }
+}
+
+static int e_comparacao_x86(TipoNoAST tipo) {
+    return tipo == NO_OP_IGUAL || tipo == NO_OP_DIFERENTE || tipo == NO_OP_MENOR
+        || tipo == NO_OP_MENOR_IGUAL || tipo == NO_OP_MAIOR || tipo == NO_OP_MAIOR_IGUAL;
+}
+
+/**
+ * @brief Desvia para .L<label> quando a condição tem o valor 'desviar_se_verdadeira'.
+ */
+static void gerar_desvio_x86(const NoAST *no, int desviar_se_verdadeira, int label) {
+    int valor;
+    if (constante_x86(no, &valor)) {
+        if ((valor != 0) == desviar_se_verdadeira) emitir_x86("jmp .L%d", label);
+        return;
+    }
+    if (no->tipo_no == NO_OP_NEGACAO) {
+        gerar_desvio_x86(no->filho1, !desviar_se_verdadeira, label);
+        return;
+    }
+    if (no->tipo_no == NO_OP_E || no->tipo_no == NO_OP_OU) {
+        int curto_circuito = no->tipo_no == NO_OP_OU;
+        if (desviar_se_verdadeira == curto_circuito) {
+            gerar_desvio_x86(no->filho1, desviar_se_verdadeira, label);
+            gerar_desvio_x86(no->filho2, desviar_se_verdadeira, label);
+        } else {
+            int segue = contador_labels_x86++;
+            gerar_desvio_x86(no->filho1, curto_circuito, segue);
+            gerar_desvio_x86(no->filho2, desviar_se_verdadeira, label);
+            emitir_label_numerado_x86(segue);
+        }
+        return;
+    }
+    if (e_comparacao_x86(no->tipo_no)) {
+        char direito[256];
+        gerar_operandos_x86(no, direito, sizeof(direito));
+        emitir_x86("cmpl %s, %%eax", direito);
+        emitir_x86("j%s .L%d", condicao_x86(no->tipo_no, !desviar_se_verdadeira), label);
+        return;
+    }
+    gerar_expressao_x86(no);
+    emitir_x86("testl %%eax, %%eax");
+    emitir_x86(desviar_se_verdadeira ? "jne .L%d" : "je .L%d", label);
+}
+
+static void gerar_chamada_x86(const NoAST *no) {
+    int num_argumentos = 0;
+    for (const NoAST *arg = no->filho2; arg != NULL; arg = arg->proximo) {
+        gerar_expressao_x86(arg);
+        emitir_x86("pushq %%rax");
+        num_argumentos++;
+    }
+    emitir_x86("call func_%s", no->filho1->lexema);
+    if (num_argumentos > 0) emitir_x86("addq $%d, %%rsp", 8 * num_argumentos);
+}
+
+/**
+ * @brief Gera o valor da expressão em %eax.
+ */
+static void gerar_expressao_x86(const NoAST *no) {
+    int valor;
+    if (constante_x86(no, &valor)) {
+        if (valor == 0) {
+            emitir_x86("xorl %%eax, %%eax");
+        } else {
+            emitir_x86("movl $%d, %%eax", valor);
+        }
+        return;
+    }
+
+    char direito[256];
+    switch (no->tipo_no) {
+        case NO_ID:
+            carregar_variavel_x86(no->entrada_tabela);
+            break;
+        case NO_CHAMADA_FUNCAO:
+            gerar_chamada_x86(no);
+            break;
+        case NO_COMANDO_ATRIBUICAO:
+            gerar_expressao_x86(no->filho2);
+            armazenar_variavel_x86(no->filho1->entrada_tabela);
+            break;
+        case NO_OP_SOMA:
+            gerar_operandos_x86(no, direito, sizeof(direito));
+            emitir_x86("addl %s, %%eax", direito);
+            break;
+        case NO_OP_SUB:
+            gerar_operandos_x86(no, direito, sizeof(direito));
+            emitir_x86("subl %s, %%eax", direito);
+            break;
+        case NO_OP_MULT:
+            gerar_operandos_x86(no, direito, sizeof(direito));
+            emitir_x86("imull %s, %%eax", direito);
+            break;
+        case NO_OP_DIV:
+            gerar_operandos_x86(no, direito, sizeof(direito));
+            gerar_divisao_x86(direito);
+            break;
+        case NO_OP_IGUAL: case NO_OP_DIFERENTE: case NO_OP_MENOR:
+        case NO_OP_MENOR_IGUAL: case NO_OP_MAIOR: case NO_OP_MAIOR_IGUAL:
+            gerar_operandos_x86(no, direito, sizeof(direito));
+            emitir_x86("cmpl %s, %%eax", direito);
+            emitir_x86("set%s %%al", condicao_x86(no->tipo_no, 0));
+            emitir_x86("movzbl %%al, %%eax");
+            break;
+        case NO_OP_NEGACAO:
+            gerar_expressao_x86(no->filho1);
+            emitir_x86("testl %%eax, %%eax");
+            emitir_x86("sete %%al");
+            emitir_x86("movzbl %%al, %%eax");
+            break;
+        case NO_OP_UNARIO_MENOS:
+            gerar_expressao_x86(no->filho1);
+            emitir_x86("negl %%eax");
+            break;
+        case NO_OP_E:
+        case NO_OP_OU: {
+            int label_falso = contador_labels_x86++;
+            int label_fim = contador_labels_x86++;
+            gerar_desvio_x86(no, 0, label_falso);
+            emitir_x86("movl $1, %%eax");
+            emitir_x86("jmp .L%d", label_fim);
+            emitir_label_numerado_x86(label_falso);
+            emitir_x86("xorl %%eax, %%eax");
+            emitir_label_numerado_x86(label_fim);
+            break;
+        }
+        default:
+            fprintf(stderr, "Erro de geracao x86-64: No de expressao desconhecido (%d)\n", no->tipo_no);
+            break;
+    }
+}
+
+/* ---------- Comandos ---------- */
+
+static void gerar_lista_comandos_x86(const NoAST *no) {
+    for (; no != NULL; no = no->proximo) gerar_comando_x86(no);
+}
+
+static void gerar_comando_x86(const NoAST *no) {
+    switch (no->tipo_no) {
+        case NO_BLOCO:
+            // As posições das declarações já foram calculadas no layout do quadro.
+            gerar_lista_comandos_x86(no->filho2);
+            break;
+
+        case NO_COMANDO_SE: {
+            int label_senao = contador_labels_x86++;
+            gerar_desvio_x86(no->filho1, 0, label_senao);
+            if (no->filho2 != NULL) gerar_comando_x86(no->filho2);
+            if (no->filho3 != NULL) {
+                int label_fim = contador_labels_x86++;
+                emitir_x86("jmp .L%d", label_fim);
+                emitir_label_numerado_x86(label_senao);
+                gerar_comando_x86(no->filho3);
+                emitir_label_numerado_x86(label_fim);
+            } else {
+                emitir_label_numerado_x86(label_senao);
+            }
+            break;
+        }
+
+        case NO_COMANDO_ENQUANTO: {
+            // Teste no fim do laço, como no backend MIPS com rotação de laços.
+            int label_corpo = contador_labels_x86++;
+            int label_teste = contador_labels_x86++;
+            emitir_x86("jmp .L%d", label_teste);
+            emitir_label_numerado_x86(label_corpo);
+            if (no->filho2 != NULL) gerar_comando_x86(no->filho2);
+            emitir_label_numerado_x86(label_teste);
+            gerar_desvio_x86(no->filho1, 1, label_corpo);
+            break;
+        }
+
+        case NO_COMANDO_LEIA: {
+            const EntradaTabela *entrada = no->filho1->entrada_tabela;
+            emitir_x86("call %s", ROTINA_X86_LEIA_INT);
+            // Uma variável 'car' guarda só o byte lido (como o 'sb' do MIPS).
+            if (entrada->tipo == TIPO_CAR && !variavel_em_byte_x86(entrada)) emitir_x86("movsbl %%al, %%eax");
+            armazenar_variavel_x86(entrada);
+            break;
+        }
+
+        case NO_COMANDO_ESCREVA:
+            if (no->filho1->tipo_no == NO_LITERAL_STRING) {
+                emitir_x86("leaq str_%d(%%rip), %%rdi", registrar_string(&strings_x86, no->filho1->lexema));
+                emitir_x86("call %s", ROTINA_X86_ESCREVA_STR);
+            } else {
+                gerar_expressao_x86(no->filho1);
+                emitir_x86("movl %%eax, %%edi");
+                emitir_x86("call %s", no->filho1->tipo_dado_computado == TIPO_CAR ? ROTINA_X86_ESCREVA_CAR
+                                                                                 : ROTINA_X86_ESCREVA_INT);
+            }
+            break;
+
+        case NO_COMANDO_NOVALINHA:
+            emitir_x86("movl $10, %%edi");
+            emitir_x86("call %s", ROTINA_X86_ESCREVA_CAR);
+            break;
+
+        case NO_COMANDO_RETORNE:
+            if (no->filho1 != NULL) gerar_expressao_x86(no->filho1);
+            emitir_x86("jmp ret_%s", nome_funcao_x86);
+            break;
+
+        default:
+            gerar_expressao_x86(no);
+            break;
+    }
+}
+
+/* ---------- Funções e programa ---------- */
+
+/**
+ * @brief Prólogo, corpo e epílogo de uma função ou do bloco 'programa'.
+ * O quadro é arredondado para 16 bytes.
+ */
+static void gerar_corpo_x86(const char *label, const NoAST *declaracoes, const NoAST *comandos) {
+    LayoutQuadro layout;
+    calcular_layout_quadro(declaracoes, comandos, 0, &layout);
+    aplicar_layout_quadro(&layout);
+    int tamanho = (layout.tamanho + 15) & ~15;
+    liberar_layout_quadro(&layout);
+
+    adicionar_label(&codigo_x86, label);
+    emitir_x86("pushq %%rbp");
+    emitir_x86("movq %%rsp, %%rbp");
+    if (tamanho > 0) emitir_x86("subq $%d, %%rsp", tamanho);
+    gerar_lista_comandos_x86(comandos);
+    if (nome_funcao_x86 != NULL) {
+        char label_retorno[256];
+        // Sem 'retorne', a função devolve 0.
+        emitir_x86("xorl %%eax, %%eax");
+        snprintf(label_retorno, sizeof(label_retorno), "ret_%s", nome_funcao_x86);
+        adicionar_label(&codigo_x86, label_retorno);
+    }
+    emitir_x86("leave");
+    emitir_x86("ret");
+}
+
+/**
+ * @brief Troca o '.asciiz' do pool de strings pelo equivalente do GNU as (.asciz).
+ */
+static void traduzir_strings_x86(ListaInstrucoes *lista) {
+    for (int i = 0; i < lista->tamanho; i++) {
+        InstrucaoMIPS *linha = &lista->itens[i];
+        if (linha->tipo != LINHA_DIRETIVA || strncmp(linha->texto, ".asciiz ", 8) != 0) continue;
+        memmove(linha->texto + 5, linha->texto + 6, strlen(linha->texto + 6) + 1);
+    }
+}
+
+void gerar_codigo_x86(NoAST *raiz, const char *nome_arquivo_saida, const OpcoesGeracao *opcoes) {
+    FILE *arquivo = fopen(nome_arquivo_saida, "w");
+    if (arquivo == NULL) {
+        perror("Erro ao abrir arquivo de saida x86-64");
+        exit(EXIT_FAILURE);
+    }
+    iniciar_lista_instrucoes(&codigo_x86);
+    iniciar_tabela_strings(&strings_x86);
+    contador_labels_x86 = 0;
+
+    int num_alcancaveis = 0;
+    char *alcancaveis = NULL;
+    if (opcoes != NULL && opcoes->apenas_alcancaveis) alcancaveis = marcar_funcoes_alcancaveis(raiz, &num_alcancaveis);
+
+    adicionar_diretiva(&codigo_x86, ".bss");
+    adicionar_diretiva(&codigo_x86, ".align 4");
+    int num_globais = 0;
+    char label[256];
+    for (NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_VARIAVEL) continue;
+        EntradaTabela *entrada = decl->filho1->entrada_tabela;
+        entrada->endereco_global = 4 * num_globais++;
+        snprintf(label, sizeof(label), "glob_%s", entrada->lexema);
+        adicionar_label(&codigo_x86, label);
+        adicionar_diretiva(&codigo_x86, ".zero 4");
+    }
+    adicionar_diretiva(&codigo_x86, ".text");
+
+    int indice = 0, funcoes_geradas = 0;
+    for (NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        if (alcancaveis != NULL && !alcancaveis[indice++]) continue;
+        nome_funcao_x86 = decl->filho1->lexema;
+        num_parametros_x86 = 0;
+        for (const NoAST *param = decl->filho2; param != NULL; param = param->proximo) {
+            if (param->tipo_no == NO_PARAMETRO) num_parametros_x86++;
+        }
+        snprintf(label, sizeof(label), "func_%s", nome_funcao_x86);
+        adicionar_comentario(&codigo_x86, label);
+        gerar_corpo_x86(label, decl->filho3->filho1, decl->filho3->filho2);
+        funcoes_geradas++;
+    }
+    free(alcancaveis);
+
+    adicionar_comentario(&codigo_x86, "--- Programa Principal ---");
+    nome_funcao_x86 = NULL;
+    num_parametros_x86 = 0;
+    gerar_corpo_x86(LABEL_PRINCIPAL_X86, raiz->filho3, raiz->filho2);
+    emitir_runtime_x86(&codigo_x86, LABEL_PRINCIPAL_X86);
+
+    ListaInstrucoes codigo_strings;
+    iniciar_lista_instrucoes(&codigo_strings);
+    emitir_tabela_strings(&strings_x86, &codigo_strings);
+    traduzir_strings_x86(&codigo_strings);
+    anexar_lista_instrucoes(&codigo_x86, &codigo_strings);
+    liberar_tabela_strings(&strings_x86);
+
+    printf("x86-64: %d funcao(oes) e %d global(is) geradas.\n", funcoes_geradas, num_globais);
+    imprimir_lista_instrucoes(arquivo, &codigo_x86);
+    liberar_lista_instrucoes(&codigo_x86);
+    fclose(arquivo);
+}
@@ -0,0 +1,24 @@
+#ifndef GERADOR_X86_H
+#define GERADOR_X86_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+#include "modulo_gerador_codigo.h"
+
+/*
+ * Backend x86-64 (--target=x86_64): gera assembly GNU (sintaxe AT&T) para
+ * Linux, montado e ligado sem libc. Segue a mesma estrutura do gerador MIPS
+ * (acumulador em %eax, temporários na pilha, argumentos empilhados da
+ * esquerda para a direita e locais nas posições do layout do quadro); as
+ * otimizações específicas do MIPS (peephole, despacho, laços, inline e
+ * especialização) não se aplicam, exceto a dobra de constantes.
+ */
+
+/**
+ * @brief Gera o assembly x86-64 do programa.
+ * @param raiz O nó raiz da AST (já validada semanticamente).
+ * @param nome_arquivo_saida Arquivo onde o assembly será escrito.
+ * @param opcoes Opções de geração (só 'apenas_alcancaveis' é usada; NULL usa os padrões).
+ */
+void gerar_codigo_x86(NoAST *raiz, const char *nome_arquivo_saida, const OpcoesGeracao *opcoes);
+
+#endif
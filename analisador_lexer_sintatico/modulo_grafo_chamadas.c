@@ -0,0 +1,271 @@
+#include "modulo_grafo_chamadas.h"
+#include <stdint.h>
+
+static void *alocar(size_t tamanho) {
+    void *memoria = calloc(1, tamanho > 0 ? tamanho : 1);
+    if (memoria == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o grafo de chamadas.\n");
+        exit(EXIT_FAILURE);
+    }
+    return memoria;
+}
+
+int contar_nos_ast(const NoAST *no) {
+    int total = 0;
+    for (; no != NULL; no = no->proximo) {
+        total += 1 + contar_nos_ast(no->filho1) + contar_nos_ast(no->filho2) + contar_nos_ast(no->filho3);
+    }
+    return total;
+}
+
+/* ---------- Índice entrada -> função ---------- */
+
+static unsigned espalhar(const EntradaTabela *entrada, int capacidade) {
+    uintptr_t valor = (uintptr_t)entrada;
+    valor ^= valor >> 17;
+    valor *= 0x9E3779B1u;
+    return (unsigned)(valor ^ (valor >> 13)) & (unsigned)(capacidade - 1);
+}
+
+static void indexar_funcoes(GrafoChamadas *grafo) {
+    grafo->capacidade_indice = 16;
+    while (grafo->capacidade_indice < 2 * grafo->num_funcoes) grafo->capacidade_indice *= 2;
+    grafo->indice = alocar(grafo->capacidade_indice * sizeof(int));
+    for (int i = 0; i < grafo->num_funcoes; i++) {
+        unsigned h = espalhar(grafo->funcoes[i].entrada, grafo->capacidade_indice);
+        while (grafo->indice[h] != 0) h = (h + 1) & (grafo->capacidade_indice - 1);
+        grafo->indice[h] = i + 1;
+    }
+}
+
+FuncaoGrafo *buscar_funcao_grafo(const GrafoChamadas *grafo, const EntradaTabela *entrada) {
+    if (entrada == NULL || grafo->indice == NULL) return NULL;
+    unsigned h = espalhar(entrada, grafo->capacidade_indice);
+    while (grafo->indice[h] != 0) {
+        FuncaoGrafo *funcao = &grafo->funcoes[grafo->indice[h] - 1];
+        if (funcao->entrada == entrada) return funcao;
+        h = (h + 1) & (grafo->capacidade_indice - 1);
+    }
+    return NULL;
+}
+
+/* ---------- Arestas ---------- */
+
+/**
+ * @brief Acrescenta as funções chamadas em 'no' a 'destino' (sem repetição)
+ * e conta as chamadas recebidas por cada uma.
+ */
+static void coletar_chamadas(const GrafoChamadas *grafo, const NoAST *no, int **destino, int *num, int *capacidade) {
+    for (; no != NULL; no = no->proximo) {
+        if (no->tipo_no == NO_CHAMADA_FUNCAO) {
+            FuncaoGrafo *chamada = buscar_funcao_grafo(grafo, no->filho1->entrada_tabela);
+            if (chamada != NULL) {
+                int indice = (int)(chamada - grafo->funcoes);
+                chamada->num_chamadas_recebidas++;
+                int repetida = 0;
+                for (int i = 0; i < *num && !repetida; i++) repetida = (*destino)[i] == indice;
+                if (!repetida) {
+                    if (*num == *capacidade) {
+                        *capacidade = *capacidade == 0 ? 4 : *capacidade * 2;
+                        int *novas = realloc(*destino, *capacidade * sizeof(int));
+                        if (novas == NULL) {
+                            fprintf(stderr, "Erro critico: Falha ao alocar memoria para o grafo de chamadas.\n");
+                            exit(EXIT_FAILURE);
+                        }
+                        *destino = novas;
+                    }
+                    (*destino)[(*num)++] = indice;
+                }
+            }
+        }
+        coletar_chamadas(grafo, no->filho1, destino, num, capacidade);
+        coletar_chamadas(grafo, no->filho2, destino, num, capacidade);
+        coletar_chamadas(grafo, no->filho3, destino, num, capacidade);
+    }
+}
+
+/* ---------- Alcançabilidade (pelo nome, antes da análise semântica) ---------- */
+
+typedef struct IndiceNomes {
+    const NoAST **declaracoes;  // Funções na ordem de declaração
+    int capacidade;
+    int *posicoes;              // Índice da função + 1 (0 = posição vazia)
+} IndiceNomes;
+
+static unsigned espalhar_nome(const char *nome, int capacidade) {
+    unsigned valor = 2166136261u;
+    for (; *nome != '\0'; nome++) valor = (valor ^ (unsigned char)*nome) * 16777619u;
+    return valor & (unsigned)(capacidade - 1);
+}
+
+/**
+ * @brief Marca as funções chamadas em 'no' (todas as de mesmo nome, se houver
+ * redeclaração) e as empilha para serem visitadas.
+ */
+static void marcar_chamadas_por_nome(const IndiceNomes *nomes, const NoAST *no, char *alcancavel,
+                                     int *pendentes, int *num_pendentes) {
+    for (; no != NULL; no = no->proximo) {
+        if (no->tipo_no == NO_CHAMADA_FUNCAO) {
+            const char *nome = no->filho1->lexema;
+            unsigned h = espalhar_nome(nome, nomes->capacidade);
+            while (nomes->posicoes[h] != 0) {
+                int indice = nomes->posicoes[h] - 1;
+                if (!alcancavel[indice] && strcmp(nomes->declaracoes[indice]->filho1->lexema, nome) == 0) {
+                    alcancavel[indice] = 1;
+                    pendentes[(*num_pendentes)++] = indice;
+                }
+                h = (h + 1) & (unsigned)(nomes->capacidade - 1);
+            }
+        }
+        marcar_chamadas_por_nome(nomes, no->filho1, alcancavel, pendentes, num_pendentes);
+        marcar_chamadas_por_nome(nomes, no->filho2, alcancavel, pendentes, num_pendentes);
+        marcar_chamadas_por_nome(nomes, no->filho3, alcancavel, pendentes, num_pendentes);
+    }
+}
+
+char *marcar_funcoes_alcancaveis(const NoAST *raiz, int *num_alcancaveis) {
+    int num_funcoes = 0;
+    *num_alcancaveis = 0;
+    if (raiz == NULL || raiz->tipo_no != NO_PROGRAMA) return alocar(1);
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_FUNCAO) num_funcoes++;
+    }
+
+    IndiceNomes nomes;
+    nomes.declaracoes = alocar(num_funcoes * sizeof(NoAST *));
+    nomes.capacidade = 16;
+    while (nomes.capacidade < 2 * num_funcoes) nomes.capacidade *= 2;
+    nomes.posicoes = alocar(nomes.capacidade * sizeof(int));
+    int n = 0;
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        nomes.declaracoes[n] = decl;
+        unsigned h = espalhar_nome(decl->filho1->lexema, nomes.capacidade);
+        while (nomes.posicoes[h] != 0) h = (h + 1) & (unsigned)(nomes.capacidade - 1);
+        nomes.posicoes[h] = ++n;
+    }
+
+    // Cada função entra uma única vez na pilha de pendentes (ao ser marcada).
+    char *alcancavel = alocar(num_funcoes);
+    int *pendentes = alocar(num_funcoes * sizeof(int));
+    int num_pendentes = 0;
+    marcar_chamadas_por_nome(&nomes, raiz->filho2, alcancavel, pendentes, &num_pendentes);
+    while (num_pendentes > 0) {
+        const NoAST *decl = nomes.declaracoes[pendentes[--num_pendentes]];
+        (*num_alcancaveis)++;
+        marcar_chamadas_por_nome(&nomes, decl->filho3, alcancavel, pendentes, &num_pendentes);
+    }
+
+    free(pendentes);
+    free(nomes.declaracoes);
+    free(nomes.posicoes);
+    return alcancavel;
+}
+
+/* ---------- Recursão (componentes fortemente conexos, Tarjan) ---------- */
+
+typedef struct EstadoTarjan {
+    const GrafoChamadas *grafo;
+    int *ordem;
+    int *menor;
+    int *na_pilha;
+    int *pilha;
+    int topo;
+    int contador;
+} EstadoTarjan;
+
+static void visitar_tarjan(EstadoTarjan *estado, int v) {
+    FuncaoGrafo *funcao = &estado->grafo->funcoes[v];
+    estado->ordem[v] = estado->menor[v] = ++estado->contador;
+    estado->pilha[estado->topo++] = v;
+    estado->na_pilha[v] = 1;
+
+    for (int i = 0; i < funcao->num_chamadas; i++) {
+        int w = funcao->chamadas[i];
+        if (w == v) funcao->recursiva = 1;
+        if (estado->ordem[w] == 0) {
+            visitar_tarjan(estado, w);
+            if (estado->menor[w] < estado->menor[v]) estado->menor[v] = estado->menor[w];
+        } else if (estado->na_pilha[w] && estado->ordem[w] < estado->menor[v]) {
+            estado->menor[v] = estado->ordem[w];
+        }
+    }
+
+    if (estado->menor[v] == estado->ordem[v]) {
+        int base = estado->topo;
+        do { base--; } while (estado->pilha[base] != v);
+        int tamanho = estado->topo - base;
+        for (int i = base; i < estado->topo; i++) {
+            int w = estado->pilha[i];
+            estado->na_pilha[w] = 0;
+            if (tamanho > 1) estado->grafo->funcoes[w].recursiva = 1;
+        }
+        estado->topo = base;
+    }
+}
+
+static void marcar_recursivas(const GrafoChamadas *grafo) {
+    int n = grafo->num_funcoes;
+    EstadoTarjan estado;
+    estado.grafo = grafo;
+    estado.ordem = alocar(n * sizeof(int));
+    estado.menor = alocar(n * sizeof(int));
+    estado.na_pilha = alocar(n * sizeof(int));
+    estado.pilha = alocar(n * sizeof(int));
+    estado.topo = 0;
+    estado.contador = 0;
+    for (int v = 0; v < n; v++) {
+        if (estado.ordem[v] == 0) visitar_tarjan(&estado, v);
+    }
+    free(estado.ordem);
+    free(estado.menor);
+    free(estado.na_pilha);
+    free(estado.pilha);
+}
+
+void construir_grafo_chamadas(NoAST *raiz, GrafoChamadas *grafo) {
+    grafo->num_funcoes = 0;
+    grafo->funcoes = NULL;
+    grafo->num_chamadas_programa = 0;
+    grafo->chamadas_programa = NULL;
+    grafo->capacidade_indice = 0;
+    grafo->indice = NULL;
+    if (raiz == NULL || raiz->tipo_no != NO_PROGRAMA) return;
+
+    for (NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_FUNCAO) grafo->num_funcoes++;
+    }
+    grafo->funcoes = alocar(grafo->num_funcoes * sizeof(FuncaoGrafo));
+    int n = 0;
+    for (NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        FuncaoGrafo *funcao = &grafo->funcoes[n++];
+        funcao->declaracao = decl;
+        funcao->entrada = decl->filho1->entrada_tabela;
+        funcao->tamanho = contar_nos_ast(decl->filho3);
+    }
+    indexar_funcoes(grafo);
+
+    for (int i = 0; i < grafo->num_funcoes; i++) {
+        FuncaoGrafo *funcao = &grafo->funcoes[i];
+        int capacidade = 0;
+        coletar_chamadas(grafo, funcao->declaracao->filho3, &funcao->chamadas, &funcao->num_chamadas, &capacidade);
+    }
+    int capacidade = 0;
+    coletar_chamadas(grafo, raiz->filho2, &grafo->chamadas_programa, &grafo->num_chamadas_programa, &capacidade);
+
+    marcar_recursivas(grafo);
+}
+
+void liberar_grafo_chamadas(GrafoChamadas *grafo) {
+    for (int i = 0; i < grafo->num_funcoes; i++) free(grafo->funcoes[i].chamadas);
+    free(grafo->funcoes);
+    free(grafo->chamadas_programa);
+    grafo->funcoes = NULL;
+    grafo->chamadas_programa = NULL;
+    grafo->num_funcoes = 0;
+    grafo->num_chamadas_programa = 0;
+    free(grafo->indice);
+    grafo->indice = NULL;
+    grafo->capacidade_indice = 0;
+}
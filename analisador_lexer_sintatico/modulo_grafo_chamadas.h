@@ -0,0 +1,63 @@
+#ifndef GRAFO_CHAMADAS_H
+#define GRAFO_CHAMADAS_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+
+/**
+ * @brief Uma função declarada no programa e as funções que ela chama.
+ */
+typedef struct FuncaoGrafo {
+    NoAST *declaracao;          // Nó NO_DECL_FUNCAO
+    EntradaTabela *entrada;     // Entrada da função na tabela de símbolos
+    int tamanho;                // Número de nós da AST do corpo
+    int num_chamadas_recebidas; // Chamadas a esta função no programa inteiro
+    int num_chamadas;           // Funções distintas chamadas por esta
+    int *chamadas;              // Índices (em 'funcoes') das funções chamadas
+    int recursiva;              // Pode chamar a si mesma, direta ou indiretamente
+} FuncaoGrafo;
+
+/**
+ * @brief Grafo de chamadas entre as funções do programa.
+ */
+typedef struct GrafoChamadas {
+    int num_funcoes;
+    FuncaoGrafo *funcoes;       // Na ordem de declaração
+    int num_chamadas_programa;
+    int *chamadas_programa;     // Funções chamadas diretamente pelo bloco 'programa'
+    int capacidade_indice;      // Tabela de espalhamento entrada -> função
+    int *indice;                // Índice da função + 1 (0 = posição vazia)
+} GrafoChamadas;
+
+/**
+ * @brief Constrói o grafo de chamadas a partir do nó NO_PROGRAMA.
+ * A AST já deve ter passado pela análise semântica (chamadas resolvidas).
+ */
+void construir_grafo_chamadas(NoAST *raiz, GrafoChamadas *grafo);
+
+/**
+ * @brief Procura a função pela sua entrada na tabela de símbolos.
+ * @return A função, ou NULL se ela não foi declarada no programa.
+ */
+FuncaoGrafo *buscar_funcao_grafo(const GrafoChamadas *grafo, const EntradaTabela *entrada);
+
+/**
+ * @brief Libera a memória do grafo.
+ */
+void liberar_grafo_chamadas(GrafoChamadas *grafo);
+
+/**
+ * @brief Marca as funções alcançáveis a partir do bloco 'programa'.
+ * As chamadas são resolvidas pelo nome, e por isso a marcação pode ser feita
+ * antes da análise semântica.
+ * @param num_alcancaveis Recebe o número de funções alcançáveis.
+ * @return Vetor (a ser liberado com free) com 1 para cada função alcançável,
+ * na ordem de declaração.
+ */
+char *marcar_funcoes_alcancaveis(const NoAST *raiz, int *num_alcancaveis);
+
+/**
+ * @brief Conta os nós de uma lista de nós da AST (e de suas subárvores).
+ */
+int contar_nos_ast(const NoAST *no);
+
+#endif
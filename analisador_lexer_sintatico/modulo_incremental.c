@@ -0,0 +1,619 @@
+#include "modulo_incremental.h"
+#include "modulo_cache_compilacao.h"
+#include "modulo_sha256.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CABECALHO_ESTADO "goianinha-incremental 1"
+#define SUFIXO_ESTADO ".inc"
+#define PREFIXO_TEMPORARIO ".tmp-"
+
+/**
+ * @brief Uma unidade do programa atual e o que se sabe dela.
+ */
+typedef struct UnidadeIncremental {
+    char *nome;                     // "func_<nome>" ou "main" (o prefixo dos labels)
+    char chave[65];                 // SHA-256 de tudo de que o código da unidade depende
+    int *chamadas;                  // Funções chamadas (índices de declaração, sem repetição)
+    int num_chamadas;
+    FragmentoIncremental *guardado; // Código da compilação anterior com a mesma chave (ou NULL)
+    FragmentoIncremental novo;      // Código gerado nesta compilação
+    int gerada;
+} UnidadeIncremental;
+
+/**
+ * @brief Uma unidade lida do arquivo de estado.
+ */
+typedef struct RegistroIncremental {
+    char *nome;
+    char chave[65];
+    FragmentoIncremental fragmento;
+    int usado;
+} RegistroIncremental;
+
+struct EstadoIncremental {
+    char diretorio[PATH_MAX];
+    char caminho[PATH_MAX + 80];
+    char ambiente[65];              // Compilador, opções e globais
+    int num_funcoes;
+    UnidadeIncremental *unidades;   // As funções, na ordem de declaração, e o programa por último
+    RegistroIncremental *registros;
+    int num_registros;
+};
+
+static void *alocar(size_t tamanho) {
+    void *memoria = calloc(1, tamanho > 0 ? tamanho : 1);
+    if (memoria == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a compilacao incremental.\n");
+        exit(EXIT_FAILURE);
+    }
+    return memoria;
+}
+
+static char *ler_arquivo(const char *caminho, size_t *tamanho) {
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) return NULL;
+    size_t capacidade = 4096, n = 0, lidos;
+    char *dados = alocar(capacidade + 1);
+    while ((lidos = fread(dados + n, 1, capacidade - n, arquivo)) > 0) {
+        n += lidos;
+        if (n == capacidade) {
+            char *novos = realloc(dados, (capacidade *= 2) + 1);
+            if (novos == NULL) {
+                fprintf(stderr, "Erro critico: Falha ao alocar memoria para a compilacao incremental.\n");
+                exit(EXIT_FAILURE);
+            }
+            dados = novos;
+        }
+    }
+    fclose(arquivo);
+    dados[n] = '\0';
+    *tamanho = n;
+    return dados;
+}
+
+static UnidadeIncremental *unidade_do_indice(const EstadoIncremental *estado, int unidade) {
+    return &estado->unidades[unidade == UNIDADE_PRINCIPAL ? estado->num_funcoes : unidade];
+}
+
+static void liberar_fragmento(FragmentoIncremental *fragmento) {
+    free(fragmento->texto);
+    liberar_tabela_strings(&fragmento->strings);
+}
+
+// ---------------------------------------------------------------------------
+// Impressões digitais
+// ---------------------------------------------------------------------------
+
+static void resumir_lista(Sha256 *sha, const NoAST *no);
+
+/**
+ * @brief Acrescenta ao resumo a subárvore de 'no' (sem os irmãos). Os números
+ * de linha ficam de fora: mover uma função no fonte não muda o seu código.
+ */
+static void resumir_no(Sha256 *sha, const NoAST *no) {
+    int campos[4] = { (int)no->tipo_no, (int)no->tipo_dado_computado, no->ival, (int)no->cval };
+    atualizar_sha(sha, "(", 1);
+    atualizar_sha(sha, campos, sizeof(campos));
+    if (no->lexema != NULL) {
+        atualizar_sha(sha, "s", 1);
+        atualizar_campo_sha(sha, no->lexema, strlen(no->lexema));
+    } else {
+        atualizar_sha(sha, "-", 1);
+    }
+    resumir_lista(sha, no->filho1);
+    resumir_lista(sha, no->filho2);
+    resumir_lista(sha, no->filho3);
+}
+
+static void resumir_lista(Sha256 *sha, const NoAST *no) {
+    for (; no != NULL; no = no->proximo) resumir_no(sha, no);
+    atualizar_sha(sha, ")", 1);
+}
+
+static void resumir_inteiro(Sha256 *sha, long long valor) {
+    atualizar_sha(sha, &valor, sizeof(valor));
+}
+
+/**
+ * @brief Resumo do que vale para todas as unidades: o compilador, as opções
+ * de geração e as variáveis globais (os endereços seguem a ordem delas).
+ */
+static void calcular_ambiente(EstadoIncremental *estado, const NoAST *raiz, const OpcoesGeracao *opcoes) {
+    Sha256 sha;
+    iniciar_sha(&sha);
+    atualizar_campo_sha(&sha, VERSAO_COMPILADOR, strlen(VERSAO_COMPILADOR));
+    atualizar_campo_sha(&sha, resumo_executavel(), strlen(resumo_executavel()));
+
+    // 'apenas_alcancaveis' só decide quais unidades são geradas, não o código delas.
+    long long valores[] = {
+        opcoes->otimizar_peephole, opcoes->otimizar_despacho, opcoes->reduzir_forca,
+        opcoes->mover_invariantes, opcoes->rotacionar_lacos, opcoes->reduzir_inducao,
+        opcoes->desenrolar_lacos, opcoes->expandir_chamadas, opcoes->orcamento_inline,
+        opcoes->especializar_funcoes, opcoes->crescimento_especializacao, opcoes->saida_bufferizada,
+        opcoes->instrumentar, opcoes->avaliar_em_compilacao, opcoes->passos_avaliacao,
+        opcoes->memoria_avaliacao,
+    };
+    for (size_t i = 0; i < sizeof(valores) / sizeof(valores[0]); i++) resumir_inteiro(&sha, valores[i]);
+
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_VARIAVEL) continue;
+        resumir_inteiro(&sha, decl->tipo_dado_computado);
+        atualizar_campo_sha(&sha, decl->filho1->lexema, strlen(decl->filho1->lexema));
+    }
+    finalizar_sha(&sha, estado->ambiente);
+}
+
+// ---------------------------------------------------------------------------
+// Chamadas entre unidades (pelo nome, antes da análise semântica)
+// ---------------------------------------------------------------------------
+
+typedef struct IndiceFuncoes {
+    const NoAST **declaracoes;
+    int capacidade;
+    int *posicoes;              // Índice da função + 1 (0 = posição vazia)
+    int *visita;                // Última unidade que registrou a chamada à função
+} IndiceFuncoes;
+
+static unsigned espalhar_nome(const char *nome, int capacidade) {
+    unsigned valor = 2166136261u;
+    for (; *nome != '\0'; nome++) valor = (valor ^ (unsigned char)*nome) * 16777619u;
+    return valor & (unsigned)(capacidade - 1);
+}
+
+/**
+ * @brief A primeira função declarada com o nome (-1 se não há nenhuma).
+ */
+static int buscar_funcao(const IndiceFuncoes *indice, const char *nome) {
+    unsigned h = espalhar_nome(nome, indice->capacidade);
+    while (indice->posicoes[h] != 0) {
+        int i = indice->posicoes[h] - 1;
+        if (strcmp(indice->declaracoes[i]->filho1->lexema, nome) == 0) return i;
+        h = (h + 1) & (unsigned)(indice->capacidade - 1);
+    }
+    return -1;
+}
+
+/**
+ * @brief Acrescenta ao resumo da unidade a assinatura de cada função chamada
+ * (na ordem da primeira chamada) e guarda os índices delas em 'unidade'.
+ * A análise semântica só aceita chamadas a funções declaradas antes (ou à
+ * própria função): o resumo também diz se a chamada está declarada antes da
+ * unidade, cuja posição é 'visita - 1'.
+ */
+static void resumir_chamadas(Sha256 *sha, IndiceFuncoes *indice, const NoAST *no, int visita,
+                             UnidadeIncremental *unidade, int *capacidade) {
+    for (; no != NULL; no = no->proximo) {
+        if (no->tipo_no == NO_CHAMADA_FUNCAO) {
+            const char *nome = no->filho1->lexema;
+            int funcao = buscar_funcao(indice, nome);
+            if (funcao < 0) {
+                atualizar_campo_sha(sha, nome, strlen(nome));
+                atualizar_sha(sha, "?", 1);
+            } else if (indice->visita[funcao] != visita) {
+                indice->visita[funcao] = visita;
+                const NoAST *decl = indice->declaracoes[funcao];
+                atualizar_campo_sha(sha, nome, strlen(nome));
+                resumir_inteiro(sha, funcao <= visita - 1);
+                resumir_inteiro(sha, decl->tipo_dado_computado);
+                int num_parametros = 0;
+                for (const NoAST *p = decl->filho2; p != NULL; p = p->proximo) num_parametros++;
+                resumir_inteiro(sha, num_parametros);
+                for (const NoAST *p = decl->filho2; p != NULL; p = p->proximo) {
+                    resumir_inteiro(sha, p->tipo_dado_computado);
+                }
+                if (unidade->num_chamadas == *capacidade) {
+                    *capacidade = *capacidade == 0 ? 4 : *capacidade * 2;
+                    int *novas = realloc(unidade->chamadas, *capacidade * sizeof(int));
+                    if (novas == NULL) {
+                        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a compilacao incremental.\n");
+                        exit(EXIT_FAILURE);
+                    }
+                    unidade->chamadas = novas;
+                }
+                unidade->chamadas[unidade->num_chamadas++] = funcao;
+            }
+        }
+        resumir_chamadas(sha, indice, no->filho1, visita, unidade, capacidade);
+        resumir_chamadas(sha, indice, no->filho2, visita, unidade, capacidade);
+        resumir_chamadas(sha, indice, no->filho3, visita, unidade, capacidade);
+    }
+}
+
+/**
+ * @brief Chave da unidade: ambiente, a própria declaração, as assinaturas
+ * das funções que ela chama e quantas globais são declaradas antes dela
+ * (as primeiras 'globais_antes' da ordem resumida em calcular_ambiente são
+ * as que ela enxerga).
+ */
+static void calcular_chave_unidade(const EstadoIncremental *estado, IndiceFuncoes *indice, int visita,
+                                   int globais_antes, const NoAST *codigo, const NoAST *locais,
+                                   UnidadeIncremental *unidade) {
+    Sha256 sha;
+    int capacidade = 0;
+    iniciar_sha(&sha);
+    atualizar_sha(&sha, estado->ambiente, 64);
+    atualizar_campo_sha(&sha, unidade->nome, strlen(unidade->nome));
+    resumir_inteiro(&sha, globais_antes);
+    if (locais == NULL) {
+        resumir_no(&sha, codigo);
+    } else {
+        resumir_lista(&sha, codigo);
+        resumir_lista(&sha, locais);
+    }
+    if (locais == NULL) {
+        // Só o corpo da função, sem as declarações seguintes ('proximo').
+        resumir_chamadas(&sha, indice, codigo->filho2, visita, unidade, &capacidade);
+        resumir_chamadas(&sha, indice, codigo->filho3, visita, unidade, &capacidade);
+    } else {
+        resumir_chamadas(&sha, indice, codigo, visita, unidade, &capacidade);
+        resumir_chamadas(&sha, indice, locais, visita, unidade, &capacidade);
+    }
+    finalizar_sha(&sha, unidade->chave);
+}
+
+// ---------------------------------------------------------------------------
+// Arquivo de estado
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Lê a próxima linha do arquivo (o '\n' vira '\0').
+ * @return A linha, ou NULL no fim dos dados.
+ */
+static char *proxima_linha(char **cursor, char *fim) {
+    char *inicio = *cursor;
+    if (inicio >= fim) return NULL;
+    char *quebra = memchr(inicio, '\n', (size_t)(fim - inicio));
+    if (quebra == NULL) return NULL;
+    *quebra = '\0';
+    *cursor = quebra + 1;
+    return inicio;
+}
+
+/**
+ * @brief Copia os próximos 'tamanho' bytes, que devem ser seguidos de '\n'.
+ */
+static char *proximo_bloco(char **cursor, char *fim, long tamanho) {
+    if (tamanho < 0 || fim - *cursor < tamanho + 1 || (*cursor)[tamanho] != '\n') return NULL;
+    char *copia = alocar((size_t)tamanho + 1);
+    memcpy(copia, *cursor, (size_t)tamanho);
+    *cursor += tamanho + 1;
+    return copia;
+}
+
+/**
+ * @brief Lê um registro de unidade.
+ * @return 1 se o registro está completo.
+ */
+static int ler_registro(char **cursor, char *fim, RegistroIncremental *registro) {
+    FragmentoIncremental *fragmento = &registro->fragmento;
+    iniciar_tabela_strings(&fragmento->strings);
+    char chave[65];
+    int num_strings, num_usos, bytes_usos;
+    long bytes_texto;
+    char *linha = proxima_linha(cursor, fim);
+    char *espaco = linha != NULL ? strchr(linha, ' ') : NULL;
+    if (espaco == NULL
+        || sscanf(espaco, " %64s %d %d %d %ld", chave, &num_strings, &num_usos, &bytes_usos, &bytes_texto) != 5
+        || strlen(chave) != 64 || num_strings < 0) {
+        return 0;
+    }
+    registro->nome = alocar((size_t)(espaco - linha) + 1);
+    memcpy(registro->nome, linha, (size_t)(espaco - linha));
+    memcpy(registro->chave, chave, sizeof(chave));
+
+    RuntimeES *runtime = &fragmento->runtime;
+    linha = proxima_linha(cursor, fim);
+    for (int i = 0; i < NUM_ROTINAS_ES; i++) {
+        int lidos = 0;
+        if (linha == NULL || sscanf(linha, "%d%n", &runtime->chamadas[i], &lidos) != 1) return 0;
+        linha += lidos;
+    }
+
+    EstatisticasPeephole *peephole = &fragmento->peephole;
+    linha = proxima_linha(cursor, fim);
+    int lidos = 0;
+    if (linha == NULL
+        || sscanf(linha, "%d %d %d%n", &peephole->passadas, &peephole->instrucoes_antes,
+                  &peephole->instrucoes_depois, &lidos) != 3) {
+        return 0;
+    }
+    linha += lidos;
+    for (int i = 0; i < NUM_REGRAS_PEEPHOLE; i++) {
+        if (sscanf(linha, "%d%n", &peephole->aplicacoes[i], &lidos) != 1) return 0;
+        linha += lidos;
+    }
+
+    for (int i = 0; i < num_strings; i++) {
+        long tamanho;
+        linha = proxima_linha(cursor, fim);
+        if (linha == NULL || sscanf(linha, "%ld", &tamanho) != 1) return 0;
+        char *texto = proximo_bloco(cursor, fim, tamanho);
+        if (texto == NULL) return 0;
+        registrar_string(&fragmento->strings, texto);
+        free(texto);
+    }
+    fragmento->strings.num_usos = num_usos;
+    fragmento->strings.bytes_usos = bytes_usos;
+
+    fragmento->texto = proximo_bloco(cursor, fim, bytes_texto);
+    return fragmento->texto != NULL;
+}
+
+static void liberar_registros(EstadoIncremental *estado) {
+    for (int i = 0; i < estado->num_registros; i++) {
+        free(estado->registros[i].nome);
+        liberar_fragmento(&estado->registros[i].fragmento);
+    }
+    free(estado->registros);
+    estado->registros = NULL;
+    estado->num_registros = 0;
+}
+
+/**
+ * @brief Lê o estado da compilação anterior. Um arquivo de outro compilador,
+ * com outras opções ou outras globais (ou danificado) é ignorado por inteiro.
+ */
+static void ler_estado(EstadoIncremental *estado) {
+    size_t tamanho;
+    char *dados = ler_arquivo(estado->caminho, &tamanho);
+    if (dados == NULL) return;
+    char *cursor = dados, *fim = dados + tamanho;
+    char *cabecalho = proxima_linha(&cursor, fim);
+    char *ambiente = proxima_linha(&cursor, fim);
+    char *contagem = proxima_linha(&cursor, fim);
+    int num_registros;
+    if (cabecalho == NULL || ambiente == NULL || contagem == NULL
+        || strcmp(cabecalho, CABECALHO_ESTADO) != 0 || strcmp(ambiente, estado->ambiente) != 0
+        || sscanf(contagem, "%d", &num_registros) != 1 || num_registros < 0
+        || (size_t)num_registros > tamanho) {
+        free(dados);
+        return;
+    }
+    estado->registros = alocar(num_registros * sizeof(RegistroIncremental));
+    for (int i = 0; i < num_registros; i++) {
+        estado->num_registros++;
+        if (!ler_registro(&cursor, fim, &estado->registros[i])) {
+            liberar_registros(estado);
+            break;
+        }
+    }
+    free(dados);
+}
+
+/**
+ * @brief Associa a cada unidade o registro de mesmo nome, se a chave é a mesma.
+ */
+static void associar_registros(EstadoIncremental *estado) {
+    int capacidade = 16;
+    while (capacidade < 2 * estado->num_registros) capacidade *= 2;
+    int *posicoes = alocar(capacidade * sizeof(int));
+    for (int i = 0; i < estado->num_registros; i++) {
+        unsigned h = espalhar_nome(estado->registros[i].nome, capacidade);
+        while (posicoes[h] != 0) h = (h + 1) & (unsigned)(capacidade - 1);
+        posicoes[h] = i + 1;
+    }
+    for (int u = 0; u <= estado->num_funcoes; u++) {
+        UnidadeIncremental *unidade = &estado->unidades[u];
+        unsigned h = espalhar_nome(unidade->nome, capacidade);
+        for (; posicoes[h] != 0; h = (h + 1) & (unsigned)(capacidade - 1)) {
+            RegistroIncremental *registro = &estado->registros[posicoes[h] - 1];
+            if (registro->usado || strcmp(registro->nome, unidade->nome) != 0) continue;
+            if (strcmp(registro->chave, unidade->chave) == 0) {
+                registro->usado = 1;
+                unidade->guardado = &registro->fragmento;
+            }
+            break;
+        }
+    }
+    free(posicoes);
+}
+
+static void escrever_fragmento(FILE *arquivo, const char *nome, const char *chave,
+                               const FragmentoIncremental *fragmento) {
+    const TabelaStrings *strings = &fragmento->strings;
+    fprintf(arquivo, "%s %s %d %d %d %zu\n", nome, chave, strings->num_strings, strings->num_usos,
+            strings->bytes_usos, strlen(fragmento->texto));
+    for (int i = 0; i < NUM_ROTINAS_ES; i++) {
+        fprintf(arquivo, i == 0 ? "%d" : " %d", fragmento->runtime.chamadas[i]);
+    }
+    const EstatisticasPeephole *peephole = &fragmento->peephole;
+    fprintf(arquivo, "\n%d %d %d", peephole->passadas, peephole->instrucoes_antes, peephole->instrucoes_depois);
+    for (int i = 0; i < NUM_REGRAS_PEEPHOLE; i++) fprintf(arquivo, " %d", peephole->aplicacoes[i]);
+    fputc('\n', arquivo);
+    for (int i = 0; i < strings->num_strings; i++) {
+        fprintf(arquivo, "%zu\n%s\n", strlen(strings->strings[i].texto), strings->strings[i].texto);
+    }
+    fprintf(arquivo, "%s\n", fragmento->texto);
+}
+
+/**
+ * @brief Grava o estado: o código novo das unidades geradas e o guardado das
+ * que não mudaram. Unidades que mudaram e não foram geradas saem do estado.
+ * A gravação é atômica (temporário renomeado), como no cache de compilação.
+ */
+static void gravar_estado(EstadoIncremental *estado) {
+    char *dados = NULL;
+    size_t tamanho = 0;
+    FILE *arquivo = open_memstream(&dados, &tamanho);
+    if (arquivo == NULL) return;
+    int num_registros = 0;
+    for (int u = 0; u <= estado->num_funcoes; u++) {
+        const UnidadeIncremental *unidade = &estado->unidades[u];
+        num_registros += unidade->gerada || unidade->guardado != NULL;
+    }
+    fprintf(arquivo, "%s\n%s\n%d\n", CABECALHO_ESTADO, estado->ambiente, num_registros);
+    for (int u = 0; u <= estado->num_funcoes; u++) {
+        const UnidadeIncremental *unidade = &estado->unidades[u];
+        if (unidade->gerada) {
+            escrever_fragmento(arquivo, unidade->nome, unidade->chave, &unidade->novo);
+        } else if (unidade->guardado != NULL) {
+            escrever_fragmento(arquivo, unidade->nome, unidade->chave, unidade->guardado);
+        }
+    }
+    fclose(arquivo);
+
+    char temporario[PATH_MAX + 16];
+    snprintf(temporario, sizeof(temporario), "%s/" PREFIXO_TEMPORARIO "XXXXXX", estado->diretorio);
+    int ok = 0;
+    if (mkdir(estado->diretorio, 0755) == 0 || errno == EEXIST) {
+        int fd = mkstemp(temporario);
+        if (fd >= 0) {
+            FILE *destino = fdopen(fd, "wb");
+            ok = destino != NULL && fwrite(dados, 1, tamanho, destino) == tamanho;
+            if (destino == NULL) close(fd);
+            if (destino != NULL && fclose(destino) != 0) ok = 0;
+            if (ok) {
+                chmod(temporario, 0644);
+                ok = rename(temporario, estado->caminho) == 0;
+            }
+            if (!ok) unlink(temporario);
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "Aviso: nao foi possivel gravar o estado incremental em '%s'.\n", estado->caminho);
+    }
+    free(dados);
+}
+
+// ---------------------------------------------------------------------------
+// Interface
+// ---------------------------------------------------------------------------
+
+EstadoIncremental *abrir_estado_incremental(const char *diretorio, const char *arquivo_fonte,
+                                            const NoAST *raiz, const OpcoesGeracao *opcoes) {
+    EstadoIncremental *estado = alocar(sizeof(EstadoIncremental));
+    snprintf(estado->diretorio, sizeof(estado->diretorio), "%s", diretorio);
+
+    // Um arquivo de estado por fonte, pelo caminho absoluto.
+    char absoluto[PATH_MAX];
+    const char *caminho_fonte = realpath(arquivo_fonte, absoluto) != NULL ? absoluto : arquivo_fonte;
+    Sha256 sha;
+    char resumo_caminho[65];
+    iniciar_sha(&sha);
+    atualizar_sha(&sha, caminho_fonte, strlen(caminho_fonte));
+    finalizar_sha(&sha, resumo_caminho);
+    snprintf(estado->caminho, sizeof(estado->caminho), "%s/%s" SUFIXO_ESTADO, diretorio, resumo_caminho);
+
+    calcular_ambiente(estado, raiz, opcoes);
+
+    IndiceFuncoes indice;
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_FUNCAO) estado->num_funcoes++;
+    }
+    indice.capacidade = 16;
+    while (indice.capacidade < 2 * estado->num_funcoes) indice.capacidade *= 2;
+    indice.declaracoes = alocar(estado->num_funcoes * sizeof(NoAST *));
+    indice.posicoes = alocar(indice.capacidade * sizeof(int));
+    indice.visita = alocar((estado->num_funcoes + 1) * sizeof(int));
+    estado->unidades = alocar((estado->num_funcoes + 1) * sizeof(UnidadeIncremental));
+    int n = 0;
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        indice.declaracoes[n] = decl;
+        if (buscar_funcao(&indice, decl->filho1->lexema) < 0) {
+            unsigned h = espalhar_nome(decl->filho1->lexema, indice.capacidade);
+            while (indice.posicoes[h] != 0) h = (h + 1) & (unsigned)(indice.capacidade - 1);
+            indice.posicoes[h] = n + 1;
+        }
+        n++;
+    }
+
+    int i = 0, globais = 0;
+    for (const NoAST *decl = raiz->filho1; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_VARIAVEL) {
+            globais++;
+            continue;
+        }
+        if (decl->tipo_no != NO_DECL_FUNCAO) continue;
+        UnidadeIncremental *unidade = &estado->unidades[i];
+        const char *nome = decl->filho1->lexema;
+        unidade->nome = alocar(strlen(nome) + 6);
+        sprintf(unidade->nome, "func_%s", nome);
+        calcular_chave_unidade(estado, &indice, i + 1, globais, decl, NULL, unidade);
+        i++;
+    }
+    UnidadeIncremental *principal = &estado->unidades[n];
+    principal->nome = alocar(5);
+    strcpy(principal->nome, "main");
+    calcular_chave_unidade(estado, &indice, n + 1, globais, raiz->filho2, raiz->filho3, principal);
+
+    free(indice.declaracoes);
+    free(indice.posicoes);
+    free(indice.visita);
+
+    ler_estado(estado);
+    associar_registros(estado);
+    return estado;
+}
+
+char *funcoes_a_analisar(const EstadoIncremental *estado, const char *alcancaveis) {
+    char *analisar = alocar(estado->num_funcoes);
+    for (int i = 0; i < estado->num_funcoes; i++) {
+        analisar[i] = estado->unidades[i].guardado == NULL && (alcancaveis == NULL || alcancaveis[i]);
+    }
+    return analisar;
+}
+
+const FragmentoIncremental *fragmento_reaproveitavel(const EstadoIncremental *estado, int unidade) {
+    return unidade_do_indice(estado, unidade)->guardado;
+}
+
+int chamadas_da_unidade(const EstadoIncremental *estado, int unidade, const int **funcoes) {
+    const UnidadeIncremental *u = unidade_do_indice(estado, unidade);
+    *funcoes = u->chamadas;
+    return u->num_chamadas;
+}
+
+void guardar_fragmento(EstadoIncremental *estado, int unidade, const ListaInstrucoes *codigo,
+                       const TabelaStrings *strings, const RuntimeES *runtime,
+                       const EstatisticasPeephole *peephole) {
+    UnidadeIncremental *u = unidade_do_indice(estado, unidade);
+    if (u->gerada) liberar_fragmento(&u->novo);
+
+    size_t tamanho = 0;
+    FILE *arquivo = open_memstream(&u->novo.texto, &tamanho);
+    if (arquivo == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a compilacao incremental.\n");
+        exit(EXIT_FAILURE);
+    }
+    imprimir_lista_instrucoes(arquivo, codigo);
+    fclose(arquivo);
+
+    iniciar_tabela_strings(&u->novo.strings);
+    for (int i = 0; i < strings->num_strings; i++) registrar_string(&u->novo.strings, strings->strings[i].texto);
+    u->novo.strings.num_usos = strings->num_usos;
+    u->novo.strings.bytes_usos = strings->bytes_usos;
+    u->novo.runtime = *runtime;
+    u->novo.peephole = *peephole;
+    u->gerada = 1;
+}
+
+void concluir_estado_incremental(EstadoIncremental *estado, int gravar) {
+    int num_unidades = estado->num_funcoes + 1, reaproveitadas = 0, geradas = 0;
+    for (int u = 0; u < num_unidades; u++) {
+        reaproveitadas += !estado->unidades[u].gerada && estado->unidades[u].guardado != NULL;
+        geradas += estado->unidades[u].gerada;
+    }
+    if (gravar) {
+        printf("Incremental: %d de %d unidade(s) sem alteracoes reaproveitada(s), %d gerada(s) de novo.\n",
+               reaproveitadas, num_unidades, geradas);
+        // Nada a gravar se todas as unidades vieram do estado e nenhum registro ficou velho.
+        if (geradas > 0 || reaproveitadas != estado->num_registros) gravar_estado(estado);
+    }
+
+    for (int u = 0; u < num_unidades; u++) {
+        if (estado->unidades[u].gerada) liberar_fragmento(&estado->unidades[u].novo);
+        free(estado->unidades[u].chamadas);
+        free(estado->unidades[u].nome);
+    }
+    free(estado->unidades);
+    liberar_registros(estado);
+    free(estado);
+}
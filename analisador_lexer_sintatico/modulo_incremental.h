@@ -0,0 +1,83 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+#include "modulo_gerador_codigo.h"
+#include "modulo_instrucoes_mips.h"
+#include "modulo_tabela_strings.h"
+#include "modulo_runtime_es.h"
+#include "modulo_otimizador_peephole.h"
+
+/*
+ * Compilação incremental por função (--incremental=DIR, alvo MIPS).
+ *
+ * Cada unidade de código (uma função ou o programa principal) é gerada de
+ * forma independente das demais (labels, literais e rotinas de E/S próprios;
+ * ver UnidadeGerada em modulo_gerador_codigo.c). O arquivo DIR/<fonte>.inc
+ * guarda, para cada unidade, o assembly gerado e a chave de que ele depende:
+ * a impressão digital da declaração (a AST, sem números de linha), as
+ * assinaturas das funções que ela chama, as globais, as opções de geração e
+ * o executável do compilador. Na compilação seguinte, só as unidades cuja
+ * chave mudou são analisadas e geradas; as demais reaproveitam o código
+ * guardado, e o programa é montado na ordem de sempre.
+ *
+ * As otimizações entre funções (inline, especialização, avaliação parcial)
+ * fazem o código de uma função depender do corpo de outras e ficam
+ * desligadas com --incremental.
+ */
+
+// Índice da unidade do programa principal (as funções usam o índice de declaração).
+#define UNIDADE_PRINCIPAL (-1)
+
+/**
+ * @brief Código de uma unidade e o que ela acrescenta ao programa.
+ */
+typedef struct FragmentoIncremental {
+    char *texto;                    // Assembly da unidade, já no formato do montador
+    TabelaStrings strings;          // Literais usados (labels "<unidade>.str_<k>")
+    RuntimeES runtime;              // Rotinas de E/S chamadas
+    EstatisticasPeephole peephole;  // Aplicações do peephole sobre a unidade
+} FragmentoIncremental;
+
+typedef struct EstadoIncremental EstadoIncremental;
+
+/**
+ * @brief Lê o estado guardado para o fonte e calcula as chaves das unidades
+ * da AST (ainda sem análise semântica).
+ */
+EstadoIncremental *abrir_estado_incremental(const char *diretorio, const char *arquivo_fonte,
+                                            const NoAST *raiz, const OpcoesGeracao *opcoes);
+
+/**
+ * @brief Funções cujo corpo precisa ser analisado: as que não têm código
+ * reaproveitável (e, se 'alcancaveis' não é NULL, são alcançáveis).
+ * @return Uma posição por função, no formato de analisar_semantica_alcancavel
+ * (liberar com free).
+ */
+char *funcoes_a_analisar(const EstadoIncremental *estado, const char *alcancaveis);
+
+/**
+ * @brief O código guardado da unidade, se a chave dela não mudou (ou NULL).
+ */
+const FragmentoIncremental *fragmento_reaproveitavel(const EstadoIncremental *estado, int unidade);
+
+/**
+ * @brief Funções chamadas pela unidade (índices de declaração, sem repetição).
+ * @return O número de funções.
+ */
+int chamadas_da_unidade(const EstadoIncremental *estado, int unidade, const int **funcoes);
+
+/**
+ * @brief Guarda o código recém-gerado de uma unidade (copiado).
+ */
+void guardar_fragmento(EstadoIncremental *estado, int unidade, const ListaInstrucoes *codigo,
+                       const TabelaStrings *strings, const RuntimeES *runtime,
+                       const EstatisticasPeephole *peephole);
+
+/**
+ * @brief Grava o novo estado (se 'gravar'), informa quantas unidades foram
+ * reaproveitadas e libera o estado.
+ */
+void concluir_estado_incremental(EstadoIncremental *estado, int gravar);
+
+#endif
@@ -0,0 +1,40 @@
+#include "modulo_inliner.h"
+
+DecisaoInline decidir_inline(const GrafoChamadas *grafo, const NoAST *chamada, int profundidade,
+                             int orcamento, FuncaoGrafo **funcao, int *custo) {
+    FuncaoGrafo *chamada_grafo = buscar_funcao_grafo(grafo, chamada->filho1->entrada_tabela);
+    *funcao = chamada_grafo;
+    *custo = 0;
+    if (chamada_grafo == NULL) return INLINE_DESCONHECIDA;
+
+    int num_args = chamada_grafo->entrada->num_argumentos;
+    *custo = chamada_grafo->tamanho - CUSTO_CHAMADA - CUSTO_ARGUMENTO * num_args;
+
+    if (chamada_grafo->recursiva) return INLINE_RECURSIVA;
+    if (profundidade >= MAX_PROFUNDIDADE_INLINE) return INLINE_PROFUNDIDADE;
+    if (*custo > orcamento) return INLINE_CUSTO;
+    return INLINE_EXPANDIR;
+}
+
+void relatar_inline(FILE *saida, const NoAST *chamada, DecisaoInline decisao, int custo, int orcamento) {
+    const char *nome = chamada->filho1->lexema;
+    switch (decisao) {
+        case INLINE_EXPANDIR:
+            fprintf(saida, "Inline: linha %d, chamada a '%s' expandida (custo %d, orcamento %d).\n",
+                    chamada->linha, nome, custo, orcamento);
+            break;
+        case INLINE_RECURSIVA:
+            fprintf(saida, "Inline: linha %d, chamada a '%s' mantida (funcao recursiva).\n", chamada->linha, nome);
+            break;
+        case INLINE_CUSTO:
+            fprintf(saida, "Inline: linha %d, chamada a '%s' mantida (custo %d acima do orcamento %d).\n",
+                    chamada->linha, nome, custo, orcamento);
+            break;
+        case INLINE_PROFUNDIDADE:
+            fprintf(saida, "Inline: linha %d, chamada a '%s' mantida (limite de %d expansoes aninhadas).\n",
+                    chamada->linha, nome, MAX_PROFUNDIDADE_INLINE);
+            break;
+        case INLINE_DESCONHECIDA:
+            break;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef INLINER_H
+#define INLINER_H
+
+#include <stdio.h>
+#include "modulo_grafo_chamadas.h"
+
+/*
+ * Modelo de custo da expansão de chamadas (inlining).
+ *
+ * O custo de expandir uma chamada é o tamanho do corpo da função (em nós da
+ * AST) menos o que a chamada deixa de custar: o 'jal', o prólogo e o epílogo
+ * (CUSTO_CHAMADA) e o empilhamento de cada argumento (CUSTO_ARGUMENTO). A
+ * chamada é expandida quando esse custo não passa do orçamento.
+ */
+#define ORCAMENTO_INLINE_PADRAO 24
+#define CUSTO_CHAMADA 12
+#define CUSTO_ARGUMENTO 2
+
+// Número máximo de expansões aninhadas (função expandida dentro de outra expansão).
+#define MAX_PROFUNDIDADE_INLINE 4
+
+typedef enum {
+    INLINE_EXPANDIR,        // A chamada é substituída pelo corpo da função
+    INLINE_RECURSIVA,       // A função pode chamar a si mesma
+    INLINE_CUSTO,           // O custo passa do orçamento
+    INLINE_PROFUNDIDADE,    // Limite de expansões aninhadas atingido
+    INLINE_DESCONHECIDA     // A função não foi declarada no programa
+} DecisaoInline;
+
+/**
+ * @brief Decide se uma chamada deve ser expandida.
+ * @param chamada O nó NO_CHAMADA_FUNCAO.
+ * @param profundidade Número de expansões em andamento ao redor da chamada.
+ * @param orcamento Custo máximo aceito.
+ * @param funcao Recebe a função chamada (ou NULL).
+ * @param custo Recebe o custo calculado.
+ */
+DecisaoInline decidir_inline(const GrafoChamadas *grafo, const NoAST *chamada, int profundidade,
+                             int orcamento, FuncaoGrafo **funcao, int *custo);
+
+/**
+ * @brief Imprime uma linha do relatório de inlining para a chamada.
+ */
+void relatar_inline(FILE *saida, const NoAST *chamada, DecisaoInline decisao, int custo, int orcamento);
+
+#endif
@@ -0,0 +1,375 @@
+#include "modulo_instrucoes_mips.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+/**
+ * @brief Tabela de formatos das instruções emitidas pelo gerador de código.
+ */
+static const struct {
+    const char *opcode;
+    FormatoInstrucao formato;
+} tabela_formatos[] = {
+    {"add", FORMATO_RRR}, {"addu", FORMATO_RRR}, {"sub", FORMATO_RRR}, {"subu", FORMATO_RRR},
+    {"and", FORMATO_RRR}, {"or", FORMATO_RRR}, {"xor", FORMATO_RRR}, {"nor", FORMATO_RRR},
+    {"slt", FORMATO_RRR}, {"sltu", FORMATO_RRR}, {"seq", FORMATO_RRR}, {"sne", FORMATO_RRR},
+    {"sgt", FORMATO_RRR}, {"sge", FORMATO_RRR}, {"sle", FORMATO_RRR}, {"mul", FORMATO_RRR},
+    {"sllv", FORMATO_RRR}, {"srlv", FORMATO_RRR}, {"srav", FORMATO_RRR},
+    {"addi", FORMATO_RRI}, {"addiu", FORMATO_RRI}, {"slti", FORMATO_RRI}, {"sltiu", FORMATO_RRI},
+    {"andi", FORMATO_RRI}, {"ori", FORMATO_RRI}, {"xori", FORMATO_RRI},
+    {"sll", FORMATO_RRI}, {"srl", FORMATO_RRI}, {"sra", FORMATO_RRI},
+    {"li", FORMATO_RI}, {"lui", FORMATO_RI},
+    {"la", FORMATO_RL},
+    {"move", FORMATO_RR}, {"neg", FORMATO_RR}, {"negu", FORMATO_RR}, {"not", FORMATO_RR},
+    {"mflo", FORMATO_MOVE_HILO}, {"mfhi", FORMATO_MOVE_HILO},
+    {"mult", FORMATO_HILO}, {"multu", FORMATO_HILO}, {"div", FORMATO_HILO}, {"divu", FORMATO_HILO},
+    {"lw", FORMATO_LOAD}, {"lb", FORMATO_LOAD}, {"lbu", FORMATO_LOAD},
+    {"sw", FORMATO_STORE}, {"sb", FORMATO_STORE},
+    {"beqz", FORMATO_DESVIO_1}, {"bnez", FORMATO_DESVIO_1}, {"bltz", FORMATO_DESVIO_1},
+    {"blez", FORMATO_DESVIO_1}, {"bgtz", FORMATO_DESVIO_1}, {"bgez", FORMATO_DESVIO_1},
+    {"beq", FORMATO_DESVIO_2}, {"bne", FORMATO_DESVIO_2}, {"blt", FORMATO_DESVIO_2},
+    {"bgt", FORMATO_DESVIO_2}, {"ble", FORMATO_DESVIO_2}, {"bge", FORMATO_DESVIO_2},
+    {"j", FORMATO_SALTO}, {"b", FORMATO_SALTO},
+    {"jal", FORMATO_CHAMADA},
+    {"jr", FORMATO_SALTO_REG},
+    {"syscall", FORMATO_SYSCALL},
+    {NULL, FORMATO_DESCONHECIDO}
+};
+
+/* Registradores que uma chamada (jal) pode ler ou destruir. */
+static const char *registradores_lidos_chamada[] = {"$a0", "$a1", "$a2", "$a3", "$sp", "$fp", "$gp", NULL};
+static const char *registradores_escritos_chamada[] = {
+    "$v0", "$v1", "$a0", "$a1", "$a2", "$a3", "$ra",
+    "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7", "$t8", "$t9", NULL
+};
+/* $a2 é o tamanho na escrita em arquivo (syscall 15) do runtime de E/S. */
+static const char *registradores_lidos_syscall[] = {"$v0", "$a0", "$a1", "$a2", NULL};
+
+static FormatoInstrucao buscar_formato(const char *opcode) {
+    for (int i = 0; tabela_formatos[i].opcode != NULL; i++) {
+        if (strcmp(tabela_formatos[i].opcode, opcode) == 0) {
+            return tabela_formatos[i].formato;
+        }
+    }
+    return FORMATO_DESCONHECIDO;
+}
+
+static char *duplicar_texto(const char *texto) {
+    char *copia = strdup(texto);
+    if (copia == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para instrucao MIPS.\n");
+        exit(EXIT_FAILURE);
+    }
+    return copia;
+}
+
+static InstrucaoMIPS *nova_linha(ListaInstrucoes *lista, TipoLinhaMIPS tipo, const char *texto) {
+    if (lista->tamanho == lista->capacidade) {
+        int nova_capacidade = lista->capacidade == 0 ? 256 : lista->capacidade * 2;
+        InstrucaoMIPS *novos = realloc(lista->itens, nova_capacidade * sizeof(InstrucaoMIPS));
+        if (novos == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para lista de instrucoes.\n");
+            exit(EXIT_FAILURE);
+        }
+        lista->itens = novos;
+        lista->capacidade = nova_capacidade;
+    }
+    InstrucaoMIPS *instr = &lista->itens[lista->tamanho++];
+    memset(instr, 0, sizeof(InstrucaoMIPS));
+    instr->tipo = tipo;
+    instr->formato = FORMATO_DESCONHECIDO;
+    instr->texto = duplicar_texto(texto);
+    return instr;
+}
+
+void iniciar_lista_instrucoes(ListaInstrucoes *lista) {
+    lista->itens = NULL;
+    lista->tamanho = 0;
+    lista->capacidade = 0;
+}
+
+void liberar_lista_instrucoes(ListaInstrucoes *lista) {
+    for (int i = 0; i < lista->tamanho; i++) {
+        free(lista->itens[i].texto);
+    }
+    free(lista->itens);
+    iniciar_lista_instrucoes(lista);
+}
+
+/**
+ * @brief Copia 'inicio..fim' (sem espaços nas pontas) para 'destino'.
+ * @return 0 se o texto não couber.
+ */
+static int copiar_aparado(char *destino, int tam, const char *inicio, const char *fim) {
+    while (inicio < fim && isspace((unsigned char)*inicio)) inicio++;
+    while (fim > inicio && isspace((unsigned char)*(fim - 1))) fim--;
+    if (fim - inicio >= tam) return 0;
+    memcpy(destino, inicio, fim - inicio);
+    destino[fim - inicio] = '\0';
+    return 1;
+}
+
+/**
+ * @brief Decompõe "opcode op1, op2, op3" nos campos da instrução.
+ * @return 0 se o texto não tiver o formato esperado.
+ */
+static int decompor_instrucao(InstrucaoMIPS *instr, const char *texto) {
+    const char *p = texto;
+    while (isspace((unsigned char)*p)) p++;
+    const char *fim_opcode = p;
+    while (*fim_opcode != '\0' && !isspace((unsigned char)*fim_opcode)) fim_opcode++;
+    if (fim_opcode == p || !copiar_aparado(instr->opcode, TAM_OPCODE_MIPS, p, fim_opcode)) {
+        return 0;
+    }
+    if (instr->opcode[0] == '.' || strchr(texto, '\n') != NULL || strchr(texto, '"') != NULL) {
+        return 0;
+    }
+
+    instr->num_operandos = 0;
+    p = fim_opcode;
+    while (isspace((unsigned char)*p)) p++;
+    while (*p != '\0') {
+        if (instr->num_operandos == MAX_OPERANDOS_MIPS) return 0;
+        const char *virgula = strchr(p, ',');
+        const char *fim = virgula != NULL ? virgula : p + strlen(p);
+        if (!copiar_aparado(instr->operandos[instr->num_operandos], TAM_OPERANDO_MIPS, p, fim)) {
+            return 0;
+        }
+        if (instr->operandos[instr->num_operandos][0] == '\0') return 0;
+        instr->num_operandos++;
+        p = virgula != NULL ? virgula + 1 : fim;
+    }
+    instr->formato = buscar_formato(instr->opcode);
+    return 1;
+}
+
+void adicionar_instrucao(ListaInstrucoes *lista, const char *texto) {
+    InstrucaoMIPS *instr = nova_linha(lista, LINHA_INSTRUCAO, texto);
+    if (!decompor_instrucao(instr, texto)) {
+        instr->tipo = LINHA_DIRETIVA;
+        instr->formato = FORMATO_DESCONHECIDO;
+        instr->num_operandos = 0;
+    }
+}
+
+void adicionar_label(ListaInstrucoes *lista, const char *label) {
+    nova_linha(lista, LINHA_LABEL, label);
+}
+
+void adicionar_comentario(ListaInstrucoes *lista, const char *comentario) {
+    nova_linha(lista, LINHA_COMENTARIO, comentario);
+}
+
+void adicionar_texto(ListaInstrucoes *lista, const char *texto) {
+    nova_linha(lista, LINHA_TEXTO, texto);
+}
+
+void adicionar_diretiva(ListaInstrucoes *lista, const char *texto) {
+    nova_linha(lista, LINHA_DIRETIVA, texto);
+}
+
+void reescrever_instrucao(InstrucaoMIPS *instr, const char *opcode,
+                          const char *op1, const char *op2, const char *op3) {
+    const char *ops[MAX_OPERANDOS_MIPS] = {op1, op2, op3};
+    char novo_opcode[TAM_OPCODE_MIPS];
+    char novos[MAX_OPERANDOS_MIPS][TAM_OPERANDO_MIPS];
+    int n = 0;
+
+    // Copia antes de escrever: os operandos podem apontar para a própria instrução.
+    snprintf(novo_opcode, TAM_OPCODE_MIPS, "%s", opcode);
+    for (int i = 0; i < MAX_OPERANDOS_MIPS; i++) {
+        if (ops[i] != NULL) {
+            snprintf(novos[n++], TAM_OPERANDO_MIPS, "%s", ops[i]);
+        }
+    }
+    memcpy(instr->opcode, novo_opcode, TAM_OPCODE_MIPS);
+    for (int i = 0; i < n; i++) {
+        memcpy(instr->operandos[i], novos[i], TAM_OPERANDO_MIPS);
+    }
+    instr->num_operandos = n;
+    instr->formato = buscar_formato(instr->opcode);
+
+    char texto[TAM_OPCODE_MIPS + MAX_OPERANDOS_MIPS * (TAM_OPERANDO_MIPS + 2) + 2];
+    int pos = snprintf(texto, sizeof(texto), "%s", instr->opcode);
+    for (int i = 0; i < n; i++) {
+        pos += snprintf(texto + pos, sizeof(texto) - pos, "%s%s", i == 0 ? " " : ", ", instr->operandos[i]);
+    }
+    free(instr->texto);
+    instr->texto = duplicar_texto(texto);
+}
+
+void remover_instrucao(InstrucaoMIPS *instr) {
+    instr->tipo = LINHA_REMOVIDA;
+}
+
+void compactar_lista_instrucoes(ListaInstrucoes *lista) {
+    int destino = 0;
+    for (int i = 0; i < lista->tamanho; i++) {
+        if (lista->itens[i].tipo == LINHA_REMOVIDA) {
+            free(lista->itens[i].texto);
+            continue;
+        }
+        lista->itens[destino++] = lista->itens[i];
+    }
+    lista->tamanho = destino;
+}
+
+void anexar_lista_instrucoes(ListaInstrucoes *destino, ListaInstrucoes *origem) {
+    if (destino->tamanho + origem->tamanho > destino->capacidade) {
+        int nova_capacidade = destino->capacidade == 0 ? 256 : destino->capacidade;
+        while (nova_capacidade < destino->tamanho + origem->tamanho) nova_capacidade *= 2;
+        InstrucaoMIPS *novos = realloc(destino->itens, nova_capacidade * sizeof(InstrucaoMIPS));
+        if (novos == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para lista de instrucoes.\n");
+            exit(EXIT_FAILURE);
+        }
+        destino->itens = novos;
+        destino->capacidade = nova_capacidade;
+    }
+    // Os textos passam a pertencer a 'destino'; só o vetor de 'origem' é liberado.
+    if (origem->tamanho > 0) {
+        memcpy(&destino->itens[destino->tamanho], origem->itens, origem->tamanho * sizeof(InstrucaoMIPS));
+    }
+    destino->tamanho += origem->tamanho;
+    free(origem->itens);
+    iniciar_lista_instrucoes(origem);
+}
+
+void imprimir_lista_instrucoes(FILE *arquivo, const ListaInstrucoes *lista) {
+    for (int i = 0; i < lista->tamanho; i++) {
+        const InstrucaoMIPS *instr = &lista->itens[i];
+        switch (instr->tipo) {
+            case LINHA_INSTRUCAO:
+            case LINHA_DIRETIVA:   fprintf(arquivo, "\t%s\n", instr->texto); break;
+            case LINHA_LABEL:      fprintf(arquivo, "%s:\n", instr->texto); break;
+            case LINHA_COMENTARIO: fprintf(arquivo, "\n\t# %s\n", instr->texto); break;
+            case LINHA_TEXTO:      fputs(instr->texto, arquivo); break;
+            case LINHA_REMOVIDA:   break;
+        }
+    }
+}
+
+int decompor_operando_memoria(const char *operando, int *offset, char *base, int tam_base) {
+    const char *abre = strchr(operando, '(');
+    const char *fecha = strchr(operando, ')');
+    if (abre == NULL || fecha == NULL || fecha < abre) return 0;
+    char *fim_numero;
+    *offset = (int) strtol(operando, &fim_numero, 10);
+    if (fim_numero != abre) return 0;
+    return copiar_aparado(base, tam_base, abre + 1, fecha);
+}
+
+static int lista_contem(const char **lista, const char *reg) {
+    for (int i = 0; lista[i] != NULL; i++) {
+        if (strcmp(lista[i], reg) == 0) return 1;
+    }
+    return 0;
+}
+
+static int operando_e_registrador(const InstrucaoMIPS *instr, int indice, const char *reg) {
+    return indice < instr->num_operandos && strcmp(instr->operandos[indice], reg) == 0;
+}
+
+static int base_e_registrador(const InstrucaoMIPS *instr, const char *reg) {
+    char base[TAM_OPERANDO_MIPS];
+    int offset;
+    if (instr->num_operandos < 2) return 0;
+    if (!decompor_operando_memoria(instr->operandos[1], &offset, base, sizeof(base))) return 0;
+    return strcmp(base, reg) == 0;
+}
+
+int instrucao_le_registrador(const InstrucaoMIPS *instr, const char *reg) {
+    if (instr->tipo != LINHA_INSTRUCAO) return instr->tipo == LINHA_DIRETIVA;
+
+    switch (instr->formato) {
+        case FORMATO_RRR:
+        case FORMATO_DESVIO_2:
+            return operando_e_registrador(instr, 1, reg) || operando_e_registrador(instr, 2, reg)
+                || (instr->formato == FORMATO_DESVIO_2 && operando_e_registrador(instr, 0, reg));
+        case FORMATO_RRI:
+        case FORMATO_RR:
+            return operando_e_registrador(instr, 1, reg);
+        case FORMATO_RI:
+        case FORMATO_RL:
+        case FORMATO_SALTO:
+            return 0;
+        case FORMATO_MOVE_HILO:
+            return strcmp(reg, "$lo") == 0 || strcmp(reg, "$hi") == 0;
+        case FORMATO_HILO:
+        case FORMATO_DESVIO_1:
+        case FORMATO_SALTO_REG:
+            return operando_e_registrador(instr, 0, reg) || operando_e_registrador(instr, 1, reg);
+        case FORMATO_LOAD:
+            return base_e_registrador(instr, reg);
+        case FORMATO_STORE:
+            return operando_e_registrador(instr, 0, reg) || base_e_registrador(instr, reg);
+        case FORMATO_CHAMADA:
+            return lista_contem(registradores_lidos_chamada, reg);
+        case FORMATO_SYSCALL:
+            return lista_contem(registradores_lidos_syscall, reg);
+        case FORMATO_DESCONHECIDO:
+            return 1;
+    }
+    return 1;
+}
+
+int instrucao_escreve_registrador(const InstrucaoMIPS *instr, const char *reg) {
+    if (instr->tipo != LINHA_INSTRUCAO) return instr->tipo == LINHA_DIRETIVA;
+
+    switch (instr->formato) {
+        case FORMATO_RRR:
+        case FORMATO_RRI:
+        case FORMATO_RI:
+        case FORMATO_RL:
+        case FORMATO_RR:
+        case FORMATO_MOVE_HILO:
+        case FORMATO_LOAD:
+            return operando_e_registrador(instr, 0, reg);
+        case FORMATO_HILO:
+            return strcmp(reg, "$lo") == 0 || strcmp(reg, "$hi") == 0;
+        case FORMATO_STORE:
+        case FORMATO_DESVIO_1:
+        case FORMATO_DESVIO_2:
+        case FORMATO_SALTO:
+        case FORMATO_SALTO_REG:
+            return 0;
+        case FORMATO_CHAMADA:
+            return lista_contem(registradores_escritos_chamada, reg);
+        case FORMATO_SYSCALL:
+            return strcmp(reg, "$v0") == 0;
+        case FORMATO_DESCONHECIDO:
+            return 1;
+    }
+    return 1;
+}
+
+int instrucao_e_barreira(const InstrucaoMIPS *instr) {
+    if (instr->tipo == LINHA_LABEL || instr->tipo == LINHA_DIRETIVA || instr->tipo == LINHA_TEXTO) return 1;
+    if (instr->tipo != LINHA_INSTRUCAO) return 0;
+    switch (instr->formato) {
+        case FORMATO_DESVIO_1:
+        case FORMATO_DESVIO_2:
+        case FORMATO_SALTO:
+        case FORMATO_CHAMADA:
+        case FORMATO_SALTO_REG:
+        case FORMATO_DESCONHECIDO:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+const char *instrucao_destino(const InstrucaoMIPS *instr) {
+    if (instr->tipo != LINHA_INSTRUCAO) return NULL;
+    switch (instr->formato) {
+        case FORMATO_SALTO:
+        case FORMATO_CHAMADA:
+            return instr->num_operandos == 1 ? instr->operandos[0] : NULL;
+        case FORMATO_DESVIO_1:
+            return instr->num_operandos == 2 ? instr->operandos[1] : NULL;
+        case FORMATO_DESVIO_2:
+            return instr->num_operandos == 3 ? instr->operandos[2] : NULL;
+        default:
+            return NULL;
+    }
+}
@@ -0,0 +1,159 @@
+#ifndef INSTRUCOES_MIPS_H
+#define INSTRUCOES_MIPS_H
+
+#include <stdio.h>
+
+#define TAM_OPCODE_MIPS 16
+#define TAM_OPERANDO_MIPS 64
+#define MAX_OPERANDOS_MIPS 3
+
+/**
+ * @brief Tipo de cada linha do fluxo de saída em memória.
+ */
+typedef enum {
+    LINHA_INSTRUCAO,
+    LINHA_LABEL,
+    LINHA_COMENTARIO,
+    LINHA_DIRETIVA,    // Diretivas (.data, .text, .asciiz, ...) e textos opacos
+    LINHA_TEXTO,       // Trecho já formatado (várias linhas), impresso sem alteração
+    LINHA_REMOVIDA     // Marcada pelo otimizador; descartada na compactação
+} TipoLinhaMIPS;
+
+/**
+ * @brief Formato (classe) de uma instrução MIPS, usado para saber quais
+ * operandos são lidos e escritos.
+ */
+typedef enum {
+    FORMATO_DESCONHECIDO, // Tratada como barreira (lê e escreve tudo)
+    FORMATO_RRR,          // rd, rs, rt   (add, sub, slt, seq, and, ...)
+    FORMATO_RRI,          // rd, rs, imm  (addiu, slti, andi, sll, ...)
+    FORMATO_RI,           // rd, imm      (li, lui)
+    FORMATO_RL,           // rd, label    (la)
+    FORMATO_RR,           // rd, rs       (move, neg)
+    FORMATO_MOVE_HILO,    // rd           (mflo, mfhi)
+    FORMATO_HILO,         // rs, rt       (mult, div)
+    FORMATO_LOAD,         // rt, off(base)
+    FORMATO_STORE,        // rt, off(base)
+    FORMATO_DESVIO_1,     // rs, label    (beqz, bnez, bltz, ...)
+    FORMATO_DESVIO_2,     // rs, rt, label (beq, bne, blt, bge, ...)
+    FORMATO_SALTO,        // label        (j)
+    FORMATO_CHAMADA,      // label        (jal)
+    FORMATO_SALTO_REG,    // rs           (jr)
+    FORMATO_SYSCALL
+} FormatoInstrucao;
+
+/**
+ * @brief Uma linha do código MIPS gerado, já decomposta em opcode e operandos.
+ * Labels, comentários e diretivas guardam apenas o texto em 'texto'.
+ */
+typedef struct InstrucaoMIPS {
+    TipoLinhaMIPS tipo;
+    FormatoInstrucao formato;
+    char opcode[TAM_OPCODE_MIPS];
+    char operandos[MAX_OPERANDOS_MIPS][TAM_OPERANDO_MIPS];
+    int num_operandos;
+    char *texto; // Texto original (impresso como está enquanto a linha não for reescrita)
+} InstrucaoMIPS;
+
+/**
+ * @brief Lista (vetor dinâmico) de linhas MIPS na ordem de emissão.
+ */
+typedef struct ListaInstrucoes {
+    InstrucaoMIPS *itens;
+    int tamanho;
+    int capacidade;
+} ListaInstrucoes;
+
+/**
+ * @brief Inicializa uma lista vazia.
+ */
+void iniciar_lista_instrucoes(ListaInstrucoes *lista);
+
+/**
+ * @brief Libera toda a memória da lista (a lista volta a ficar vazia).
+ */
+void liberar_lista_instrucoes(ListaInstrucoes *lista);
+
+/**
+ * @brief Adiciona uma instrução a partir do seu texto (ex: "addiu $sp, $sp, -4").
+ * Textos que não puderem ser decompostos são guardados como linha opaca.
+ */
+void adicionar_instrucao(ListaInstrucoes *lista, const char *texto);
+
+/**
+ * @brief Adiciona um label (sem o ':').
+ */
+void adicionar_label(ListaInstrucoes *lista, const char *label);
+
+/**
+ * @brief Adiciona um comentário (sem o '#').
+ */
+void adicionar_comentario(ListaInstrucoes *lista, const char *comentario);
+
+/**
+ * @brief Adiciona uma diretiva ou qualquer texto que deve ser impresso como está.
+ */
+void adicionar_diretiva(ListaInstrucoes *lista, const char *texto);
+
+/**
+ * @brief Adiciona um trecho já no formato do montador (ex: o código de uma
+ * função guardado pela compilação incremental), escrito exatamente como está.
+ */
+void adicionar_texto(ListaInstrucoes *lista, const char *texto);
+
+/**
+ * @brief Reescreve uma instrução já existente com novo opcode e operandos.
+ * Operandos NULL são ignorados.
+ */
+void reescrever_instrucao(InstrucaoMIPS *instr, const char *opcode,
+                          const char *op1, const char *op2, const char *op3);
+
+/**
+ * @brief Marca uma linha como removida.
+ */
+void remover_instrucao(InstrucaoMIPS *instr);
+
+/**
+ * @brief Descarta as linhas marcadas como removidas.
+ */
+void compactar_lista_instrucoes(ListaInstrucoes *lista);
+
+/**
+ * @brief Move todas as linhas de 'origem' para o fim de 'destino'.
+ * A lista 'origem' fica vazia.
+ */
+void anexar_lista_instrucoes(ListaInstrucoes *destino, ListaInstrucoes *origem);
+
+/**
+ * @brief Escreve a lista no arquivo, no formato do montador (SPIM/MARS).
+ */
+void imprimir_lista_instrucoes(FILE *arquivo, const ListaInstrucoes *lista);
+
+/**
+ * @brief Indica se a instrução lê o registrador 'reg' (ex: "$v0").
+ */
+int instrucao_le_registrador(const InstrucaoMIPS *instr, const char *reg);
+
+/**
+ * @brief Indica se a instrução escreve no registrador 'reg'.
+ */
+int instrucao_escreve_registrador(const InstrucaoMIPS *instr, const char *reg);
+
+/**
+ * @brief Indica se a linha encerra um trecho de código em linha reta
+ * (labels, diretivas, desvios, saltos, chamadas e instruções desconhecidas).
+ */
+int instrucao_e_barreira(const InstrucaoMIPS *instr);
+
+/**
+ * @brief Retorna o label de destino de um salto/desvio, ou NULL.
+ */
+const char *instrucao_destino(const InstrucaoMIPS *instr);
+
+/**
+ * @brief Decompõe um operando de memória "off(base)".
+ * @return 1 em caso de sucesso.
+ */
+int decompor_operando_memoria(const char *operando, int *offset, char *base, int tam_base);
+
+#endif
@@ -0,0 +1,228 @@
+#include "modulo_interpretador_ast.h"
+#include <stdint.h>
+
+typedef struct VariavelAST {
+    const EntradaTabela *entrada;
+    int32_t valor;
+} VariavelAST;
+
+static const NoAST *programa_ast = NULL;
+static EntradaSaidaBuferizada *es_ast = NULL;
+static VariavelAST *variaveis = NULL;     // Globais, depois as locais dos quadros ativos
+static int num_variaveis = 0;
+static int capacidade_variaveis = 0;
+static int num_globais_ast = 0;
+static int inicio_quadro = 0;             // Primeira local da função em execução
+static int32_t *parametros = NULL;        // Argumentos da função em execução
+static int retornando = 0;
+static int32_t valor_retorno = 0;
+
+static void empilhar_variavel(const EntradaTabela *entrada) {
+    if (num_variaveis == capacidade_variaveis) {
+        capacidade_variaveis = capacidade_variaveis == 0 ? 64 : capacidade_variaveis * 2;
+        variaveis = realloc(variaveis, capacidade_variaveis * sizeof(VariavelAST));
+        if (variaveis == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para o interpretador.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    variaveis[num_variaveis].entrada = entrada;
+    variaveis[num_variaveis].valor = 0;
+    num_variaveis++;
+}
+
+static void empilhar_declaracoes(const NoAST *declaracoes) {
+    for (const NoAST *decl = declaracoes; decl != NULL; decl = decl->proximo) {
+        if (decl->tipo_no == NO_DECL_VARIAVEL) empilhar_variavel(decl->filho1->entrada_tabela);
+    }
+}
+
+/**
+ * @brief Endereço do valor de uma variável: locais do quadro (da mais
+ * interna para fora), parâmetros e, por fim, globais. O endereço só vale
+ * até a próxima declaração empilhada.
+ */
+static int32_t *endereco_variavel(const EntradaTabela *entrada) {
+    for (int i = num_variaveis - 1; i >= inicio_quadro; i--) {
+        if (variaveis[i].entrada == entrada) return &variaveis[i].valor;
+    }
+    if (entrada->tipo != TIPO_FUNCAO && entrada->posicao >= 0) return &parametros[entrada->posicao];
+    for (int i = 0; i < num_globais_ast; i++) {
+        if (variaveis[i].entrada == entrada) return &variaveis[i].valor;
+    }
+    fprintf(stderr, "Erro interno: variavel '%s' nao encontrada pelo interpretador.\n", entrada->lexema);
+    exit(EXIT_FAILURE);
+}
+
+static void erro_execucao(const char *mensagem, int linha) {
+    descarregar_es(es_ast);
+    fprintf(stderr, "Erro de execucao: %s (linha %d).\n", mensagem, linha);
+    exit(EXIT_FAILURE);
+}
+
+static int32_t avaliar(const NoAST *no);
+static void executar_comando(const NoAST *no);
+
+static int32_t chamar_funcao(const NoAST *chamada) {
+    const NoAST *declaracao = programa_ast->filho1;
+    while (declaracao->tipo_no != NO_DECL_FUNCAO
+           || declaracao->filho1->entrada_tabela != chamada->filho1->entrada_tabela) {
+        declaracao = declaracao->proximo;
+    }
+
+    int num_argumentos = 0;
+    for (const NoAST *arg = chamada->filho2; arg != NULL; arg = arg->proximo) num_argumentos++;
+    int32_t *argumentos = malloc((num_argumentos + 1) * sizeof(int32_t));
+    if (argumentos == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o interpretador.\n");
+        exit(EXIT_FAILURE);
+    }
+    int i = 0;
+    for (const NoAST *arg = chamada->filho2; arg != NULL; arg = arg->proximo) argumentos[i++] = avaliar(arg);
+
+    int inicio_anterior = inicio_quadro;
+    int32_t *parametros_anteriores = parametros;
+    int topo_anterior = num_variaveis;
+    inicio_quadro = num_variaveis;
+    parametros = argumentos;
+
+    executar_comando(declaracao->filho3);
+    int32_t resultado = retornando ? valor_retorno : 0;
+    retornando = 0;
+
+    num_variaveis = topo_anterior;
+    inicio_quadro = inicio_anterior;
+    parametros = parametros_anteriores;
+    free(argumentos);
+    return resultado;
+}
+
+static int32_t avaliar(const NoAST *no) {
+    switch (no->tipo_no) {
+        case NO_LITERAL_INT: return no->ival;
+        case NO_LITERAL_CAR: return no->cval;
+        case NO_ID: return *endereco_variavel(no->entrada_tabela);
+        case NO_CHAMADA_FUNCAO: return chamar_funcao(no);
+        case NO_COMANDO_ATRIBUICAO: {
+            int32_t valor = avaliar(no->filho2);
+            *endereco_variavel(no->filho1->entrada_tabela) = valor;
+            return valor;
+        }
+        case NO_OP_E: return avaliar(no->filho1) && avaliar(no->filho2);
+        case NO_OP_OU: return avaliar(no->filho1) || avaliar(no->filho2);
+        case NO_OP_NEGACAO: return !avaliar(no->filho1);
+        case NO_OP_UNARIO_MENOS: return (int32_t)(0u - (uint32_t)avaliar(no->filho1));
+        default: break;
+    }
+
+    int32_t esquerdo = avaliar(no->filho1);
+    int32_t direito = avaliar(no->filho2);
+    switch (no->tipo_no) {
+        case NO_OP_SOMA: return (int32_t)((uint32_t)esquerdo + (uint32_t)direito);
+        case NO_OP_SUB: return (int32_t)((uint32_t)esquerdo - (uint32_t)direito);
+        case NO_OP_MULT: return (int32_t)((uint32_t)esquerdo * (uint32_t)direito);
+        case NO_OP_DIV:
+            if (direito == 0) erro_execucao("divisao por zero", no->linha);
+            if (direito == -1) return (int32_t)(0u - (uint32_t)esquerdo);
+            return esquerdo / direito;
+        case NO_OP_IGUAL: return esquerdo == direito;
+        case NO_OP_DIFERENTE: return esquerdo != direito;
+        case NO_OP_MENOR: return esquerdo < direito;
+        case NO_OP_MENOR_IGUAL: return esquerdo <= direito;
+        case NO_OP_MAIOR: return esquerdo > direito;
+        case NO_OP_MAIOR_IGUAL: return esquerdo >= direito;
+        default:
+            fprintf(stderr, "Erro interno: expressao sem interpretacao (linha %d).\n", no->linha);
+            exit(EXIT_FAILURE);
+    }
+}
+
+static void escrever_string(const char *texto) {
+    for (const char *c = texto; *c != '\0'; c++) {
+        if (*c == '\\' && c[1] != '\0') {
+            c++;
+            switch (*c) {
+                case 'n': escrever_car_es(es_ast, '\n'); break;
+                case 't': escrever_car_es(es_ast, '\t'); break;
+                case 'r': escrever_car_es(es_ast, '\r'); break;
+                case '0': escrever_car_es(es_ast, '\0'); break;
+                default:  escrever_car_es(es_ast, *c); break;
+            }
+        } else {
+            escrever_car_es(es_ast, *c);
+        }
+    }
+}
+
+static void executar_lista(const NoAST *no) {
+    for (; no != NULL && !retornando; no = no->proximo) executar_comando(no);
+}
+
+static void executar_comando(const NoAST *no) {
+    switch (no->tipo_no) {
+        case NO_BLOCO: {
+            int topo = num_variaveis;
+            empilhar_declaracoes(no->filho1);
+            executar_lista(no->filho2);
+            num_variaveis = topo;
+            break;
+        }
+        case NO_COMANDO_SE:
+            if (avaliar(no->filho1)) {
+                if (no->filho2 != NULL) executar_comando(no->filho2);
+            } else if (no->filho3 != NULL) {
+                executar_comando(no->filho3);
+            }
+            break;
+        case NO_COMANDO_ENQUANTO:
+            while (!retornando && avaliar(no->filho1)) {
+                if (no->filho2 != NULL) executar_comando(no->filho2);
+            }
+            break;
+        case NO_COMANDO_LEIA: {
+            int32_t valor = ler_int_es(es_ast);
+            if (no->filho1->entrada_tabela->tipo == TIPO_CAR) valor = (signed char)valor;
+            *endereco_variavel(no->filho1->entrada_tabela) = valor;
+            break;
+        }
+        case NO_COMANDO_ESCREVA:
+            if (no->filho1->tipo_no == NO_LITERAL_STRING) {
+                escrever_string(no->filho1->lexema);
+            } else if (no->filho1->tipo_dado_computado == TIPO_CAR) {
+                escrever_car_es(es_ast, avaliar(no->filho1));
+            } else {
+                escrever_int_es(es_ast, avaliar(no->filho1));
+            }
+            break;
+        case NO_COMANDO_NOVALINHA:
+            escrever_car_es(es_ast, '\n');
+            break;
+        case NO_COMANDO_RETORNE:
+            valor_retorno = no->filho1 != NULL ? avaliar(no->filho1) : 0;
+            retornando = 1;
+            break;
+        default:
+            avaliar(no);
+            break;
+    }
+}
+
+int interpretar_ast(const NoAST *raiz, EntradaSaidaBuferizada *es) {
+    programa_ast = raiz;
+    es_ast = es;
+    num_variaveis = 0;
+    retornando = 0;
+    parametros = NULL;
+
+    empilhar_declaracoes(raiz->filho1);
+    num_globais_ast = num_variaveis;
+    inicio_quadro = num_variaveis;
+    empilhar_declaracoes(raiz->filho3);
+    executar_lista(raiz->filho2);
+
+    descarregar_es(es);
+    free(variaveis);
+    variaveis = NULL;
+    capacidade_variaveis = 0;
+    return 0;
+}
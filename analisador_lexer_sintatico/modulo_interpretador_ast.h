@@ -0,0 +1,21 @@
+#ifndef INTERPRETADOR_AST_H
+#define INTERPRETADOR_AST_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+#include "modulo_es_buferizada.h"
+
+/*
+ * Interpretador que percorre a AST diretamente (--run-ast). É a referência
+ * simples para conferir e medir a máquina virtual de bytecode: as variáveis
+ * ficam numa pilha procurada linearmente e as funções são procuradas na
+ * lista de declarações a cada chamada.
+ */
+
+/**
+ * @brief Executa o programa (AST já verificada pela análise semântica).
+ * @return 0. Um erro de execução (divisão por zero) é relatado em stderr e
+ * encerra o processo com EXIT_FAILURE.
+ */
+int interpretar_ast(const NoAST *raiz, EntradaSaidaBuferizada *es);
+
+#endif
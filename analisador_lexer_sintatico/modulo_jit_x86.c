@@ -0,0 +1,598 @@
+#include "modulo_jit_x86.h"
+#include "modulo_maquina_virtual.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) && defined(__linux__)
+
+#include <stddef.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * Convenções do código gerado:
+ *   %rbx  base do quadro de registradores de bytecode da função (R[i] em 4*i(%rbx))
+ *   %r12  vetor de globais (G[i] em 4*i(%r12))
+ *   %r13  tabela com o endereço de cada função (ou do seu stub)
+ *   %r14  fim da pilha de registradores
+ *   %r15  ContextoJIT
+ * Todos são preservados pelas rotinas em C, que recebem os argumentos em
+ * %rdi/%esi/%edx. Uma chamada empilha %rbx e o endereço de retorno; assim,
+ * no corpo de toda função, %rsp fica alinhado em 16 bytes, como a ABI exige
+ * nas chamadas ao runtime. O código roda numa pilha nativa própria, com
+ * espaço para a mesma profundidade de chamadas da máquina virtual.
+ */
+
+#define TAMANHO_PILHA_REGISTRADORES (1 << 22)   // Como na máquina virtual
+#define MAX_QUADROS (1 << 20)
+#define BYTES_POR_QUADRO 16                     // %rbx salvo e endereço de retorno
+#define FOLGA_PILHA_NATIVA (1 << 20)            // Para as rotinas em C chamadas pelo código gerado
+#define TAMANHO_ARENA_JIT ((size_t)1 << 28)     // Espaço de endereços reservado para o código
+
+typedef struct ContextoJIT {
+    void *rsp_salvo;                    // %rsp de quem chamou a entrada
+    void *topo_pilha_nativa;
+    void *limite_pilha_nativa;          // Abaixo disso, a chamada relata pilha esgotada
+    int32_t *globais;
+    void **tabela;                      // Endereço de cada função (ou do seu stub)
+    int32_t *base_registradores;
+    int32_t *limite_registradores;
+    EntradaSaidaBuferizada *es;
+    const ProgramaBytecode *programa;
+    uint8_t *arena;                     // Memória de código (reservada, sem permissões)
+    size_t usado_arena;
+    uint8_t *pilha_nativa;
+    void *rotina_divisao;               // Rotinas do runtime gerado
+    void *rotina_estouro;
+    int funcoes_compiladas;
+    int bytes_codigo;
+} ContextoJIT;
+
+typedef int (*EntradaJIT)(ContextoJIT *contexto, void *principal);
+
+/* ---------- Montagem de instruções ---------- */
+
+typedef struct CodigoJIT {
+    uint8_t *bytes;
+    int tamanho;
+    int capacidade;
+} CodigoJIT;
+
+enum { RAX = 0, RCX = 1, RDX = 2, RBX = 3, RSP = 4, RSI = 6, RDI = 7, R12 = 12, R13 = 13, R14 = 14, R15 = 15 };
+
+/* Condições dos jcc/setcc. */
+enum { CC_B = 0x2, CC_E = 0x4, CC_NE = 0x5, CC_A = 0x7, CC_L = 0xC, CC_GE = 0xD, CC_LE = 0xE, CC_G = 0xF };
+
+/* Desvios para fora da sequência de bytecode, resolvidos no fim da função. */
+#define ALVO_DIVISAO_ZERO (-1)
+#define ALVO_ESTOURO (-2)
+
+typedef struct CorrecaoJIT {
+    int posicao;                // Onde está o rel32
+    int alvo;                   // Índice da instrução de bytecode, ou ALVO_*
+} CorrecaoJIT;
+
+static CorrecaoJIT *correcoes = NULL;
+static int num_correcoes = 0;
+static int capacidade_correcoes = 0;
+
+static void *alocar_jit(void *antigo, size_t tamanho) {
+    void *novo = realloc(antigo, tamanho);
+    if (novo == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o JIT.\n");
+        exit(EXIT_FAILURE);
+    }
+    return novo;
+}
+
+static void emitir_byte(CodigoJIT *c, int valor) {
+    if (c->tamanho == c->capacidade) {
+        c->capacidade = c->capacidade == 0 ? 1024 : c->capacidade * 2;
+        c->bytes = alocar_jit(c->bytes, c->capacidade);
+    }
+    c->bytes[c->tamanho++] = (uint8_t)valor;
+}
+
+static void emitir_bytes(CodigoJIT *c, const char *bytes, int quantidade) {
+    for (int i = 0; i < quantidade; i++) emitir_byte(c, (uint8_t)bytes[i]);
+}
+
+static void escrever_int32(uint8_t *destino, int32_t valor) {
+    for (int i = 0; i < 4; i++) destino[i] = (uint8_t)((uint32_t)valor >> (8 * i));
+}
+
+static void emitir_int32(CodigoJIT *c, int32_t valor) {
+    for (int i = 0; i < 4; i++) emitir_byte(c, (uint8_t)((uint32_t)valor >> (8 * i)));
+}
+
+static void emitir_int64(CodigoJIT *c, uint64_t valor) {
+    for (int i = 0; i < 8; i++) emitir_byte(c, (uint8_t)(valor >> (8 * i)));
+}
+
+/**
+ * @brief Emite prefixo REX (se preciso), opcode (1 ou 2 bytes) e ModRM com
+ * operando em memória [base + deslocamento].
+ */
+static void emitir_op_memoria(CodigoJIT *c, int largura64, int opcode, int reg, int base, int32_t desloc) {
+    int rex = 0x40 | (largura64 ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((base & 8) ? 1 : 0);
+    if (rex != 0x40) emitir_byte(c, rex);
+    if (opcode > 0xff) emitir_byte(c, opcode >> 8);
+    emitir_byte(c, opcode & 0xff);
+    int mod = (desloc == 0 && (base & 7) != 5) ? 0 : (desloc >= -128 && desloc <= 127) ? 1 : 2;
+    emitir_byte(c, (mod << 6) | ((reg & 7) << 3) | (base & 7));
+    if ((base & 7) == 4) emitir_byte(c, 0x24);      // SIB de %rsp/%r12
+    if (mod == 1) emitir_byte(c, desloc & 0xff);
+    else if (mod == 2) emitir_int32(c, desloc);
+}
+
+static void carregar(CodigoJIT *c, int reg, int base, int32_t desloc) {
+    emitir_op_memoria(c, 0, 0x8B, reg, base, desloc);
+}
+
+static void armazenar(CodigoJIT *c, int reg, int base, int32_t desloc) {
+    emitir_op_memoria(c, 0, 0x89, reg, base, desloc);
+}
+
+static void carregar_64(CodigoJIT *c, int reg, int base, int32_t desloc) {
+    emitir_op_memoria(c, 1, 0x8B, reg, base, desloc);
+}
+
+/**
+ * @brief Instrução do grupo 1 (add = 0, cmp = 7) de 32 bits com operando em
+ * memória e imediato, na forma curta quando o imediato cabe num byte.
+ */
+static void emitir_grupo1_memoria(CodigoJIT *c, int extensao, int base, int32_t desloc, int32_t imediato) {
+    int curto = imediato >= -128 && imediato <= 127;
+    emitir_op_memoria(c, 0, curto ? 0x83 : 0x81, extensao, base, desloc);
+    if (curto) emitir_byte(c, imediato & 0xff);
+    else emitir_int32(c, imediato);
+}
+
+/* movl $imediato, desloc(base) */
+static void armazenar_imediato(CodigoJIT *c, int base, int32_t desloc, int32_t imediato) {
+    emitir_op_memoria(c, 0, 0xC7, 0, base, desloc);
+    emitir_int32(c, imediato);
+}
+
+/* movabs $funcao, %rax; call *%rax */
+static void chamar_rotina(CodigoJIT *c, void *funcao) {
+    emitir_bytes(c, "\x48\xB8", 2);
+    emitir_int64(c, (uint64_t)(uintptr_t)funcao);
+    emitir_bytes(c, "\xFF\xD0", 2);
+}
+
+/* movabs $endereco, %rax; jmp *%rax */
+static void saltar_para(CodigoJIT *c, void *endereco) {
+    emitir_bytes(c, "\x48\xB8", 2);
+    emitir_int64(c, (uint64_t)(uintptr_t)endereco);
+    emitir_bytes(c, "\xFF\xE0", 2);
+}
+
+/**
+ * @brief Desvio (jmp, se a condição for negativa, ou jcc) para uma instrução
+ * de bytecode ou para um dos ALVO_*.
+ */
+static void emitir_desvio(CodigoJIT *c, int condicao, int alvo) {
+    if (condicao < 0) {
+        emitir_byte(c, 0xE9);
+    } else {
+        emitir_byte(c, 0x0F);
+        emitir_byte(c, 0x80 | condicao);
+    }
+    if (num_correcoes == capacidade_correcoes) {
+        capacidade_correcoes = capacidade_correcoes == 0 ? 64 : capacidade_correcoes * 2;
+        correcoes = alocar_jit(correcoes, capacidade_correcoes * sizeof(CorrecaoJIT));
+    }
+    correcoes[num_correcoes].posicao = c->tamanho;
+    correcoes[num_correcoes].alvo = alvo;
+    num_correcoes++;
+    emitir_int32(c, 0);
+}
+
+/* setcc %al; movzbl %al, %eax; movl %eax, desloc(%rbx) */
+static void armazenar_condicao(CodigoJIT *c, int condicao, int destino) {
+    emitir_byte(c, 0x0F);
+    emitir_byte(c, 0x90 | condicao);
+    emitir_bytes(c, "\xC0\x0F\xB6\xC0", 4);
+    armazenar(c, RAX, RBX, 4 * destino);
+}
+
+/* ---------- Runtime chamado pelo código gerado ---------- */
+
+static void escrever_car_jit(EntradaSaidaBuferizada *es, int32_t valor) {
+    escrever_car_es(es, valor);
+}
+
+static void relatar_divisao_jit(ContextoJIT *contexto) {
+    descarregar_es(contexto->es);
+    fprintf(stderr, "Erro de execucao: divisao por zero.\n");
+}
+
+static void relatar_estouro_jit(ContextoJIT *contexto, int indice) {
+    fprintf(stderr, "Erro de execucao: pilha esgotada ao chamar '%s'.\n",
+            contexto->programa->funcoes[indice].nome);
+}
+
+/**
+ * @brief Copia o código para páginas novas da arena e as torna executáveis
+ * (e não mais graváveis).
+ */
+static void *instalar_codigo(ContextoJIT *contexto, const CodigoJIT *c) {
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    size_t tamanho = ((size_t)c->tamanho + pagina - 1) / pagina * pagina;
+    if (contexto->usado_arena + tamanho > TAMANHO_ARENA_JIT) {
+        fprintf(stderr, "Erro critico: Memoria de codigo do JIT esgotada.\n");
+        exit(EXIT_FAILURE);
+    }
+    uint8_t *destino = contexto->arena + contexto->usado_arena;
+    if (mprotect(destino, tamanho, PROT_READ | PROT_WRITE) != 0) {
+        perror("Erro critico: mprotect");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(destino, c->bytes, c->tamanho);
+    if (mprotect(destino, tamanho, PROT_READ | PROT_EXEC) != 0) {
+        perror("Erro critico: mprotect");
+        exit(EXIT_FAILURE);
+    }
+    contexto->usado_arena += tamanho;
+    contexto->bytes_codigo += c->tamanho;
+    return destino;
+}
+
+/* ---------- Tradução de uma função ---------- */
+
+/* O código do bloco 'programa' vem primeiro, seguido pelas funções na ordem da tabela. */
+static int fim_funcao(const ProgramaBytecode *programa, int indice) {
+    int principal = programa->num_funcoes - 1;
+    int seguinte = indice == principal ? 0 : indice + 1;
+    return seguinte < principal ? programa->funcoes[seguinte].inicio : programa->tamanho;
+}
+
+/* Condição x86 das comparações, na ordem EQ, NE, LT, LE, GT, GE do bytecode. */
+static const int condicoes_comparacao[] = { CC_E, CC_NE, CC_L, CC_LE, CC_G, CC_GE };
+
+static void traduzir_instrucao(CodigoJIT *c, const ProgramaBytecode *programa, const InstrucaoBytecode *i) {
+    int a = 4 * i->a;
+    switch ((OpBytecode)i->op) {
+        case BC_CONST:
+            armazenar_imediato(c, RBX, a, i->b);
+            break;
+        case BC_MOVE:
+            carregar(c, RAX, RBX, 4 * i->b);
+            armazenar(c, RAX, RBX, a);
+            break;
+        case BC_LOADG:
+            carregar(c, RAX, R12, 4 * i->b);
+            armazenar(c, RAX, RBX, a);
+            break;
+        case BC_STOREG:
+            carregar(c, RAX, RBX, a);
+            armazenar(c, RAX, R12, 4 * i->b);
+            break;
+        case BC_INCG:
+            emitir_grupo1_memoria(c, 0, R12, 4 * i->b, i->c);
+            break;
+
+        case BC_ADD:
+        case BC_SUB:
+        case BC_MUL:
+            carregar(c, RAX, RBX, 4 * i->b);
+            emitir_op_memoria(c, 0, i->op == BC_ADD ? 0x03 : i->op == BC_SUB ? 0x2B : 0x0FAF, RAX, RBX, 4 * i->c);
+            armazenar(c, RAX, RBX, a);
+            break;
+        case BC_DIV:
+            carregar(c, RCX, RBX, 4 * i->c);
+            emitir_bytes(c, "\x85\xC9", 2);                     // test %ecx, %ecx
+            emitir_desvio(c, CC_E, ALVO_DIVISAO_ZERO);
+            carregar(c, RAX, RBX, 4 * i->b);
+            // Como o 'div' do MIPS: INT_MIN / -1 resulta em INT_MIN (o idivl geraria exceção).
+            emitir_bytes(c, "\x83\xF9\xFF\x75\x04", 5);         // cmp $-1, %ecx; jne 1f
+            emitir_bytes(c, "\xF7\xD8\xEB\x03", 4);             // negl %eax; jmp 2f
+            emitir_bytes(c, "\x99\xF7\xF9", 3);                 // 1: cltd; idivl %ecx
+            armazenar(c, RAX, RBX, a);                          // 2:
+            break;
+        case BC_ADDK:
+            carregar(c, RAX, RBX, 4 * i->b);
+            emitir_byte(c, 0x05);
+            emitir_int32(c, i->c);
+            armazenar(c, RAX, RBX, a);
+            break;
+        case BC_MULK: {
+            int curto = i->c >= -128 && i->c <= 127;
+            emitir_op_memoria(c, 0, curto ? 0x6B : 0x69, RAX, RBX, 4 * i->b);
+            if (curto) emitir_byte(c, i->c & 0xff);
+            else emitir_int32(c, i->c);
+            armazenar(c, RAX, RBX, a);
+            break;
+        }
+        case BC_DIVK:
+            carregar(c, RAX, RBX, 4 * i->b);
+            if (i->c == -1) {
+                emitir_bytes(c, "\xF7\xD8", 2);                 // negl %eax
+            } else {
+                emitir_byte(c, 0xB9);                           // movl $c, %ecx
+                emitir_int32(c, i->c);
+                emitir_bytes(c, "\x99\xF7\xF9", 3);             // cltd; idivl %ecx
+            }
+            armazenar(c, RAX, RBX, a);
+            break;
+        case BC_NEG:
+            carregar(c, RAX, RBX, 4 * i->b);
+            emitir_bytes(c, "\xF7\xD8", 2);
+            armazenar(c, RAX, RBX, a);
+            break;
+        case BC_NOT:
+            emitir_grupo1_memoria(c, 7, RBX, 4 * i->b, 0);
+            armazenar_condicao(c, CC_E, i->a);
+            break;
+
+        case BC_EQ: case BC_NE: case BC_LT: case BC_LE: case BC_GT: case BC_GE:
+            carregar(c, RAX, RBX, 4 * i->b);
+            emitir_op_memoria(c, 0, 0x3B, RAX, RBX, 4 * i->c);
+            armazenar_condicao(c, condicoes_comparacao[i->op - BC_EQ], i->a);
+            break;
+        case BC_TRUNCA_CAR:
+            emitir_op_memoria(c, 0, 0x0FBE, RAX, RBX, a);       // movsbl
+            armazenar(c, RAX, RBX, a);
+            break;
+
+        case BC_JMP:
+            emitir_desvio(c, -1, i->c);
+            break;
+        case BC_JZ:
+        case BC_JNZ:
+            emitir_grupo1_memoria(c, 7, RBX, a, 0);
+            emitir_desvio(c, i->op == BC_JZ ? CC_E : CC_NE, i->c);
+            break;
+        case BC_JEQ: case BC_JNE: case BC_JLT: case BC_JLE: case BC_JGT: case BC_JGE:
+            carregar(c, RAX, RBX, a);
+            emitir_op_memoria(c, 0, 0x3B, RAX, RBX, 4 * i->b);
+            emitir_desvio(c, condicoes_comparacao[i->op - BC_JEQ], i->c);
+            break;
+        case BC_JEQK: case BC_JNEK: case BC_JLTK: case BC_JLEK: case BC_JGTK: case BC_JGEK:
+            emitir_grupo1_memoria(c, 7, RBX, a, i->b);
+            emitir_desvio(c, condicoes_comparacao[i->op - BC_JEQK], i->c);
+            break;
+
+        case BC_CALL:
+            emitir_byte(c, 0x53);                               // push %rbx
+            emitir_op_memoria(c, 1, 0x8D, RBX, RBX, a);         // lea a(%rbx), %rbx
+            emitir_op_memoria(c, 0, 0xFF, 2, R13, 8 * i->b);    // call *8b(%r13)
+            emitir_byte(c, 0x5B);                               // pop %rbx
+            break;
+        case BC_RET:
+            carregar(c, RAX, RBX, a);
+            armazenar(c, RAX, RBX, 0);
+            emitir_byte(c, 0xC3);
+            break;
+        case BC_RET0:
+            armazenar_imediato(c, RBX, 0, 0);
+            emitir_byte(c, 0xC3);
+            break;
+
+        case BC_LEIA:
+            carregar_64(c, RDI, R15, offsetof(ContextoJIT, es));
+            chamar_rotina(c, (void *)ler_int_es);
+            armazenar(c, RAX, RBX, a);
+            break;
+        case BC_ESCREVA_INT:
+        case BC_ESCREVA_CAR:
+            carregar_64(c, RDI, R15, offsetof(ContextoJIT, es));
+            carregar(c, RSI, RBX, a);
+            chamar_rotina(c, i->op == BC_ESCREVA_INT ? (void *)escrever_int_es : (void *)escrever_car_jit);
+            break;
+        case BC_ESCREVA_STR:
+            carregar_64(c, RDI, R15, offsetof(ContextoJIT, es));
+            emitir_bytes(c, "\x48\xBE", 2);                     // movabs $bytes, %rsi
+            emitir_int64(c, (uint64_t)(uintptr_t)programa->strings[i->b].bytes);
+            emitir_byte(c, 0xBA);                               // movl $tamanho, %edx
+            emitir_int32(c, programa->strings[i->b].tamanho);
+            chamar_rotina(c, (void *)escrever_texto_es);
+            break;
+        case BC_NOVALINHA:
+            carregar_64(c, RDI, R15, offsetof(ContextoJIT, es));
+            emitir_byte(c, 0xBE);                               // movl $'\n', %esi
+            emitir_int32(c, '\n');
+            chamar_rotina(c, (void *)escrever_car_jit);
+            break;
+        case BC_FIM:
+            emitir_byte(c, 0xC3);                               // Volta para a entrada
+            break;
+        case NUM_OPS_BYTECODE:
+            break;
+    }
+}
+
+/**
+ * @brief Traduz a função de índice dado, instala o código e atualiza a tabela.
+ */
+static void *compilar_funcao_jit(ContextoJIT *contexto, int indice) {
+    const ProgramaBytecode *programa = contexto->programa;
+    const FuncaoBytecode *funcao = &programa->funcoes[indice];
+    int inicio = funcao->inicio;
+    int fim = fim_funcao(programa, indice);
+    int *deslocamentos = alocar_jit(NULL, (fim - inicio + 1) * sizeof(int));
+    CodigoJIT c = { NULL, 0, 0 };
+    num_correcoes = 0;
+
+    // Prólogo: pilhas esgotadas, depois as locais zeradas (como na máquina virtual).
+    emitir_op_memoria(&c, 1, 0x3B, RSP, R15, offsetof(ContextoJIT, limite_pilha_nativa));
+    emitir_desvio(&c, CC_B, ALVO_ESTOURO);
+    emitir_op_memoria(&c, 1, 0x8D, RAX, RBX, 4 * funcao->num_registradores);
+    emitir_bytes(&c, "\x4C\x39\xF0", 3);                        // cmp %r14, %rax
+    emitir_desvio(&c, CC_A, ALVO_ESTOURO);
+    int num_locais = funcao->num_registradores - funcao->num_parametros;
+    if (num_locais <= 8) {
+        for (int r = funcao->num_parametros; r < funcao->num_registradores; r++) armazenar_imediato(&c, RBX, 4 * r, 0);
+    } else {
+        emitir_op_memoria(&c, 1, 0x8D, RDI, RBX, 4 * funcao->num_parametros);
+        emitir_byte(&c, 0xB9);                                  // movl $num_locais, %ecx
+        emitir_int32(&c, num_locais);
+        emitir_bytes(&c, "\x31\xC0\xF3\xAB", 4);                // xorl %eax, %eax; rep stosl
+    }
+
+    for (int pc = inicio; pc < fim; pc++) {
+        deslocamentos[pc - inicio] = c.tamanho;
+        traduzir_instrucao(&c, programa, &programa->codigo[pc]);
+    }
+    deslocamentos[fim - inicio] = c.tamanho;
+
+    // Saídas de erro, fora do caminho principal.
+    int rotulo_estouro = c.tamanho;
+    emitir_byte(&c, 0xBE);                                      // movl $indice, %esi
+    emitir_int32(&c, indice);
+    saltar_para(&c, contexto->rotina_estouro);
+    int rotulo_divisao = c.tamanho;
+    saltar_para(&c, contexto->rotina_divisao);
+
+    for (int k = 0; k < num_correcoes; k++) {
+        int alvo = correcoes[k].alvo == ALVO_ESTOURO ? rotulo_estouro
+                 : correcoes[k].alvo == ALVO_DIVISAO_ZERO ? rotulo_divisao
+                 : deslocamentos[correcoes[k].alvo - inicio];
+        escrever_int32(c.bytes + correcoes[k].posicao, alvo - (correcoes[k].posicao + 4));
+    }
+
+    void *endereco = instalar_codigo(contexto, &c);
+    contexto->tabela[indice] = endereco;
+    contexto->funcoes_compiladas++;
+    free(deslocamentos);
+    free(c.bytes);
+    return endereco;
+}
+
+/* Chamada pelo stub na primeira chamada da função (compilação preguiçosa). */
+static void *resolver_funcao_jit(ContextoJIT *contexto, int indice) {
+    return compilar_funcao_jit(contexto, indice);
+}
+
+/* ---------- Runtime gerado ---------- */
+
+static void emitir_salto_local(CodigoJIT *c, int alvo) {
+    emitir_byte(c, 0xE9);
+    emitir_int32(c, alvo - (c->tamanho + 4));
+}
+
+/**
+ * @brief Gera a entrada (troca de pilha e registradores fixos), a saída, as
+ * rotinas de erro, o resolvedor e um stub por função, que ficam na tabela
+ * até a função ser compilada.
+ */
+static EntradaJIT gerar_runtime_jit(ContextoJIT *contexto) {
+    const ProgramaBytecode *programa = contexto->programa;
+    CodigoJIT c = { NULL, 0, 0 };
+
+    // int entrada(ContextoJIT *contexto, void *principal)
+    emitir_bytes(&c, "\x53\x41\x54\x41\x55\x41\x56\x41\x57", 9);   // push %rbx, %r12-%r15
+    emitir_bytes(&c, "\x49\x89\xFF", 3);                            // mov %rdi, %r15
+    emitir_op_memoria(&c, 1, 0x89, RSP, R15, offsetof(ContextoJIT, rsp_salvo));
+    carregar_64(&c, R12, R15, offsetof(ContextoJIT, globais));
+    carregar_64(&c, R13, R15, offsetof(ContextoJIT, tabela));
+    carregar_64(&c, R14, R15, offsetof(ContextoJIT, limite_registradores));
+    carregar_64(&c, RBX, R15, offsetof(ContextoJIT, base_registradores));
+    carregar_64(&c, RSP, R15, offsetof(ContextoJIT, topo_pilha_nativa));
+    emitir_bytes(&c, "\x53\xFF\xD6\x5B", 4);                        // push %rbx; call *%rsi; pop %rbx
+    emitir_bytes(&c, "\x31\xC0", 2);                                // xorl %eax, %eax
+    int saida = c.tamanho;
+    carregar_64(&c, RSP, R15, offsetof(ContextoJIT, rsp_salvo));
+    emitir_bytes(&c, "\x41\x5F\x41\x5E\x41\x5D\x41\x5C\x5B\xC3", 10);
+
+    int rotina_divisao = c.tamanho;
+    emitir_bytes(&c, "\x4C\x89\xFF", 3);                            // mov %r15, %rdi
+    chamar_rotina(&c, (void *)relatar_divisao_jit);
+    emitir_byte(&c, 0xB8);
+    emitir_int32(&c, EXIT_FAILURE);
+    emitir_salto_local(&c, saida);
+
+    int rotina_estouro = c.tamanho;                                 // %esi = índice da função
+    emitir_bytes(&c, "\x4C\x89\xFF", 3);
+    chamar_rotina(&c, (void *)relatar_estouro_jit);
+    emitir_byte(&c, 0xB8);
+    emitir_int32(&c, EXIT_FAILURE);
+    emitir_salto_local(&c, saida);
+
+    int resolvedor = c.tamanho;                                     // %esi = índice da função
+    emitir_bytes(&c, "\x4C\x89\xFF", 3);
+    chamar_rotina(&c, (void *)resolver_funcao_jit);
+    emitir_bytes(&c, "\xFF\xE0", 2);                                // jmp *%rax
+
+    int *stubs = alocar_jit(NULL, programa->num_funcoes * sizeof(int));
+    for (int f = 0; f < programa->num_funcoes; f++) {
+        stubs[f] = c.tamanho;
+        emitir_byte(&c, 0xBE);                                      // movl $f, %esi
+        emitir_int32(&c, f);
+        emitir_salto_local(&c, resolvedor);
+    }
+
+    uint8_t *base = instalar_codigo(contexto, &c);
+    contexto->bytes_codigo -= c.tamanho;                            // O relatório conta só as funções
+    contexto->rotina_divisao = base + rotina_divisao;
+    contexto->rotina_estouro = base + rotina_estouro;
+    for (int f = 0; f < programa->num_funcoes; f++) contexto->tabela[f] = base + stubs[f];
+    free(stubs);
+    free(c.bytes);
+    return (EntradaJIT)(void *)base;
+}
+
+static void *mapear_jit(size_t tamanho, int protecao) {
+    void *memoria = mmap(NULL, tamanho, protecao, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (memoria == MAP_FAILED) {
+        perror("Erro critico: mmap");
+        exit(EXIT_FAILURE);
+    }
+    return memoria;
+}
+
+int executar_jit(const ProgramaBytecode *programa, EntradaSaidaBuferizada *es, int compilacao_preguicosa) {
+    ContextoJIT contexto;
+    memset(&contexto, 0, sizeof(ContextoJIT));
+    contexto.programa = programa;
+    contexto.es = es;
+    contexto.globais = calloc(programa->num_globais + 1, sizeof(int32_t));
+    contexto.base_registradores = calloc(TAMANHO_PILHA_REGISTRADORES, sizeof(int32_t));
+    contexto.tabela = malloc(programa->num_funcoes * sizeof(void *));
+    if (contexto.globais == NULL || contexto.base_registradores == NULL || contexto.tabela == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o JIT.\n");
+        exit(EXIT_FAILURE);
+    }
+    contexto.limite_registradores = contexto.base_registradores + TAMANHO_PILHA_REGISTRADORES;
+
+    size_t tamanho_pilha = (size_t)MAX_QUADROS * BYTES_POR_QUADRO + FOLGA_PILHA_NATIVA;
+    contexto.pilha_nativa = mapear_jit(tamanho_pilha, PROT_READ | PROT_WRITE);
+    contexto.limite_pilha_nativa = contexto.pilha_nativa + FOLGA_PILHA_NATIVA;
+    contexto.topo_pilha_nativa = contexto.pilha_nativa + tamanho_pilha;
+    contexto.arena = mapear_jit(TAMANHO_ARENA_JIT, PROT_NONE);
+
+    EntradaJIT entrada = gerar_runtime_jit(&contexto);
+    int principal = programa->num_funcoes - 1;
+    void *codigo_principal = compilar_funcao_jit(&contexto, principal);
+    if (!compilacao_preguicosa) {
+        for (int f = 0; f < principal; f++) compilar_funcao_jit(&contexto, f);
+    }
+
+    int status = entrada(&contexto, codigo_principal);
+    descarregar_es(es);
+
+    printf("JIT: %d de %d funcao(oes) compilada(s), %d bytes de codigo x86-64.\n",
+           contexto.funcoes_compiladas, programa->num_funcoes, contexto.bytes_codigo);
+
+    munmap(contexto.arena, TAMANHO_ARENA_JIT);
+    munmap(contexto.pilha_nativa, tamanho_pilha);
+    free(contexto.globais);
+    free(contexto.base_registradores);
+    free(contexto.tabela);
+    free(correcoes);
+    correcoes = NULL;
+    capacidade_correcoes = 0;
+    return status;
+}
+
+#else
+
+int executar_jit(const ProgramaBytecode *programa, EntradaSaidaBuferizada *es, int compilacao_preguicosa) {
+    (void)compilacao_preguicosa;
+    fprintf(stderr, "Aviso: JIT disponivel apenas em Linux x86-64; executando na maquina virtual.\n");
+    return executar_bytecode(programa, es);
+}
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef JIT_X86_H
+#define JIT_X86_H
+
+#include "modulo_bytecode.h"
+#include "modulo_es_buferizada.h"
+
+/*
+ * Compilador JIT (--jit): traduz o bytecode de cada função (e do bloco
+ * 'programa') para código de máquina x86-64 em memória obtida com mmap e o
+ * executa diretamente, chamando o runtime de E/S buferizada em C.
+ *
+ * A memória de código segue W^X: cada função é escrita em páginas novas com
+ * permissão de escrita, que passam a ser só de leitura e execução antes de o
+ * código rodar; nenhuma página executável volta a ser gravável.
+ *
+ * Com a compilação preguiçosa (padrão), só o bloco 'programa' é compilado
+ * no início. As chamadas passam por uma tabela de endereços que começa
+ * apontando para stubs; na primeira chamada, o stub compila a função,
+ * atualiza a tabela e salta para o código gerado.
+ *
+ * Disponível apenas em Linux x86-64; nas demais plataformas o programa roda
+ * na máquina virtual de bytecode.
+ */
+
+/**
+ * @brief Compila e executa o programa a partir do bloco 'programa'.
+ * @param compilacao_preguicosa 1 compila cada função na primeira chamada;
+ * 0 compila todas antes de executar.
+ * @return 0, ou EXIT_FAILURE após um erro de execução (divisão por zero,
+ * pilha esgotada), já relatado em stderr.
+ */
+int executar_jit(const ProgramaBytecode *programa, EntradaSaidaBuferizada *es, int compilacao_preguicosa);
+
+#endif
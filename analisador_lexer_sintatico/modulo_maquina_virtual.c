@@ -0,0 +1,158 @@
+#include "modulo_maquina_virtual.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TAMANHO_PILHA_REGISTRADORES (1 << 22)   // Registradores de todos os quadros ativos
+#define MAX_QUADROS (1 << 20)                   // Profundidade máxima de chamadas
+
+typedef struct QuadroChamada {
+    const InstrucaoBytecode *retorno;
+    int32_t *base;              // Registradores de quem chamou
+} QuadroChamada;
+
+/* Aritmética com complemento de dois (como no MIPS), sem comportamento indefinido em C. */
+#define SOMA_32(x, y) ((int32_t)((uint32_t)(x) + (uint32_t)(y)))
+#define SUB_32(x, y) ((int32_t)((uint32_t)(x) - (uint32_t)(y)))
+#define MULT_32(x, y) ((int32_t)((uint32_t)(x) * (uint32_t)(y)))
+
+static int32_t dividir_32(int32_t x, int32_t y) {
+    // O 'div' do MIPS devolve INT_MIN para INT_MIN / -1.
+    if (y == -1) return SUB_32(0, x);
+    return x / y;
+}
+
+int executar_bytecode(const ProgramaBytecode *programa, EntradaSaidaBuferizada *es) {
+    int32_t *pilha = calloc(TAMANHO_PILHA_REGISTRADORES, sizeof(int32_t));
+    QuadroChamada *quadros = malloc(MAX_QUADROS * sizeof(QuadroChamada));
+    int32_t *globais = calloc(programa->num_globais + 1, sizeof(int32_t));
+    if (pilha == NULL || quadros == NULL || globais == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a maquina virtual.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const InstrucaoBytecode *codigo = programa->codigo;
+    const FuncaoBytecode *funcoes = programa->funcoes;
+    const int32_t *limite = pilha + TAMANHO_PILHA_REGISTRADORES;
+    const InstrucaoBytecode *ip = codigo + funcoes[programa->num_funcoes - 1].inicio;
+    const InstrucaoBytecode *i;
+    int32_t *r = pilha;
+    int profundidade = 0;
+    int status = 0;
+
+#ifdef __GNUC__
+#define ROTULO_OP_BYTECODE(nome) &&op_##nome,
+    static void *const tratadores[NUM_OPS_BYTECODE] = { LISTA_OPS_BYTECODE(ROTULO_OP_BYTECODE) };
+#undef ROTULO_OP_BYTECODE
+#define CASO(nome) op_##nome:
+#define DESPACHAR() do { i = ip++; goto *tratadores[i->op]; } while (0)
+    DESPACHAR();
+#else
+#define CASO(nome) case nome:
+#define DESPACHAR() continue
+    for (;;) {
+        i = ip++;
+        switch (i->op) {
+#endif
+
+    CASO(BC_CONST)  r[i->a] = i->b; DESPACHAR();
+    CASO(BC_MOVE)   r[i->a] = r[i->b]; DESPACHAR();
+    CASO(BC_LOADG)  r[i->a] = globais[i->b]; DESPACHAR();
+    CASO(BC_STOREG) globais[i->b] = r[i->a]; DESPACHAR();
+    CASO(BC_INCG)   globais[i->b] = SOMA_32(globais[i->b], i->c); DESPACHAR();
+
+    CASO(BC_ADD)    r[i->a] = SOMA_32(r[i->b], r[i->c]); DESPACHAR();
+    CASO(BC_SUB)    r[i->a] = SUB_32(r[i->b], r[i->c]); DESPACHAR();
+    CASO(BC_MUL)    r[i->a] = MULT_32(r[i->b], r[i->c]); DESPACHAR();
+    CASO(BC_DIV)
+        if (r[i->c] == 0) goto divisao_por_zero;
+        r[i->a] = dividir_32(r[i->b], r[i->c]);
+        DESPACHAR();
+    CASO(BC_ADDK)   r[i->a] = SOMA_32(r[i->b], i->c); DESPACHAR();
+    CASO(BC_MULK)   r[i->a] = MULT_32(r[i->b], i->c); DESPACHAR();
+    CASO(BC_DIVK)   r[i->a] = dividir_32(r[i->b], i->c); DESPACHAR();
+    CASO(BC_NEG)    r[i->a] = SUB_32(0, r[i->b]); DESPACHAR();
+    CASO(BC_NOT)    r[i->a] = !r[i->b]; DESPACHAR();
+
+    CASO(BC_EQ)     r[i->a] = r[i->b] == r[i->c]; DESPACHAR();
+    CASO(BC_NE)     r[i->a] = r[i->b] != r[i->c]; DESPACHAR();
+    CASO(BC_LT)     r[i->a] = r[i->b] < r[i->c]; DESPACHAR();
+    CASO(BC_LE)     r[i->a] = r[i->b] <= r[i->c]; DESPACHAR();
+    CASO(BC_GT)     r[i->a] = r[i->b] > r[i->c]; DESPACHAR();
+    CASO(BC_GE)     r[i->a] = r[i->b] >= r[i->c]; DESPACHAR();
+    CASO(BC_TRUNCA_CAR) r[i->a] = (signed char)r[i->a]; DESPACHAR();
+
+    CASO(BC_JMP)    ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JZ)     if (r[i->a] == 0) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JNZ)    if (r[i->a] != 0) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JEQ)    if (r[i->a] == r[i->b]) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JNE)    if (r[i->a] != r[i->b]) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JLT)    if (r[i->a] < r[i->b]) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JLE)    if (r[i->a] <= r[i->b]) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JGT)    if (r[i->a] > r[i->b]) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JGE)    if (r[i->a] >= r[i->b]) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JEQK)   if (r[i->a] == i->b) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JNEK)   if (r[i->a] != i->b) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JLTK)   if (r[i->a] < i->b) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JLEK)   if (r[i->a] <= i->b) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JGTK)   if (r[i->a] > i->b) ip = codigo + i->c; DESPACHAR();
+    CASO(BC_JGEK)   if (r[i->a] >= i->b) ip = codigo + i->c; DESPACHAR();
+
+    CASO(BC_CALL) {
+        const FuncaoBytecode *funcao = &funcoes[i->b];
+        int32_t *base = r + i->a;
+        if (profundidade == MAX_QUADROS || base + funcao->num_registradores > limite) {
+            fprintf(stderr, "Erro de execucao: pilha esgotada ao chamar '%s'.\n", funcao->nome);
+            status = EXIT_FAILURE;
+            goto fim;
+        }
+        quadros[profundidade].retorno = ip;
+        quadros[profundidade].base = r;
+        profundidade++;
+        // Locais começam zeradas, como os quadros novos da pilha do simulador.
+        memset(base + funcao->num_parametros, 0,
+               (size_t)(funcao->num_registradores - funcao->num_parametros) * sizeof(int32_t));
+        r = base;
+        ip = codigo + funcao->inicio;
+        DESPACHAR();
+    }
+    CASO(BC_RET)
+        r[0] = r[i->a];
+        profundidade--;
+        ip = quadros[profundidade].retorno;
+        r = quadros[profundidade].base;
+        DESPACHAR();
+    CASO(BC_RET0)
+        r[0] = 0;
+        profundidade--;
+        ip = quadros[profundidade].retorno;
+        r = quadros[profundidade].base;
+        DESPACHAR();
+
+    CASO(BC_LEIA)        r[i->a] = ler_int_es(es); DESPACHAR();
+    CASO(BC_ESCREVA_INT) escrever_int_es(es, r[i->a]); DESPACHAR();
+    CASO(BC_ESCREVA_CAR) escrever_car_es(es, r[i->a]); DESPACHAR();
+    CASO(BC_ESCREVA_STR)
+        escrever_texto_es(es, programa->strings[i->b].bytes, programa->strings[i->b].tamanho);
+        DESPACHAR();
+    CASO(BC_NOVALINHA)   escrever_car_es(es, '\n'); DESPACHAR();
+    CASO(BC_FIM)         goto fim;
+
+#ifndef __GNUC__
+        }
+    }
+#endif
+#undef CASO
+#undef DESPACHAR
+
+divisao_por_zero:
+    descarregar_es(es);
+    fprintf(stderr, "Erro de execucao: divisao por zero.\n");
+    status = EXIT_FAILURE;
+fim:
+    descarregar_es(es);
+    free(pilha);
+    free(quadros);
+    free(globais);
+    return status;
+}
@@ -0,0 +1,20 @@
+#ifndef MAQUINA_VIRTUAL_H
+#define MAQUINA_VIRTUAL_H
+
+#include "modulo_bytecode.h"
+#include "modulo_es_buferizada.h"
+
+/*
+ * Interpretador do bytecode. Com GCC ou Clang o despacho é "threaded": cada
+ * instrução salta diretamente para o tratador da seguinte por um goto
+ * computado; nos demais compiladores é um switch dentro de um laço.
+ */
+
+/**
+ * @brief Executa o programa a partir do bloco 'programa'.
+ * @return 0, ou EXIT_FAILURE após um erro de execução (divisão por zero,
+ * pilha esgotada), já relatado em stderr.
+ */
+int executar_bytecode(const ProgramaBytecode *programa, EntradaSaidaBuferizada *es);
+
+#endif
@@ -0,0 +1,358 @@
+#include "modulo_otimizador_lacos.h"
+#include <stdint.h>
+#include <limits.h>
+
+/* ---------- Consultas sobre a AST ---------- */
+
+static int lista_contem(const NoAST *no, TipoNoAST tipo);
+
+/**
+ * @brief Indica se a subárvore (sem seguir o 'proximo' da raiz) contém um nó do tipo dado.
+ */
+static int subarvore_contem(const NoAST *no, TipoNoAST tipo) {
+    if (no == NULL) return 0;
+    if (no->tipo_no == tipo) return 1;
+    return lista_contem(no->filho1, tipo) || lista_contem(no->filho2, tipo) || lista_contem(no->filho3, tipo);
+}
+
+static int lista_contem(const NoAST *no, TipoNoAST tipo) {
+    for (; no != NULL; no = no->proximo) {
+        if (subarvore_contem(no, tipo)) return 1;
+    }
+    return 0;
+}
+
+static int lista_conta_nos(const NoAST *no);
+
+static int subarvore_conta_nos(const NoAST *no) {
+    if (no == NULL) return 0;
+    return 1 + lista_conta_nos(no->filho1) + lista_conta_nos(no->filho2) + lista_conta_nos(no->filho3);
+}
+
+static int lista_conta_nos(const NoAST *no) {
+    int total = 0;
+    for (; no != NULL; no = no->proximo) total += subarvore_conta_nos(no);
+    return total;
+}
+
+static int lista_conta_alteracoes(const NoAST *no, const EntradaTabela *variavel, const NoAST **ultima);
+
+/**
+ * @brief Conta as atribuições e leituras ('leia') da variável na subárvore.
+ * @param ultima Recebe a última atribuição encontrada.
+ */
+static int subarvore_conta_alteracoes(const NoAST *no, const EntradaTabela *variavel, const NoAST **ultima) {
+    if (no == NULL) return 0;
+    int total = 0;
+    if ((no->tipo_no == NO_COMANDO_ATRIBUICAO || no->tipo_no == NO_COMANDO_LEIA)
+        && no->filho1->entrada_tabela == variavel) {
+        total++;
+        if (no->tipo_no == NO_COMANDO_ATRIBUICAO) *ultima = no;
+    }
+    return total + lista_conta_alteracoes(no->filho1, variavel, ultima)
+                 + lista_conta_alteracoes(no->filho2, variavel, ultima)
+                 + lista_conta_alteracoes(no->filho3, variavel, ultima);
+}
+
+static int lista_conta_alteracoes(const NoAST *no, const EntradaTabela *variavel, const NoAST **ultima) {
+    int total = 0;
+    for (; no != NULL; no = no->proximo) total += subarvore_conta_alteracoes(no, variavel, ultima);
+    return total;
+}
+
+static int conta_alteracoes_no_laco(const NoAST *laco, const EntradaTabela *variavel, const NoAST **ultima) {
+    *ultima = NULL;
+    return subarvore_conta_alteracoes(laco->filho1, variavel, ultima)
+         + subarvore_conta_alteracoes(laco->filho2, variavel, ultima);
+}
+
+/**
+ * @brief Indica se a variável é declarada (como local) em algum ponto da subárvore.
+ */
+static int declarada_em(const NoAST *no, const EntradaTabela *variavel) {
+    for (; no != NULL; no = no->proximo) {
+        if (no->tipo_no == NO_DECL_VARIAVEL && no->filho1->entrada_tabela == variavel) return 1;
+        if (declarada_em(no->filho1, variavel) || declarada_em(no->filho2, variavel) || declarada_em(no->filho3, variavel)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Indica se a variável é um parâmetro ou uma local da função atual,
+ * e portanto não pode ser alterada por outras funções chamadas no laço.
+ */
+static int variavel_privada(const EntradaTabela *variavel, const NoAST *funcao) {
+    if (funcao == NULL) return 0;
+    return variavel->posicao >= 0 || declarada_em(funcao->filho3, variavel);
+}
+
+static const NoAST *corpo_do_laco(const NoAST *laco) {
+    const NoAST *corpo = laco->filho2;
+    return (corpo != NULL && corpo->tipo_no == NO_BLOCO) ? corpo->filho2 : corpo;
+}
+
+int expressoes_iguais(const NoAST *a, const NoAST *b) {
+    if (a == NULL || b == NULL) return a == b;
+    if (a->tipo_no != b->tipo_no) return 0;
+    switch (a->tipo_no) {
+        case NO_ID:          return a->entrada_tabela == b->entrada_tabela;
+        case NO_LITERAL_INT: return a->ival == b->ival;
+        case NO_LITERAL_CAR: return a->cval == b->cval;
+        case NO_OP_SOMA: case NO_OP_SUB: case NO_OP_MULT: case NO_OP_DIV:
+        case NO_OP_IGUAL: case NO_OP_DIFERENTE: case NO_OP_MENOR: case NO_OP_MAIOR:
+        case NO_OP_MENOR_IGUAL: case NO_OP_MAIOR_IGUAL: case NO_OP_E: case NO_OP_OU:
+        case NO_OP_NEGACAO:
+            return expressoes_iguais(a->filho1, b->filho1) && expressoes_iguais(a->filho2, b->filho2);
+        default:
+            return 0;
+    }
+}
+
+/* ---------- Invariantes ---------- */
+
+typedef struct ContextoAnalise {
+    const NoAST *laco;
+    const NoAST *funcao;
+    int laco_tem_chamada;
+    AnaliseLaco *analise;
+    int registrador_livre;
+} ContextoAnalise;
+
+static int e_invariante(const NoAST *no, const ContextoAnalise *ctx) {
+    const NoAST *ultima;
+    switch (no->tipo_no) {
+        case NO_LITERAL_INT:
+        case NO_LITERAL_CAR:
+            return 1;
+        case NO_ID:
+            if (no->entrada_tabela == NULL) return 0;
+            if (ctx->laco_tem_chamada && !variavel_privada(no->entrada_tabela, ctx->funcao)) return 0;
+            return conta_alteracoes_no_laco(ctx->laco, no->entrada_tabela, &ultima) == 0;
+        case NO_OP_SOMA: case NO_OP_SUB: case NO_OP_MULT: case NO_OP_DIV:
+        case NO_OP_IGUAL: case NO_OP_DIFERENTE: case NO_OP_MENOR: case NO_OP_MAIOR:
+        case NO_OP_MENOR_IGUAL: case NO_OP_MAIOR_IGUAL: case NO_OP_E: case NO_OP_OU:
+            return e_invariante(no->filho1, ctx) && e_invariante(no->filho2, ctx);
+        case NO_OP_NEGACAO:
+            return e_invariante(no->filho1, ctx);
+        default:
+            return 0;
+    }
+}
+
+static int e_aritmetica(const NoAST *no) {
+    return no->tipo_no == NO_OP_SOMA || no->tipo_no == NO_OP_SUB
+        || no->tipo_no == NO_OP_MULT || no->tipo_no == NO_OP_DIV;
+}
+
+static int adicionar_valor(ContextoAnalise *ctx, TipoValorLaco tipo, NoAST *expressao, NoAST *atualizacao, int passo) {
+    AnaliseLaco *analise = ctx->analise;
+    for (int i = 0; i < analise->num_valores; i++) {
+        if (analise->valores[i].tipo == tipo && expressoes_iguais(analise->valores[i].expressao, expressao)) return 1;
+    }
+    if (ctx->registrador_livre >= NUM_REGISTRADORES_LACO) return 0;
+
+    ValorLaco *valor = &analise->valores[analise->num_valores++];
+    valor->tipo = tipo;
+    valor->expressao = expressao;
+    valor->atualizacao = atualizacao;
+    valor->passo = passo;
+    valor->registrador = ctx->registrador_livre++;
+    if (tipo == VALOR_INVARIANTE) analise->num_invariantes++;
+    else analise->num_inducao++;
+    return 1;
+}
+
+/**
+ * @brief Procura as maiores subexpressões aritméticas invariantes.
+ * O operando direito de '&&'/'||' não é visitado, pois pode não ser avaliado.
+ */
+static void coletar_invariantes(NoAST *no, ContextoAnalise *ctx) {
+    if (no == NULL) return;
+    if (e_aritmetica(no) && e_invariante(no, ctx)) {
+        adicionar_valor(ctx, VALOR_INVARIANTE, no, NULL, 0);
+        return;
+    }
+    switch (no->tipo_no) {
+        case NO_OP_E:
+        case NO_OP_OU:
+        case NO_OP_NEGACAO:
+            coletar_invariantes(no->filho1, ctx);
+            break;
+        case NO_OP_SOMA: case NO_OP_SUB: case NO_OP_MULT: case NO_OP_DIV:
+        case NO_OP_IGUAL: case NO_OP_DIFERENTE: case NO_OP_MENOR: case NO_OP_MAIOR:
+        case NO_OP_MENOR_IGUAL: case NO_OP_MAIOR_IGUAL:
+            coletar_invariantes(no->filho1, ctx);
+            coletar_invariantes(no->filho2, ctx);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Visita as expressões avaliadas obrigatoriamente na primeira iteração,
+ * parando no primeiro comando com efeito observável, que pode sair do laço ou
+ * que contém um laço (que pode não terminar).
+ */
+static void coletar_invariantes_do_corpo(const NoAST *comando, ContextoAnalise *ctx) {
+    for (; comando != NULL; comando = comando->proximo) {
+        if (subarvore_contem(comando, NO_CHAMADA_FUNCAO)) return;
+
+        switch (comando->tipo_no) {
+            case NO_COMANDO_ATRIBUICAO: coletar_invariantes(comando->filho2, ctx); break;
+            case NO_COMANDO_SE:
+            case NO_COMANDO_ENQUANTO:
+            case NO_COMANDO_RETORNE:    coletar_invariantes(comando->filho1, ctx); break;
+            case NO_COMANDO_ESCREVA:
+                if (comando->filho1->tipo_no != NO_LITERAL_STRING) coletar_invariantes(comando->filho1, ctx);
+                break;
+            default: break;
+        }
+
+        if (subarvore_contem(comando, NO_COMANDO_ESCREVA) || subarvore_contem(comando, NO_COMANDO_LEIA)
+            || subarvore_contem(comando, NO_COMANDO_NOVALINHA) || subarvore_contem(comando, NO_COMANDO_RETORNE)
+            || subarvore_contem(comando, NO_COMANDO_ENQUANTO)) {
+            return;
+        }
+    }
+}
+
+/* ---------- Variáveis de indução ---------- */
+
+/**
+ * @brief Reconhece "i = i + c", "i = c + i" e "i = i - c" (c literal).
+ * @return 1 e o incremento em 'passo' se a atribuição tem essa forma.
+ */
+static int atualizacao_de_inducao(const NoAST *atribuicao, int *passo) {
+    const NoAST *rhs = atribuicao->filho2;
+    const EntradaTabela *variavel = atribuicao->filho1->entrada_tabela;
+    if (rhs->tipo_no != NO_OP_SOMA && rhs->tipo_no != NO_OP_SUB) return 0;
+
+    const NoAST *id = rhs->filho1, *literal = rhs->filho2;
+    if (rhs->tipo_no == NO_OP_SOMA && id->tipo_no == NO_LITERAL_INT) {
+        id = rhs->filho2;
+        literal = rhs->filho1;
+    }
+    if (id->tipo_no != NO_ID || id->entrada_tabela != variavel || literal->tipo_no != NO_LITERAL_INT) return 0;
+    if (literal->ival == 0) return 0;
+    *passo = rhs->tipo_no == NO_OP_SOMA ? literal->ival : (int)(0u - (uint32_t)literal->ival);
+    return 1;
+}
+
+/**
+ * @brief Procura "i * k" (ou "k * i") para as variáveis de indução do laço.
+ */
+static void coletar_derivadas(NoAST *no, ContextoAnalise *ctx) {
+    for (; no != NULL; no = no->proximo) {
+        if (no->tipo_no == NO_OP_MULT) {
+            NoAST *id = no->filho1, *literal = no->filho2;
+            if (id->tipo_no == NO_LITERAL_INT) {
+                id = no->filho2;
+                literal = no->filho1;
+            }
+            const NoAST *atualizacao;
+            int passo;
+            if (id->tipo_no == NO_ID && literal->tipo_no == NO_LITERAL_INT && id->entrada_tabela != NULL
+                && (!ctx->laco_tem_chamada || variavel_privada(id->entrada_tabela, ctx->funcao))
+                && conta_alteracoes_no_laco(ctx->laco, id->entrada_tabela, &atualizacao) == 1
+                && atualizacao != NULL && atualizacao_de_inducao(atualizacao, &passo)) {
+                int incremento = (int)((uint32_t)passo * (uint32_t)literal->ival);
+                adicionar_valor(ctx, VALOR_INDUCAO, no, (NoAST *)atualizacao, incremento);
+                continue;
+            }
+        }
+        coletar_derivadas(no->filho1, ctx);
+        coletar_derivadas(no->filho2, ctx);
+        coletar_derivadas(no->filho3, ctx);
+    }
+}
+
+int analisar_laco(NoAST *laco, NoAST *funcao, int mover_invariantes, int reduzir_inducao,
+                  int rotacionado, int primeiro_registrador, AnaliseLaco *analise) {
+    ContextoAnalise ctx;
+    ctx.laco = laco;
+    ctx.funcao = funcao;
+    ctx.laco_tem_chamada = subarvore_contem(laco, NO_CHAMADA_FUNCAO);
+    ctx.analise = analise;
+    ctx.registrador_livre = primeiro_registrador;
+    analise->num_valores = 0;
+    analise->num_invariantes = 0;
+    analise->num_inducao = 0;
+
+    if (mover_invariantes) {
+        if (!subarvore_contem(laco->filho1, NO_CHAMADA_FUNCAO)) {
+            coletar_invariantes(laco->filho1, &ctx);
+            if (rotacionado) coletar_invariantes_do_corpo(corpo_do_laco(laco), &ctx);
+        }
+    }
+    if (reduzir_inducao) {
+        coletar_derivadas(laco->filho1, &ctx);
+        coletar_derivadas(laco->filho2, &ctx);
+    }
+    return analise->num_valores;
+}
+
+/* ---------- Desenrolamento ---------- */
+
+static int relacao_verdadeira(TipoNoAST operador, long long a, long long b) {
+    switch (operador) {
+        case NO_OP_IGUAL:       return a == b;
+        case NO_OP_DIFERENTE:   return a != b;
+        case NO_OP_MENOR:       return a < b;
+        case NO_OP_MAIOR:       return a > b;
+        case NO_OP_MENOR_IGUAL: return a <= b;
+        default:                return a >= b;
+    }
+}
+
+int laco_pode_ser_desenrolado(NoAST *laco, NoAST *comando_anterior, NoAST *funcao, int *iteracoes) {
+    if (comando_anterior == NULL || comando_anterior->tipo_no != NO_COMANDO_ATRIBUICAO
+        || comando_anterior->filho2->tipo_no != NO_LITERAL_INT) {
+        return 0;
+    }
+    EntradaTabela *variavel = comando_anterior->filho1->entrada_tabela;
+
+    // Condição "i OP b" ou "b OP i".
+    NoAST *condicao = laco->filho1;
+    TipoNoAST operador = condicao->tipo_no;
+    if (operador < NO_OP_IGUAL || operador > NO_OP_MAIOR_IGUAL) return 0;
+    NoAST *id = condicao->filho1, *limite = condicao->filho2;
+    if (id->tipo_no == NO_LITERAL_INT) {
+        id = condicao->filho2;
+        limite = condicao->filho1;
+        if (operador == NO_OP_MENOR) operador = NO_OP_MAIOR;
+        else if (operador == NO_OP_MAIOR) operador = NO_OP_MENOR;
+        else if (operador == NO_OP_MENOR_IGUAL) operador = NO_OP_MAIOR_IGUAL;
+        else if (operador == NO_OP_MAIOR_IGUAL) operador = NO_OP_MENOR_IGUAL;
+    }
+    if (id->tipo_no != NO_ID || id->entrada_tabela != variavel || limite->tipo_no != NO_LITERAL_INT) return 0;
+
+    // Uma única atualização "i = i ± c", executada uma vez por iteração (no nível do corpo).
+    const NoAST *atualizacao;
+    int passo;
+    if (conta_alteracoes_no_laco(laco, variavel, &atualizacao) != 1 || atualizacao == NULL
+        || !atualizacao_de_inducao(atualizacao, &passo)) {
+        return 0;
+    }
+    int no_nivel_do_corpo = 0;
+    for (const NoAST *c = corpo_do_laco(laco); c != NULL; c = c->proximo) {
+        if (c == atualizacao) no_nivel_do_corpo = 1;
+    }
+    if (!no_nivel_do_corpo) return 0;
+    if (subarvore_contem(laco, NO_CHAMADA_FUNCAO) && !variavel_privada(variavel, funcao)) return 0;
+
+    long long valor = comando_anterior->filho2->ival;
+    int n = 0;
+    while (relacao_verdadeira(operador, valor, limite->ival)) {
+        if (n == MAX_ITERACOES_DESENROLAMENTO) return 0;
+        valor += passo;
+        if (valor < INT_MIN || valor > INT_MAX) return 0; // O laço original terminaria em erro de overflow
+        n++;
+    }
+    if ((long long)n * subarvore_conta_nos(laco->filho2) > MAX_NOS_DESENROLAMENTO) return 0;
+
+    *iteracoes = n;
+    return 1;
+}
@@ -0,0 +1,80 @@
+#ifndef OTIMIZADOR_LACOS_H
+#define OTIMIZADOR_LACOS_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+
+// Registradores $s0-$s7 disponíveis para valores mantidos durante um laço.
+#define NUM_REGISTRADORES_LACO 8
+
+// Limites do desenrolamento completo de laços com número constante de iterações.
+#define MAX_ITERACOES_DESENROLAMENTO 8
+#define MAX_NOS_DESENROLAMENTO 256
+
+/**
+ * @brief Tipo de valor que o laço mantém num registrador $sN.
+ */
+typedef enum {
+    VALOR_INVARIANTE,   // Expressão invariante, calculada uma vez no pré-cabeçalho
+    VALOR_INDUCAO       // "i * k" para uma variável de indução i, atualizado junto com i
+} TipoValorLaco;
+
+typedef struct ValorLaco {
+    TipoValorLaco tipo;
+    NoAST *expressao;       // Expressão cujo valor fica no registrador
+    NoAST *atualizacao;     // (indução) Atribuição "i = i ± c" após a qual o registrador é atualizado
+    int passo;              // (indução) Incremento do registrador a cada atualização
+    int registrador;        // Número N do registrador $sN
+} ValorLaco;
+
+/**
+ * @brief Resultado da análise de um laço 'enquanto'.
+ */
+typedef struct AnaliseLaco {
+    ValorLaco valores[NUM_REGISTRADORES_LACO];
+    int num_valores;
+    int num_invariantes;
+    int num_inducao;
+} AnaliseLaco;
+
+/**
+ * @brief Analisa um laço e escolhe os valores a manter em registradores.
+ *
+ * Uma expressão é invariante quando não contém chamadas nem atribuições e
+ * nenhuma de suas variáveis é alterada no laço. Se o laço contém chamadas,
+ * apenas parâmetros e locais da função atual são considerados inalterados.
+ * Só são movidas expressões avaliadas obrigatoriamente na primeira iteração,
+ * antes de qualquer efeito observável, para que a antecipação não mude o
+ * comportamento do programa (inclusive erros de execução). Expressões do
+ * corpo só são movidas em laços rotacionados, em que o pré-cabeçalho fica
+ * depois do teste de guarda.
+ *
+ * @param laco O nó NO_COMANDO_ENQUANTO.
+ * @param funcao A declaração da função atual (NULL no programa principal).
+ * @param mover_invariantes Habilita a movimentação de invariantes.
+ * @param reduzir_inducao Habilita a redução de força de variáveis de indução.
+ * @param rotacionado Indica se o laço será gerado na forma rotacionada.
+ * @param primeiro_registrador Primeiro $sN livre.
+ * @param analise Recebe os valores escolhidos.
+ * @return O número de valores escolhidos.
+ */
+int analisar_laco(NoAST *laco, NoAST *funcao, int mover_invariantes, int reduzir_inducao,
+                  int rotacionado, int primeiro_registrador, AnaliseLaco *analise);
+
+/**
+ * @brief Calcula o número de iterações de um laço da forma
+ * "i = a; enquanto (i OP b) { ...; i = i ± c; }" com a, b e c constantes.
+ *
+ * @param laco O nó NO_COMANDO_ENQUANTO.
+ * @param comando_anterior O comando imediatamente anterior ao laço (ou NULL).
+ * @param funcao A declaração da função atual (NULL no programa principal).
+ * @param iteracoes Recebe o número de iterações.
+ * @return 1 se o laço pode ser desenrolado por completo, 0 caso contrário.
+ */
+int laco_pode_ser_desenrolado(NoAST *laco, NoAST *comando_anterior, NoAST *funcao, int *iteracoes);
+
+/**
+ * @brief Compara duas expressões estruturalmente (mesmas variáveis e constantes).
+ */
+int expressoes_iguais(const NoAST *a, const NoAST *b);
+
+#endif
@@ -0,0 +1,478 @@
+#include "modulo_otimizador_peephole.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PASSADAS_PEEPHOLE 100
+#define MAX_SALTOS_ENCADEADOS 16
+
+typedef int (*FuncaoRegra)(ListaInstrucoes *lista, int indice);
+
+/* Índice label -> posição na lista, reconstruído a cada passada (um por
+ * thread: as funções são otimizadas em paralelo, ver modulo_gerador_codigo.c). */
+static _Thread_local const char **labels_tabela = NULL;
+static _Thread_local int *labels_posicao = NULL;
+static _Thread_local int labels_capacidade = 0;
+
+static int regra_codigo_inalcancavel(ListaInstrucoes *lista, int i);
+static int regra_salto_para_proxima(ListaInstrucoes *lista, int i);
+static int regra_encadeamento_saltos(ListaInstrucoes *lista, int i);
+static int regra_push_pop(ListaInstrucoes *lista, int i);
+static int regra_armazena_carrega(ListaInstrucoes *lista, int i);
+static int regra_imediato(ListaInstrucoes *lista, int i);
+static int regra_propagacao_move(ListaInstrucoes *lista, int i);
+
+/**
+ * @brief Tabela de regras, na mesma ordem de RegraPeephole.
+ */
+static const struct {
+    const char *nome;
+    FuncaoRegra aplicar;
+} tabela_regras[NUM_REGRAS_PEEPHOLE] = {
+    {"codigo inalcancavel apos salto", regra_codigo_inalcancavel},
+    {"salto para a proxima instrucao", regra_salto_para_proxima},
+    {"encadeamento de saltos", regra_encadeamento_saltos},
+    {"par push/pop redundante", regra_push_pop},
+    {"store seguido de load", regra_armazena_carrega},
+    {"li + operacao com imediato", regra_imediato},
+    {"propagacao de move", regra_propagacao_move},
+};
+
+/* ---------- Funções auxiliares ---------- */
+
+static unsigned hash_label(const char *label) {
+    unsigned h = 5381;
+    while (*label) h = h * 33 + (unsigned char)*label++;
+    return h;
+}
+
+static void construir_indice_labels(ListaInstrucoes *lista) {
+    int necessario = 16;
+    while (necessario < lista->tamanho * 2) necessario *= 2;
+    if (necessario > labels_capacidade) {
+        free(labels_tabela);
+        free(labels_posicao);
+        labels_tabela = malloc(necessario * sizeof(char *));
+        labels_posicao = malloc(necessario * sizeof(int));
+        if (labels_tabela == NULL || labels_posicao == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para o otimizador peephole.\n");
+            exit(EXIT_FAILURE);
+        }
+        labels_capacidade = necessario;
+    }
+    memset(labels_tabela, 0, labels_capacidade * sizeof(char *));
+
+    for (int i = 0; i < lista->tamanho; i++) {
+        if (lista->itens[i].tipo != LINHA_LABEL) continue;
+        unsigned pos = hash_label(lista->itens[i].texto) & (labels_capacidade - 1);
+        while (labels_tabela[pos] != NULL) pos = (pos + 1) & (labels_capacidade - 1);
+        labels_tabela[pos] = lista->itens[i].texto;
+        labels_posicao[pos] = i;
+    }
+}
+
+static int posicao_label(const char *label) {
+    unsigned pos = hash_label(label) & (labels_capacidade - 1);
+    while (labels_tabela[pos] != NULL) {
+        if (strcmp(labels_tabela[pos], label) == 0) return labels_posicao[pos];
+        pos = (pos + 1) & (labels_capacidade - 1);
+    }
+    return -1;
+}
+
+/**
+ * @brief Próxima linha depois de 'i' que não é comentário nem foi removida.
+ */
+static int proxima(const ListaInstrucoes *lista, int i) {
+    for (i++; i < lista->tamanho; i++) {
+        TipoLinhaMIPS tipo = lista->itens[i].tipo;
+        if (tipo != LINHA_COMENTARIO && tipo != LINHA_REMOVIDA) break;
+    }
+    return i;
+}
+
+static int e_opcode(const ListaInstrucoes *lista, int i, const char *opcode) {
+    return i < lista->tamanho && lista->itens[i].tipo == LINHA_INSTRUCAO
+        && strcmp(lista->itens[i].opcode, opcode) == 0;
+}
+
+static int e_temporario(const char *reg) {
+    return reg[0] == '$' && reg[1] == 't';
+}
+
+static int e_registrador_reservado(const char *reg) {
+    return strcmp(reg, "$sp") == 0 || strcmp(reg, "$fp") == 0
+        || strcmp(reg, "$ra") == 0 || strcmp(reg, "$gp") == 0;
+}
+
+static int ler_inteiro(const char *texto, long *valor) {
+    char *fim;
+    *valor = strtol(texto, &fim, 10);
+    return fim != texto && *fim == '\0';
+}
+
+/**
+ * @brief Indica se 'reg' está morto logo após a linha 'i'.
+ * Na fronteira de um bloco básico só os temporários $t são considerados mortos.
+ */
+static int registrador_morto_apos(const ListaInstrucoes *lista, int i, const char *reg) {
+    for (int k = proxima(lista, i); k < lista->tamanho; k = proxima(lista, k)) {
+        const InstrucaoMIPS *instr = &lista->itens[k];
+        if (instr->tipo != LINHA_INSTRUCAO) return e_temporario(reg);
+        if (instrucao_le_registrador(instr, reg)) return 0;
+        if (instrucao_escreve_registrador(instr, reg)) return 1;
+        if (instrucao_e_barreira(instr)) return e_temporario(reg);
+    }
+    return e_temporario(reg);
+}
+
+/**
+ * @brief Reconhece "addiu $sp, $sp, <delta>".
+ */
+static int e_ajuste_pilha(const ListaInstrucoes *lista, int i, int delta) {
+    if (!e_opcode(lista, i, "addiu")) return 0;
+    const InstrucaoMIPS *instr = &lista->itens[i];
+    long valor;
+    return instr->num_operandos == 3
+        && strcmp(instr->operandos[0], "$sp") == 0 && strcmp(instr->operandos[1], "$sp") == 0
+        && ler_inteiro(instr->operandos[2], &valor) && valor == delta;
+}
+
+static int menciona_sp(const InstrucaoMIPS *instr) {
+    return instrucao_le_registrador(instr, "$sp") || instrucao_escreve_registrador(instr, "$sp");
+}
+
+/**
+ * @brief Substitui as leituras de 'de' por 'para' nos operandos-fonte.
+ * @return 1 se algum operando foi trocado.
+ */
+static int substituir_leituras(InstrucaoMIPS *instr, const char *de, const char *para) {
+    int fontes[MAX_OPERANDOS_MIPS] = {0, 0, 0};
+    int base_memoria = 0;
+
+    switch (instr->formato) {
+        case FORMATO_RRR:       fontes[1] = fontes[2] = 1; break;
+        case FORMATO_RRI:
+        case FORMATO_RR:        fontes[1] = 1; break;
+        case FORMATO_HILO:
+        case FORMATO_DESVIO_2:  fontes[0] = fontes[1] = 1; break;
+        case FORMATO_DESVIO_1:
+        case FORMATO_SALTO_REG: fontes[0] = 1; break;
+        case FORMATO_STORE:     fontes[0] = 1; base_memoria = 1; break;
+        case FORMATO_LOAD:      base_memoria = 1; break;
+        default:                return 0;
+    }
+
+    char ops[MAX_OPERANDOS_MIPS][TAM_OPERANDO_MIPS];
+    int trocou = 0;
+    for (int o = 0; o < MAX_OPERANDOS_MIPS; o++) {
+        strcpy(ops[o], o < instr->num_operandos ? instr->operandos[o] : "");
+        if (fontes[o] && strcmp(ops[o], de) == 0) {
+            strcpy(ops[o], para);
+            trocou = 1;
+        }
+    }
+    if (base_memoria && instr->num_operandos >= 2) {
+        int offset;
+        char base[TAM_OPERANDO_MIPS];
+        if (decompor_operando_memoria(ops[1], &offset, base, sizeof(base)) && strcmp(base, de) == 0) {
+            snprintf(ops[1], TAM_OPERANDO_MIPS, "%d(%s)", offset, para);
+            trocou = 1;
+        }
+    }
+    if (trocou) {
+        reescrever_instrucao(instr, instr->opcode,
+                             instr->num_operandos > 0 ? ops[0] : NULL,
+                             instr->num_operandos > 1 ? ops[1] : NULL,
+                             instr->num_operandos > 2 ? ops[2] : NULL);
+    }
+    return trocou;
+}
+
+/* ---------- Regras ---------- */
+
+/**
+ * @brief Remove instruções entre um salto incondicional e o próximo label.
+ */
+static int regra_codigo_inalcancavel(ListaInstrucoes *lista, int i) {
+    if (!e_opcode(lista, i, "j") && !e_opcode(lista, i, "b") && !e_opcode(lista, i, "jr")) return 0;
+    int aplicou = 0;
+    for (int k = proxima(lista, i); k < lista->tamanho && lista->itens[k].tipo == LINHA_INSTRUCAO; k = proxima(lista, k)) {
+        remover_instrucao(&lista->itens[k]);
+        aplicou = 1;
+    }
+    return aplicou;
+}
+
+/**
+ * @brief "j L" (ou desvio para L) imediatamente seguido do label L.
+ */
+static int regra_salto_para_proxima(ListaInstrucoes *lista, int i) {
+    InstrucaoMIPS *instr = &lista->itens[i];
+    if (instr->formato == FORMATO_CHAMADA) return 0;
+    const char *destino = instrucao_destino(instr);
+    if (destino == NULL) return 0;
+
+    for (int k = proxima(lista, i); k < lista->tamanho && lista->itens[k].tipo == LINHA_LABEL; k = proxima(lista, k)) {
+        if (strcmp(lista->itens[k].texto, destino) == 0) {
+            remover_instrucao(instr);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Segue a cadeia "L: j L2" a partir de um label.
+ * @return O destino final, ou NULL se não houver cadeia (ou se houver ciclo).
+ */
+static const char *destino_final(const ListaInstrucoes *lista, const char *label) {
+    const char *atual = label;
+    for (int saltos = 0; saltos <= MAX_SALTOS_ENCADEADOS; saltos++) {
+        int pos = posicao_label(atual);
+        if (pos < 0) break;
+        int k = proxima(lista, pos);
+        while (k < lista->tamanho && lista->itens[k].tipo == LINHA_LABEL) k = proxima(lista, k);
+        if (!e_opcode(lista, k, "j") || lista->itens[k].num_operandos != 1) break;
+        const char *seguinte = lista->itens[k].operandos[0];
+        if (strcmp(seguinte, label) == 0 || strcmp(seguinte, atual) == 0) return NULL;
+        atual = seguinte;
+        if (saltos == MAX_SALTOS_ENCADEADOS) return NULL;
+    }
+    return atual == label ? NULL : atual;
+}
+
+/**
+ * @brief Redireciona saltos/desvios cujo destino é outro salto incondicional.
+ */
+static int regra_encadeamento_saltos(ListaInstrucoes *lista, int i) {
+    InstrucaoMIPS *instr = &lista->itens[i];
+    if (instr->formato == FORMATO_CHAMADA) return 0;
+    const char *destino = instrucao_destino(instr);
+    if (destino == NULL) return 0;
+
+    const char *final = destino_final(lista, destino);
+    if (final == NULL) return 0;
+
+    char novo_destino[TAM_OPERANDO_MIPS];
+    snprintf(novo_destino, sizeof(novo_destino), "%s", final);
+    int n = instr->num_operandos;
+    reescrever_instrucao(instr, instr->opcode,
+                         n == 1 ? novo_destino : instr->operandos[0],
+                         n == 1 ? NULL : (n == 2 ? novo_destino : instr->operandos[1]),
+                         n == 3 ? novo_destino : NULL);
+    return 1;
+}
+
+/**
+ * @brief "addiu $sp,$sp,-4; sw R,0($sp); ... lw R2,0($sp); addiu $sp,$sp,4"
+ * vira "move R2, R; ..." quando o trecho intermediário não usa a pilha nem R2.
+ */
+static int regra_push_pop(ListaInstrucoes *lista, int i) {
+    if (!e_ajuste_pilha(lista, i, -4)) return 0;
+    int j = proxima(lista, i);
+    if (!e_opcode(lista, j, "sw") || lista->itens[j].num_operandos != 2
+        || strcmp(lista->itens[j].operandos[1], "0($sp)") != 0) return 0;
+    const char *reg = lista->itens[j].operandos[0];
+
+    int k;
+    for (k = proxima(lista, j); k < lista->tamanho; k = proxima(lista, k)) {
+        InstrucaoMIPS *instr = &lista->itens[k];
+        if (e_opcode(lista, k, "lw") && instr->num_operandos == 2
+            && strcmp(instr->operandos[1], "0($sp)") == 0) break;
+        if (instrucao_e_barreira(instr) || menciona_sp(instr)) return 0;
+    }
+    int m = proxima(lista, k);
+    if (k >= lista->tamanho || !e_ajuste_pilha(lista, m, 4)) return 0;
+    const char *reg_destino = lista->itens[k].operandos[0];
+    int mesmo_registrador = strcmp(reg_destino, reg) == 0;
+
+    // O valor passa a viver em R2 (ou continua em R) durante o trecho intermediário.
+    for (int t = proxima(lista, j); t < k; t = proxima(lista, t)) {
+        InstrucaoMIPS *instr = &lista->itens[t];
+        if (instrucao_escreve_registrador(instr, reg_destino)) return 0;
+        if (!mesmo_registrador && instrucao_le_registrador(instr, reg_destino)) return 0;
+    }
+
+    if (mesmo_registrador) {
+        remover_instrucao(&lista->itens[i]);
+    } else {
+        reescrever_instrucao(&lista->itens[i], "move", reg_destino, reg, NULL);
+    }
+    remover_instrucao(&lista->itens[j]);
+    remover_instrucao(&lista->itens[k]);
+    remover_instrucao(&lista->itens[m]);
+    return 1;
+}
+
+/**
+ * @brief "sw R, M" seguido (sem outros stores) de "lw R2, M": o load vira "move R2, R".
+ */
+static int regra_armazena_carrega(ListaInstrucoes *lista, int i) {
+    if (!e_opcode(lista, i, "sw") || lista->itens[i].num_operandos != 2) return 0;
+    const char *reg = lista->itens[i].operandos[0];
+    const char *memoria = lista->itens[i].operandos[1];
+    int offset;
+    char base[TAM_OPERANDO_MIPS];
+    if (!decompor_operando_memoria(memoria, &offset, base, sizeof(base))) return 0;
+
+    for (int k = proxima(lista, i); k < lista->tamanho; k = proxima(lista, k)) {
+        InstrucaoMIPS *instr = &lista->itens[k];
+        if (instrucao_e_barreira(instr) || instr->formato == FORMATO_STORE) return 0;
+        if (e_opcode(lista, k, "lw") && instr->num_operandos == 2
+            && strcmp(instr->operandos[1], memoria) == 0) {
+            if (strcmp(instr->operandos[0], reg) == 0) {
+                remover_instrucao(instr);
+            } else {
+                reescrever_instrucao(instr, "move", instr->operandos[0], reg, NULL);
+            }
+            return 1;
+        }
+        if (instrucao_escreve_registrador(instr, reg) || instrucao_escreve_registrador(instr, base)) return 0;
+    }
+    return 0;
+}
+
+/**
+ * @brief "li Rk, K; op Rd, Rs, Rk" vira "addi/addiu/slti/andi/ori/xori Rd, Rs, K".
+ * add e sub geram exceção de overflow e viram addi, que também gera (Rs - K
+ * transborda exatamente quando Rs + (-K) transborda); addu e subu viram addiu.
+ */
+static int regra_imediato(ListaInstrucoes *lista, int i) {
+    if (!e_opcode(lista, i, "li") || lista->itens[i].num_operandos != 2) return 0;
+    const char *reg_k = lista->itens[i].operandos[0];
+    long k;
+    if (!ler_inteiro(lista->itens[i].operandos[1], &k)) return 0;
+
+    int j = proxima(lista, i);
+    if (j >= lista->tamanho || lista->itens[j].tipo != LINHA_INSTRUCAO
+        || lista->itens[j].formato != FORMATO_RRR || lista->itens[j].num_operandos != 3) return 0;
+    InstrucaoMIPS *op = &lista->itens[j];
+
+    static const struct {
+        const char *opcode;
+        const char *imediato;
+        int comutativa;
+        int negar;
+        int sem_sinal;
+    } dobras[] = {
+        {"add", "addi", 1, 0, 0}, {"addu", "addiu", 1, 0, 0},
+        {"sub", "addi", 0, 1, 0}, {"subu", "addiu", 0, 1, 0},
+        {"slt", "slti", 0, 0, 0},
+        {"and", "andi", 1, 0, 1}, {"or", "ori", 1, 0, 1}, {"xor", "xori", 1, 0, 1},
+        {NULL, NULL, 0, 0, 0}
+    };
+    int d;
+    for (d = 0; dobras[d].opcode != NULL; d++) {
+        if (strcmp(dobras[d].opcode, op->opcode) == 0) break;
+    }
+    if (dobras[d].opcode == NULL) return 0;
+
+    const char *fonte;
+    if (strcmp(op->operandos[2], reg_k) == 0 && strcmp(op->operandos[1], reg_k) != 0) {
+        fonte = op->operandos[1];
+    } else if (dobras[d].comutativa && strcmp(op->operandos[1], reg_k) == 0
+               && strcmp(op->operandos[2], reg_k) != 0) {
+        fonte = op->operandos[2];
+    } else {
+        return 0;
+    }
+
+    long imediato = dobras[d].negar ? -k : k;
+    if (dobras[d].sem_sinal ? (imediato < 0 || imediato > 65535)
+                            : (imediato < -32768 || imediato > 32767)) return 0;
+    if (strcmp(op->operandos[0], reg_k) != 0 && !registrador_morto_apos(lista, j, reg_k)) return 0;
+
+    if (imediato == 0 && strcmp(dobras[d].imediato, "andi") != 0 && strcmp(dobras[d].imediato, "slti") != 0) {
+        // x + 0, x - 0, x | 0, x ^ 0: sobra apenas a cópia.
+        reescrever_instrucao(op, "move", op->operandos[0], fonte, NULL);
+    } else {
+        char texto_imediato[TAM_OPERANDO_MIPS];
+        snprintf(texto_imediato, sizeof(texto_imediato), "%ld", imediato);
+        reescrever_instrucao(op, dobras[d].imediato, op->operandos[0], fonte, texto_imediato);
+    }
+    remover_instrucao(&lista->itens[i]);
+    return 1;
+}
+
+/**
+ * @brief "move A, B": propaga B para as leituras seguintes de A e remove o
+ * move quando A fica morto.
+ */
+static int regra_propagacao_move(ListaInstrucoes *lista, int i) {
+    if (!e_opcode(lista, i, "move") || lista->itens[i].num_operandos != 2) return 0;
+    char a[TAM_OPERANDO_MIPS], b[TAM_OPERANDO_MIPS];
+    strcpy(a, lista->itens[i].operandos[0]);
+    strcpy(b, lista->itens[i].operandos[1]);
+
+    if (strcmp(a, b) == 0) {
+        remover_instrucao(&lista->itens[i]);
+        return 1;
+    }
+    if (e_registrador_reservado(a) || e_registrador_reservado(b) || strcmp(a, "$zero") == 0) return 0;
+
+    int aplicou = 0;
+    for (int k = proxima(lista, i); k < lista->tamanho; k = proxima(lista, k)) {
+        InstrucaoMIPS *instr = &lista->itens[k];
+        if (instr->tipo != LINHA_INSTRUCAO) break;
+        if (instrucao_le_registrador(instr, a)) {
+            if (!substituir_leituras(instr, a, b) || instrucao_le_registrador(instr, a)) break;
+            aplicou = 1;
+        }
+        if (instrucao_escreve_registrador(instr, a) || instrucao_escreve_registrador(instr, b)
+            || instrucao_e_barreira(instr)) break;
+    }
+
+    if (registrador_morto_apos(lista, i, a)) {
+        remover_instrucao(&lista->itens[i]);
+        aplicou = 1;
+    }
+    return aplicou;
+}
+
+/* ---------- Motor ---------- */
+
+static int contar_instrucoes(const ListaInstrucoes *lista) {
+    int total = 0;
+    for (int i = 0; i < lista->tamanho; i++) {
+        if (lista->itens[i].tipo == LINHA_INSTRUCAO) total++;
+    }
+    return total;
+}
+
+void otimizar_peephole(ListaInstrucoes *lista, EstatisticasPeephole *estatisticas) {
+    memset(estatisticas, 0, sizeof(EstatisticasPeephole));
+    estatisticas->instrucoes_antes = contar_instrucoes(lista);
+
+    int mudou = 1;
+    while (mudou && estatisticas->passadas < MAX_PASSADAS_PEEPHOLE) {
+        mudou = 0;
+        estatisticas->passadas++;
+        construir_indice_labels(lista);
+
+        for (int i = 0; i < lista->tamanho; i++) {
+            for (int r = 0; r < NUM_REGRAS_PEEPHOLE; r++) {
+                if (lista->itens[i].tipo != LINHA_INSTRUCAO) break;
+                if (tabela_regras[r].aplicar(lista, i)) {
+                    estatisticas->aplicacoes[r]++;
+                    mudou = 1;
+                }
+            }
+        }
+        compactar_lista_instrucoes(lista);
+    }
+
+    estatisticas->instrucoes_depois = contar_instrucoes(lista);
+    free(labels_tabela);
+    free(labels_posicao);
+    labels_tabela = NULL;
+    labels_posicao = NULL;
+    labels_capacidade = 0;
+}
+
+void imprimir_estatisticas_peephole(FILE *arquivo, const EstatisticasPeephole *estatisticas) {
+    fprintf(arquivo, "Otimizador peephole: %d -> %d instrucoes em %d passada(s).\n",
+            estatisticas->instrucoes_antes, estatisticas->instrucoes_depois, estatisticas->passadas);
+    for (int r = 0; r < NUM_REGRAS_PEEPHOLE; r++) {
+        fprintf(arquivo, "  %-32s %d\n", tabela_regras[r].nome, estatisticas->aplicacoes[r]);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef OTIMIZADOR_PEEPHOLE_H
+#define OTIMIZADOR_PEEPHOLE_H
+
+#include "modulo_instrucoes_mips.h"
+
+/**
+ * @brief Regras do otimizador peephole (a ordem é a da tabela de regras).
+ */
+typedef enum {
+    REGRA_CODIGO_INALCANCAVEL,
+    REGRA_SALTO_PARA_PROXIMA,
+    REGRA_ENCADEAMENTO_SALTOS,
+    REGRA_PUSH_POP,
+    REGRA_ARMAZENA_CARREGA,
+    REGRA_IMEDIATO,
+    REGRA_PROPAGACAO_MOVE,
+    NUM_REGRAS_PEEPHOLE
+} RegraPeephole;
+
+/**
+ * @brief Contadores do otimizador: quantas vezes cada regra foi aplicada.
+ */
+typedef struct EstatisticasPeephole {
+    int aplicacoes[NUM_REGRAS_PEEPHOLE];
+    int passadas;
+    int instrucoes_antes;
+    int instrucoes_depois;
+} EstatisticasPeephole;
+
+/**
+ * @brief Aplica as regras peephole sobre a lista até atingir um ponto fixo.
+ *
+ * Supõe a convenção do gerador de código de que os temporários $t0-$t9 nunca
+ * estão vivos na fronteira de um bloco básico (labels, desvios e saltos).
+ *
+ * @param lista O código MIPS gerado (alterado no lugar).
+ * @param estatisticas Recebe os contadores de aplicação de cada regra.
+ */
+void otimizar_peephole(ListaInstrucoes *lista, EstatisticasPeephole *estatisticas);
+
+/**
+ * @brief Imprime o relatório de aplicação das regras.
+ */
+void imprimir_estatisticas_peephole(FILE *arquivo, const EstatisticasPeephole *estatisticas);
+
+#endif
@@ -0,0 +1,315 @@
+#include "modulo_perfil.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void *alocar(size_t tamanho) {
+    void *memoria = calloc(1, tamanho > 0 ? tamanho : 1);
+    if (memoria == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o perfil.\n");
+        exit(EXIT_FAILURE);
+    }
+    return memoria;
+}
+
+/* ---------- Numeração dos pontos ---------- */
+
+static unsigned espalhar(const NoAST *no, int capacidade) {
+    uintptr_t valor = (uintptr_t)no;
+    valor ^= valor >> 17;
+    valor *= 0x9E3779B1u;
+    return (unsigned)(valor ^ (valor >> 13)) & (unsigned)(capacidade - 1);
+}
+
+static void acrescentar_ponto(PerfilPrograma *perfil, int *capacidade, TipoPontoPerfil tipo, const NoAST *no,
+                              int funcao, int chamada) {
+    if (perfil->num_pontos == *capacidade) {
+        *capacidade = *capacidade == 0 ? 16 : *capacidade * 2;
+        PontoPerfil *pontos = realloc(perfil->pontos, *capacidade * sizeof(PontoPerfil));
+        if (pontos == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para o perfil.\n");
+            exit(EXIT_FAILURE);
+        }
+        perfil->pontos = pontos;
+    }
+    PontoPerfil *ponto = &perfil->pontos[perfil->num_pontos++];
+    ponto->tipo = tipo;
+    ponto->no = no;
+    ponto->contador = perfil->num_contadores;
+    ponto->funcao = funcao;
+    ponto->chamada = chamada;
+    perfil->num_contadores += (tipo == PONTO_SE || tipo == PONTO_ENQUANTO) ? 2 : 1;
+}
+
+static void percorrer_pontos(const NoAST *no, const GrafoChamadas *grafo, int funcao, PerfilPrograma *perfil,
+                             int *capacidade) {
+    for (; no != NULL; no = no->proximo) {
+        int funcao_filhos = funcao;
+        switch (no->tipo_no) {
+            case NO_DECL_FUNCAO: {
+                FuncaoGrafo *declarada = buscar_funcao_grafo(grafo, no->filho1->entrada_tabela);
+                funcao_filhos = declarada != NULL ? (int)(declarada - grafo->funcoes) : -1;
+                acrescentar_ponto(perfil, capacidade, PONTO_FUNCAO, no, funcao_filhos, -1);
+                break;
+            }
+            case NO_COMANDO_SE:
+                acrescentar_ponto(perfil, capacidade, PONTO_SE, no, funcao, -1);
+                break;
+            case NO_COMANDO_ENQUANTO:
+                acrescentar_ponto(perfil, capacidade, PONTO_ENQUANTO, no, funcao, -1);
+                break;
+            case NO_CHAMADA_FUNCAO: {
+                FuncaoGrafo *chamada = buscar_funcao_grafo(grafo, no->filho1->entrada_tabela);
+                acrescentar_ponto(perfil, capacidade, PONTO_CHAMADA, no, funcao,
+                                  chamada != NULL ? (int)(chamada - grafo->funcoes) : -1);
+                break;
+            }
+            default:
+                break;
+        }
+        percorrer_pontos(no->filho1, grafo, funcao_filhos, perfil, capacidade);
+        percorrer_pontos(no->filho2, grafo, funcao_filhos, perfil, capacidade);
+        percorrer_pontos(no->filho3, grafo, funcao_filhos, perfil, capacidade);
+    }
+}
+
+void numerar_pontos_perfil(const NoAST *raiz, const GrafoChamadas *grafo, PerfilPrograma *perfil) {
+    memset(perfil, 0, sizeof(*perfil));
+    int capacidade = 0;
+    percorrer_pontos(raiz, grafo, -1, perfil, &capacidade);
+    perfil->contagens = alocar(perfil->num_contadores * sizeof(unsigned long long));
+
+    // FNV-1a sobre o tipo e a linha de cada ponto.
+    unsigned assinatura = 2166136261u;
+    for (int i = 0; i < perfil->num_pontos; i++) {
+        unsigned valores[2] = { (unsigned)perfil->pontos[i].tipo, (unsigned)perfil->pontos[i].no->linha };
+        for (int j = 0; j < 2; j++) {
+            assinatura = (assinatura ^ valores[j]) * 16777619u;
+        }
+    }
+    perfil->assinatura = assinatura;
+
+    perfil->capacidade_indice = 16;
+    while (perfil->capacidade_indice < 2 * perfil->num_pontos) perfil->capacidade_indice *= 2;
+    perfil->indice = alocar(perfil->capacidade_indice * sizeof(int));
+    for (int i = 0; i < perfil->num_pontos; i++) {
+        unsigned h = espalhar(perfil->pontos[i].no, perfil->capacidade_indice);
+        while (perfil->indice[h] != 0) h = (h + 1) & (perfil->capacidade_indice - 1);
+        perfil->indice[h] = i + 1;
+    }
+}
+
+static const PontoPerfil *buscar_ponto(const PerfilPrograma *perfil, const NoAST *no) {
+    if (perfil == NULL || perfil->indice == NULL || no == NULL) return NULL;
+    unsigned h = espalhar(no, perfil->capacidade_indice);
+    while (perfil->indice[h] != 0) {
+        const PontoPerfil *ponto = &perfil->pontos[perfil->indice[h] - 1];
+        if (ponto->no == no) return ponto;
+        h = (h + 1) & (perfil->capacidade_indice - 1);
+    }
+    return NULL;
+}
+
+int contador_perfil(const PerfilPrograma *perfil, const NoAST *no) {
+    const PontoPerfil *ponto = buscar_ponto(perfil, no);
+    return ponto != NULL ? ponto->contador : -1;
+}
+
+unsigned long long contagem_perfil(const PerfilPrograma *perfil, int contador) {
+    if (perfil == NULL || contador < 0 || contador >= perfil->num_contadores) return 0;
+    return perfil->contagens[contador];
+}
+
+/* ---------- Leitura ---------- */
+
+void carregar_perfil(const char *nome_arquivo, PerfilPrograma *perfil) {
+    FILE *arquivo = fopen(nome_arquivo, "r");
+    if (arquivo == NULL) {
+        perror("Erro ao abrir o arquivo de perfil");
+        exit(EXIT_FAILURE);
+    }
+
+    char linha[256];
+    int restantes = 0;  // Linhas de contagem esperadas no bloco atual
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        unsigned assinatura;
+        int num_contadores, contador;
+        unsigned long long contagem;
+        if (sscanf(linha, "perfil-goianinha %u %d", &assinatura, &num_contadores) == 2) {
+            if (assinatura != perfil->assinatura || num_contadores != perfil->num_contadores) {
+                fprintf(stderr, "Erro: o perfil '%s' foi gerado para outro programa "
+                        "(assinatura %u com %d contador(es); esperado %u com %d).\n",
+                        nome_arquivo, assinatura, num_contadores, perfil->assinatura, perfil->num_contadores);
+                fclose(arquivo);
+                exit(EXIT_FAILURE);
+            }
+            perfil->num_execucoes++;
+            restantes = num_contadores;
+        } else if (restantes > 0 && sscanf(linha, "%d %llu", &contador, &contagem) == 2
+                   && contador >= 0 && contador < perfil->num_contadores) {
+            perfil->contagens[contador] += contagem;
+            restantes--;
+        }
+    }
+    fclose(arquivo);
+
+    if (perfil->num_execucoes == 0) {
+        fprintf(stderr, "Erro: nenhum perfil encontrado em '%s' (gere-o com --instrument).\n", nome_arquivo);
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < perfil->num_pontos; i++) {
+        const PontoPerfil *ponto = &perfil->pontos[i];
+        unsigned long long contagem = perfil->contagens[ponto->contador];
+        if (ponto->tipo == PONTO_CHAMADA && contagem > perfil->maior_chamada) perfil->maior_chamada = contagem;
+    }
+    printf("Perfil: '%s' lido (%d execucao(oes), %d contador(es)).\n",
+           nome_arquivo, perfil->num_execucoes, perfil->num_contadores);
+}
+
+/* ---------- Decisões ---------- */
+
+int orcamento_inline_perfil(const PerfilPrograma *perfil, const NoAST *chamada, int orcamento) {
+    if (perfil == NULL || perfil->num_execucoes == 0) return orcamento;
+    unsigned long long contagem = contagem_perfil(perfil, contador_perfil(perfil, chamada));
+    if (contagem == 0) return 0;
+    if (contagem * FRACAO_CHAMADA_QUENTE >= perfil->maior_chamada) return orcamento * FATOR_ORCAMENTO_QUENTE;
+    return orcamento;
+}
+
+/* ---------- Runtime ---------- */
+
+/*
+ * perfil_gravar escreve o cabeçalho (texto fixo, montado aqui) e uma linha
+ * por contador. Cada linha é montada de trás para frente no fim de
+ * perfil_linha; as contagens são tratadas sem sinal (divu).
+ */
+static const char *rotina_gravar[] = {
+    "perfil_gravar:",
+    "li $a0, 2",
+    "la $a1, perfil_cabecalho",
+    "li $v0, 15",
+    "syscall",
+    "li $t0, 0",
+    "perfil_gravar_laco:",
+    "beq $t0, $t9, perfil_gravar_fim",
+    "la $t8, perfil_contadores",
+    "sll $t1, $t0, 2",
+    "addu $t1, $t8, $t1",
+    "lw $t2, 0($t1)",
+    "la $t3, perfil_linha",
+    "addiu $t3, $t3, 24",
+    "li $t4, 10",
+    "li $t5, 10",
+    "addiu $t3, $t3, -1",
+    "sb $t4, 0($t3)",
+    "perfil_gravar_contagem:",
+    "divu $t2, $t5",
+    "mfhi $t6",
+    "mflo $t2",
+    "addiu $t6, $t6, 48",
+    "addiu $t3, $t3, -1",
+    "sb $t6, 0($t3)",
+    "bnez $t2, perfil_gravar_contagem",
+    "li $t6, 32",
+    "addiu $t3, $t3, -1",
+    "sb $t6, 0($t3)",
+    "move $t2, $t0",
+    "perfil_gravar_indice:",
+    "divu $t2, $t5",
+    "mfhi $t6",
+    "mflo $t2",
+    "addiu $t6, $t6, 48",
+    "addiu $t3, $t3, -1",
+    "sb $t6, 0($t3)",
+    "bnez $t2, perfil_gravar_indice",
+    "la $t7, perfil_linha",
+    "addiu $t7, $t7, 24",
+    "subu $a2, $t7, $t3",
+    "move $a1, $t3",
+    "li $a0, 2",
+    "li $v0, 15",
+    "syscall",
+    "addiu $t0, $t0, 1",
+    "j perfil_gravar_laco",
+    "perfil_gravar_fim:",
+    "jr $ra",
+    NULL
+};
+
+void emitir_runtime_perfil(const PerfilPrograma *perfil, ListaInstrucoes *destino) {
+    char texto[128];
+    char cabecalho[64];
+    snprintf(cabecalho, sizeof(cabecalho), "perfil-goianinha %u %d", perfil->assinatura, perfil->num_contadores);
+
+    adicionar_comentario(destino, "--- Contadores do perfil (--instrument) ---");
+    adicionar_diretiva(destino, ".data");
+    adicionar_label(destino, "perfil_cabecalho");
+    snprintf(texto, sizeof(texto), ".ascii \"%s\\n\"", cabecalho);
+    adicionar_diretiva(destino, texto);
+    adicionar_diretiva(destino, ".align 2");
+    adicionar_label(destino, "perfil_contadores");
+    snprintf(texto, sizeof(texto), ".space %d", 4 * (perfil->num_contadores > 0 ? perfil->num_contadores : 1));
+    adicionar_diretiva(destino, texto);
+    adicionar_label(destino, "perfil_linha");
+    adicionar_diretiva(destino, ".space 24");
+    adicionar_diretiva(destino, ".text");
+
+    // $a2 (tamanho do cabeçalho) e $t9 (número de contadores) são fixos.
+    char label[64];
+    for (int i = 0; rotina_gravar[i] != NULL; i++) {
+        size_t tamanho = strlen(rotina_gravar[i]);
+        if (rotina_gravar[i][tamanho - 1] == ':') {
+            snprintf(label, sizeof(label), "%.*s", (int)(tamanho - 1), rotina_gravar[i]);
+            adicionar_label(destino, label);
+        } else {
+            adicionar_instrucao(destino, rotina_gravar[i]);
+        }
+        if (i == 0) {
+            snprintf(texto, sizeof(texto), "li $a2, %d", (int)strlen(cabecalho) + 1);
+            adicionar_instrucao(destino, texto);
+            snprintf(texto, sizeof(texto), "li $t9, %d", perfil->num_contadores);
+            adicionar_instrucao(destino, texto);
+        }
+    }
+    printf("Perfil: %d contador(es) em %d ponto(s) instrumentado(s); as contagens sao escritas na saida de erro "
+           "ao fim do programa.\n", perfil->num_contadores, perfil->num_pontos);
+}
+
+/* ---------- Relatório ---------- */
+
+void relatar_perfil(FILE *saida, const PerfilPrograma *perfil, const GrafoChamadas *grafo) {
+    for (int i = 0; i < perfil->num_pontos; i++) {
+        const PontoPerfil *ponto = &perfil->pontos[i];
+        if (ponto->tipo == PONTO_FUNCAO && ponto->funcao >= 0) {
+            fprintf(saida, "Perfil: funcao '%s' executada %llu vez(es).\n",
+                    grafo->funcoes[ponto->funcao].entrada->lexema, perfil->contagens[ponto->contador]);
+        }
+    }
+    // Arestas: soma das chamadas de cada par (quem chama, função chamada),
+    // impressa na primeira chamada do par.
+    for (int i = 0; i < perfil->num_pontos; i++) {
+        const PontoPerfil *ponto = &perfil->pontos[i];
+        if (ponto->tipo != PONTO_CHAMADA || ponto->chamada < 0) continue;
+        int primeira = 1;
+        unsigned long long total = 0;
+        for (int j = 0; j < perfil->num_pontos && primeira; j++) {
+            const PontoPerfil *outro = &perfil->pontos[j];
+            if (outro->tipo != PONTO_CHAMADA || outro->funcao != ponto->funcao || outro->chamada != ponto->chamada) {
+                continue;
+            }
+            if (j < i) primeira = 0;
+            total += perfil->contagens[outro->contador];
+        }
+        if (!primeira || total == 0) continue;
+        fprintf(saida, "Perfil: aresta '%s' -> '%s' com %llu chamada(s).\n",
+                ponto->funcao >= 0 ? grafo->funcoes[ponto->funcao].entrada->lexema : "programa",
+                grafo->funcoes[ponto->chamada].entrada->lexema, total);
+    }
+}
+
+void liberar_perfil(PerfilPrograma *perfil) {
+    free(perfil->pontos);
+    free(perfil->contagens);
+    free(perfil->indice);
+    memset(perfil, 0, sizeof(*perfil));
+}
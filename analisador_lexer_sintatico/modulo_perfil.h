@@ -0,0 +1,103 @@
+#ifndef PERFIL_H
+#define PERFIL_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+#include "modulo_grafo_chamadas.h"
+#include "modulo_instrucoes_mips.h"
+
+/*
+ * Otimização guiada por perfil.
+ *
+ * Com --instrument, o código MIPS conta quantas vezes cada ponto do programa
+ * é executado: a entrada de cada função, cada 'se' e o seu braço 'entao',
+ * cada 'enquanto' e cada iteração do seu corpo, e cada chamada (a aresta do
+ * grafo de chamadas entre a função que chama e a chamada). Os contadores
+ * ficam em .data e, no fim do programa, são escritos na saída de erro
+ * (descritor 2, syscall 15) no formato
+ *
+ *     perfil-goianinha <assinatura> <numero de contadores>
+ *     <contador> <contagem>
+ *     ...
+ *
+ * Os pontos são numerados pela ordem em que aparecem na AST e a assinatura
+ * é calculada a partir deles, de modo que um perfil só é aceito pelo mesmo
+ * programa fonte. Execuções podem ser acumuladas concatenando os perfis.
+ * As contagens não dependem das otimizações: um contador de uma função
+ * expandida ou especializada conta em todas as cópias.
+ */
+
+// Uma chamada é quente quando executada ao menos 1/FRACAO_CHAMADA_QUENTE das
+// vezes da chamada mais executada; o orçamento de inline dela é multiplicado.
+#define FRACAO_CHAMADA_QUENTE 10
+#define FATOR_ORCAMENTO_QUENTE 4
+
+typedef enum {
+    PONTO_FUNCAO,       // Entrada da função (1 contador)
+    PONTO_SE,           // 'se' executado; o seguinte conta o braço 'entao'
+    PONTO_ENQUANTO,     // 'enquanto' executado; o seguinte conta as iterações
+    PONTO_CHAMADA       // Chamada executada (1 contador)
+} TipoPontoPerfil;
+
+typedef struct PontoPerfil {
+    TipoPontoPerfil tipo;
+    const NoAST *no;
+    int contador;           // Primeiro contador do ponto
+    int funcao;             // Função (índice no grafo) onde o ponto está; -1 em 'programa'
+    int chamada;            // (chamada) Função chamada, ou -1
+} PontoPerfil;
+
+typedef struct PerfilPrograma {
+    int num_pontos;
+    PontoPerfil *pontos;            // Na ordem da AST
+    int num_contadores;
+    unsigned long long *contagens;  // Somadas de todos os perfis lidos
+    unsigned assinatura;
+    int num_execucoes;              // Perfis lidos (0 = sem contagens)
+    unsigned long long maior_chamada; // Contagem da chamada mais executada
+    int capacidade_indice;          // Tabela de espalhamento nó -> ponto
+    int *indice;                    // Índice do ponto + 1 (0 = posição vazia)
+} PerfilPrograma;
+
+/**
+ * @brief Numera os pontos de perfil do programa (nó NO_PROGRAMA).
+ */
+void numerar_pontos_perfil(const NoAST *raiz, const GrafoChamadas *grafo, PerfilPrograma *perfil);
+
+/**
+ * @brief Lê as contagens de um arquivo gerado por um programa instrumentado.
+ * Linhas fora dos blocos do perfil são ignoradas. Termina a compilação se o
+ * arquivo não existe ou se foi gerado por outro programa.
+ */
+void carregar_perfil(const char *nome_arquivo, PerfilPrograma *perfil);
+
+/**
+ * @brief Primeiro contador do ponto associado ao nó (função, 'se',
+ * 'enquanto' ou chamada), ou -1.
+ */
+int contador_perfil(const PerfilPrograma *perfil, const NoAST *no);
+
+/**
+ * @brief Contagem de um contador (0 sem perfil carregado).
+ */
+unsigned long long contagem_perfil(const PerfilPrograma *perfil, int contador);
+
+/**
+ * @brief Orçamento de inline para uma chamada: as quentes recebem
+ * FATOR_ORCAMENTO_QUENTE vezes o orçamento e as nunca executadas, nenhum.
+ */
+int orcamento_inline_perfil(const PerfilPrograma *perfil, const NoAST *chamada, int orcamento);
+
+/**
+ * @brief Acrescenta a 'destino' os contadores e a rotina 'perfil_gravar',
+ * que escreve as contagens na saída de erro.
+ */
+void emitir_runtime_perfil(const PerfilPrograma *perfil, ListaInstrucoes *destino);
+
+/**
+ * @brief Imprime as funções e arestas do grafo de chamadas com as contagens lidas.
+ */
+void relatar_perfil(FILE *saida, const PerfilPrograma *perfil, const GrafoChamadas *grafo);
+
+void liberar_perfil(PerfilPrograma *perfil);
+
+#endif
@@ -0,0 +1,103 @@
+#include "modulo_pool_threads.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct PoolThreads {
+    pthread_t *threads;
+    int num_threads;                // Threads criadas (sem contar a que submete)
+    pthread_mutex_t trava;
+    pthread_cond_t novo_lote;       // Sinalizada quando um lote começa ou o conjunto encerra
+    pthread_cond_t lote_concluido;  // Sinalizada quando a última tarefa do lote termina
+    // Lote atual (protegido pela trava).
+    FuncaoTarefa tarefa;
+    void *contexto;
+    int num_tarefas;
+    int proxima;                    // Próxima tarefa ainda não iniciada
+    int pendentes;                  // Tarefas iniciadas ou não que ainda não terminaram
+    unsigned geracao;               // Número do lote, para as threads saberem que há um novo
+    int encerrar;
+};
+
+/**
+ * @brief Executa tarefas do lote atual até não haver mais nenhuma a iniciar.
+ * Chamada com a trava obtida; retorna com ela obtida.
+ */
+static void executar_lote(PoolThreads *pool) {
+    while (pool->proxima < pool->num_tarefas) {
+        int indice = pool->proxima++;
+        pthread_mutex_unlock(&pool->trava);
+        pool->tarefa(pool->contexto, indice);
+        pthread_mutex_lock(&pool->trava);
+        if (--pool->pendentes == 0) pthread_cond_broadcast(&pool->lote_concluido);
+    }
+}
+
+static void *executar_thread(void *argumento) {
+    PoolThreads *pool = argumento;
+    unsigned geracao_vista = 0;
+    pthread_mutex_lock(&pool->trava);
+    for (;;) {
+        while (!pool->encerrar && pool->geracao == geracao_vista) {
+            pthread_cond_wait(&pool->novo_lote, &pool->trava);
+        }
+        if (pool->encerrar) break;
+        geracao_vista = pool->geracao;
+        executar_lote(pool);
+    }
+    pthread_mutex_unlock(&pool->trava);
+    return NULL;
+}
+
+PoolThreads *criar_pool_threads(int num_threads) {
+    PoolThreads *pool = calloc(1, sizeof(PoolThreads));
+    int extras = num_threads > 1 ? num_threads - 1 : 0;
+    if (pool == NULL || (pool->threads = calloc(extras > 0 ? extras : 1, sizeof(pthread_t))) == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para as threads.\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_mutex_init(&pool->trava, NULL);
+    pthread_cond_init(&pool->novo_lote, NULL);
+    pthread_cond_init(&pool->lote_concluido, NULL);
+    // Sem recursos para uma thread, o conjunto segue com as que já existem.
+    while (pool->num_threads < extras
+           && pthread_create(&pool->threads[pool->num_threads], NULL, executar_thread, pool) == 0) {
+        pool->num_threads++;
+    }
+    return pool;
+}
+
+void executar_tarefas(PoolThreads *pool, int num_tarefas, FuncaoTarefa tarefa, void *contexto) {
+    if (num_tarefas <= 0) return;
+    pthread_mutex_lock(&pool->trava);
+    pool->tarefa = tarefa;
+    pool->contexto = contexto;
+    pool->num_tarefas = num_tarefas;
+    pool->proxima = 0;
+    pool->pendentes = num_tarefas;
+    pool->geracao++;
+    if (pool->num_threads > 0 && num_tarefas > 1) pthread_cond_broadcast(&pool->novo_lote);
+    executar_lote(pool);
+    while (pool->pendentes > 0) pthread_cond_wait(&pool->lote_concluido, &pool->trava);
+    pthread_mutex_unlock(&pool->trava);
+}
+
+void destruir_pool_threads(PoolThreads *pool) {
+    if (pool == NULL) return;
+    pthread_mutex_lock(&pool->trava);
+    pool->encerrar = 1;
+    pthread_cond_broadcast(&pool->novo_lote);
+    pthread_mutex_unlock(&pool->trava);
+    for (int i = 0; i < pool->num_threads; i++) pthread_join(pool->threads[i], NULL);
+    pthread_cond_destroy(&pool->lote_concluido);
+    pthread_cond_destroy(&pool->novo_lote);
+    pthread_mutex_destroy(&pool->trava);
+    free(pool->threads);
+    free(pool);
+}
+
+int processadores_disponiveis(void) {
+    long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+    return processadores > 0 ? (int)processadores : 1;
+}
@@ -0,0 +1,43 @@
+#ifndef POOL_THREADS_H
+#define POOL_THREADS_H
+
+/*
+ * Conjunto fixo de threads que executa lotes de tarefas independentes
+ * (usado pela geração de código MIPS, uma tarefa por função).
+ *
+ * As threads são criadas uma vez e esperam o próximo lote. Cada lote tem
+ * tarefas numeradas de 0 a N-1, distribuídas sob demanda entre as threads
+ * do conjunto e a thread que o submeteu, que também trabalha e só retorna
+ * quando todas terminaram. A ordem de execução não é determinística: quem
+ * usa o conjunto guarda o resultado de cada tarefa pelo índice.
+ */
+
+/**
+ * @brief Executa a tarefa de índice 'indice' de um lote.
+ */
+typedef void (*FuncaoTarefa)(void *contexto, int indice);
+
+typedef struct PoolThreads PoolThreads;
+
+/**
+ * @brief Cria um conjunto para executar até 'num_threads' tarefas ao mesmo
+ * tempo (contando a thread que submete os lotes; 1 = sem threads extras).
+ */
+PoolThreads *criar_pool_threads(int num_threads);
+
+/**
+ * @brief Executa as tarefas 0..num_tarefas-1 e espera todas terminarem.
+ */
+void executar_tarefas(PoolThreads *pool, int num_tarefas, FuncaoTarefa tarefa, void *contexto);
+
+/**
+ * @brief Encerra as threads e libera o conjunto.
+ */
+void destruir_pool_threads(PoolThreads *pool);
+
+/**
+ * @brief Número de processadores disponíveis (padrão de --threads).
+ */
+int processadores_disponiveis(void);
+
+#endif
@@ -0,0 +1,80 @@
+#include "modulo_protocolo_servidor.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+void caminho_socket_padrao(char *destino, size_t tamanho) {
+    const char *ambiente = getenv("GOIANINHA_SERVIDOR");
+    if (ambiente != NULL && *ambiente != '\0') {
+        snprintf(destino, tamanho, "%s", ambiente);
+    } else {
+        snprintf(destino, tamanho, "/tmp/goianinha-%ld.sock", (long)getuid());
+    }
+}
+
+int opcao_com_valor(const char *argumento) {
+    static const char *const opcoes[] = {
+        "--inline-budget", "--specialize-growth", "--eval-steps", "--eval-memory",
+    };
+    for (size_t i = 0; i < sizeof(opcoes) / sizeof(opcoes[0]); i++) {
+        if (strcmp(argumento, opcoes[i]) == 0) return 1;
+    }
+    return 0;
+}
+
+static int escrever_tudo(int descritor, const void *dados, size_t tamanho) {
+    const char *p = dados;
+    while (tamanho > 0) {
+        ssize_t escritos = write(descritor, p, tamanho);
+        if (escritos < 0 && errno == EINTR) continue;
+        if (escritos <= 0) return 0;
+        p += escritos;
+        tamanho -= (size_t)escritos;
+    }
+    return 1;
+}
+
+static int ler_tudo(int descritor, void *dados, size_t tamanho) {
+    char *p = dados;
+    while (tamanho > 0) {
+        ssize_t lidos = read(descritor, p, tamanho);
+        if (lidos < 0 && errno == EINTR) continue;
+        if (lidos <= 0) return 0;
+        p += lidos;
+        tamanho -= (size_t)lidos;
+    }
+    return 1;
+}
+
+int enviar_campo(int descritor, const void *dados, size_t tamanho) {
+    if (tamanho > MAX_CAMPO_PROTOCOLO) return 0;
+    unsigned char cabecalho[4] = {
+        (unsigned char)(tamanho >> 24), (unsigned char)(tamanho >> 16),
+        (unsigned char)(tamanho >> 8), (unsigned char)tamanho,
+    };
+    return escrever_tudo(descritor, cabecalho, sizeof(cabecalho)) && escrever_tudo(descritor, dados, tamanho);
+}
+
+int enviar_texto(int descritor, const char *texto) {
+    return enviar_campo(descritor, texto, strlen(texto));
+}
+
+char *receber_campo(int descritor, size_t *tamanho) {
+    unsigned char cabecalho[4];
+    if (!ler_tudo(descritor, cabecalho, sizeof(cabecalho))) return NULL;
+    uint32_t n = (uint32_t)cabecalho[0] << 24 | (uint32_t)cabecalho[1] << 16
+               | (uint32_t)cabecalho[2] << 8 | cabecalho[3];
+    if (n > MAX_CAMPO_PROTOCOLO) return NULL;
+    char *dados = malloc((size_t)n + 1);
+    if (dados == NULL) return NULL;
+    if (!ler_tudo(descritor, dados, n)) {
+        free(dados);
+        return NULL;
+    }
+    dados[n] = '\0';
+    if (tamanho != NULL) *tamanho = n;
+    return dados;
+}
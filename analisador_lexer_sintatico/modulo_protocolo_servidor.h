@@ -0,0 +1,52 @@
+#ifndef PROTOCOLO_SERVIDOR_H
+#define PROTOCOLO_SERVIDOR_H
+
+#include <stddef.h>
+
+/*
+ * Protocolo entre o servidor de compilação (goianinha --server) e o cliente
+ * (goianinha_cliente), num socket Unix local.
+ *
+ * Cada mensagem é uma sequência de campos; um campo é o tamanho (4 bytes,
+ * big-endian) seguido dos bytes. O pedido tem: a versão do protocolo, o
+ * diretório atual do cliente, o número de argumentos, os argumentos (sem o
+ * nome do programa), o indicador "1"/"0" de fonte enviado e os bytes do
+ * fonte. A resposta tem: a versão, o status de término, o que a compilação
+ * escreveu na saída padrão e na de erro, o nome do arquivo gerado ("" se
+ * nenhum) e o conteúdo dele.
+ */
+
+#define VERSAO_PROTOCOLO_SERVIDOR "goianinha-servidor 1"
+// Maior campo aceito: um fonte ou um saida.s maior que isso é recusado.
+#define MAX_CAMPO_PROTOCOLO (256u << 20)
+
+/**
+ * @brief Escreve o caminho padrão do socket: $GOIANINHA_SERVIDOR ou
+ * /tmp/goianinha-<uid>.sock.
+ */
+void caminho_socket_padrao(char *destino, size_t tamanho);
+
+/**
+ * @brief Indica se a opção de goianinha recebe o valor no argumento seguinte
+ * (como "--inline-budget N"); o cliente usa isso para achar o fonte.
+ */
+int opcao_com_valor(const char *argumento);
+
+/**
+ * @brief Envia um campo.
+ * @return 1 se tudo foi escrito.
+ */
+int enviar_campo(int descritor, const void *dados, size_t tamanho);
+
+/**
+ * @brief Envia um texto como campo (sem o '\0').
+ */
+int enviar_texto(int descritor, const char *texto);
+
+/**
+ * @brief Recebe um campo (terminado com um '\0' extra, não contado).
+ * @return Os bytes (liberar com free) ou NULL no fim da conexão ou em erro.
+ */
+char *receber_campo(int descritor, size_t *tamanho);
+
+#endif
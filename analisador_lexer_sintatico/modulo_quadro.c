@@ -0,0 +1,108 @@
+#include "modulo_quadro.h"
+
+typedef struct ContextoLayout {
+    LayoutQuadro *layout;
+    int capacidade;
+} ContextoLayout;
+
+static int alinhar_palavra(int bytes) {
+    return (bytes + 3) & ~3;
+}
+
+static void acrescentar_variavel(ContextoLayout *ctx, EntradaTabela *entrada, int posicao) {
+    LayoutQuadro *layout = ctx->layout;
+    if (layout->num_variaveis == ctx->capacidade) {
+        ctx->capacidade = ctx->capacidade == 0 ? 8 : ctx->capacidade * 2;
+        EntradaTabela **variaveis = realloc(layout->variaveis, ctx->capacidade * sizeof(EntradaTabela *));
+        int *posicoes = realloc(layout->posicoes, ctx->capacidade * sizeof(int));
+        if (variaveis == NULL || posicoes == NULL) {
+            fprintf(stderr, "Erro critico: Falha ao alocar memoria para o layout do quadro.\n");
+            exit(EXIT_FAILURE);
+        }
+        layout->variaveis = variaveis;
+        layout->posicoes = posicoes;
+    }
+    layout->variaveis[layout->num_variaveis] = entrada;
+    layout->posicoes[layout->num_variaveis] = posicao;
+    layout->num_variaveis++;
+}
+
+/**
+ * @brief Dispõe as variáveis de uma lista de declarações a partir de 'inicio'
+ * bytes abaixo de $fp: primeiro as 'int' (alinhadas), depois as 'car'.
+ * @return Bytes ocupados depois das declarações.
+ */
+static int dispor_declaracoes(ContextoLayout *ctx, const NoAST *declaracoes, int inicio) {
+    for (int bytes = 0; bytes <= 1; bytes++) {
+        for (const NoAST *decl = declaracoes; decl != NULL; decl = decl->proximo) {
+            if (decl->tipo_no != NO_DECL_VARIAVEL || decl->filho1->entrada_tabela == NULL) continue;
+            EntradaTabela *entrada = decl->filho1->entrada_tabela;
+            int byte = entrada->tipo == TIPO_CAR;
+            if (byte != bytes) continue;
+            inicio = byte ? inicio + 1 : alinhar_palavra(inicio) + 4;
+            acrescentar_variavel(ctx, entrada, -inicio);
+        }
+    }
+    return inicio;
+}
+
+static int dispor_bloco(ContextoLayout *ctx, const NoAST *bloco, int inicio);
+
+/**
+ * @brief Procura os blocos internos de uma lista de comandos. Todos começam
+ * em 'inicio': blocos irmãos reaproveitam os mesmos bytes.
+ * @return O maior número de bytes ocupados por algum deles.
+ */
+static int dispor_blocos(ContextoLayout *ctx, const NoAST *no, int inicio) {
+    int fim = inicio;
+    for (; no != NULL; no = no->proximo) {
+        int fim_no;
+        if (no->tipo_no == NO_BLOCO) {
+            fim_no = dispor_bloco(ctx, no, inicio);
+        } else {
+            int a = dispor_blocos(ctx, no->filho1, inicio);
+            int b = dispor_blocos(ctx, no->filho2, inicio);
+            int c = dispor_blocos(ctx, no->filho3, inicio);
+            fim_no = a > b ? a : b;
+            if (c > fim_no) fim_no = c;
+        }
+        if (fim_no > fim) fim = fim_no;
+    }
+    return fim;
+}
+
+static int dispor_bloco(ContextoLayout *ctx, const NoAST *bloco, int inicio) {
+    int fim = dispor_declaracoes(ctx, bloco->filho1, inicio);
+    int fim_internos = dispor_blocos(ctx, bloco->filho2, fim);
+    return fim_internos > fim ? fim_internos : fim;
+}
+
+void calcular_layout_quadro(const NoAST *declaracoes, const NoAST *comandos, int base, LayoutQuadro *layout) {
+    layout->num_variaveis = 0;
+    layout->variaveis = NULL;
+    layout->posicoes = NULL;
+
+    ContextoLayout ctx;
+    ctx.layout = layout;
+    ctx.capacidade = 0;
+    int fim = dispor_declaracoes(&ctx, declaracoes, base);
+    int fim_internos = dispor_blocos(&ctx, comandos, fim);
+    if (fim_internos > fim) fim = fim_internos;
+
+    layout->tamanho = alinhar_palavra(fim) - base;
+    layout->tamanho_sem_reuso = 4 * layout->num_variaveis;
+}
+
+void aplicar_layout_quadro(const LayoutQuadro *layout) {
+    for (int i = 0; i < layout->num_variaveis; i++) {
+        layout->variaveis[i]->posicao = layout->posicoes[i];
+    }
+}
+
+void liberar_layout_quadro(LayoutQuadro *layout) {
+    free(layout->variaveis);
+    free(layout->posicoes);
+    layout->variaveis = NULL;
+    layout->posicoes = NULL;
+    layout->num_variaveis = 0;
+}
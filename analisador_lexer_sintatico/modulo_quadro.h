@@ -0,0 +1,45 @@
+#ifndef QUADRO_H
+#define QUADRO_H
+
+#include "modulo_arvore_sintatica_abstrata.h"
+
+/*
+ * Layout do quadro (registro de ativação) das variáveis locais.
+ *
+ * Todas as locais ganham posição, inclusive as declaradas em blocos
+ * internos. Blocos irmãos (cujas variáveis nunca estão vivas ao mesmo tempo)
+ * começam na mesma posição e reaproveitam os mesmos bytes. Variáveis 'car'
+ * ocupam um único byte (acessado com lb/sb) e ficam depois das 'int' do
+ * mesmo bloco, que ficam alinhadas em 4 bytes.
+ */
+
+/**
+ * @brief Posições (offsets em relação a $fp) calculadas para um quadro.
+ */
+typedef struct LayoutQuadro {
+    int num_variaveis;
+    EntradaTabela **variaveis;
+    int *posicoes;              // Offset (negativo) de cada variável em relação a $fp
+    int tamanho;                // Bytes ocupados abaixo da base, múltiplo de 4
+    int tamanho_sem_reuso;      // Bytes com uma palavra por variável e sem reuso
+} LayoutQuadro;
+
+/**
+ * @brief Calcula as posições das locais de um corpo.
+ * @param declaracoes Lista de declarações do nível mais externo (as funções são ignoradas).
+ * @param comandos Lista de comandos, percorrida em busca de blocos internos.
+ * @param base Bytes abaixo de $fp já ocupados; as posições começam depois deles.
+ */
+void calcular_layout_quadro(const NoAST *declaracoes, const NoAST *comandos, int base, LayoutQuadro *layout);
+
+/**
+ * @brief Grava as posições calculadas nas entradas da tabela de símbolos.
+ */
+void aplicar_layout_quadro(const LayoutQuadro *layout);
+
+/**
+ * @brief Libera a memória do layout.
+ */
+void liberar_layout_quadro(LayoutQuadro *layout);
+
+#endif
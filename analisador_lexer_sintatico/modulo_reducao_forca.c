@@ -0,0 +1,170 @@
+#include "modulo_reducao_forca.h"
+#include <stdint.h>
+
+/**
+ * @brief Parcela "sinal * (x << deslocamento)" de uma multiplicação.
+ */
+typedef struct Parcela {
+    int sinal;
+    int deslocamento;
+} Parcela;
+
+/**
+ * @brief Emite "opcode destino, fonte, valor" (sll, srl, sra).
+ */
+static void emitir_com_imediato(ListaInstrucoes *lista, const char *opcode, const char *destino, const char *fonte, int valor) {
+    char instrucao[96];
+    snprintf(instrucao, sizeof(instrucao), "%s %s, %s, %d", opcode, destino, fonte, valor);
+    adicionar_instrucao(lista, instrucao);
+}
+
+/**
+ * @brief Emite "opcode destino, fonte1, fonte2" (addu, subu).
+ */
+static void emitir_com_registradores(ListaInstrucoes *lista, const char *opcode, const char *destino, const char *fonte1, const char *fonte2) {
+    char instrucao[96];
+    snprintf(instrucao, sizeof(instrucao), "%s %s, %s, %s", opcode, destino, fonte1, fonte2);
+    adicionar_instrucao(lista, instrucao);
+}
+
+/**
+ * @brief Decompõe 'valor' na forma não adjacente (dígitos -1, 0 e 1 com o
+ * menor número de dígitos não nulos). Dígitos na posição 32 ou acima são
+ * descartados, pois não alteram o resultado em 32 bits.
+ * @return O número de parcelas.
+ */
+static int decompor_forma_nao_adjacente(uint64_t valor, Parcela parcelas[32]) {
+    int n = 0;
+    for (int posicao = 0; valor != 0 && posicao < 32; posicao++, valor >>= 1) {
+        if (valor & 1) {
+            int digito = (valor & 3) == 1 ? 1 : -1;
+            valor = digito == 1 ? valor - 1 : valor + 1;
+            parcelas[n].sinal = digito;
+            parcelas[n].deslocamento = posicao;
+            n++;
+        }
+    }
+    return n;
+}
+
+int gerar_multiplicacao_constante(ListaInstrucoes *lista, int constante) {
+    Parcela parcelas[32];
+    uint64_t magnitude = constante < 0 ? (uint64_t)(-(int64_t)constante) : (uint64_t)constante;
+    int n = decompor_forma_nao_adjacente(magnitude, parcelas);
+
+    if (n == 0) {
+        adicionar_instrucao(lista, "li $v0, 0");
+        return 1;
+    }
+    if (n > MAX_PARCELAS_MULTIPLICACAO) return 0;
+
+    // O sinal da constante é aplicado às parcelas; uma parcela positiva vai
+    // primeiro para evitar uma negação extra.
+    for (int i = 0; i < n; i++) {
+        if (constante < 0) parcelas[i].sinal = -parcelas[i].sinal;
+    }
+    for (int i = 0; i < n; i++) {
+        if (parcelas[i].sinal > 0) {
+            Parcela primeira = parcelas[i];
+            parcelas[i] = parcelas[0];
+            parcelas[0] = primeira;
+            break;
+        }
+    }
+
+    // Acumula em $t0 e escreve o resultado em $v0 apenas na última instrução.
+    const char *acumulador = "$v0";
+    if (parcelas[0].deslocamento > 0) {
+        const char *destino = (n == 1 && parcelas[0].sinal > 0) ? "$v0" : "$t0";
+        emitir_com_imediato(lista, "sll", destino, "$v0", parcelas[0].deslocamento);
+        acumulador = destino;
+    }
+    if (parcelas[0].sinal < 0) {
+        const char *destino = n == 1 ? "$v0" : "$t0";
+        emitir_com_registradores(lista, "subu", destino, "$zero", acumulador);
+        acumulador = destino;
+    }
+
+    for (int i = 1; i < n; i++) {
+        const char *fonte = "$v0";
+        if (parcelas[i].deslocamento > 0) {
+            emitir_com_imediato(lista, "sll", "$t1", "$v0", parcelas[i].deslocamento);
+            fonte = "$t1";
+        }
+        const char *destino = (i == n - 1) ? "$v0" : "$t0";
+        emitir_com_registradores(lista, parcelas[i].sinal > 0 ? "addu" : "subu", destino, acumulador, fonte);
+        acumulador = destino;
+    }
+    return 1;
+}
+
+void calcular_numero_magico(int divisor, int *magico, int *deslocamento) {
+    const uint32_t dois_31 = 0x80000000u;
+    uint32_t ad = divisor < 0 ? 0u - (uint32_t)divisor : (uint32_t)divisor;
+    uint32_t t = dois_31 + ((uint32_t)divisor >> 31);
+    uint32_t anc = t - 1 - t % ad;
+    int p = 31;
+    uint32_t q1 = dois_31 / anc, r1 = dois_31 - q1 * anc;
+    uint32_t q2 = dois_31 / ad, r2 = dois_31 - q2 * ad;
+    uint32_t delta;
+
+    do {
+        p++;
+        q1 = 2 * q1;
+        r1 = 2 * r1;
+        if (r1 >= anc) { q1++; r1 -= anc; }
+        q2 = 2 * q2;
+        r2 = 2 * r2;
+        if (r2 >= ad) { q2++; r2 -= ad; }
+        delta = ad - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+
+    uint32_t m = q2 + 1;
+    *magico = (int32_t)(divisor < 0 ? 0u - m : m);
+    *deslocamento = p - 32;
+}
+
+int gerar_divisao_constante(ListaInstrucoes *lista, int constante) {
+    if (constante == 0) return 0;
+    if (constante == 1) return 1;
+    if (constante == -1) {
+        adicionar_instrucao(lista, "subu $v0, $zero, $v0");
+        return 1;
+    }
+
+    uint32_t magnitude = constante < 0 ? 0u - (uint32_t)constante : (uint32_t)constante;
+    if ((magnitude & (magnitude - 1)) == 0) {
+        // x / 2^k: soma 2^k - 1 aos negativos antes do deslocamento aritmético.
+        int k = 0;
+        while ((1u << k) != magnitude) k++;
+        if (k == 1) {
+            adicionar_instrucao(lista, "srl $t0, $v0, 31");
+        } else {
+            adicionar_instrucao(lista, "sra $t0, $v0, 31");
+            emitir_com_imediato(lista, "srl", "$t0", "$t0", 32 - k);
+        }
+        adicionar_instrucao(lista, "addu $t0, $v0, $t0");
+        if (constante > 0) {
+            emitir_com_imediato(lista, "sra", "$v0", "$t0", k);
+        } else {
+            emitir_com_imediato(lista, "sra", "$t0", "$t0", k);
+            adicionar_instrucao(lista, "subu $v0, $zero, $t0");
+        }
+        return 1;
+    }
+
+    int magico, deslocamento;
+    calcular_numero_magico(constante, &magico, &deslocamento);
+    char instrucao[64];
+    snprintf(instrucao, sizeof(instrucao), "li $t1, %d", magico);
+    adicionar_instrucao(lista, instrucao);
+    adicionar_instrucao(lista, "mult $v0, $t1");
+    adicionar_instrucao(lista, "mfhi $t0");
+    if (constante > 0 && magico < 0) adicionar_instrucao(lista, "addu $t0, $t0, $v0");
+    if (constante < 0 && magico > 0) adicionar_instrucao(lista, "subu $t0, $t0, $v0");
+    if (deslocamento > 0) emitir_com_imediato(lista, "sra", "$t0", "$t0", deslocamento);
+    // Soma 1 quando o quociente parcial é negativo (truncamento em direção a zero).
+    adicionar_instrucao(lista, "srl $t1, $t0, 31");
+    adicionar_instrucao(lista, "addu $v0, $t0, $t1");
+    return 1;
+}
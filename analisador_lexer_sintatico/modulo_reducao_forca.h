@@ -0,0 +1,38 @@
+#ifndef REDUCAO_FORCA_H
+#define REDUCAO_FORCA_H
+
+#include "modulo_instrucoes_mips.h"
+
+/*
+ * Redução de força de multiplicações e divisões por constantes.
+ *
+ * As sequências geradas leem o operando em $v0, deixam o resultado em $v0
+ * e usam apenas $t0 e $t1 como temporários. Os resultados são idênticos aos
+ * de "mult/mflo" (32 bits menos significativos) e de "div/mflo" (quociente
+ * truncado em direção a zero; INT_MIN / -1 resulta em INT_MIN).
+ */
+
+// Número máximo de parcelas (sll + addu/subu) antes de preferir 'mult'.
+#define MAX_PARCELAS_MULTIPLICACAO 3
+
+/**
+ * @brief Gera $v0 = $v0 * constante com deslocamentos, somas e subtrações.
+ * @return 1 se a sequência foi gerada, 0 se 'mult' é mais barato.
+ */
+int gerar_multiplicacao_constante(ListaInstrucoes *lista, int constante);
+
+/**
+ * @brief Gera $v0 = $v0 / constante (divisão com sinal, truncada em direção a zero).
+ * Potências de dois usam 'sra' com correção de arredondamento; os demais
+ * divisores usam multiplicação pelo número mágico e 'mfhi'.
+ * @return 1 se a sequência foi gerada, 0 para constante 0 (mantém o 'div').
+ */
+int gerar_divisao_constante(ListaInstrucoes *lista, int constante);
+
+/**
+ * @brief Calcula o número mágico e o deslocamento para a divisão com sinal
+ * por 'divisor' (|divisor| >= 2), conforme o algoritmo de Hacker's Delight.
+ */
+void calcular_numero_magico(int divisor, int *magico, int *deslocamento);
+
+#endif
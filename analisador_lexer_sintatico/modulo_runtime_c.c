@@ -0,0 +1,87 @@
+#include "modulo_runtime_c.h"
+
+/*
+ * A saída só é escrita quando o buffer enche, antes de cada 'leia', no fim
+ * do programa e antes da mensagem de divisão por zero. 'leia' pula espaços,
+ * aceita um '-' e devolve 0 no fim da entrada.
+ */
+static const char *runtime[] = {
+    "#include <stdint.h>",
+    "#include <stdio.h>",
+    "#include <stdlib.h>",
+    "",
+    "#define GN_TAMANHO_BUFFER 65536",
+    "",
+    "static char gn_saida[GN_TAMANHO_BUFFER];",
+    "static int gn_tamanho_saida;",
+    "",
+    "static void gn_descarregar(void) {",
+    "    if (gn_tamanho_saida > 0 && fwrite(gn_saida, 1, gn_tamanho_saida, stdout) != (size_t)gn_tamanho_saida) {",
+    "        perror(\"Erro ao escrever a saida do programa\");",
+    "        exit(EXIT_FAILURE);",
+    "    }",
+    "    fflush(stdout);",
+    "    gn_tamanho_saida = 0;",
+    "}",
+    "",
+    "static inline void gn_escreva_car(int32_t valor) {",
+    "    if (gn_tamanho_saida == GN_TAMANHO_BUFFER) gn_descarregar();",
+    "    gn_saida[gn_tamanho_saida++] = (char)valor;",
+    "}",
+    "",
+    "static inline void gn_escreva_texto(const char *texto, int tamanho) {",
+    "    for (int i = 0; i < tamanho; i++) gn_escreva_car(texto[i]);",
+    "}",
+    "",
+    "static inline void gn_escreva_int(int32_t valor) {",
+    "    char digitos[12];",
+    "    int n = sizeof(digitos);",
+    "    uint32_t modulo = valor < 0 ? 0u - (uint32_t)valor : (uint32_t)valor;",
+    "    do {",
+    "        digitos[--n] = (char)('0' + modulo % 10);",
+    "        modulo /= 10;",
+    "    } while (modulo != 0);",
+    "    if (valor < 0) digitos[--n] = '-';",
+    "    gn_escreva_texto(digitos + n, (int)sizeof(digitos) - n);",
+    "}",
+    "",
+    "static inline int32_t gn_leia_int(void) {",
+    "    gn_descarregar();",
+    "    int c;",
+    "    do {",
+    "        c = getchar();",
+    "    } while (c != EOF && c <= ' ');",
+    "    if (c == EOF) return 0;",
+    "    int negativo = c == '-';",
+    "    if (negativo) c = getchar();",
+    "    uint32_t valor = 0;",
+    "    while (c >= '0' && c <= '9') {",
+    "        valor = valor * 10 + (uint32_t)(c - '0');",
+    "        c = getchar();",
+    "    }",
+    "    if (c != EOF) ungetc(c, stdin);",
+    "    return (int32_t)(negativo ? 0u - valor : valor);",
+    "}",
+    "",
+    "/* Aritmetica de 32 bits em complemento de dois. */",
+    "static inline int32_t gn_soma(int32_t a, int32_t b) { return (int32_t)((uint32_t)a + (uint32_t)b); }",
+    "static inline int32_t gn_sub(int32_t a, int32_t b) { return (int32_t)((uint32_t)a - (uint32_t)b); }",
+    "static inline int32_t gn_mult(int32_t a, int32_t b) { return (int32_t)((uint32_t)a * (uint32_t)b); }",
+    "",
+    "/* Divisao truncada em direcao a zero; INT_MIN / -1 resulta em INT_MIN, como no 'div' do MIPS. */",
+    "static inline int32_t gn_divide(int32_t a, int32_t b) {",
+    "    if (b == 0) {",
+    "        gn_descarregar();",
+    "        fputs(\"Erro de execucao: divisao por zero\\n\", stderr);",
+    "        exit(EXIT_FAILURE);",
+    "    }",
+    "    if (b == -1) return gn_sub(0, a);",
+    "    return a / b;",
+    "}",
+    "",
+    NULL
+};
+
+void emitir_runtime_c(FILE *arquivo) {
+    for (int i = 0; runtime[i] != NULL; i++) fprintf(arquivo, "%s\n", runtime[i]);
+}
@@ -0,0 +1,29 @@
+#ifndef RUNTIME_C_H
+#define RUNTIME_C_H
+
+#include <stdio.h>
+
+/*
+ * Runtime incluído no início do arquivo gerado por --target=c: aritmética
+ * de 32 bits em complemento de dois (sem comportamento indefinido em C),
+ * divisão truncada com os casos especiais do backend MIPS e E/S buferizada
+ * com a mesma semântica do runtime do assembly. Todas as rotinas são
+ * 'static', para o compilador C poder expandi-las.
+ */
+
+#define ROTINA_C_SOMA "gn_soma"
+#define ROTINA_C_SUB "gn_sub"
+#define ROTINA_C_MULT "gn_mult"
+#define ROTINA_C_DIVIDE "gn_divide"
+#define ROTINA_C_ESCREVA_INT "gn_escreva_int"
+#define ROTINA_C_ESCREVA_CAR "gn_escreva_car"
+#define ROTINA_C_ESCREVA_TEXTO "gn_escreva_texto"
+#define ROTINA_C_LEIA_INT "gn_leia_int"
+#define ROTINA_C_DESCARREGAR "gn_descarregar"
+
+/**
+ * @brief Escreve os #include e as rotinas do runtime.
+ */
+void emitir_runtime_c(FILE *arquivo);
+
+#endif
@@ -0,0 +1,265 @@
+#include "modulo_runtime_es.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * O buffer de saída tem 1024 bytes e é seguido pela posição de escrita (em
+ * rt_buffer_saida+1024) e por 12 bytes onde os dígitos de um número são
+ * montados de trás para frente. O de entrada tem 256 bytes (uma linha lida
+ * pelo syscall 8), seguidos pela posição de leitura. Invariante: a posição
+ * de escrita é sempre menor que 1024 quando uma rotina retorna.
+ */
+
+static const char *dados_saida[] = {
+    ".align 2",
+    "rt_buffer_saida:",
+    ".space 1024",
+    "rt_posicao_saida:",
+    ".word 0",
+    "rt_digitos:",
+    ".space 12",
+    NULL
+};
+
+static const char *dados_entrada[] = {
+    ".align 2",
+    "rt_buffer_entrada:",
+    ".space 256",
+    "rt_posicao_entrada:",
+    ".word 0",
+    NULL
+};
+
+static const char *rotina_descarregar[] = {
+    "rt_descarregar:",
+    "la $t8, rt_buffer_saida",
+    "lw $a2, 1024($t8)",
+    "beqz $a2, rt_descarregar_fim",
+    "li $a0, 1",
+    "move $a1, $t8",
+    "li $v0, 15",
+    "syscall",
+    "sw $zero, 1024($t8)",
+    "rt_descarregar_fim:",
+    "jr $ra",
+    NULL
+};
+
+/*
+ * Alcançada por "beqz <divisor>, rt_divisao_por_zero" antes de um 'div': o
+ * que o programa já escreveu sai antes de o 'div' parar a execução. Onde a
+ * divisão por zero não gera exceção, o programa termina com código 1.
+ */
+static const char *rotina_divisao_zero[] = {
+    "rt_divisao_por_zero:",
+    "jal rt_descarregar",
+    "div $zero, $zero",
+    "li $a0, 1",
+    "li $v0, 17",
+    "syscall",
+    NULL
+};
+
+static const char *rotina_escreva_car[] = {
+    "rt_escreva_car:",
+    "la $t8, rt_buffer_saida",
+    "lw $t9, 1024($t8)",
+    "addu $t7, $t8, $t9",
+    "sb $a0, 0($t7)",
+    "addiu $t9, $t9, 1",
+    "sw $t9, 1024($t8)",
+    "li $t7, 1024",
+    "beq $t9, $t7, rt_descarregar",
+    "jr $ra",
+    NULL
+};
+
+static const char *rotina_escreva_str[] = {
+    "rt_escreva_str:",
+    "move $t0, $ra",
+    "move $t6, $a0",
+    "rt_escreva_str_bloco:",
+    "la $t8, rt_buffer_saida",
+    "lw $t9, 1024($t8)",
+    "li $t5, 1024",
+    "rt_escreva_str_laco:",
+    "lbu $t7, 0($t6)",
+    "beqz $t7, rt_escreva_str_fim",
+    "addu $t4, $t8, $t9",
+    "sb $t7, 0($t4)",
+    "addiu $t6, $t6, 1",
+    "addiu $t9, $t9, 1",
+    "bne $t9, $t5, rt_escreva_str_laco",
+    "sw $t9, 1024($t8)",
+    "jal rt_descarregar",
+    "j rt_escreva_str_bloco",
+    "rt_escreva_str_fim:",
+    "sw $t9, 1024($t8)",
+    "jr $t0",
+    NULL
+};
+
+/* O módulo é tratado sem sinal (divu), o que também vale para INT_MIN. */
+static const char *rotina_escreva_int[] = {
+    "rt_escreva_int:",
+    "move $t0, $ra",
+    "la $t8, rt_buffer_saida",
+    "lw $t9, 1024($t8)",
+    "slti $t7, $t9, 1014",
+    "bnez $t7, rt_escreva_int_formata",
+    "move $t6, $a0",
+    "jal rt_descarregar",
+    "move $a0, $t6",
+    "li $t9, 0",
+    "rt_escreva_int_formata:",
+    "move $t6, $a0",
+    "addiu $t5, $t8, 1040",
+    "bgez $t6, rt_escreva_int_digitos",
+    "subu $t6, $zero, $t6",
+    "rt_escreva_int_digitos:",
+    "li $t4, 10",
+    "rt_escreva_int_laco:",
+    "divu $t6, $t4",
+    "mfhi $t7",
+    "mflo $t6",
+    "addiu $t7, $t7, 48",
+    "addiu $t5, $t5, -1",
+    "sb $t7, 0($t5)",
+    "bnez $t6, rt_escreva_int_laco",
+    "bgez $a0, rt_escreva_int_copia",
+    "li $t7, 45",
+    "addiu $t5, $t5, -1",
+    "sb $t7, 0($t5)",
+    "rt_escreva_int_copia:",
+    "addiu $t4, $t8, 1040",
+    "addu $t3, $t8, $t9",
+    "rt_escreva_int_copia_laco:",
+    "lbu $t7, 0($t5)",
+    "sb $t7, 0($t3)",
+    "addiu $t5, $t5, 1",
+    "addiu $t3, $t3, 1",
+    "bne $t5, $t4, rt_escreva_int_copia_laco",
+    "subu $t9, $t3, $t8",
+    "sw $t9, 1024($t8)",
+    "move $ra, $t0",
+    "li $t7, 1024",
+    "beq $t9, $t7, rt_descarregar",
+    "jr $ra",
+    NULL
+};
+
+/* rt_leia_car devolve em $v1 o próximo caractere da entrada (0 no fim). */
+static const char *rotina_leia_int[] = {
+    "rt_leia_car:",
+    "la $t8, rt_buffer_entrada",
+    "lw $t9, 256($t8)",
+    "addu $t7, $t8, $t9",
+    "lbu $v1, 0($t7)",
+    "bnez $v1, rt_leia_car_avanca",
+    "move $a0, $t8",
+    "li $a1, 256",
+    "li $v0, 8",
+    "syscall",
+    "li $t9, 0",
+    "lbu $v1, 0($t8)",
+    "rt_leia_car_avanca:",
+    "beqz $v1, rt_leia_car_fim",
+    "addiu $t9, $t9, 1",
+    "rt_leia_car_fim:",
+    "sw $t9, 256($t8)",
+    "jr $ra",
+    "rt_leia_int:",
+    "move $t0, $ra",
+    "jal rt_descarregar",
+    "rt_leia_int_espacos:",
+    "jal rt_leia_car",
+    "beqz $v1, rt_leia_int_fim_entrada",
+    "slti $t7, $v1, 33",
+    "bnez $t7, rt_leia_int_espacos",
+    "li $t6, 0",
+    "li $t7, 45",
+    "bne $v1, $t7, rt_leia_int_digitos",
+    "li $t6, 1",
+    "jal rt_leia_car",
+    "rt_leia_int_digitos:",
+    "li $t5, 0",
+    "rt_leia_int_laco:",
+    "addiu $t7, $v1, -48",
+    "sltiu $t4, $t7, 10",
+    "beqz $t4, rt_leia_int_fim",
+    "sll $t4, $t5, 3",
+    "sll $t5, $t5, 1",
+    "addu $t5, $t5, $t4",
+    "addu $t5, $t5, $t7",
+    "jal rt_leia_car",
+    "j rt_leia_int_laco",
+    "rt_leia_int_fim:",
+    "move $v0, $t5",
+    "beqz $t6, rt_leia_int_retorna",
+    "subu $v0, $zero, $t5",
+    "rt_leia_int_retorna:",
+    "jr $t0",
+    "rt_leia_int_fim_entrada:",
+    "li $v0, 0",
+    "jr $t0",
+    NULL
+};
+
+static const char *nomes_rotinas[NUM_ROTINAS_ES] = {
+    "rt_escreva_int", "rt_escreva_car", "rt_escreva_str", "rt_leia_int", "rt_descarregar",
+    "rt_divisao_por_zero"
+};
+
+void iniciar_runtime_es(RuntimeES *runtime) {
+    memset(runtime, 0, sizeof(*runtime));
+}
+
+const char *usar_rotina_es(RuntimeES *runtime, RotinaES rotina) {
+    runtime->chamadas[rotina]++;
+    return nomes_rotinas[rotina];
+}
+
+/**
+ * @brief Acrescenta as linhas de um trecho: labels terminam com ':' e
+ * diretivas começam com '.'.
+ */
+static void emitir_trecho(ListaInstrucoes *destino, const char **linhas) {
+    char label[64];
+    for (int i = 0; linhas[i] != NULL; i++) {
+        size_t tamanho = strlen(linhas[i]);
+        if (linhas[i][tamanho - 1] == ':') {
+            snprintf(label, sizeof(label), "%.*s", (int)(tamanho - 1), linhas[i]);
+            adicionar_label(destino, label);
+        } else if (linhas[i][0] == '.') {
+            adicionar_diretiva(destino, linhas[i]);
+        } else {
+            adicionar_instrucao(destino, linhas[i]);
+        }
+    }
+}
+
+void emitir_runtime_es(const RuntimeES *runtime, ListaInstrucoes *destino) {
+    const int *chamadas = runtime->chamadas;
+    int saida = chamadas[ROTINA_ESCREVA_INT] + chamadas[ROTINA_ESCREVA_CAR] + chamadas[ROTINA_ESCREVA_STR];
+    int leitura = chamadas[ROTINA_LEIA_INT];
+    if (saida == 0 && leitura == 0 && chamadas[ROTINA_DESCARREGAR] == 0 && chamadas[ROTINA_DIVISAO_ZERO] == 0) {
+        return;
+    }
+
+    adicionar_comentario(destino, "--- Runtime de entrada e saida ---");
+    adicionar_diretiva(destino, ".data");
+    emitir_trecho(destino, dados_saida);
+    if (leitura > 0) emitir_trecho(destino, dados_entrada);
+    adicionar_diretiva(destino, ".text");
+    emitir_trecho(destino, rotina_descarregar);
+    if (chamadas[ROTINA_DIVISAO_ZERO] > 0) emitir_trecho(destino, rotina_divisao_zero);
+    if (chamadas[ROTINA_ESCREVA_CAR] > 0) emitir_trecho(destino, rotina_escreva_car);
+    if (chamadas[ROTINA_ESCREVA_STR] > 0) emitir_trecho(destino, rotina_escreva_str);
+    if (chamadas[ROTINA_ESCREVA_INT] > 0) emitir_trecho(destino, rotina_escreva_int);
+    if (leitura > 0) emitir_trecho(destino, rotina_leia_int);
+
+    printf("E/S: saida bufferizada com %d chamada(s) de escrita (%d de int, %d de car, %d de string) "
+           "e %d de leitura.\n",
+           saida, chamadas[ROTINA_ESCREVA_INT], chamadas[ROTINA_ESCREVA_CAR], chamadas[ROTINA_ESCREVA_STR],
+           leitura);
+}
@@ -0,0 +1,47 @@
+#ifndef RUNTIME_ES_H
+#define RUNTIME_ES_H
+
+#include "modulo_instrucoes_mips.h"
+
+/*
+ * Runtime de entrada e saída emitido junto com o programa.
+ *
+ * Com a saída bufferizada, 'escreva' e 'novalinha' não fazem um syscall por
+ * item: os números são formatados pela própria rotina num buffer de 1 KiB,
+ * que só é escrito (syscall 15, no descritor 1) quando enche, antes de cada
+ * 'leia', antes de uma divisão por zero parar o programa e no fim dele. 'leia' lê uma linha por vez (syscall 8) e
+ * converte os números a partir dela.
+ *
+ * As rotinas usam apenas $v0, $v1, $a0-$a3 e $t0-$t9 (o que uma chamada já
+ * pode destruir), e só as rotinas usadas pelo programa são emitidas.
+ */
+
+typedef enum RotinaES {
+    ROTINA_ESCREVA_INT,         // $a0: inteiro a escrever
+    ROTINA_ESCREVA_CAR,         // $a0: caractere a escrever
+    ROTINA_ESCREVA_STR,         // $a0: endereço da string
+    ROTINA_LEIA_INT,            // Devolve em $v0 o inteiro lido (0 no fim da entrada)
+    ROTINA_DESCARREGAR,         // Escreve o que está no buffer de saída
+    ROTINA_DIVISAO_ZERO,        // Desvio (não 'jal') com divisor zero: descarrega e para
+    NUM_ROTINAS_ES
+} RotinaES;
+
+typedef struct RuntimeES {
+    int chamadas[NUM_ROTINAS_ES];   // Chamadas geradas para cada rotina
+} RuntimeES;
+
+void iniciar_runtime_es(RuntimeES *runtime);
+
+/**
+ * @brief Registra uma chamada à rotina.
+ * @return O label da rotina (para o 'jal').
+ */
+const char *usar_rotina_es(RuntimeES *runtime, RotinaES rotina);
+
+/**
+ * @brief Acrescenta a 'destino' os buffers e as rotinas usadas.
+ * Imprime um resumo das chamadas geradas.
+ */
+void emitir_runtime_es(const RuntimeES *runtime, ListaInstrucoes *destino);
+
+#endif
@@ -0,0 +1,235 @@
+#include "modulo_runtime_x86.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * A posição de escrita fica sempre abaixo de 4096 quando uma rotina retorna
+ * (o buffer é descarregado assim que enche). O buffer de entrada guarda o
+ * último bloco lido; a posição e o tamanho dizem o que ainda não foi usado.
+ */
+
+static const char *dados[] = {
+    ".bss",
+    ".align 16",
+    "rt_buffer_saida:",
+    ".zero 4096",
+    "rt_buffer_entrada:",
+    ".zero 4096",
+    "rt_posicao_saida:",
+    ".zero 4",
+    "rt_posicao_entrada:",
+    ".zero 4",
+    "rt_tamanho_entrada:",
+    ".zero 4",
+    ".section .rodata",
+    "rt_mensagem_divisao:",
+    ".ascii \"Erro de execucao: divisao por zero\\n\"",
+    ".text",
+    NULL
+};
+
+static const char *rotina_descarregar[] = {
+    "rt_descarregar:",
+    "movl rt_posicao_saida(%rip), %edx",
+    "leaq rt_buffer_saida(%rip), %rsi",
+    "rt_descarregar_laco:",
+    "testl %edx, %edx",
+    "jz rt_descarregar_fim",
+    "movl $1, %edi",
+    "movl $1, %eax",                    // write
+    "syscall",
+    "testq %rax, %rax",
+    "jle rt_descarregar_fim",           // Erro de escrita: descarta o buffer
+    "addq %rax, %rsi",
+    "subl %eax, %edx",
+    "jmp rt_descarregar_laco",
+    "rt_descarregar_fim:",
+    "movl $0, rt_posicao_saida(%rip)",
+    "ret",
+    NULL
+};
+
+static const char *rotina_escreva_car[] = {
+    "rt_escreva_car:",
+    "movl rt_posicao_saida(%rip), %eax",
+    "leaq rt_buffer_saida(%rip), %rcx",
+    "movb %dil, (%rcx,%rax)",
+    "incl %eax",
+    "movl %eax, rt_posicao_saida(%rip)",
+    "cmpl $4096, %eax",
+    "je rt_descarregar",
+    "ret",
+    NULL
+};
+
+/* rt_escreva_car preserva %r8. */
+static const char *rotina_escreva_str[] = {
+    "rt_escreva_str:",
+    "movq %rdi, %r8",
+    "rt_escreva_str_laco:",
+    "movzbl (%r8), %edi",
+    "testl %edi, %edi",
+    "jz rt_escreva_str_fim",
+    "call rt_escreva_car",
+    "incq %r8",
+    "jmp rt_escreva_str_laco",
+    "rt_escreva_str_fim:",
+    "ret",
+    NULL
+};
+
+/* Os dígitos são montados de trás para frente na pilha; o módulo é
+ * calculado sem sinal (divl), o que também vale para INT_MIN. */
+static const char *rotina_escreva_int[] = {
+    "rt_escreva_int:",
+    "subq $24, %rsp",
+    "leaq 24(%rsp), %r8",
+    "movq %r8, %r10",
+    "movl %edi, %r9d",
+    "movl %edi, %eax",
+    "testl %eax, %eax",
+    "jns rt_escreva_int_digitos",
+    "negl %eax",
+    "rt_escreva_int_digitos:",
+    "movl $10, %ecx",
+    "rt_escreva_int_laco:",
+    "xorl %edx, %edx",
+    "divl %ecx",
+    "addl $48, %edx",
+    "decq %r8",
+    "movb %dl, (%r8)",
+    "testl %eax, %eax",
+    "jnz rt_escreva_int_laco",
+    "testl %r9d, %r9d",
+    "jns rt_escreva_int_copia",
+    "decq %r8",
+    "movb $45, (%r8)",
+    "rt_escreva_int_copia:",
+    "movzbl (%r8), %edi",
+    "call rt_escreva_car",
+    "incq %r8",
+    "cmpq %r10, %r8",
+    "jne rt_escreva_int_copia",
+    "addq $24, %rsp",
+    "ret",
+    NULL
+};
+
+/* rt_leia_car devolve em %eax o próximo caractere da entrada (-1 no fim);
+ * preserva %r8 e %r9. */
+static const char *rotina_leia_int[] = {
+    "rt_leia_car:",
+    "movl rt_posicao_entrada(%rip), %eax",
+    "cmpl rt_tamanho_entrada(%rip), %eax",
+    "jl rt_leia_car_proximo",
+    "xorl %eax, %eax",                  // read
+    "xorl %edi, %edi",
+    "leaq rt_buffer_entrada(%rip), %rsi",
+    "movl $4096, %edx",
+    "syscall",
+    "testq %rax, %rax",
+    "jle rt_leia_car_fim",
+    "movl %eax, rt_tamanho_entrada(%rip)",
+    "xorl %eax, %eax",
+    "rt_leia_car_proximo:",
+    "leaq rt_buffer_entrada(%rip), %rcx",
+    "movzbl (%rcx,%rax), %edx",
+    "incl %eax",
+    "movl %eax, rt_posicao_entrada(%rip)",
+    "movl %edx, %eax",
+    "ret",
+    "rt_leia_car_fim:",
+    "movl $-1, %eax",
+    "ret",
+    "rt_leia_int:",
+    "call rt_descarregar",
+    "rt_leia_int_espacos:",
+    "call rt_leia_car",
+    "testl %eax, %eax",
+    "js rt_leia_int_fim_entrada",
+    "cmpl $32, %eax",
+    "jle rt_leia_int_espacos",
+    "xorl %r9d, %r9d",
+    "cmpl $45, %eax",
+    "jne rt_leia_int_digitos",
+    "movl $1, %r9d",
+    "call rt_leia_car",
+    "rt_leia_int_digitos:",
+    "xorl %r8d, %r8d",
+    "rt_leia_int_laco:",
+    "subl $48, %eax",
+    "cmpl $9, %eax",
+    "ja rt_leia_int_fim",
+    "imull $10, %r8d, %r8d",
+    "addl %eax, %r8d",
+    "call rt_leia_car",
+    "jmp rt_leia_int_laco",
+    "rt_leia_int_fim:",
+    "movl %r8d, %eax",
+    "testl %r9d, %r9d",
+    "jz rt_leia_int_retorna",
+    "negl %eax",
+    "rt_leia_int_retorna:",
+    "ret",
+    "rt_leia_int_fim_entrada:",
+    "xorl %eax, %eax",
+    "ret",
+    NULL
+};
+
+/* A saída já escrita pelo programa é descarregada antes da mensagem. */
+static const char *rotina_erro_divisao[] = {
+    "rt_erro_divisao:",
+    "call rt_descarregar",
+    "movl $2, %edi",
+    "leaq rt_mensagem_divisao(%rip), %rsi",
+    "movl $35, %edx",
+    "movl $1, %eax",
+    "syscall",
+    "movl $1, %edi",
+    "movl $60, %eax",                   // exit
+    "syscall",
+    NULL
+};
+
+/**
+ * @brief Acrescenta as linhas de um trecho: labels terminam com ':' e
+ * diretivas começam com '.'.
+ */
+static void emitir_trecho_x86(ListaInstrucoes *destino, const char **linhas) {
+    char label[64];
+    for (int i = 0; linhas[i] != NULL; i++) {
+        size_t tamanho = strlen(linhas[i]);
+        if (linhas[i][tamanho - 1] == ':') {
+            snprintf(label, sizeof(label), "%.*s", (int)(tamanho - 1), linhas[i]);
+            adicionar_label(destino, label);
+        } else if (linhas[i][0] == '.') {
+            adicionar_diretiva(destino, linhas[i]);
+        } else {
+            adicionar_instrucao(destino, linhas[i]);
+        }
+    }
+}
+
+void emitir_runtime_x86(ListaInstrucoes *destino, const char *label_principal) {
+    char instrucao[128];
+    adicionar_comentario(destino, "--- Ponto de entrada ---");
+    adicionar_diretiva(destino, ".globl _start");
+    adicionar_label(destino, "_start");
+    adicionar_instrucao(destino, "xorl %ebp, %ebp");
+    snprintf(instrucao, sizeof(instrucao), "call %s", label_principal);
+    adicionar_instrucao(destino, instrucao);
+    adicionar_instrucao(destino, "call rt_descarregar");
+    adicionar_instrucao(destino, "xorl %edi, %edi");
+    adicionar_instrucao(destino, "movl $60, %eax");
+    adicionar_instrucao(destino, "syscall");
+
+    adicionar_comentario(destino, "--- Runtime de entrada e saida ---");
+    emitir_trecho_x86(destino, rotina_descarregar);
+    emitir_trecho_x86(destino, rotina_escreva_car);
+    emitir_trecho_x86(destino, rotina_escreva_str);
+    emitir_trecho_x86(destino, rotina_escreva_int);
+    emitir_trecho_x86(destino, rotina_leia_int);
+    emitir_trecho_x86(destino, rotina_erro_divisao);
+    emitir_trecho_x86(destino, dados);
+}
@@ -0,0 +1,30 @@
+#ifndef RUNTIME_X86_H
+#define RUNTIME_X86_H
+
+#include "modulo_instrucoes_mips.h"
+
+/*
+ * Runtime do backend x86-64 (Linux), emitido no fim do saida.s: ponto de
+ * entrada _start e rotinas de E/S com buffers de 4 KiB, feitas com syscalls
+ * read/write/exit diretos, sem libc. O arquivo é montado e ligado com
+ * "gcc -nostdlib -static saida.s -o programa" (ou as + ld).
+ *
+ * Convenção das rotinas: argumento em %edi, resultado em %eax; podem
+ * destruir %rax, %rcx, %rdx, %rsi, %rdi e %r8-%r11 (como uma chamada do
+ * System V). O código gerado não mantém valores nesses registradores
+ * durante uma chamada.
+ */
+
+#define ROTINA_X86_ESCREVA_INT "rt_escreva_int"     // %edi: inteiro
+#define ROTINA_X86_ESCREVA_CAR "rt_escreva_car"     // %edi: caractere
+#define ROTINA_X86_ESCREVA_STR "rt_escreva_str"     // %rdi: endereço da string (terminada em 0)
+#define ROTINA_X86_LEIA_INT "rt_leia_int"           // %eax: inteiro lido (0 no fim da entrada)
+#define ROTINA_X86_ERRO_DIVISAO "rt_erro_divisao"   // Relata a divisão por zero e encerra
+
+/**
+ * @brief Acrescenta a 'destino' o ponto de entrada, que chama 'label_principal'
+ * e encerra com código 0, os buffers e as rotinas.
+ */
+void emitir_runtime_x86(ListaInstrucoes *destino, const char *label_principal);
+
+#endif
@@ -0,0 +1,323 @@
+#include "modulo_servidor.h"
+#include "modulo_protocolo_servidor.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t encerrar = 0;
+
+static void pedir_encerramento(int sinal) {
+    (void)sinal;
+    encerrar = 1;
+}
+
+static char *ler_arquivo(const char *caminho, size_t *tamanho) {
+    *tamanho = 0;
+    FILE *arquivo = fopen(caminho, "rb");
+    if (arquivo == NULL) return NULL;
+    size_t capacidade = 4096, lidos;
+    char *dados = malloc(capacidade + 1);
+    while (dados != NULL && (lidos = fread(dados + *tamanho, 1, capacidade - *tamanho, arquivo)) > 0) {
+        *tamanho += lidos;
+        if (*tamanho == capacidade) {
+            char *novos = realloc(dados, (capacidade *= 2) + 1);
+            if (novos == NULL) free(dados);
+            dados = novos;
+        }
+    }
+    fclose(arquivo);
+    if (dados != NULL) dados[*tamanho] = '\0';
+    return dados;
+}
+
+static void limpar_diretorio_temporario(const char *diretorio) {
+    static const char *const arquivos[] = { "saida_padrao", "saida_erro", "saida.s", "saida.c" };
+    char caminho[4200];
+    for (size_t i = 0; i < sizeof(arquivos) / sizeof(arquivos[0]); i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, arquivos[i]);
+        unlink(caminho);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Um pedido
+// ---------------------------------------------------------------------------
+
+typedef struct Pedido {
+    char *diretorio_cliente;
+    int argc;
+    char **argv;
+    char *fonte;                // NULL se o cliente não enviou o fonte
+    size_t tamanho_fonte;
+} Pedido;
+
+static void liberar_pedido(Pedido *pedido) {
+    free(pedido->diretorio_cliente);
+    for (int i = 1; i < pedido->argc; i++) free(pedido->argv[i]);
+    free(pedido->argv);
+    free(pedido->fonte);
+}
+
+static int receber_pedido(int conexao, Pedido *pedido) {
+    memset(pedido, 0, sizeof(*pedido));
+    char *versao = receber_campo(conexao, NULL);
+    int ok = versao != NULL && strcmp(versao, VERSAO_PROTOCOLO_SERVIDOR) == 0;
+    free(versao);
+    if (!ok || (pedido->diretorio_cliente = receber_campo(conexao, NULL)) == NULL) return 0;
+
+    char *contagem = receber_campo(conexao, NULL);
+    int num_argumentos = contagem != NULL ? atoi(contagem) : -1;
+    free(contagem);
+    if (num_argumentos < 0 || num_argumentos > 4096) return 0;
+    pedido->argv = calloc((size_t)num_argumentos + 2, sizeof(char *));
+    if (pedido->argv == NULL) return 0;
+    pedido->argv[0] = "goianinha";
+    pedido->argc = 1;
+    for (int i = 0; i < num_argumentos; i++) {
+        if ((pedido->argv[pedido->argc] = receber_campo(conexao, NULL)) == NULL) return 0;
+        pedido->argc++;
+    }
+
+    char *com_fonte = receber_campo(conexao, NULL);
+    ok = com_fonte != NULL;
+    if (ok) pedido->fonte = receber_campo(conexao, &pedido->tamanho_fonte);
+    ok = ok && pedido->fonte != NULL;
+    if (ok && strcmp(com_fonte, "1") != 0) {
+        free(pedido->fonte);
+        pedido->fonte = NULL;
+    }
+    free(com_fonte);
+    return ok;
+}
+
+/**
+ * @brief Processo da compilação: entra no diretório do cliente, desvia a
+ * saída padrão e a de erro para o diretório temporário e compila.
+ */
+static void compilar_pedido(const Pedido *pedido, const char *temporario, FuncaoCompilacao compilar) {
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGPIPE, SIG_DFL);
+    char caminho[4200];
+    snprintf(caminho, sizeof(caminho), "%s/saida_padrao", temporario);
+    int saida = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    snprintf(caminho, sizeof(caminho), "%s/saida_erro", temporario);
+    int erro = open(caminho, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    int entrada = open("/dev/null", O_RDONLY);
+    if (saida < 0 || erro < 0 || entrada < 0 || dup2(saida, STDOUT_FILENO) < 0
+        || dup2(erro, STDERR_FILENO) < 0 || dup2(entrada, STDIN_FILENO) < 0) {
+        _exit(EXIT_FAILURE);
+    }
+    close(saida);
+    close(erro);
+    close(entrada);
+    if (chdir(pedido->diretorio_cliente) != 0) {
+        fprintf(stderr, "Erro: o servidor nao pode entrar no diretorio '%s'.\n", pedido->diretorio_cliente);
+        exit(EXIT_FAILURE);
+    }
+
+    RequisicaoCompilacao requisicao;
+    requisicao.argc = pedido->argc;
+    requisicao.argv = pedido->argv;
+    requisicao.fonte = pedido->fonte;
+    requisicao.tamanho_fonte = pedido->tamanho_fonte;
+    requisicao.diretorio_saida = temporario;
+    exit(compilar(&requisicao));
+}
+
+/**
+ * @brief Atende uma conexão: recebe o pedido, compila num processo filho e
+ * devolve as mensagens e o arquivo gerado. 'temporario' é o diretório do
+ * trabalhador, esvaziado depois de cada pedido.
+ */
+static void atender(int conexao, const char *temporario, FuncaoCompilacao compilar) {
+    Pedido pedido;
+    if (!receber_pedido(conexao, &pedido)) {
+        liberar_pedido(&pedido);
+        return;
+    }
+
+    int status = EXIT_FAILURE, estado, esperado;
+    char mensagem_erro[160] = "";
+    pid_t filho = fork();
+    if (filho == 0) compilar_pedido(&pedido, temporario, compilar);
+    while (filho > 0 && (esperado = waitpid(filho, &estado, 0)) < 0 && errno == EINTR) {}
+    if (filho < 0 || esperado < 0) {
+        snprintf(mensagem_erro, sizeof(mensagem_erro), "Erro: o servidor nao pode iniciar a compilacao.\n");
+    } else if (WIFEXITED(estado)) {
+        status = WEXITSTATUS(estado);
+    } else {
+        status = 128 + WTERMSIG(estado);
+        snprintf(mensagem_erro, sizeof(mensagem_erro), "Erro: a compilacao terminou com o sinal %d.\n",
+                 WTERMSIG(estado));
+    }
+
+    char caminho[4200], texto_status[16];
+    size_t tamanho_saida = 0, tamanho_erro = 0, tamanho_gerado = 0;
+    snprintf(caminho, sizeof(caminho), "%s/saida_padrao", temporario);
+    char *saida = ler_arquivo(caminho, &tamanho_saida);
+    snprintf(caminho, sizeof(caminho), "%s/saida_erro", temporario);
+    char *erro = ler_arquivo(caminho, &tamanho_erro);
+    const char *nome_gerado = "";
+    char *gerado = NULL;
+    for (int i = 0; i < 2 && gerado == NULL; i++) {
+        nome_gerado = i == 0 ? "saida.s" : "saida.c";
+        snprintf(caminho, sizeof(caminho), "%s/%s", temporario, nome_gerado);
+        gerado = ler_arquivo(caminho, &tamanho_gerado);
+    }
+    if (gerado == NULL) nome_gerado = "";
+    if (mensagem_erro[0] != '\0') {
+        char *com_mensagem = realloc(erro, tamanho_erro + strlen(mensagem_erro) + 1);
+        if (com_mensagem != NULL) {
+            memcpy(com_mensagem + tamanho_erro, mensagem_erro, strlen(mensagem_erro) + 1);
+            tamanho_erro += strlen(mensagem_erro);
+            erro = com_mensagem;
+        }
+    }
+
+    snprintf(texto_status, sizeof(texto_status), "%d", status);
+    // Um cliente que desistiu (conexão fechada) só faz o envio falhar.
+    (void)(enviar_texto(conexao, VERSAO_PROTOCOLO_SERVIDOR) && enviar_texto(conexao, texto_status)
+           && enviar_campo(conexao, saida != NULL ? saida : "", tamanho_saida)
+           && enviar_campo(conexao, erro != NULL ? erro : "", tamanho_erro)
+           && enviar_texto(conexao, nome_gerado)
+           && enviar_campo(conexao, gerado != NULL ? gerado : "", tamanho_gerado));
+
+    free(saida);
+    free(erro);
+    free(gerado);
+    limpar_diretorio_temporario(temporario);
+    liberar_pedido(&pedido);
+}
+
+/**
+ * @brief Laço de um trabalhador. O diretório temporário é criado uma vez e
+ * removido quando o processo principal pede o encerramento.
+ */
+static void executar_trabalhador(int servidor, FuncaoCompilacao compilar) {
+    signal(SIGPIPE, SIG_IGN);
+    const char *base = getenv("TMPDIR");
+    char temporario[4096];
+    snprintf(temporario, sizeof(temporario), "%s/goianinha-servidor-XXXXXX",
+             base != NULL && *base != '\0' ? base : "/tmp");
+    if (mkdtemp(temporario) == NULL) {
+        perror("Erro ao criar o diretorio temporario do trabalhador");
+        _exit(EXIT_FAILURE);
+    }
+    while (!encerrar) {
+        int conexao = accept(servidor, NULL, NULL);
+        if (conexao < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            perror("Erro ao aceitar conexao");
+            break;
+        }
+        atender(conexao, temporario, compilar);
+        close(conexao);
+    }
+    limpar_diretorio_temporario(temporario);
+    rmdir(temporario);
+    _exit(encerrar ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// ---------------------------------------------------------------------------
+// Processo principal
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Cria o socket. Um socket que sobrou de um servidor encerrado é
+ * removido; um servidor ativo no mesmo caminho é um erro.
+ */
+static int abrir_socket(const char *caminho) {
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "Caminho de socket longo demais: %s\n", caminho);
+        return -1;
+    }
+    strcpy(endereco.sun_path, caminho);
+
+    int servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (servidor < 0) {
+        perror("Erro ao criar o socket");
+        return -1;
+    }
+    if (connect(servidor, (struct sockaddr *)&endereco, sizeof(endereco)) == 0) {
+        fprintf(stderr, "Ja existe um servidor de compilacao em %s.\n", caminho);
+        close(servidor);
+        return -1;
+    }
+    close(servidor);
+    unlink(caminho);
+
+    servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    // Só o dono do servidor conecta: o fonte e a saída são dele.
+    mode_t mascara = umask(077);
+    int ok = servidor >= 0 && bind(servidor, (struct sockaddr *)&endereco, sizeof(endereco)) == 0;
+    umask(mascara);
+    if (!ok || listen(servidor, 128) != 0) {
+        perror("Erro ao escutar no socket");
+        if (servidor >= 0) close(servidor);
+        return -1;
+    }
+    return servidor;
+}
+
+static pid_t iniciar_trabalhador(int servidor, FuncaoCompilacao compilar) {
+    pid_t trabalhador = fork();
+    if (trabalhador == 0) executar_trabalhador(servidor, compilar);
+    if (trabalhador < 0) perror("Erro ao iniciar trabalhador");
+    return trabalhador;
+}
+
+int executar_servidor(const char *caminho_socket, int num_trabalhadores, FuncaoCompilacao compilar) {
+    int servidor = abrir_socket(caminho_socket);
+    if (servidor < 0) return EXIT_FAILURE;
+
+    struct sigaction acao;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = pedir_encerramento;
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, NULL);
+    sigaction(SIGTERM, &acao, NULL);
+
+    printf("Servidor de compilacao em %s com %d trabalhador(es).\n", caminho_socket, num_trabalhadores);
+    fflush(stdout);
+    pid_t *trabalhadores = calloc((size_t)num_trabalhadores, sizeof(pid_t));
+    if (trabalhadores == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para o servidor.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < num_trabalhadores; i++) trabalhadores[i] = iniciar_trabalhador(servidor, compilar);
+
+    // Um trabalhador que morre (por exemplo, sem memória) é substituído.
+    while (!encerrar) {
+        int estado;
+        pid_t terminado = wait(&estado);
+        if (terminado < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (int i = 0; i < num_trabalhadores && !encerrar; i++) {
+            if (trabalhadores[i] == terminado) trabalhadores[i] = iniciar_trabalhador(servidor, compilar);
+        }
+    }
+
+    for (int i = 0; i < num_trabalhadores; i++) {
+        if (trabalhadores[i] > 0) kill(trabalhadores[i], SIGTERM);
+    }
+    while (wait(NULL) > 0 || errno == EINTR) {}
+    close(servidor);
+    unlink(caminho_socket);
+    free(trabalhadores);
+    printf("Servidor de compilacao encerrado.\n");
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <stddef.h>
+
+/*
+ * Servidor de compilação (goianinha --server[=SOCKET]).
+ *
+ * Um processo inicializado uma vez escuta num socket Unix e mantém um
+ * conjunto de trabalhadores (--workers=N), que atendem os pedidos em
+ * paralelo (protocolo em modulo_protocolo_servidor.h). Cada pedido é
+ * compilado num fork do trabalhador: as fases do compilador guardam estado
+ * em variáveis globais e encerram o processo nos erros fatais, e a cópia
+ * isola os pedidos sem o custo de carregar o executável de novo. O processo
+ * da compilação entra no diretório do cliente (os caminhos das opções valem
+ * como na linha de comando), lê o fonte recebido da memória e escreve a
+ * saída padrão, a de erro e o código gerado num diretório temporário,
+ * devolvidos ao cliente.
+ */
+
+/**
+ * @brief Um pedido de compilação, como a linha de comando de goianinha.
+ */
+typedef struct RequisicaoCompilacao {
+    int argc;
+    char **argv;
+    const char *fonte;              // Bytes do fonte recebidos (NULL = ler o arquivo)
+    size_t tamanho_fonte;
+    const char *diretorio_saida;    // Onde gravar saida.s/saida.c (NULL = diretório atual)
+} RequisicaoCompilacao;
+
+/**
+ * @brief Executa uma compilação; devolve o status de término.
+ */
+typedef int (*FuncaoCompilacao)(const RequisicaoCompilacao *requisicao);
+
+/**
+ * @brief Escuta em 'caminho_socket' e atende os pedidos até receber SIGINT
+ * ou SIGTERM.
+ * @return O status de término do servidor.
+ */
+int executar_servidor(const char *caminho_socket, int num_trabalhadores, FuncaoCompilacao compilar);
+
+#endif
@@ -0,0 +1,100 @@
+#include "modulo_sha256.h"
+#include <stdio.h>
+#include <string.h>
+
+static const uint32_t constantes_sha[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTACAO(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void processar_bloco_sha(Sha256 *sha, const unsigned char *bloco) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)bloco[4 * i] << 24 | (uint32_t)bloco[4 * i + 1] << 16
+             | (uint32_t)bloco[4 * i + 2] << 8 | (uint32_t)bloco[4 * i + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        uint32_t s0 = ROTACAO(w[i - 15], 7) ^ ROTACAO(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = ROTACAO(w[i - 2], 17) ^ ROTACAO(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = sha->estado[0], b = sha->estado[1], c = sha->estado[2], d = sha->estado[3];
+    uint32_t e = sha->estado[4], f = sha->estado[5], g = sha->estado[6], h = sha->estado[7];
+    for (int i = 0; i < 64; i++) {
+        uint32_t t1 = h + (ROTACAO(e, 6) ^ ROTACAO(e, 11) ^ ROTACAO(e, 25)) + ((e & f) ^ (~e & g))
+                    + constantes_sha[i] + w[i];
+        uint32_t t2 = (ROTACAO(a, 2) ^ ROTACAO(a, 13) ^ ROTACAO(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    sha->estado[0] += a; sha->estado[1] += b; sha->estado[2] += c; sha->estado[3] += d;
+    sha->estado[4] += e; sha->estado[5] += f; sha->estado[6] += g; sha->estado[7] += h;
+}
+
+void iniciar_sha(Sha256 *sha) {
+    static const uint32_t iniciais[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memcpy(sha->estado, iniciais, sizeof(iniciais));
+    sha->bytes = 0;
+    sha->usados = 0;
+}
+
+void atualizar_sha(Sha256 *sha, const void *dados, size_t tamanho) {
+    const unsigned char *p = dados;
+    sha->bytes += tamanho;
+    while (tamanho > 0) {
+        size_t n = 64 - sha->usados < tamanho ? 64 - sha->usados : tamanho;
+        memcpy(sha->bloco + sha->usados, p, n);
+        sha->usados += n;
+        p += n;
+        tamanho -= n;
+        if (sha->usados == 64) {
+            processar_bloco_sha(sha, sha->bloco);
+            sha->usados = 0;
+        }
+    }
+}
+
+void finalizar_sha(Sha256 *sha, char hexadecimal[65]) {
+    uint64_t bits = sha->bytes * 8;
+    unsigned char marcador = 0x80, zero = 0, tamanho[8];
+    atualizar_sha(sha, &marcador, 1);
+    while (sha->usados != 56) atualizar_sha(sha, &zero, 1);
+    for (int i = 0; i < 8; i++) tamanho[i] = (unsigned char)(bits >> (56 - 8 * i));
+    atualizar_sha(sha, tamanho, 8);
+    for (int i = 0; i < 8; i++) snprintf(hexadecimal + 8 * i, 9, "%08x", sha->estado[i]);
+}
+
+void atualizar_campo_sha(Sha256 *sha, const void *dados, size_t tamanho) {
+    char prefixo[32];
+    int n = snprintf(prefixo, sizeof(prefixo), "%zu:", tamanho);
+    atualizar_sha(sha, prefixo, (size_t)n);
+    atualizar_sha(sha, dados, tamanho);
+}
+
+const char *resumo_executavel(void) {
+    static int calculado = 0;
+    static char resumo[65] = "";
+    if (calculado) return resumo;
+    calculado = 1;
+    FILE *arquivo = fopen("/proc/self/exe", "rb");
+    if (arquivo == NULL) return resumo;
+    Sha256 sha;
+    unsigned char bloco[65536];
+    size_t lidos;
+    iniciar_sha(&sha);
+    while ((lidos = fread(bloco, 1, sizeof(bloco), arquivo)) > 0) atualizar_sha(&sha, bloco, lidos);
+    int erro = ferror(arquivo);
+    fclose(arquivo);
+    if (!erro) finalizar_sha(&sha, resumo);
+    return resumo;
+}
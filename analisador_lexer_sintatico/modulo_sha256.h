@@ -0,0 +1,40 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * SHA-256 (FIPS 180-4), usado nas chaves do cache de compilação e nas
+ * impressões digitais da compilação incremental.
+ */
+
+typedef struct Sha256 {
+    uint32_t estado[8];
+    uint64_t bytes;
+    unsigned char bloco[64];
+    size_t usados;
+} Sha256;
+
+void iniciar_sha(Sha256 *sha);
+
+void atualizar_sha(Sha256 *sha, const void *dados, size_t tamanho);
+
+/**
+ * @brief Acrescenta um campo, precedido do tamanho (campos não se confundem).
+ */
+void atualizar_campo_sha(Sha256 *sha, const void *dados, size_t tamanho);
+
+/**
+ * @brief Termina o cálculo e escreve o resumo em hexadecimal (64 dígitos e '\0').
+ */
+void finalizar_sha(Sha256 *sha, char hexadecimal[65]);
+
+/**
+ * @brief Resumo do próprio executável (/proc/self/exe), calculado uma vez por
+ * processo; "" se não puder ser lido. O servidor de compilação o calcula
+ * antes de criar os trabalhadores, que o herdam.
+ */
+const char *resumo_executavel(void);
+
+#endif
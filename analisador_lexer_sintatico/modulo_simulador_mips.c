@@ -0,0 +1,1148 @@
+#include "modulo_simulador_mips.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <limits.h>
+
+#define BASE_TEXTO        0x00400000u
+#define BASE_DADOS_GP     0x10000000u  // Área de dados pequenos (.extern), acessível via $gp
+#define BASE_DADOS        0x10010000u
+#define VALOR_INICIAL_GP  0x10008000u
+#define TAM_DADOS         (64u * 1024u * 1024u)
+#define TOPO_PILHA        0x7ffffffcu
+#define SP_INICIAL        0x7fffeffcu
+#define TAM_PILHA         (32u * 1024u * 1024u)
+#define RA_SENTINELA      0u
+
+#define TAM_LINHA 4096
+
+typedef enum {
+    /* rd, rs, rt (ou imediato) */
+    OP_ADD, OP_ADDU, OP_SUB, OP_SUBU, OP_AND, OP_OR, OP_XOR, OP_NOR,
+    OP_SLT, OP_SLTU, OP_SLLV, OP_SRLV, OP_SRAV, OP_MUL,
+    OP_SEQ, OP_SNE, OP_SGT, OP_SGE, OP_SLE, OP_SGTU, OP_SGEU, OP_SLEU,
+    OP_REM, OP_REMU, OP_DIV3, OP_DIVU3,
+    /* rd, rs, imediato */
+    OP_ADDI, OP_ADDIU, OP_SLTI, OP_SLTIU, OP_ANDI, OP_ORI, OP_XORI, OP_SLL, OP_SRL, OP_SRA,
+    /* rd, imediato / rd, rs */
+    OP_LUI, OP_LI, OP_MOVE, OP_NEG, OP_NOT, OP_ABS,
+    /* hi/lo */
+    OP_MULT, OP_MULTU, OP_DIV, OP_DIVU, OP_MFLO, OP_MFHI, OP_MTLO, OP_MTHI,
+    /* memória */
+    OP_LW, OP_LH, OP_LHU, OP_LB, OP_LBU, OP_SW, OP_SH, OP_SB,
+    /* desvios */
+    OP_BEQ, OP_BNE, OP_BLT, OP_BGT, OP_BLE, OP_BGE, OP_BLTU, OP_BGTU, OP_BLEU, OP_BGEU,
+    OP_BEQZ, OP_BNEZ, OP_BLTZ, OP_BGTZ, OP_BLEZ, OP_BGEZ,
+    /* saltos */
+    OP_B, OP_J, OP_JAL, OP_JR, OP_JALR,
+    OP_SYSCALL, OP_NOP,
+    NUM_OPS
+} CodigoOperacao;
+
+typedef enum {
+    F_RRR,      // rd, rs, rt|imm
+    F_RRI,      // rd, rs, imm
+    F_RI,       // rd, imm
+    F_LA,       // rd, endereço
+    F_RR,       // rd, rs
+    F_R_DEST,   // rd (mflo/mfhi)
+    F_R_FONTE,  // rs (mtlo/mthi/jr/jalr)
+    F_HILO,     // rs, rt
+    F_MEM,      // rt, endereço
+    F_DESVIO_2, // rs, rt|imm, label
+    F_DESVIO_1, // rs, label
+    F_SALTO,    // label
+    F_NENHUM
+} FormatoOperandos;
+
+static const struct {
+    const char *nome;
+    CodigoOperacao op;
+    FormatoOperandos formato;
+    ClasseInstrucao classe;
+    int custo;  // Instruções reais na expansão (aproximação do SPIM/MARS)
+} tabela_ops[] = {
+    {"add", OP_ADD, F_RRR, CLASSE_ALU, 1}, {"addu", OP_ADDU, F_RRR, CLASSE_ALU, 1},
+    {"sub", OP_SUB, F_RRR, CLASSE_ALU, 1}, {"subu", OP_SUBU, F_RRR, CLASSE_ALU, 1},
+    {"and", OP_AND, F_RRR, CLASSE_ALU, 1}, {"or", OP_OR, F_RRR, CLASSE_ALU, 1},
+    {"xor", OP_XOR, F_RRR, CLASSE_ALU, 1}, {"nor", OP_NOR, F_RRR, CLASSE_ALU, 1},
+    {"slt", OP_SLT, F_RRR, CLASSE_ALU, 1}, {"sltu", OP_SLTU, F_RRR, CLASSE_ALU, 1},
+    {"sllv", OP_SLLV, F_RRR, CLASSE_ALU, 1}, {"srlv", OP_SRLV, F_RRR, CLASSE_ALU, 1},
+    {"srav", OP_SRAV, F_RRR, CLASSE_ALU, 1}, {"mul", OP_MUL, F_RRR, CLASSE_MULT_DIV, 1},
+    {"seq", OP_SEQ, F_RRR, CLASSE_ALU, 3}, {"sne", OP_SNE, F_RRR, CLASSE_ALU, 2},
+    {"sgt", OP_SGT, F_RRR, CLASSE_ALU, 1}, {"sge", OP_SGE, F_RRR, CLASSE_ALU, 3},
+    {"sle", OP_SLE, F_RRR, CLASSE_ALU, 3}, {"sgtu", OP_SGTU, F_RRR, CLASSE_ALU, 1},
+    {"sgeu", OP_SGEU, F_RRR, CLASSE_ALU, 3}, {"sleu", OP_SLEU, F_RRR, CLASSE_ALU, 3},
+    {"rem", OP_REM, F_RRR, CLASSE_MULT_DIV, 4}, {"remu", OP_REMU, F_RRR, CLASSE_MULT_DIV, 4},
+    {"addi", OP_ADDI, F_RRI, CLASSE_ALU, 1}, {"addiu", OP_ADDIU, F_RRI, CLASSE_ALU, 1},
+    {"slti", OP_SLTI, F_RRI, CLASSE_ALU, 1}, {"sltiu", OP_SLTIU, F_RRI, CLASSE_ALU, 1},
+    {"andi", OP_ANDI, F_RRI, CLASSE_ALU, 1}, {"ori", OP_ORI, F_RRI, CLASSE_ALU, 1},
+    {"xori", OP_XORI, F_RRI, CLASSE_ALU, 1}, {"sll", OP_SLL, F_RRI, CLASSE_ALU, 1},
+    {"srl", OP_SRL, F_RRI, CLASSE_ALU, 1}, {"sra", OP_SRA, F_RRI, CLASSE_ALU, 1},
+    {"lui", OP_LUI, F_RI, CLASSE_ALU, 1}, {"li", OP_LI, F_RI, CLASSE_ALU, 1},
+    {"la", OP_LI, F_LA, CLASSE_ALU, 2},
+    {"move", OP_MOVE, F_RR, CLASSE_ALU, 1}, {"neg", OP_NEG, F_RR, CLASSE_ALU, 1},
+    {"negu", OP_NEG, F_RR, CLASSE_ALU, 1}, {"not", OP_NOT, F_RR, CLASSE_ALU, 1},
+    {"abs", OP_ABS, F_RR, CLASSE_ALU, 3},
+    {"mult", OP_MULT, F_HILO, CLASSE_MULT_DIV, 1}, {"multu", OP_MULTU, F_HILO, CLASSE_MULT_DIV, 1},
+    {"div", OP_DIV, F_HILO, CLASSE_MULT_DIV, 1}, {"divu", OP_DIVU, F_HILO, CLASSE_MULT_DIV, 1},
+    {"mflo", OP_MFLO, F_R_DEST, CLASSE_MULT_DIV, 1}, {"mfhi", OP_MFHI, F_R_DEST, CLASSE_MULT_DIV, 1},
+    {"mtlo", OP_MTLO, F_R_FONTE, CLASSE_MULT_DIV, 1}, {"mthi", OP_MTHI, F_R_FONTE, CLASSE_MULT_DIV, 1},
+    {"lw", OP_LW, F_MEM, CLASSE_LOAD, 1}, {"lh", OP_LH, F_MEM, CLASSE_LOAD, 1},
+    {"lhu", OP_LHU, F_MEM, CLASSE_LOAD, 1}, {"lb", OP_LB, F_MEM, CLASSE_LOAD, 1},
+    {"lbu", OP_LBU, F_MEM, CLASSE_LOAD, 1},
+    {"sw", OP_SW, F_MEM, CLASSE_STORE, 1}, {"sh", OP_SH, F_MEM, CLASSE_STORE, 1},
+    {"sb", OP_SB, F_MEM, CLASSE_STORE, 1},
+    {"beq", OP_BEQ, F_DESVIO_2, CLASSE_DESVIO, 1}, {"bne", OP_BNE, F_DESVIO_2, CLASSE_DESVIO, 1},
+    {"blt", OP_BLT, F_DESVIO_2, CLASSE_DESVIO, 2}, {"bgt", OP_BGT, F_DESVIO_2, CLASSE_DESVIO, 2},
+    {"ble", OP_BLE, F_DESVIO_2, CLASSE_DESVIO, 2}, {"bge", OP_BGE, F_DESVIO_2, CLASSE_DESVIO, 2},
+    {"bltu", OP_BLTU, F_DESVIO_2, CLASSE_DESVIO, 2}, {"bgtu", OP_BGTU, F_DESVIO_2, CLASSE_DESVIO, 2},
+    {"bleu", OP_BLEU, F_DESVIO_2, CLASSE_DESVIO, 2}, {"bgeu", OP_BGEU, F_DESVIO_2, CLASSE_DESVIO, 2},
+    {"beqz", OP_BEQZ, F_DESVIO_1, CLASSE_DESVIO, 1}, {"bnez", OP_BNEZ, F_DESVIO_1, CLASSE_DESVIO, 1},
+    {"bltz", OP_BLTZ, F_DESVIO_1, CLASSE_DESVIO, 1}, {"bgtz", OP_BGTZ, F_DESVIO_1, CLASSE_DESVIO, 1},
+    {"blez", OP_BLEZ, F_DESVIO_1, CLASSE_DESVIO, 1}, {"bgez", OP_BGEZ, F_DESVIO_1, CLASSE_DESVIO, 1},
+    {"b", OP_B, F_SALTO, CLASSE_SALTO, 1}, {"j", OP_J, F_SALTO, CLASSE_SALTO, 1},
+    {"jal", OP_JAL, F_SALTO, CLASSE_CHAMADA, 1}, {"jr", OP_JR, F_R_FONTE, CLASSE_SALTO, 1},
+    {"jalr", OP_JALR, F_R_FONTE, CLASSE_CHAMADA, 1},
+    {"syscall", OP_SYSCALL, F_NENHUM, CLASSE_SYSCALL, 1}, {"nop", OP_NOP, F_NENHUM, CLASSE_ALU, 1},
+    {NULL, OP_NOP, F_NENHUM, CLASSE_ALU, 0}
+};
+
+static const char *nomes_classes[NUM_CLASSES_INSTRUCAO] = {
+    "aritmetica/logica", "multiplicacao/divisao", "load", "store",
+    "desvio condicional", "salto", "chamada (jal)", "syscall"
+};
+
+static const char *nomes_registradores[32] = {
+    "zero", "at", "v0", "v1", "a0", "a1", "a2", "a3",
+    "t0", "t1", "t2", "t3", "t4", "t5", "t6", "t7",
+    "s0", "s1", "s2", "s3", "s4", "s5", "s6", "s7",
+    "t8", "t9", "k0", "k1", "gp", "sp", "fp", "ra"
+};
+
+/**
+ * @brief Instrução já decodificada (operandos resolvidos para números).
+ */
+typedef struct InstrucaoSimulada {
+    unsigned char op;
+    unsigned char rd, rs, rt;
+    unsigned char usa_imediato;   // O último operando-fonte é 'imm' e não 'rt'
+    unsigned char classe;
+    unsigned char custo;
+    int32_t imm;
+    int alvo;                     // Índice da instrução de destino (desvios e saltos)
+    int linha;
+} InstrucaoSimulada;
+
+typedef struct Simbolo {
+    char *nome;
+    uint32_t endereco;
+    int e_texto;
+    struct Simbolo *proximo;
+} Simbolo;
+
+/* Instrução ainda não decodificada (primeira passada da montagem). */
+typedef struct InstrucaoPendente {
+    char *opcode;
+    char *operandos;
+    int linha;
+} InstrucaoPendente;
+
+#define TAM_TABELA_SIMBOLOS 4096
+
+struct ProgramaMIPS {
+    char *nome;
+    InstrucaoSimulada *instrucoes;
+    int num_instrucoes;
+    Simbolo *simbolos[TAM_TABELA_SIMBOLOS];
+    char **label_da_instrucao;    // Primeiro label de cada instrução de texto (ou NULL)
+    long long *chamadas;          // Chamadas (jal) recebidas por instrução
+    unsigned char *dados;         // [BASE_DADOS_GP, BASE_DADOS_GP + TAM_DADOS)
+    uint32_t fim_dados;
+    uint32_t fim_dados_gp;
+    unsigned char *pilha;         // (TOPO_PILHA + 4 - TAM_PILHA, TOPO_PILHA + 4]
+    int indice_main;
+};
+
+/* ---------- Tabela de símbolos ---------- */
+
+static unsigned hash_nome(const char *nome) {
+    unsigned h = 5381;
+    while (*nome) h = h * 33 + (unsigned char)*nome++;
+    return h % TAM_TABELA_SIMBOLOS;
+}
+
+static Simbolo *buscar_simbolo(const ProgramaMIPS *p, const char *nome) {
+    for (Simbolo *s = p->simbolos[hash_nome(nome)]; s != NULL; s = s->proximo) {
+        if (strcmp(s->nome, nome) == 0) return s;
+    }
+    return NULL;
+}
+
+static int definir_simbolo(ProgramaMIPS *p, const char *nome, uint32_t endereco, int e_texto) {
+    if (buscar_simbolo(p, nome) != NULL) return 0;
+    Simbolo *s = malloc(sizeof(Simbolo));
+    s->nome = strdup(nome);
+    s->endereco = endereco;
+    s->e_texto = e_texto;
+    unsigned h = hash_nome(nome);
+    s->proximo = p->simbolos[h];
+    p->simbolos[h] = s;
+    return 1;
+}
+
+/* ---------- Funções auxiliares de montagem ---------- */
+
+static int erros_montagem = 0;
+static const char *nome_arquivo_atual = "";
+
+static void erro_montagem(int linha, const char *mensagem, const char *detalhe) {
+    fprintf(stderr, "%s:%d: erro de montagem: %s%s%s\n", nome_arquivo_atual, linha, mensagem,
+            detalhe ? ": " : "", detalhe ? detalhe : "");
+    erros_montagem++;
+}
+
+static char *aparar(char *texto) {
+    while (isspace((unsigned char)*texto)) texto++;
+    char *fim = texto + strlen(texto);
+    while (fim > texto && isspace((unsigned char)*(fim - 1))) *--fim = '\0';
+    return texto;
+}
+
+/**
+ * @brief Remove o comentário '#' (fora de aspas) de uma linha.
+ */
+static void remover_comentario(char *linha) {
+    int em_aspas = 0, em_apostrofo = 0;
+    for (char *c = linha; *c; c++) {
+        if (*c == '\\' && (em_aspas || em_apostrofo) && c[1]) { c++; continue; }
+        if (*c == '"' && !em_apostrofo) em_aspas = !em_aspas;
+        else if (*c == '\'' && !em_aspas) em_apostrofo = !em_apostrofo;
+        else if (*c == '#' && !em_aspas && !em_apostrofo) { *c = '\0'; return; }
+    }
+}
+
+/**
+ * @brief Divide os operandos por vírgulas (fora de parênteses e aspas).
+ * @return O número de operandos.
+ */
+static int dividir_operandos(char *texto, char **operandos, int max) {
+    int n = 0, nivel = 0, em_aspas = 0;
+    char *inicio = texto;
+    if (*aparar(texto) == '\0') return 0;
+    for (char *c = texto; ; c++) {
+        if (*c == '"') em_aspas = !em_aspas;
+        if (!em_aspas && *c == '(') nivel++;
+        if (!em_aspas && *c == ')') nivel--;
+        if (*c == '\0' || (*c == ',' && nivel == 0 && !em_aspas)) {
+            int fim = (*c == '\0');
+            *c = '\0';
+            if (n < max) operandos[n] = aparar(inicio);
+            n++;
+            if (fim) break;
+            inicio = c + 1;
+        }
+    }
+    return n;
+}
+
+static int ler_registrador(const char *texto) {
+    if (texto[0] != '$') return -1;
+    texto++;
+    if (isdigit((unsigned char)texto[0])) {
+        char *fim;
+        long n = strtol(texto, &fim, 10);
+        return (*fim == '\0' && n >= 0 && n < 32) ? (int)n : -1;
+    }
+    if (strcmp(texto, "s8") == 0) return 30;
+    for (int r = 0; r < 32; r++) {
+        if (strcmp(texto, nomes_registradores[r]) == 0) return r;
+    }
+    return -1;
+}
+
+static int ler_numero(const char *texto, int32_t *valor) {
+    if (texto[0] == '\'' ) {
+        if (texto[1] == '\\' && texto[3] == '\'') {
+            switch (texto[2]) {
+                case 'n': *valor = '\n'; return 1;
+                case 't': *valor = '\t'; return 1;
+                case '0': *valor = 0; return 1;
+                default:  *valor = (unsigned char)texto[2]; return 1;
+            }
+        }
+        if (texto[1] != '\0' && texto[2] == '\'') { *valor = (unsigned char)texto[1]; return 1; }
+        return 0;
+    }
+    char *fim;
+    long long n = strtoll(texto, &fim, 0);
+    if (fim == texto || *aparar(fim) != '\0') return 0;
+    if (n < INT32_MIN || n > UINT32_MAX) return 0;
+    *valor = (int32_t)(uint32_t)n;
+    return 1;
+}
+
+/**
+ * @brief Avalia "numero", "label", "label+n" ou "label-n".
+ */
+static int avaliar_expressao(const ProgramaMIPS *p, const char *texto, int32_t *valor) {
+    if (ler_numero(texto, valor)) return 1;
+    char nome[512];
+    const char *c = texto;
+    int n = 0;
+    while (*c && (isalnum((unsigned char)*c) || *c == '_' || *c == '.' || *c == '$') && n < 511) nome[n++] = *c++;
+    nome[n] = '\0';
+    if (n == 0) return 0;
+    Simbolo *s = buscar_simbolo(p, nome);
+    if (s == NULL) return 0;
+    int32_t deslocamento = 0;
+    while (isspace((unsigned char)*c)) c++;
+    if (*c == '+' || *c == '-') {
+        int negativo = (*c == '-');
+        c++;
+        while (isspace((unsigned char)*c)) c++;
+        if (!ler_numero(c, &deslocamento)) return 0;
+        if (negativo) deslocamento = -deslocamento;
+    } else if (*c != '\0') {
+        return 0;
+    }
+    *valor = (int32_t)(s->endereco + (uint32_t)deslocamento);
+    return 1;
+}
+
+/* ---------- Segmento de dados ---------- */
+
+static int reservar_dados(uint32_t *cursor, uint32_t tamanho, int linha) {
+    if (*cursor + tamanho > BASE_DADOS_GP + TAM_DADOS || *cursor + tamanho < *cursor) {
+        erro_montagem(linha, "segmento de dados excedido", NULL);
+        return 0;
+    }
+    *cursor += tamanho;
+    return 1;
+}
+
+static void alinhar(uint32_t *cursor, uint32_t alinhamento) {
+    *cursor = (*cursor + alinhamento - 1) & ~(alinhamento - 1);
+}
+
+/**
+ * @brief Decodifica o conteúdo de uma string entre aspas (com escapes).
+ * @return O número de bytes escritos em 'destino' (sem o terminador).
+ */
+static int decodificar_string(const char *texto, char *destino, int linha) {
+    const char *c = strchr(texto, '"');
+    int n = 0;
+    if (c == NULL) { erro_montagem(linha, "string esperada", texto); return 0; }
+    for (c++; *c && *c != '"'; c++) {
+        if (*c == '\\' && c[1]) {
+            c++;
+            switch (*c) {
+                case 'n': destino[n++] = '\n'; break;
+                case 't': destino[n++] = '\t'; break;
+                case 'r': destino[n++] = '\r'; break;
+                case '0': destino[n++] = '\0'; break;
+                default:  destino[n++] = *c; break;
+            }
+        } else {
+            destino[n++] = *c;
+        }
+    }
+    if (*c != '"') erro_montagem(linha, "string nao termina", texto);
+    return n;
+}
+
+/* Palavras com labels (.word label) resolvidas apenas na segunda passada. */
+typedef struct PalavraPendente {
+    uint32_t endereco;
+    char *expressao;
+    int linha;
+    struct PalavraPendente *proximo;
+} PalavraPendente;
+
+static void liberar_pendentes(InstrucaoPendente *pendentes, int n, PalavraPendente *palavras) {
+    for (int i = 0; i < n; i++) {
+        free(pendentes[i].opcode);
+        free(pendentes[i].operandos);
+    }
+    free(pendentes);
+    while (palavras != NULL) {
+        PalavraPendente *t = palavras;
+        palavras = palavras->proximo;
+        free(t->expressao);
+        free(t);
+    }
+}
+
+/**
+ * @brief Processa uma diretiva de dados.
+ */
+static void processar_diretiva(ProgramaMIPS *p, const char *diretiva, char *argumentos, int linha,
+                               int em_texto, uint32_t *cursor, uint32_t *cursor_gp,
+                               PalavraPendente **palavras) {
+    if (strcmp(diretiva, ".globl") == 0 || strcmp(diretiva, ".global") == 0
+        || strcmp(diretiva, ".ent") == 0 || strcmp(diretiva, ".end") == 0) {
+        return;
+    }
+    if (strcmp(diretiva, ".extern") == 0) {
+        char *args[2];
+        int32_t tamanho;
+        if (dividir_operandos(argumentos, args, 2) != 2 || !ler_numero(args[1], &tamanho)) {
+            erro_montagem(linha, "uso: .extern simbolo tamanho", NULL);
+            return;
+        }
+        alinhar(cursor_gp, 4);
+        if (*cursor_gp + tamanho > BASE_DADOS) { erro_montagem(linha, "area .extern excedida", NULL); return; }
+        if (!definir_simbolo(p, args[0], *cursor_gp, 0)) erro_montagem(linha, "simbolo redefinido", args[0]);
+        *cursor_gp += tamanho;
+        return;
+    }
+    if (em_texto) {
+        erro_montagem(linha, "diretiva de dados no segmento .text", diretiva);
+        return;
+    }
+    if (strcmp(diretiva, ".asciiz") == 0 || strcmp(diretiva, ".ascii") == 0) {
+        char *buffer = malloc(strlen(argumentos) + 2);
+        int n = decodificar_string(argumentos, buffer, linha);
+        if (strcmp(diretiva, ".asciiz") == 0) buffer[n++] = '\0';
+        uint32_t inicio = *cursor;
+        if (reservar_dados(cursor, n, linha)) memcpy(p->dados + (inicio - BASE_DADOS_GP), buffer, n);
+        free(buffer);
+    } else if (strcmp(diretiva, ".word") == 0 || strcmp(diretiva, ".half") == 0 || strcmp(diretiva, ".byte") == 0) {
+        uint32_t tamanho = diretiva[1] == 'w' ? 4 : (diretiva[1] == 'h' ? 2 : 1);
+        char *args[1024];
+        int n = dividir_operandos(argumentos, args, 1024);
+        if (n > 1024) { erro_montagem(linha, "muitos valores na diretiva", NULL); n = 1024; }
+        alinhar(cursor, tamanho);
+        for (int i = 0; i < n; i++) {
+            // "valor : repeticoes"
+            int32_t repeticoes = 1;
+            char *dois_pontos = strchr(args[i], ':');
+            if (dois_pontos != NULL) {
+                *dois_pontos = '\0';
+                if (!ler_numero(aparar(dois_pontos + 1), &repeticoes)) repeticoes = 1;
+            }
+            char *expressao = aparar(args[i]);
+            int32_t valor = 0;
+            int resolvido = ler_numero(expressao, &valor);
+            for (int r = 0; r < repeticoes; r++) {
+                uint32_t endereco = *cursor;
+                if (!reservar_dados(cursor, tamanho, linha)) return;
+                if (resolvido) {
+                    memcpy(p->dados + (endereco - BASE_DADOS_GP), &valor, tamanho);
+                } else {
+                    PalavraPendente *pp = malloc(sizeof(PalavraPendente));
+                    pp->endereco = endereco;
+                    pp->expressao = strdup(expressao);
+                    pp->linha = linha;
+                    pp->proximo = *palavras;
+                    *palavras = pp;
+                }
+            }
+        }
+    } else if (strcmp(diretiva, ".space") == 0) {
+        int32_t tamanho;
+        if (!ler_numero(aparar(argumentos), &tamanho) || tamanho < 0) {
+            erro_montagem(linha, "tamanho invalido em .space", argumentos);
+            return;
+        }
+        reservar_dados(cursor, tamanho, linha);
+    } else if (strcmp(diretiva, ".align") == 0) {
+        int32_t expoente;
+        if (!ler_numero(aparar(argumentos), &expoente) || expoente < 0 || expoente > 12) {
+            erro_montagem(linha, "alinhamento invalido", argumentos);
+            return;
+        }
+        alinhar(cursor, 1u << expoente);
+    } else {
+        erro_montagem(linha, "diretiva desconhecida", diretiva);
+    }
+}
+
+/* ---------- Decodificação das instruções ---------- */
+
+static int decodificar_endereco(const ProgramaMIPS *p, char *texto, InstrucaoSimulada *instr, int linha) {
+    // off(reg), (reg), label, label+n, label(reg)
+    char *abre = strchr(texto, '(');
+    if (abre != NULL) {
+        char *fecha = strchr(abre, ')');
+        if (fecha == NULL) { erro_montagem(linha, "operando de memoria invalido", texto); return 0; }
+        *fecha = '\0';
+        int base = ler_registrador(aparar(abre + 1));
+        if (base < 0) { erro_montagem(linha, "registrador invalido", abre + 1); return 0; }
+        *abre = '\0';
+        char *deslocamento = aparar(texto);
+        int32_t valor = 0;
+        if (*deslocamento != '\0' && !avaliar_expressao(p, deslocamento, &valor)) {
+            erro_montagem(linha, "deslocamento invalido", deslocamento);
+            return 0;
+        }
+        instr->rs = base;
+        instr->imm = valor;
+        return 1;
+    }
+    int32_t valor;
+    if (!avaliar_expressao(p, aparar(texto), &valor)) {
+        erro_montagem(linha, "endereco invalido", texto);
+        return 0;
+    }
+    instr->rs = 0;
+    instr->imm = valor;
+    instr->custo++; // lui + acesso
+    return 1;
+}
+
+static int decodificar_alvo(const ProgramaMIPS *p, const char *texto, InstrucaoSimulada *instr, int linha) {
+    Simbolo *s = buscar_simbolo(p, texto);
+    if (s == NULL || !s->e_texto) {
+        erro_montagem(linha, "label de codigo desconhecido", texto);
+        return 0;
+    }
+    instr->alvo = (int)((s->endereco - BASE_TEXTO) / 4);
+    return 1;
+}
+
+static int registrador_ou_erro(const char *texto, int linha) {
+    int r = ler_registrador(texto);
+    if (r < 0) erro_montagem(linha, "registrador invalido", texto);
+    return r < 0 ? 0 : r;
+}
+
+/**
+ * @brief Lê um operando-fonte que pode ser registrador ou imediato.
+ */
+static void fonte_registrador_ou_imediato(const ProgramaMIPS *p, const char *texto,
+                                          InstrucaoSimulada *instr, int linha) {
+    int r = ler_registrador(texto);
+    if (r >= 0) {
+        instr->rt = r;
+        return;
+    }
+    if (!avaliar_expressao(p, texto, &instr->imm)) {
+        erro_montagem(linha, "operando invalido", texto);
+        return;
+    }
+    instr->usa_imediato = 1;
+}
+
+static int decodificar_instrucao(const ProgramaMIPS *p, const InstrucaoPendente *pendente, InstrucaoSimulada *instr) {
+    int linha = pendente->linha;
+    int t;
+    for (t = 0; tabela_ops[t].nome != NULL; t++) {
+        if (strcmp(tabela_ops[t].nome, pendente->opcode) == 0) break;
+    }
+    if (tabela_ops[t].nome == NULL) {
+        erro_montagem(linha, "instrucao desconhecida", pendente->opcode);
+        return 0;
+    }
+
+    char *copia = strdup(pendente->operandos);
+    char *ops[4];
+    int n = dividir_operandos(copia, ops, 4);
+
+    memset(instr, 0, sizeof(InstrucaoSimulada));
+    instr->op = tabela_ops[t].op;
+    instr->classe = tabela_ops[t].classe;
+    instr->custo = tabela_ops[t].custo;
+    instr->linha = linha;
+    instr->alvo = -1;
+    FormatoOperandos formato = tabela_ops[t].formato;
+
+    // div/divu com três operandos é a pseudo-instrução (com teste de divisão por zero).
+    if ((instr->op == OP_DIV || instr->op == OP_DIVU) && n == 3) {
+        instr->op = instr->op == OP_DIV ? OP_DIV3 : OP_DIVU3;
+        formato = F_RRR;
+        instr->custo = 4;
+    }
+
+    static const int esperados[] = {3, 3, 2, 2, 2, 1, 1, 2, 2, 3, 2, 1, 0};
+    int ok = 1;
+    if (n != esperados[formato]) {
+        erro_montagem(linha, "numero de operandos incorreto", pendente->opcode);
+        ok = 0;
+    } else {
+        switch (formato) {
+            case F_RRR:
+                instr->rd = registrador_ou_erro(ops[0], linha);
+                instr->rs = registrador_ou_erro(ops[1], linha);
+                fonte_registrador_ou_imediato(p, ops[2], instr, linha);
+                if (instr->usa_imediato) {
+                    int imediato_nativo = (instr->op == OP_ADD || instr->op == OP_ADDU || instr->op == OP_SLT
+                                           || instr->op == OP_SLTU || instr->op == OP_AND || instr->op == OP_OR
+                                           || instr->op == OP_XOR) && instr->imm >= -32768 && instr->imm <= 32767;
+                    if (!imediato_nativo) instr->custo++;
+                }
+                break;
+            case F_RRI:
+                instr->rd = registrador_ou_erro(ops[0], linha);
+                instr->rs = registrador_ou_erro(ops[1], linha);
+                if (!avaliar_expressao(p, ops[2], &instr->imm)) {
+                    erro_montagem(linha, "imediato invalido", ops[2]);
+                    ok = 0;
+                }
+                instr->usa_imediato = 1;
+                break;
+            case F_RI:
+                instr->rd = registrador_ou_erro(ops[0], linha);
+                if (!avaliar_expressao(p, ops[1], &instr->imm)) {
+                    erro_montagem(linha, "imediato invalido", ops[1]);
+                    ok = 0;
+                }
+                if (instr->op == OP_LI && (instr->imm < -32768 || instr->imm > 65535)) instr->custo = 2;
+                break;
+            case F_LA:
+                instr->rd = registrador_ou_erro(ops[0], linha);
+                {
+                    InstrucaoSimulada endereco;
+                    memset(&endereco, 0, sizeof(endereco));
+                    if (!decodificar_endereco(p, ops[1], &endereco, linha)) { ok = 0; break; }
+                    if (endereco.rs != 0) {
+                        // la rd, off(base) == addiu rd, base, off
+                        instr->op = OP_ADDIU;
+                        instr->rs = endereco.rs;
+                        instr->usa_imediato = 1;
+                        instr->custo = 1;
+                    }
+                    instr->imm = endereco.imm;
+                }
+                break;
+            case F_RR:
+                instr->rd = registrador_ou_erro(ops[0], linha);
+                instr->rs = registrador_ou_erro(ops[1], linha);
+                break;
+            case F_R_DEST:
+                instr->rd = registrador_ou_erro(ops[0], linha);
+                break;
+            case F_R_FONTE:
+                instr->rs = registrador_ou_erro(ops[0], linha);
+                instr->rd = 31;
+                break;
+            case F_HILO:
+                instr->rs = registrador_ou_erro(ops[0], linha);
+                instr->rt = registrador_ou_erro(ops[1], linha);
+                break;
+            case F_MEM:
+                instr->rt = registrador_ou_erro(ops[0], linha);
+                ok = decodificar_endereco(p, ops[1], instr, linha);
+                break;
+            case F_DESVIO_2:
+                instr->rs = registrador_ou_erro(ops[0], linha);
+                fonte_registrador_ou_imediato(p, ops[1], instr, linha);
+                if (instr->usa_imediato) instr->custo++;
+                ok = decodificar_alvo(p, ops[2], instr, linha);
+                break;
+            case F_DESVIO_1:
+                instr->rs = registrador_ou_erro(ops[0], linha);
+                ok = decodificar_alvo(p, ops[1], instr, linha);
+                break;
+            case F_SALTO:
+                ok = decodificar_alvo(p, ops[0], instr, linha);
+                break;
+            case F_NENHUM:
+                break;
+        }
+    }
+    free(copia);
+    return ok;
+}
+
+/* ---------- Carga do programa ---------- */
+
+ProgramaMIPS *carregar_programa_mips(FILE *arquivo, const char *nome) {
+    ProgramaMIPS *p = calloc(1, sizeof(ProgramaMIPS));
+    p->nome = strdup(nome);
+    p->dados = calloc(TAM_DADOS, 1);
+    p->pilha = calloc(TAM_PILHA, 1);
+    if (p->dados == NULL || p->pilha == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria do simulador.\n");
+        exit(EXIT_FAILURE);
+    }
+    erros_montagem = 0;
+    nome_arquivo_atual = nome;
+
+    InstrucaoPendente *pendentes = NULL;
+    int num_pendentes = 0, capacidade_pendentes = 0;
+    PalavraPendente *palavras = NULL;
+
+    uint32_t cursor = BASE_DADOS, cursor_gp = BASE_DADOS_GP;
+    int em_texto = 1;
+    char linha_texto[TAM_LINHA];
+    int numero_linha = 0;
+
+    // Primeira passada: labels, dados e instruções ainda em texto.
+    while (fgets(linha_texto, sizeof(linha_texto), arquivo) != NULL) {
+        numero_linha++;
+        remover_comentario(linha_texto);
+        char *c = aparar(linha_texto);
+
+        // Labels (possivelmente vários na mesma linha).
+        for (;;) {
+            char *dois_pontos = c;
+            while (*dois_pontos && (isalnum((unsigned char)*dois_pontos) || *dois_pontos == '_' || *dois_pontos == '.' || *dois_pontos == '$')) dois_pontos++;
+            if (dois_pontos == c || *dois_pontos != ':') break;
+            *dois_pontos = '\0';
+            uint32_t endereco = em_texto ? BASE_TEXTO + 4u * num_pendentes : cursor;
+            if (!definir_simbolo(p, c, endereco, em_texto)) erro_montagem(numero_linha, "label redefinido", c);
+            c = aparar(dois_pontos + 1);
+        }
+        if (*c == '\0') continue;
+
+        char *fim_palavra = c;
+        while (*fim_palavra && !isspace((unsigned char)*fim_palavra)) fim_palavra++;
+        char *resto = *fim_palavra ? fim_palavra + 1 : fim_palavra;
+        *fim_palavra = '\0';
+        resto = aparar(resto);
+
+        if (c[0] == '.') {
+            if (strcmp(c, ".text") == 0) { em_texto = 1; continue; }
+            if (strcmp(c, ".data") == 0) { em_texto = 0; continue; }
+            processar_diretiva(p, c, resto, numero_linha, em_texto, &cursor, &cursor_gp, &palavras);
+            continue;
+        }
+        if (!em_texto) {
+            erro_montagem(numero_linha, "instrucao no segmento .data", c);
+            continue;
+        }
+        if (num_pendentes == capacidade_pendentes) {
+            capacidade_pendentes = capacidade_pendentes ? capacidade_pendentes * 2 : 1024;
+            pendentes = realloc(pendentes, capacidade_pendentes * sizeof(InstrucaoPendente));
+        }
+        pendentes[num_pendentes].opcode = strdup(c);
+        pendentes[num_pendentes].operandos = strdup(resto);
+        pendentes[num_pendentes].linha = numero_linha;
+        num_pendentes++;
+    }
+    p->fim_dados = cursor;
+    p->fim_dados_gp = cursor_gp;
+
+    // Segunda passada: operandos.
+    p->num_instrucoes = num_pendentes;
+    p->instrucoes = calloc(num_pendentes + 1, sizeof(InstrucaoSimulada));
+    p->chamadas = calloc(num_pendentes + 1, sizeof(long long));
+    p->label_da_instrucao = calloc(num_pendentes + 1, sizeof(char *));
+    for (int i = 0; i < num_pendentes; i++) {
+        decodificar_instrucao(p, &pendentes[i], &p->instrucoes[i]);
+    }
+    for (PalavraPendente *pp = palavras; pp != NULL; pp = pp->proximo) {
+        int32_t valor;
+        if (!avaliar_expressao(p, pp->expressao, &valor)) {
+            erro_montagem(pp->linha, "simbolo desconhecido", pp->expressao);
+            continue;
+        }
+        memcpy(p->dados + (pp->endereco - BASE_DADOS_GP), &valor, 4);
+    }
+    for (int h = 0; h < TAM_TABELA_SIMBOLOS; h++) {
+        for (Simbolo *s = p->simbolos[h]; s != NULL; s = s->proximo) {
+            if (!s->e_texto) continue;
+            int indice = (int)((s->endereco - BASE_TEXTO) / 4);
+            if (indice <= num_pendentes && p->label_da_instrucao[indice] == NULL) {
+                p->label_da_instrucao[indice] = s->nome;
+            }
+        }
+    }
+    liberar_pendentes(pendentes, num_pendentes, palavras);
+
+    Simbolo *main_simbolo = buscar_simbolo(p, "main");
+    if (main_simbolo == NULL || !main_simbolo->e_texto) {
+        erro_montagem(numero_linha, "label 'main' nao encontrado", NULL);
+    } else {
+        p->indice_main = (int)((main_simbolo->endereco - BASE_TEXTO) / 4);
+    }
+
+    if (erros_montagem > 0) {
+        liberar_programa_mips(p);
+        return NULL;
+    }
+    return p;
+}
+
+void liberar_programa_mips(ProgramaMIPS *p) {
+    if (p == NULL) return;
+    for (int h = 0; h < TAM_TABELA_SIMBOLOS; h++) {
+        Simbolo *s = p->simbolos[h];
+        while (s != NULL) {
+            Simbolo *t = s;
+            s = s->proximo;
+            free(t->nome);
+            free(t);
+        }
+    }
+    free(p->instrucoes);
+    free(p->chamadas);
+    free(p->label_da_instrucao);
+    free(p->dados);
+    free(p->pilha);
+    free(p->nome);
+    free(p);
+}
+
+/* ---------- Execução ---------- */
+
+/**
+ * @brief Traduz um endereço simulado para um ponteiro na memória do host.
+ * @return NULL se o acesso estiver fora dos segmentos.
+ */
+static inline unsigned char *memoria(ProgramaMIPS *p, uint32_t endereco, uint32_t tamanho) {
+    if (endereco >= BASE_DADOS_GP && endereco + tamanho <= BASE_DADOS_GP + TAM_DADOS) {
+        return p->dados + (endereco - BASE_DADOS_GP);
+    }
+    uint32_t base_pilha = TOPO_PILHA + 4 - TAM_PILHA;
+    if (endereco >= base_pilha && endereco + tamanho <= TOPO_PILHA + 4) {
+        return p->pilha + (endereco - base_pilha);
+    }
+    return NULL;
+}
+
+static int erro_execucao(const ProgramaMIPS *p, int pc, const char *mensagem, uint32_t valor) {
+    int linha = (pc >= 0 && pc < p->num_instrucoes) ? p->instrucoes[pc].linha : 0;
+    fflush(stdout);
+    fprintf(stderr, "%s:%d: erro de execucao: %s (0x%08x)\n", p->nome, linha, mensagem, valor);
+    return 1;
+}
+
+int executar_programa_mips(ProgramaMIPS *p, FILE *entrada, FILE *saida,
+                           long long limite_instrucoes, EstatisticasSimulador *est) {
+    int32_t reg[32];
+    int32_t hi = 0, lo = 0;
+    uint32_t heap = (p->fim_dados + 7) & ~7u;
+    memset(reg, 0, sizeof(reg));
+    memset(est, 0, sizeof(EstatisticasSimulador));
+    reg[28] = (int32_t)VALOR_INICIAL_GP;
+    reg[29] = (int32_t)SP_INICIAL;
+    reg[30] = (int32_t)SP_INICIAL;
+    reg[31] = (int32_t)RA_SENTINELA;
+    uint32_t menor_sp = SP_INICIAL;
+
+    int pc = p->indice_main;
+    const InstrucaoSimulada *instrucoes = p->instrucoes;
+    long long executadas = 0;
+    int codigo_saida = 0;
+
+    for (;;) {
+        if (pc < 0 || pc >= p->num_instrucoes) {
+            codigo_saida = erro_execucao(p, pc, "execucao fora do segmento de texto", BASE_TEXTO + 4u * pc);
+            break;
+        }
+        if (limite_instrucoes > 0 && executadas >= limite_instrucoes) {
+            codigo_saida = erro_execucao(p, pc, "limite de instrucoes atingido", (uint32_t)executadas);
+            break;
+        }
+        const InstrucaoSimulada *in = &instrucoes[pc];
+        executadas++;
+        est->por_classe[in->classe]++;
+        est->instrucoes_reais += in->custo;
+        int proximo = pc + 1;
+        int32_t a = reg[in->rs];
+        int32_t b = in->usa_imediato ? in->imm : reg[in->rt];
+        int32_t r = 0;
+        int escreve = 1;
+
+        switch ((CodigoOperacao)in->op) {
+            case OP_ADD:
+            case OP_ADDI: {
+                int64_t soma = (int64_t)a + b;
+                if (soma > INT32_MAX || soma < INT32_MIN) {
+                    codigo_saida = erro_execucao(p, pc, "overflow aritmetico", (uint32_t)soma);
+                    goto fim;
+                }
+                r = (int32_t)soma;
+                break;
+            }
+            case OP_SUB: {
+                int64_t diferenca = (int64_t)a - b;
+                if (diferenca > INT32_MAX || diferenca < INT32_MIN) {
+                    codigo_saida = erro_execucao(p, pc, "overflow aritmetico", (uint32_t)diferenca);
+                    goto fim;
+                }
+                r = (int32_t)diferenca;
+                break;
+            }
+            case OP_ADDU: case OP_ADDIU: r = (int32_t)((uint32_t)a + (uint32_t)b); break;
+            case OP_SUBU: r = (int32_t)((uint32_t)a - (uint32_t)b); break;
+            case OP_AND:  r = a & b; break;
+            case OP_OR:   r = a | b; break;
+            case OP_XOR:  r = a ^ b; break;
+            case OP_NOR:  r = ~(a | b); break;
+            case OP_ANDI: r = a & (b & 0xffff); break;
+            case OP_ORI:  r = a | (b & 0xffff); break;
+            case OP_XORI: r = a ^ (b & 0xffff); break;
+            case OP_SLT:  case OP_SLTI:  r = a < b; break;
+            case OP_SLTU: case OP_SLTIU: r = (uint32_t)a < (uint32_t)b; break;
+            case OP_SEQ:  r = a == b; break;
+            case OP_SNE:  r = a != b; break;
+            case OP_SGT:  r = a > b; break;
+            case OP_SGE:  r = a >= b; break;
+            case OP_SLE:  r = a <= b; break;
+            case OP_SGTU: r = (uint32_t)a > (uint32_t)b; break;
+            case OP_SGEU: r = (uint32_t)a >= (uint32_t)b; break;
+            case OP_SLEU: r = (uint32_t)a <= (uint32_t)b; break;
+            case OP_SLL:  r = (int32_t)((uint32_t)a << (b & 31)); break;
+            case OP_SRL:  r = (int32_t)((uint32_t)a >> (b & 31)); break;
+            case OP_SRA:  r = a >> (b & 31); break;
+            case OP_SLLV: r = (int32_t)((uint32_t)a << (b & 31)); break;
+            case OP_SRLV: r = (int32_t)((uint32_t)a >> (b & 31)); break;
+            case OP_SRAV: r = a >> (b & 31); break;
+            case OP_MUL:  r = (int32_t)((int64_t)a * b); break;
+            case OP_DIV3:
+            case OP_REM:
+                if (b == 0) { codigo_saida = erro_execucao(p, pc, "divisao por zero", 0); goto fim; }
+                if (a == INT32_MIN && b == -1) r = in->op == OP_DIV3 ? INT32_MIN : 0;
+                else r = in->op == OP_DIV3 ? a / b : a % b;
+                break;
+            case OP_DIVU3:
+            case OP_REMU:
+                if (b == 0) { codigo_saida = erro_execucao(p, pc, "divisao por zero", 0); goto fim; }
+                r = (int32_t)(in->op == OP_DIVU3 ? (uint32_t)a / (uint32_t)b : (uint32_t)a % (uint32_t)b);
+                break;
+            case OP_LUI:  r = (int32_t)((uint32_t)in->imm << 16); break;
+            case OP_LI:   r = in->imm; break;
+            case OP_MOVE: r = a; break;
+            case OP_NEG:  r = (int32_t)(0u - (uint32_t)a); break;
+            case OP_NOT:  r = ~a; break;
+            case OP_ABS:  r = a < 0 ? (int32_t)(0u - (uint32_t)a) : a; break;
+
+            case OP_MULT: {
+                int64_t produto = (int64_t)a * reg[in->rt];
+                lo = (int32_t)produto;
+                hi = (int32_t)(produto >> 32);
+                escreve = 0;
+                break;
+            }
+            case OP_MULTU: {
+                uint64_t produto = (uint64_t)(uint32_t)a * (uint32_t)reg[in->rt];
+                lo = (int32_t)produto;
+                hi = (int32_t)(produto >> 32);
+                escreve = 0;
+                break;
+            }
+            case OP_DIV: {
+                int32_t divisor = reg[in->rt];
+                if (divisor == 0) { codigo_saida = erro_execucao(p, pc, "divisao por zero", 0); goto fim; }
+                if (a == INT32_MIN && divisor == -1) { lo = INT32_MIN; hi = 0; }
+                else { lo = a / divisor; hi = a % divisor; }
+                escreve = 0;
+                break;
+            }
+            case OP_DIVU: {
+                uint32_t divisor = (uint32_t)reg[in->rt];
+                if (divisor == 0) { codigo_saida = erro_execucao(p, pc, "divisao por zero", 0); goto fim; }
+                lo = (int32_t)((uint32_t)a / divisor);
+                hi = (int32_t)((uint32_t)a % divisor);
+                escreve = 0;
+                break;
+            }
+            case OP_MFLO: r = lo; break;
+            case OP_MFHI: r = hi; break;
+            case OP_MTLO: lo = a; escreve = 0; break;
+            case OP_MTHI: hi = a; escreve = 0; break;
+
+            case OP_LW: case OP_LH: case OP_LHU: case OP_LB: case OP_LBU: {
+                uint32_t endereco = (uint32_t)a + (uint32_t)in->imm;
+                uint32_t tamanho = (in->op == OP_LW) ? 4 : (in->op == OP_LB || in->op == OP_LBU) ? 1 : 2;
+                unsigned char *m = memoria(p, endereco, tamanho);
+                if (m == NULL) { codigo_saida = erro_execucao(p, pc, "leitura em endereco invalido", endereco); goto fim; }
+                if (endereco % tamanho != 0) { codigo_saida = erro_execucao(p, pc, "leitura desalinhada", endereco); goto fim; }
+                if (tamanho == 4) { memcpy(&r, m, 4); }
+                else if (tamanho == 2) { int16_t h; memcpy(&h, m, 2); r = in->op == OP_LH ? h : (uint16_t)h; }
+                else { r = in->op == OP_LB ? (int32_t)(int8_t)*m : (int32_t)*m; }
+                reg[in->rt] = r;
+                escreve = 0;
+                break;
+            }
+            case OP_SW: case OP_SH: case OP_SB: {
+                uint32_t endereco = (uint32_t)a + (uint32_t)in->imm;
+                uint32_t tamanho = in->op == OP_SW ? 4 : in->op == OP_SB ? 1 : 2;
+                unsigned char *m = memoria(p, endereco, tamanho);
+                if (m == NULL) { codigo_saida = erro_execucao(p, pc, "escrita em endereco invalido", endereco); goto fim; }
+                if (endereco % tamanho != 0) { codigo_saida = erro_execucao(p, pc, "escrita desalinhada", endereco); goto fim; }
+                int32_t valor = reg[in->rt];
+                memcpy(m, &valor, tamanho);
+                escreve = 0;
+                break;
+            }
+
+            case OP_BEQ: case OP_BNE: case OP_BLT: case OP_BGT: case OP_BLE: case OP_BGE:
+            case OP_BLTU: case OP_BGTU: case OP_BLEU: case OP_BGEU:
+            case OP_BEQZ: case OP_BNEZ: case OP_BLTZ: case OP_BGTZ: case OP_BLEZ: case OP_BGEZ: {
+                int tomado;
+                switch ((CodigoOperacao)in->op) {
+                    case OP_BEQ:  tomado = a == b; break;
+                    case OP_BNE:  tomado = a != b; break;
+                    case OP_BLT:  tomado = a < b; break;
+                    case OP_BGT:  tomado = a > b; break;
+                    case OP_BLE:  tomado = a <= b; break;
+                    case OP_BGE:  tomado = a >= b; break;
+                    case OP_BLTU: tomado = (uint32_t)a < (uint32_t)b; break;
+                    case OP_BGTU: tomado = (uint32_t)a > (uint32_t)b; break;
+                    case OP_BLEU: tomado = (uint32_t)a <= (uint32_t)b; break;
+                    case OP_BGEU: tomado = (uint32_t)a >= (uint32_t)b; break;
+                    case OP_BEQZ: tomado = a == 0; break;
+                    case OP_BNEZ: tomado = a != 0; break;
+                    case OP_BLTZ: tomado = a < 0; break;
+                    case OP_BGTZ: tomado = a > 0; break;
+                    case OP_BLEZ: tomado = a <= 0; break;
+                    default:      tomado = a >= 0; break;
+                }
+                est->desvios_executados++;
+                if (tomado) {
+                    est->desvios_tomados++;
+                    proximo = in->alvo;
+                }
+                escreve = 0;
+                break;
+            }
+            case OP_B:
+            case OP_J:
+                proximo = in->alvo;
+                escreve = 0;
+                break;
+            case OP_JAL:
+                reg[31] = (int32_t)(BASE_TEXTO + 4u * (pc + 1));
+                p->chamadas[in->alvo]++;
+                proximo = in->alvo;
+                escreve = 0;
+                break;
+            case OP_JR:
+            case OP_JALR: {
+                uint32_t destino = (uint32_t)a;
+                if (in->op == OP_JALR) reg[31] = (int32_t)(BASE_TEXTO + 4u * (pc + 1));
+                if (destino == RA_SENTINELA && in->op == OP_JR) goto fim; // retorno de main
+                if (destino < BASE_TEXTO || (destino - BASE_TEXTO) % 4 != 0) {
+                    codigo_saida = erro_execucao(p, pc, "salto para endereco invalido", destino);
+                    goto fim;
+                }
+                proximo = (int)((destino - BASE_TEXTO) / 4);
+                if (in->op == OP_JALR && proximo < p->num_instrucoes) p->chamadas[proximo]++;
+                escreve = 0;
+                break;
+            }
+
+            case OP_SYSCALL: {
+                int codigo = reg[2];
+                if (codigo >= 0 && codigo < MAX_SYSCALLS_ESTATISTICA) est->syscalls[codigo]++;
+                escreve = 0;
+                switch (codigo) {
+                    case 1: fprintf(saida, "%d", reg[4]); break;
+                    case 4: {
+                        uint32_t endereco = (uint32_t)reg[4];
+                        unsigned char *m;
+                        while ((m = memoria(p, endereco, 1)) != NULL && *m != '\0') { fputc(*m, saida); endereco++; }
+                        if (m == NULL) { codigo_saida = erro_execucao(p, pc, "string em endereco invalido", endereco); goto fim; }
+                        break;
+                    }
+                    case 5: {
+                        int valor = 0;
+                        fflush(saida);
+                        if (fscanf(entrada, "%d", &valor) != 1) valor = 0;
+                        reg[2] = valor;
+                        break;
+                    }
+                    case 8: {
+                        uint32_t endereco = (uint32_t)reg[4];
+                        int tamanho = reg[5];
+                        unsigned char *m = memoria(p, endereco, tamanho > 0 ? (uint32_t)tamanho : 1);
+                        if (m == NULL) { codigo_saida = erro_execucao(p, pc, "buffer invalido", endereco); goto fim; }
+                        fflush(saida);
+                        if (tamanho > 0 && fgets((char *)m, tamanho, entrada) == NULL) m[0] = '\0';
+                        break;
+                    }
+                    case 9: {
+                        uint32_t inicio = heap;
+                        uint32_t tamanho = ((uint32_t)reg[4] + 7) & ~7u;
+                        if (memoria(p, inicio, tamanho ? tamanho : 1) == NULL) {
+                            codigo_saida = erro_execucao(p, pc, "memoria esgotada (sbrk)", tamanho);
+                            goto fim;
+                        }
+                        heap += tamanho;
+                        reg[2] = (int32_t)inicio;
+                        break;
+                    }
+                    case 10: goto fim;
+                    case 11: fputc(reg[4] & 0xff, saida); break;
+                    case 12: {
+                        fflush(saida);
+                        int c = fgetc(entrada);
+                        reg[2] = c == EOF ? 0 : c;
+                        break;
+                    }
+                    case 14: case 15: {
+                        uint32_t endereco = (uint32_t)reg[5];
+                        int32_t tamanho = reg[6];
+                        unsigned char *m = tamanho > 0 ? memoria(p, endereco, (uint32_t)tamanho) : p->dados;
+                        if (m == NULL) { codigo_saida = erro_execucao(p, pc, "buffer invalido", endereco); goto fim; }
+                        if (codigo == 15) {
+                            FILE *destino = reg[4] == 2 ? stderr : saida;
+                            reg[2] = (reg[4] == 1 || reg[4] == 2) ? (int32_t)fwrite(m, 1, tamanho, destino) : -1;
+                        } else {
+                            fflush(saida);
+                            reg[2] = reg[4] == 0 ? (int32_t)fread(m, 1, tamanho, entrada) : -1;
+                        }
+                        break;
+                    }
+                    case 17: codigo_saida = reg[4]; goto fim;
+                    default:
+                        codigo_saida = erro_execucao(p, pc, "syscall nao suportado", (uint32_t)codigo);
+                        goto fim;
+                }
+                break;
+            }
+            case OP_NOP:
+                escreve = 0;
+                break;
+            default:
+                codigo_saida = erro_execucao(p, pc, "instrucao nao suportada", in->op);
+                goto fim;
+        }
+
+        if (escreve) reg[in->rd] = r;
+        reg[0] = 0;
+        if ((uint32_t)reg[29] < menor_sp) menor_sp = (uint32_t)reg[29];
+        pc = proximo;
+    }
+
+fim:
+    fflush(saida);
+    est->instrucoes = executadas;
+    est->pilha_maxima = SP_INICIAL - menor_sp;
+    return codigo_saida;
+}
+
+static const char *nomes_syscalls(int codigo) {
+    switch (codigo) {
+        case 1: return "print_int";
+        case 4: return "print_string";
+        case 5: return "read_int";
+        case 8: return "read_string";
+        case 9: return "sbrk";
+        case 10: return "exit";
+        case 11: return "print_char";
+        case 12: return "read_char";
+        case 14: return "read";
+        case 15: return "write";
+        case 17: return "exit2";
+        default: return "?";
+    }
+}
+
+void imprimir_estatisticas_simulador(FILE *arquivo, const ProgramaMIPS *p, const EstatisticasSimulador *est) {
+    fprintf(arquivo, "--- Estatisticas do simulador ---\n");
+    fprintf(arquivo, "Instrucoes executadas: %lld (%lld apos expandir pseudo-instrucoes)\n",
+            est->instrucoes, est->instrucoes_reais);
+    for (int c = 0; c < NUM_CLASSES_INSTRUCAO; c++) {
+        if (est->por_classe[c] == 0) continue;
+        fprintf(arquivo, "  %-24s %12lld (%5.1f%%)\n", nomes_classes[c], est->por_classe[c],
+                est->instrucoes ? 100.0 * est->por_classe[c] / est->instrucoes : 0.0);
+    }
+    fprintf(arquivo, "Desvios condicionais: %lld executados, %lld tomados\n",
+            est->desvios_executados, est->desvios_tomados);
+    fprintf(arquivo, "Profundidade maxima da pilha: %u bytes\n", est->pilha_maxima);
+    fprintf(arquivo, "Syscalls:\n");
+    for (int s = 0; s < MAX_SYSCALLS_ESTATISTICA; s++) {
+        if (est->syscalls[s] > 0) fprintf(arquivo, "  %2d %-14s %12lld\n", s, nomes_syscalls(s), est->syscalls[s]);
+    }
+    fprintf(arquivo, "Chamadas por funcao:\n");
+    for (int i = 0; i < p->num_instrucoes; i++) {
+        if (p->chamadas[i] == 0) continue;
+        fprintf(arquivo, "  %-24s %12lld\n", p->label_da_instrucao[i] ? p->label_da_instrucao[i] : "?", p->chamadas[i]);
+    }
+}
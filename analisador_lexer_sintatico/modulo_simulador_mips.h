@@ -0,0 +1,76 @@
+#ifndef SIMULADOR_MIPS_H
+#define SIMULADOR_MIPS_H
+
+#include <stdio.h>
+
+/*
+ * Simulador do subconjunto do MIPS (e das pseudo-instruções do SPIM/MARS)
+ * usado pelo gerador de código, com os syscalls de E/S, sbrk e exit.
+ *
+ * O arquivo é montado uma única vez: as instruções ficam decodificadas, com
+ * registradores, imediatos e alvos de salto já resolvidos, e a execução é um
+ * laço sobre esse vetor. Os segmentos seguem o layout do SPIM: .text em
+ * 0x00400000, .extern a partir de 0x10000000 (com $gp = 0x10008000), .data
+ * em 0x10010000 e a pilha abaixo de 0x7ffffffc.
+ */
+
+/**
+ * @brief Classes de instrução usadas nas estatísticas do simulador.
+ */
+typedef enum {
+    CLASSE_ALU,         // Aritméticas, lógicas, comparações, li/la/move
+    CLASSE_MULT_DIV,    // mult, div, mflo, mfhi, mul, rem
+    CLASSE_LOAD,
+    CLASSE_STORE,
+    CLASSE_DESVIO,      // Desvios condicionais
+    CLASSE_SALTO,       // j, jr, b
+    CLASSE_CHAMADA,     // jal, jalr
+    CLASSE_SYSCALL,
+    NUM_CLASSES_INSTRUCAO
+} ClasseInstrucao;
+
+#define MAX_SYSCALLS_ESTATISTICA 64
+
+/**
+ * @brief Estatísticas coletadas durante a execução.
+ */
+typedef struct EstatisticasSimulador {
+    long long instrucoes;                            // Instruções do fonte executadas
+    long long instrucoes_reais;                      // Após expandir as pseudo-instruções
+    long long por_classe[NUM_CLASSES_INSTRUCAO];
+    long long desvios_executados;
+    long long desvios_tomados;
+    long long syscalls[MAX_SYSCALLS_ESTATISTICA];
+    unsigned int pilha_maxima;                       // Em bytes, a partir do $sp inicial
+} EstatisticasSimulador;
+
+typedef struct ProgramaMIPS ProgramaMIPS;
+
+/**
+ * @brief Monta (carrega) um arquivo assembly MIPS.
+ * @return O programa carregado, ou NULL em caso de erro (mensagem em stderr).
+ */
+ProgramaMIPS *carregar_programa_mips(FILE *arquivo, const char *nome);
+
+/**
+ * @brief Executa o programa a partir do label 'main'.
+ * @param entrada Fluxo lido pelos syscalls de leitura.
+ * @param saida Fluxo escrito pelos syscalls de escrita.
+ * @param limite_instrucoes Interrompe a execução após este número de instruções (0 = sem limite).
+ * @return O código de saída (0 em término normal, 1 em erro de execução).
+ */
+int executar_programa_mips(ProgramaMIPS *programa, FILE *entrada, FILE *saida,
+                           long long limite_instrucoes, EstatisticasSimulador *estatisticas);
+
+/**
+ * @brief Imprime as estatísticas, incluindo o número de chamadas por função.
+ */
+void imprimir_estatisticas_simulador(FILE *arquivo, const ProgramaMIPS *programa,
+                                     const EstatisticasSimulador *estatisticas);
+
+/**
+ * @brief Libera o programa carregado.
+ */
+void liberar_programa_mips(ProgramaMIPS *programa);
+
+#endif
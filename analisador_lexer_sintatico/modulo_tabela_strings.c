@@ -0,0 +1,273 @@
+#include "modulo_tabela_strings.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Caracteres de texto por diretiva: as linhas do montador têm tamanho limitado.
+#define MAX_CARACTERES_DIRETIVA 1000
+
+static void *realocar(void *memoria, size_t tamanho) {
+    void *nova = realloc(memoria, tamanho > 0 ? tamanho : 1);
+    if (nova == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a tabela de strings.\n");
+        exit(EXIT_FAILURE);
+    }
+    return nova;
+}
+
+/**
+ * @brief Converte o texto em símbolos de um byte na memória: os caracteres
+ * comuns valem o próprio código e os escapes ("\n") valem 256 + a letra.
+ * @return O número de símbolos (bytes).
+ */
+static int decodificar(const char *texto, int *simbolos) {
+    int n = 0;
+    for (const char *c = texto; *c != '\0'; c++) {
+        if (*c == '\\' && c[1] != '\0') {
+            c++;
+            if (simbolos != NULL) simbolos[n] = 256 + (unsigned char)*c;
+        } else if (simbolos != NULL) {
+            simbolos[n] = (unsigned char)*c;
+        }
+        n++;
+    }
+    return n;
+}
+
+/**
+ * @brief Posição no texto (com escapes) em que começa o byte de número 'byte'.
+ */
+static int posicao_no_texto(const char *texto, int byte) {
+    const char *c = texto;
+    for (int i = 0; i < byte && *c != '\0'; i++) {
+        c += (*c == '\\' && c[1] != '\0') ? 2 : 1;
+    }
+    return (int)(c - texto);
+}
+
+static unsigned espalhar_texto(const char *texto, int capacidade) {
+    unsigned valor = 2166136261u;
+    for (; *texto != '\0'; texto++) valor = (valor ^ (unsigned char)*texto) * 16777619u;
+    return valor & (unsigned)(capacidade - 1);
+}
+
+static void reindexar(TabelaStrings *tabela) {
+    free(tabela->indice);
+    tabela->capacidade_indice = tabela->capacidade_indice == 0 ? 64 : tabela->capacidade_indice * 2;
+    tabela->indice = calloc(tabela->capacidade_indice, sizeof(int));
+    if (tabela->indice == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a tabela de strings.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < tabela->num_strings; i++) {
+        unsigned h = espalhar_texto(tabela->strings[i].texto, tabela->capacidade_indice);
+        while (tabela->indice[h] != 0) h = (h + 1) & (unsigned)(tabela->capacidade_indice - 1);
+        tabela->indice[h] = i + 1;
+    }
+}
+
+void iniciar_tabela_strings(TabelaStrings *tabela) {
+    tabela->num_strings = 0;
+    tabela->capacidade = 0;
+    tabela->strings = NULL;
+    tabela->capacidade_indice = 0;
+    tabela->indice = NULL;
+    tabela->num_usos = 0;
+    tabela->bytes_usos = 0;
+}
+
+int registrar_string(TabelaStrings *tabela, const char *texto) {
+    int bytes = decodificar(texto, NULL);
+    tabela->num_usos++;
+    tabela->bytes_usos += bytes + 1;
+
+    if (tabela->indice != NULL) {
+        unsigned h = espalhar_texto(texto, tabela->capacidade_indice);
+        while (tabela->indice[h] != 0) {
+            int i = tabela->indice[h] - 1;
+            if (strcmp(tabela->strings[i].texto, texto) == 0) return i;
+            h = (h + 1) & (unsigned)(tabela->capacidade_indice - 1);
+        }
+    }
+
+    if (tabela->num_strings == tabela->capacidade) {
+        tabela->capacidade = tabela->capacidade == 0 ? 16 : tabela->capacidade * 2;
+        tabela->strings = realocar(tabela->strings, tabela->capacidade * sizeof(StringLiteral));
+    }
+    int i = tabela->num_strings++;
+    StringLiteral *string = &tabela->strings[i];
+    string->texto = strdup(texto);
+    if (string->texto == NULL) {
+        fprintf(stderr, "Erro critico: Falha ao alocar memoria para a tabela de strings.\n");
+        exit(EXIT_FAILURE);
+    }
+    string->bytes = bytes;
+    string->container = i;
+    string->deslocamento = 0;
+    string->labels = NULL;
+    string->num_labels = 0;
+
+    // Mantém a tabela de espalhamento no máximo meio cheia.
+    if (2 * tabela->num_strings > tabela->capacidade_indice) {
+        reindexar(tabela);
+    } else {
+        unsigned h = espalhar_texto(texto, tabela->capacidade_indice);
+        while (tabela->indice[h] != 0) h = (h + 1) & (unsigned)(tabela->capacidade_indice - 1);
+        tabela->indice[h] = i + 1;
+    }
+    return i;
+}
+
+void juntar_tabela_strings(TabelaStrings *tabela, const TabelaStrings *origem, const char *prefixo) {
+    int num_usos = tabela->num_usos, bytes_usos = tabela->bytes_usos;
+    for (int k = 0; k < origem->num_strings; k++) {
+        int i = registrar_string(tabela, origem->strings[k].texto);
+        StringLiteral *string = &tabela->strings[i];
+        size_t tamanho = strlen(prefixo) + 32;
+        char *label = realocar(NULL, tamanho);
+        snprintf(label, tamanho, "%s.str_%d", prefixo, k);
+        string->labels = realocar(string->labels, (string->num_labels + 1) * sizeof(char *));
+        string->labels[string->num_labels++] = label;
+    }
+    tabela->num_usos = num_usos + origem->num_usos;
+    tabela->bytes_usos = bytes_usos + origem->bytes_usos;
+}
+
+/* ---------- Agrupamento de sufixos ---------- */
+
+typedef struct StringDecodificada {
+    int *simbolos;
+    int tamanho;
+    int indice;
+} StringDecodificada;
+
+/**
+ * @brief Ordena pelas strings invertidas: quem é sufixo de outra fica logo
+ * antes das strings que terminam com ela.
+ */
+static int comparar_invertidas(const void *a, const void *b) {
+    const StringDecodificada *x = a, *y = b;
+    for (int i = 1; i <= x->tamanho && i <= y->tamanho; i++) {
+        int sx = x->simbolos[x->tamanho - i], sy = y->simbolos[y->tamanho - i];
+        if (sx != sy) return sx < sy ? -1 : 1;
+    }
+    return (x->tamanho > y->tamanho) - (x->tamanho < y->tamanho);
+}
+
+static int e_sufixo(const StringDecodificada *curta, const StringDecodificada *longa) {
+    if (curta->tamanho > longa->tamanho) return 0;
+    int inicio = longa->tamanho - curta->tamanho;
+    for (int i = 0; i < curta->tamanho; i++) {
+        if (curta->simbolos[i] != longa->simbolos[inicio + i]) return 0;
+    }
+    return 1;
+}
+
+static void agrupar_sufixos(TabelaStrings *tabela) {
+    int n = tabela->num_strings;
+    StringDecodificada *ordem = realocar(NULL, n * sizeof(StringDecodificada));
+    for (int i = 0; i < n; i++) {
+        ordem[i].simbolos = realocar(NULL, tabela->strings[i].bytes * sizeof(int));
+        ordem[i].tamanho = decodificar(tabela->strings[i].texto, ordem[i].simbolos);
+        ordem[i].indice = i;
+    }
+    qsort(ordem, n, sizeof(StringDecodificada), comparar_invertidas);
+
+    // De trás para frente: o container da seguinte já é o final.
+    for (int i = n - 2; i >= 0; i--) {
+        if (!e_sufixo(&ordem[i], &ordem[i + 1])) continue;
+        StringLiteral *string = &tabela->strings[ordem[i].indice];
+        const StringLiteral *maior = &tabela->strings[ordem[i + 1].indice];
+        string->container = maior->container;
+        string->deslocamento = tabela->strings[maior->container].bytes - string->bytes;
+    }
+
+    for (int i = 0; i < n; i++) free(ordem[i].simbolos);
+    free(ordem);
+}
+
+/* ---------- Emissão ---------- */
+
+static const TabelaStrings *tabela_em_ordenacao = NULL;
+
+static int comparar_posicao(const void *a, const void *b) {
+    const StringLiteral *x = &tabela_em_ordenacao->strings[*(const int *)a];
+    const StringLiteral *y = &tabela_em_ordenacao->strings[*(const int *)b];
+    if (x->container != y->container) return x->container - y->container;
+    return x->deslocamento - y->deslocamento;
+}
+
+/**
+ * @brief Emite um pedaço do texto como '.ascii' (ou '.asciiz', se é o último),
+ * numa diretiva a cada MAX_CARACTERES_DIRETIVA caracteres (sem separar escapes).
+ */
+static void emitir_pedaco(ListaInstrucoes *destino, const char *texto, int inicio, int fim, int ultimo) {
+    do {
+        int limite = fim;
+        if (limite - inicio > MAX_CARACTERES_DIRETIVA) {
+            limite = inicio;
+            while (limite < fim && limite - inicio < MAX_CARACTERES_DIRETIVA) {
+                limite += texto[limite] == '\\' && limite + 1 < fim ? 2 : 1;
+            }
+        }
+        size_t tamanho = (size_t)(limite - inicio) + 16;
+        char *diretiva = realocar(NULL, tamanho);
+        snprintf(diretiva, tamanho, "%s \"%.*s\"", ultimo && limite == fim ? ".asciiz" : ".ascii",
+                 limite - inicio, texto + inicio);
+        adicionar_diretiva(destino, diretiva);
+        free(diretiva);
+        inicio = limite;
+    } while (inicio < fim);
+}
+
+void emitir_tabela_strings(TabelaStrings *tabela, ListaInstrucoes *destino) {
+    int n = tabela->num_strings;
+    if (n == 0) return;
+    agrupar_sufixos(tabela);
+
+    // Strings de um mesmo container ficam juntas, em ordem de posição.
+    int *ordem = realocar(NULL, n * sizeof(int));
+    for (int i = 0; i < n; i++) ordem[i] = i;
+    tabela_em_ordenacao = tabela;
+    qsort(ordem, n, sizeof(int), comparar_posicao);
+    tabela_em_ordenacao = NULL;
+
+    adicionar_diretiva(destino, ".data");
+    int bytes_emitidos = 0, sufixos = 0;
+    char label[32];
+    for (int i = 0; i < n; ) {
+        const StringLiteral *container = &tabela->strings[tabela->strings[ordem[i]].container];
+        int posicao = 0;
+        for (; i < n && &tabela->strings[tabela->strings[ordem[i]].container] == container; i++) {
+            const StringLiteral *string = &tabela->strings[ordem[i]];
+            int inicio = posicao_no_texto(container->texto, string->deslocamento);
+            if (inicio > posicao) {
+                emitir_pedaco(destino, container->texto, posicao, inicio, 0);
+                posicao = inicio;
+            }
+            if (string->num_labels == 0) {
+                snprintf(label, sizeof(label), "str_%d", ordem[i]);
+                adicionar_label(destino, label);
+            }
+            for (int k = 0; k < string->num_labels; k++) adicionar_label(destino, string->labels[k]);
+            if (string != container) sufixos++;
+        }
+        emitir_pedaco(destino, container->texto, posicao, (int)strlen(container->texto), 1);
+        bytes_emitidos += container->bytes + 1;
+    }
+    free(ordem);
+
+    printf("Strings: %d literal(is), %d distinta(s), %d sufixo(s) reaproveitado(s); "
+           "%d bytes em .data (seriam %d com um label por literal).\n",
+           tabela->num_usos, n, sufixos, bytes_emitidos, tabela->bytes_usos);
+}
+
+void liberar_tabela_strings(TabelaStrings *tabela) {
+    for (int i = 0; i < tabela->num_strings; i++) {
+        free(tabela->strings[i].texto);
+        for (int k = 0; k < tabela->strings[i].num_labels; k++) free(tabela->strings[i].labels[k]);
+        free(tabela->strings[i].labels);
+    }
+    free(tabela->strings);
+    free(tabela->indice);
+    iniciar_tabela_strings(tabela);
+}
@@ -0,0 +1,65 @@
+#ifndef TABELA_STRINGS_H
+#define TABELA_STRINGS_H
+
+#include "modulo_instrucoes_mips.h"
+
+/*
+ * Tabela (pool) das strings literais do programa.
+ *
+ * Strings iguais recebem o mesmo label, e uma string que é sufixo de outra
+ * aponta para o fim da maior (tail merging): a maior é emitida em pedaços
+ * '.ascii' com um label no início de cada sufixo. Todas são emitidas num único
+ * bloco '.data' no fim do programa.
+ *
+ * O gerador MIPS registra os literais de cada função numa tabela própria
+ * (labels "<função>.str_<k>", que não dependem das outras funções) e depois
+ * junta as tabelas das funções na do programa.
+ */
+
+/**
+ * @brief Uma string distinta. O texto é mantido como no fonte (com os
+ * escapes, ex: "\n"); cada escape ocupa um byte na memória.
+ */
+typedef struct StringLiteral {
+    char *texto;
+    int bytes;                  // Tamanho em memória (sem o '\0')
+    int container;              // String em que esta é emitida (ela mesma, se não é sufixo de outra)
+    int deslocamento;           // Posição, em bytes, dentro do container
+    char **labels;              // Labels vindos de juntar_tabela_strings (nenhum = "str_<numero>")
+    int num_labels;
+} StringLiteral;
+
+typedef struct TabelaStrings {
+    int num_strings;
+    int capacidade;
+    StringLiteral *strings;
+    int capacidade_indice;      // Tabela de espalhamento texto -> string
+    int *indice;                // Índice da string + 1 (0 = posição vazia)
+    int num_usos;               // Total de literais registrados (com repetições)
+    int bytes_usos;             // Bytes que os literais ocupariam, um label por uso
+} TabelaStrings;
+
+void iniciar_tabela_strings(TabelaStrings *tabela);
+
+/**
+ * @brief Registra um literal (o texto entre aspas, como no fonte).
+ * @return O número da string; o label dela é "str_<numero>".
+ */
+int registrar_string(TabelaStrings *tabela, const char *texto);
+
+/**
+ * @brief Acrescenta a 'tabela' as strings de 'origem' (a tabela de uma
+ * unidade de código): a string 'k' de 'origem' é emitida também com o label
+ * "<prefixo>.str_<k>", e os usos de 'origem' contam como usos de 'tabela'.
+ */
+void juntar_tabela_strings(TabelaStrings *tabela, const TabelaStrings *origem, const char *prefixo);
+
+/**
+ * @brief Agrupa os sufixos e acrescenta o bloco '.data' com todas as strings a 'destino'.
+ * Imprime um resumo do espaço economizado.
+ */
+void emitir_tabela_strings(TabelaStrings *tabela, ListaInstrucoes *destino);
+
+void liberar_tabela_strings(TabelaStrings *tabela);
+
+#endif
@@ -0,0 +1,89 @@
+#!/bin/sh
+#
+# Compara o servidor de compilação (goianinha --server + goianinha_cliente)
+# com um processo goianinha por arquivo, em PEDIDOS compilações pequenas
+# (os programas de geracaoCodigo/Corretos, repetidos) feitas PARALELOS por
+# vez, sem e com --cache-dir (cuja chave inclui o resumo do executável, que
+# o servidor calcula uma vez). Mostra a vazão (compilações por segundo) e a
+# latência de cada compilação (mediana e percentil 95, medidas pelo script,
+# incluindo o processo goianinha ou goianinha_cliente). O saida.s de todas as
+# formas precisa ser o mesmo.
+# Executar a partir de analisador_lexer_sintatico/ (make benchmark).
+
+COMPILADOR="$(pwd)/goianinha"
+CLIENTE="$(pwd)/goianinha_cliente"
+PROGRAMAS="$(pwd)/geracaoCodigo/Corretos"
+PEDIDOS=${PEDIDOS:-400}
+PARALELOS=${PARALELOS:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)}
+TRABALHADORES=${TRABALHADORES:-$PARALELOS}
+
+temporario=$(mktemp -d) || exit 1
+SOCKET="$temporario/servidor.sock"
+servidor=
+trap '[ -n "$servidor" ] && kill "$servidor" 2>/dev/null; rm -rf "$temporario"' EXIT
+
+"$COMPILADOR" --server="$SOCKET" --workers="$TRABALHADORES" > "$temporario/servidor.log" 2>&1 &
+servidor=$!
+n=0
+while [ ! -S "$SOCKET" ] && [ $n -lt 50 ]; do sleep 0.1; n=$((n + 1)); done
+if [ ! -S "$SOCKET" ]; then
+    echo "FALHA: o servidor nao iniciou"
+    cat "$temporario/servidor.log"
+    exit 1
+fi
+
+# Um diretório por pedido: cada compilação escreve saida.s no diretório atual.
+set -- "$PROGRAMAS"/*.g
+i=0
+while [ $i -lt "$PEDIDOS" ]; do
+    [ $# -gt 0 ] || set -- "$PROGRAMAS"/*.g
+    mkdir "$temporario/p$i"
+    cp "$1" "$temporario/p$i/programa.g"
+    shift
+    i=$((i + 1))
+done
+
+# Compila todos os pedidos com o comando dado; as latências (us) vão para $temporario/<forma>.lat.
+medir() {
+    forma=$1
+    shift
+    : > "$temporario/$forma.lat"
+    inicio=$(date +%s%N)
+    i=0
+    while [ $i -lt "$PEDIDOS" ]; do echo "$temporario/p$i"; i=$((i + 1)); done \
+        | xargs -P "$PARALELOS" -I DIR sh -c '
+            cd "DIR" || exit 1
+            inicio=$(date +%s%N)
+            "$@" programa.g > /dev/null 2>&1 || echo "FALHA: DIR" >&2
+            fim=$(date +%s%N)
+            echo $(( (fim - inicio) / 1000 )) >> "'"$temporario/$forma.lat"'"
+            mv saida.s "saida_'"$forma"'.s"' _ "$@"
+    fim=$(date +%s%N)
+    total_us=$(( (fim - inicio) / 1000 ))
+    sort -n "$temporario/$forma.lat" | awk -v pedidos="$PEDIDOS" -v total="$total_us" -v forma="$forma" '
+        { latencia[NR] = $1 }
+        END {
+            p50 = latencia[int((NR - 1) * 0.50) + 1]; p95 = latencia[int((NR - 1) * 0.95) + 1]
+            printf "%-20s %10.0f comp/s %10.2f ms %10.2f ms\n", forma, pedidos / (total / 1e6), p50 / 1000, p95 / 1000
+        }'
+}
+
+echo "$PEDIDOS compilacoes, $PARALELOS em paralelo, servidor com $TRABALHADORES trabalhador(es)"
+printf "%-20s %17s %13s %13s\n" "forma" "vazao" "latencia p50" "p95"
+medir processo "$COMPILADOR"
+medir servidor "$CLIENTE" --server="$SOCKET"
+medir processo_cache "$COMPILADOR" --cache-dir="$temporario/cache_processo"
+medir servidor_cache "$CLIENTE" --server="$SOCKET" --cache-dir="$temporario/cache_servidor"
+
+falhas=0
+i=0
+while [ $i -lt "$PEDIDOS" ]; do
+    for forma in servidor processo_cache servidor_cache; do
+        if ! cmp -s "$temporario/p$i/saida_processo.s" "$temporario/p$i/saida_$forma.s"; then
+            echo "FALHA: saida.s diferente em p$i ($forma)"
+            falhas=$((falhas + 1))
+        fi
+    done
+    i=$((i + 1))
+done
+[ "$falhas" -eq 0 ]
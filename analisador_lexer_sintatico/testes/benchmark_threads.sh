@@ -0,0 +1,76 @@
+#!/bin/sh
+#
+# Mede a compilação de um programa gerado com FUNCOES funções (cada uma com
+# condicionais, laços e chamadas) com --threads=1, 2, 4, ... até
+# MAX_THREADS (padrão: o número de processadores, no mínimo 4). Cada
+# contagem roda REPETICOES vezes e o melhor tempo é o considerado; o ganho é
+# em relação a --threads=1. O tempo é o da compilação inteira: a análise
+# sintática e a semântica continuam numa thread só. O saida.s e as mensagens
+# de todas as contagens precisam ser os de --threads=1.
+# Executar a partir de analisador_lexer_sintatico/ (make benchmark).
+
+COMPILADOR="$(pwd)/goianinha"
+FUNCOES=${FUNCOES:-4000}
+REPETICOES=${REPETICOES:-3}
+PROCESSADORES=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)
+MAX_THREADS=${MAX_THREADS:-$PROCESSADORES}
+[ "$MAX_THREADS" -ge 4 ] || MAX_THREADS=4
+
+temporario=$(mktemp -d) || exit 1
+trap 'rm -rf "$temporario"' EXIT
+falhas=0
+
+awk -v funcoes="$FUNCOES" 'BEGIN {
+    print "int total;"
+    for (i = 0; i < funcoes; i++) {
+        printf "int f%d(int a, int b) {\n  int c; int i;\n  c = a * %d + b;\n  i = 0;\n", i, i % 13 + 2
+        printf "  enquanto (i < b) execute {\n    c = c + i * %d;\n", i % 7 + 3
+        printf "    se (c > %d) entao { c = c - a; } senao { c = c + 1; }\n    i = i + 1;\n  }\n", i
+        printf "  se (a == 1) entao c = c + 1; senao se (a == 2) entao c = c + 2; senao se (a == 3) entao c = c + 3;\n"
+        printf "  senao se (a == 4) entao c = c + 4; senao c = c / %d;\n", i % 5 + 2
+        if (i > 0) printf "  se (a > 0) entao c = c + f%d(a - 1, b);\n", i - 1
+        printf "  total = total + c;\n  retorne c;\n}\n"
+    }
+    printf "programa {\n  int x;\n  leia x;\n  escreva f%d(x, 3);\n  novalinha;\n}\n", funcoes - 1
+}' > "$temporario/programa.g"
+
+# Melhor tempo (ms) de REPETICOES compilações; saida.s e mensagens em $temporario/t<N>.*.
+medir() {
+    threads=$1
+    melhor=
+    n=0
+    while [ $n -lt "$REPETICOES" ]; do
+        inicio=$(date +%s%N)
+        (cd "$temporario" && "$COMPILADOR" --threads="$threads" programa.g > "t$threads.log" 2>&1) || return 1
+        fim=$(date +%s%N)
+        tempo=$(( (fim - inicio) / 1000000 ))
+        if [ -z "$melhor" ] || [ "$tempo" -lt "$melhor" ]; then melhor=$tempo; fi
+        n=$((n + 1))
+    done
+    mv "$temporario/saida.s" "$temporario/t$threads.s"
+    echo "$melhor"
+}
+
+echo "$FUNCOES funcoes, $PROCESSADORES processador(es)"
+printf "%-10s %12s %10s\n" "threads" "tempo" "ganho"
+threads=1
+while :; do
+    if ! tempo=$(medir "$threads"); then
+        echo "FALHA: --threads=$threads terminou com erro"
+        falhas=$((falhas + 1))
+    else
+        [ "$threads" -eq 1 ] && tempo_um=$tempo
+        printf "%-10s %10s ms %9sx\n" "$threads" "$tempo" \
+            "$(awk -v a="$tempo_um" -v b="$tempo" 'BEGIN { printf "%.2f", (b > 0 ? a / b : 0) }')"
+        if [ "$threads" -gt 1 ] && ! (cmp -s "$temporario/t1.s" "$temporario/t$threads.s" \
+                                      && cmp -s "$temporario/t1.log" "$temporario/t$threads.log"); then
+            echo "FALHA: --threads=$threads gerou saida diferente de --threads=1"
+            falhas=$((falhas + 1))
+        fi
+    fi
+    [ "$threads" -ge "$MAX_THREADS" ] && break
+    threads=$((threads * 2))
+    [ "$threads" -le "$MAX_THREADS" ] || threads=$MAX_THREADS
+done
+
+[ "$falhas" -eq 0 ]
@@ -0,0 +1,57 @@
+#!/bin/sh
+#
+# Compara a máquina virtual de bytecode (--run) e o JIT (--jit) com o
+# interpretador que percorre a AST (--run-ast) nos programas de
+# testes/benchmarks. Cada modo roda REPETICOES vezes e o melhor tempo é o
+# considerado; as saídas dos modos precisam ser iguais.
+# Executar a partir de analisador_lexer_sintatico/ (make benchmark).
+
+COMPILADOR="$(pwd)/goianinha"
+PROGRAMAS="$(pwd)/testes/benchmarks"
+REPETICOES=${REPETICOES:-3}
+
+temporario=$(mktemp -d) || exit 1
+trap 'rm -rf "$temporario"' EXIT
+falhas=0
+
+# Melhor tempo (ms) de REPETICOES execuções; a saída fica em $temporario/<modo>.txt.
+medir() {
+    modo=$1
+    fonte=$2
+    melhor=
+    n=0
+    while [ $n -lt "$REPETICOES" ]; do
+        inicio=$(date +%s%N)
+        "$COMPILADOR" "$modo" "$fonte" < /dev/null > "$temporario/$modo.txt" 2> /dev/null || return 1
+        fim=$(date +%s%N)
+        tempo=$(( (fim - inicio) / 1000000 ))
+        if [ -z "$melhor" ] || [ "$tempo" -lt "$melhor" ]; then melhor=$tempo; fi
+        n=$((n + 1))
+    done
+    echo "$melhor"
+}
+
+printf "%-12s %12s %12s %10s %12s %10s\n" "programa" "--run-ast" "--run" "ganho" "--jit" "ganho"
+for fonte in "$PROGRAMAS"/*.g; do
+    nome=$(basename "$fonte" .g)
+    if ! tempo_ast=$(medir --run-ast "$fonte") || ! tempo_vm=$(medir --run "$fonte") \
+       || ! tempo_jit=$(medir --jit "$fonte"); then
+        echo "FALHA: $nome terminou com erro"
+        falhas=$((falhas + 1))
+        continue
+    fi
+    if ! cmp -s "$temporario/--run-ast.txt" "$temporario/--run.txt" \
+       || ! cmp -s "$temporario/--run-ast.txt" "$temporario/--jit.txt"; then
+        echo "FALHA: $nome produziu saidas diferentes nos modos de execucao"
+        falhas=$((falhas + 1))
+        continue
+    fi
+    [ "$tempo_vm" -gt 0 ] || tempo_vm=1
+    [ "$tempo_jit" -gt 0 ] || tempo_jit=1
+    ganho=$(awk "BEGIN { printf \"%.1fx\", $tempo_ast / $tempo_vm }")
+    ganho_jit=$(awk "BEGIN { printf \"%.1fx\", $tempo_ast / $tempo_jit }")
+    printf "%-12s %10d ms %10d ms %10s %10d ms %10s\n" "$nome" "$tempo_ast" "$tempo_vm" "$ganho" \
+           "$tempo_jit" "$ganho_jit"
+done
+
+[ "$falhas" -eq 0 ]
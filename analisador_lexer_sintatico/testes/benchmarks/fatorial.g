@@ -0,0 +1,25 @@
+/* Fatorial recursivo calculado muitas vezes, com soma num acumulador global. */
+int total;
+
+int fatorial(int n) {
+    se (n == 0) entao
+        retorne 1;
+    senao
+        retorne n * fatorial(n - 1);
+}
+
+programa {
+    int i;
+    i = 0;
+    total = 0;
+    enquanto (i < 300000) execute {
+        total = total + fatorial(12) / 479001600;
+        i = i + 1;
+    }
+    escreva "fatorial(12) = ";
+    escreva fatorial(12);
+    escreva ", somado ";
+    escreva total;
+    escreva " vezes";
+    novalinha;
+}
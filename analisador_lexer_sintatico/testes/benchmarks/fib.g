@@ -0,0 +1,12 @@
+/* Fibonacci recursivo: dominado por chamadas e desvios. */
+int fibonacci(int n) {
+    se (n < 2) entao
+        retorne n;
+    retorne fibonacci(n - 1) + fibonacci(n - 2);
+}
+
+programa {
+    escreva "fibonacci(30) = ";
+    escreva fibonacci(30);
+    novalinha;
+}
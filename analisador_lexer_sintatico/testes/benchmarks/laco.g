@@ -0,0 +1,23 @@
+/* Laços aninhados: comparação e desvio, aritmética com constantes e incremento de global. */
+int contador;
+
+programa {
+    int i, j, soma;
+    i = 0;
+    soma = 0;
+    contador = 0;
+    enquanto (i < 3000) execute {
+        j = 0;
+        enquanto (j < 3000) execute {
+            soma = soma + i * 2 - j / 3;
+            contador = contador + 1;
+            j = j + 1;
+        }
+        i = i + 1;
+    }
+    escreva "soma = ";
+    escreva soma;
+    escreva ", iteracoes = ";
+    escreva contador;
+    novalinha;
+}
@@ -0,0 +1,57 @@
+#!/bin/sh
+#
+# Compila os programas de geracaoCodigo/Corretos com --target=c, compila o
+# saida.c com "$CC -O2" (gcc por padrão) e compara a saída do executável com
+# a do caminho MIPS (saida.s executado no simulador) para a mesma entrada
+# (testes/corretos/<nome>.entrada, se existir).
+# Executar a partir de analisador_lexer_sintatico/ (make teste).
+
+COMPILADOR="$(pwd)/goianinha"
+SIMULADOR="$(pwd)/simulador_mips"
+ENTRADAS="$(pwd)/testes/corretos"
+LIMITE=100000000
+CC=${CC:-gcc}
+
+if ! command -v "$CC" > /dev/null 2>&1; then
+    echo "AVISO: backend C nao testado (compilador '$CC' nao encontrado)"
+    exit 0
+fi
+
+temporario=$(mktemp -d) || exit 1
+trap 'rm -rf "$temporario"' EXIT
+falhas=0
+total=0
+
+for fonte in "$(pwd)"/geracaoCodigo/Corretos/*.g; do
+    nome=$(basename "$fonte" .g)
+    entrada="$ENTRADAS/$nome.entrada"
+    [ -f "$entrada" ] || entrada=/dev/null
+    total=$((total + 1))
+    # O compilador escreve saida.s / saida.c no diretório atual.
+    if ! (cd "$temporario" && "$COMPILADOR" "$fonte" > compilacao.log 2>&1); then
+        echo "FALHA: $nome nao compilou para MIPS"
+        falhas=$((falhas + 1))
+        continue
+    fi
+    if ! "$SIMULADOR" --limite $LIMITE "$temporario/saida.s" < "$entrada" > "$temporario/mips.txt"; then
+        echo "FALHA: $nome terminou com erro no simulador"
+        falhas=$((falhas + 1))
+        continue
+    fi
+    if ! (cd "$temporario" && "$COMPILADOR" --target=c "$fonte" > compilacao.log 2>&1 \
+          && "$CC" -O2 saida.c -o programa 2> cc.log); then
+        echo "FALHA: $nome (C) nao compilou"
+        cat "$temporario/cc.log" 2> /dev/null | head -20
+        falhas=$((falhas + 1))
+    elif ! "$temporario/programa" < "$entrada" > "$temporario/c.txt"; then
+        echo "FALHA: $nome (C) terminou com erro"
+        falhas=$((falhas + 1))
+    elif ! cmp -s "$temporario/mips.txt" "$temporario/c.txt"; then
+        echo "FALHA: $nome (C) produziu saida diferente do MIPS"
+        diff "$temporario/mips.txt" "$temporario/c.txt" | head -20
+        falhas=$((falhas + 1))
+    fi
+done
+
+echo "Backend C: $((total - falhas)) de $total programas com a mesma saida do MIPS."
+[ "$falhas" -eq 0 ]
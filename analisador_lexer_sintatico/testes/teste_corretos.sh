@@ -0,0 +1,228 @@
+#!/bin/sh
+#
+# Compila os programas de geracaoCodigo/Corretos e executa o saida.s no
+# simulador, comparando a saída com testes/corretos/<nome>.saida. A entrada
+# vem de testes/corretos/<nome>.entrada (se existir). Cada programa é testado
+# com as opções padrão e com todas as otimizações desligadas, e também
+# executado diretamente na máquina virtual (--run), pela AST (--run-ast) e
+# pelo JIT (--jit, com e sem compilação preguiçosa). A versão instrumentada
+# (--instrument) e a compilada com o perfil que ela gera (--profile-use)
+# também precisam produzir a saída esperada. Com --incremental, a segunda
+# compilação (que reaproveita todas as funções) tem de reproduzir o saida.s
+# da compilação completa, assim como --stream (lendo o arquivo e a entrada padrão).
+# Alguns programas também são editados entre duas compilações --incremental
+# (trocando declarações de lugar): as mensagens de erro e o saida.s da segunda
+# têm de ser os de uma compilação completa do programa editado.
+# Programas que param com erro de execução (overflow, divisão por zero) têm
+# de parar com e sem as otimizações e a saída bufferizada, depois de escrever
+# o mesmo texto.
+# Com --threads=4, o saida.s e as mensagens têm de ser os de --threads=1.
+# Em máquinas x86-64 com gcc, também é compilado com --target=x86_64 e
+# executado nativamente.
+# Executar a partir de analisador_lexer_sintatico/ (make teste).
+
+COMPILADOR="$(pwd)/goianinha"
+SIMULADOR="$(pwd)/simulador_mips"
+ESPERADOS="$(pwd)/testes/corretos"
+LIMITE=100000000
+SEM_OTIMIZACOES="--no-peephole --no-dispatch --no-strength-reduction --no-licm --no-loop-rotation \
+--no-iv-reduction --no-unroll --no-inline --no-specialize --no-io-buffer --no-partial-eval"
+
+NATIVO=0
+if [ "$(uname -m)" = "x86_64" ] && command -v gcc > /dev/null 2>&1; then
+    NATIVO=1
+else
+    echo "AVISO: backend x86-64 nao testado (requer Linux x86-64 com gcc)"
+fi
+
+temporario=$(mktemp -d) || exit 1
+trap 'rm -rf "$temporario"' EXIT
+falhas=0
+total=0
+
+for fonte in "$(pwd)"/geracaoCodigo/Corretos/*.g; do
+    nome=$(basename "$fonte" .g)
+    esperado="$ESPERADOS/$nome.saida"
+    entrada="$ESPERADOS/$nome.entrada"
+    [ -f "$entrada" ] || entrada=/dev/null
+    if [ ! -f "$esperado" ]; then
+        echo "AVISO: $nome sem saida esperada ($esperado)"
+        continue
+    fi
+    # Sem 'leia', o padrão executa o programa em compilação; --no-partial-eval
+    # testa a geração de código otimizada dele.
+    for opcoes in "" "--no-partial-eval" "$SEM_OTIMIZACOES"; do
+        total=$((total + 1))
+        case "$opcoes" in
+            "") rotulo="$nome" ;;
+            --no-partial-eval) rotulo="$nome (sem avaliacao parcial)" ;;
+            *) rotulo="$nome (sem otimizacoes)" ;;
+        esac
+        # O compilador escreve saida.s no diretório atual.
+        if ! (cd "$temporario" && "$COMPILADOR" $opcoes "$fonte" > compilacao.log 2>&1); then
+            echo "FALHA: $rotulo nao compilou"
+            falhas=$((falhas + 1))
+            continue
+        fi
+        if ! "$SIMULADOR" --limite $LIMITE "$temporario/saida.s" < "$entrada" > "$temporario/saida.txt"; then
+            echo "FALHA: $rotulo terminou com erro no simulador"
+            falhas=$((falhas + 1))
+        elif ! cmp -s "$temporario/saida.txt" "$esperado"; then
+            echo "FALHA: $rotulo produziu saida diferente da esperada"
+            diff "$esperado" "$temporario/saida.txt" | head -20
+            falhas=$((falhas + 1))
+        fi
+    done
+    total=$((total + 1))
+    if ! (cd "$temporario" && "$COMPILADOR" --no-partial-eval --instrument "$fonte" > compilacao.log 2>&1 \
+          && "$SIMULADOR" --limite $LIMITE saida.s < "$entrada" > saida.txt 2> perfil.txt \
+          && cmp -s saida.txt "$esperado" \
+          && "$COMPILADOR" --no-partial-eval --profile-use=perfil.txt "$fonte" > compilacao.log 2>&1 \
+          && "$SIMULADOR" --limite $LIMITE saida.s < "$entrada" > saida.txt \
+          && cmp -s saida.txt "$esperado"); then
+        echo "FALHA: $nome (--instrument / --profile-use)"
+        tail -3 "$temporario/compilacao.log"
+        falhas=$((falhas + 1))
+    fi
+    # Um acerto no cache tem de reproduzir o saida.s da compilação sem cache.
+    total=$((total + 1))
+    if ! (cd "$temporario" && "$COMPILADOR" "$fonte" > compilacao.log 2>&1 && mv saida.s sem_cache.s \
+          && "$COMPILADOR" --cache-dir=cache "$fonte" > compilacao.log 2>&1 \
+          && "$COMPILADOR" --cache-dir=cache "$fonte" > compilacao.log 2>&1 \
+          && grep -q "^Cache: acerto" compilacao.log && cmp -s saida.s sem_cache.s); then
+        echo "FALHA: $nome (--cache-dir)"
+        falhas=$((falhas + 1))
+    fi
+    total=$((total + 1))
+    if ! (cd "$temporario" && rm -rf incremental \
+          && "$COMPILADOR" --no-inline --no-specialize --no-partial-eval "$fonte" > compilacao.log 2>&1 \
+          && mv saida.s completo.s \
+          && "$COMPILADOR" --incremental=incremental "$fonte" > compilacao.log 2>&1 && cmp -s saida.s completo.s \
+          && "$COMPILADOR" --incremental=incremental "$fonte" > compilacao.log 2>&1 \
+          && grep -q "^Incremental: .* 0 gerada(s) de novo" compilacao.log && cmp -s saida.s completo.s); then
+        echo "FALHA: $nome (--incremental)"
+        falhas=$((falhas + 1))
+    fi
+    total=$((total + 1))
+    if ! (cd "$temporario" && "$COMPILADOR" --stream "$fonte" > compilacao.log 2>&1 && cmp -s saida.s completo.s \
+          && "$COMPILADOR" --stream - < "$fonte" > compilacao.log 2>&1 && cmp -s saida.s completo.s); then
+        echo "FALHA: $nome (--stream)"
+        falhas=$((falhas + 1))
+    fi
+    total=$((total + 1))
+    if ! (cd "$temporario" && "$COMPILADOR" --threads=1 --no-partial-eval "$fonte" > uma.log 2>&1 \
+          && mv saida.s uma.s && "$COMPILADOR" --threads=4 --no-partial-eval "$fonte" > quatro.log 2>&1 \
+          && cmp -s saida.s uma.s && cmp -s quatro.log uma.log); then
+        echo "FALHA: $nome (--threads=4 diferente de --threads=1)"
+        falhas=$((falhas + 1))
+    fi
+    if [ "$NATIVO" -eq 1 ]; then
+        total=$((total + 1))
+        if ! (cd "$temporario" && "$COMPILADOR" --target=x86_64 "$fonte" > compilacao.log 2>&1 \
+              && gcc -nostdlib -static saida.s -o programa); then
+            echo "FALHA: $nome (x86-64) nao compilou"
+            falhas=$((falhas + 1))
+        elif ! "$temporario/programa" < "$entrada" > "$temporario/saida.txt"; then
+            echo "FALHA: $nome (x86-64) terminou com erro"
+            falhas=$((falhas + 1))
+        elif ! cmp -s "$temporario/saida.txt" "$esperado"; then
+            echo "FALHA: $nome (x86-64) produziu saida diferente da esperada"
+            diff "$esperado" "$temporario/saida.txt" | head -20
+            falhas=$((falhas + 1))
+        fi
+    fi
+    for modo in --run --run-ast --jit "--jit --no-lazy-jit"; do
+        total=$((total + 1))
+        if ! "$COMPILADOR" $modo "$fonte" < "$entrada" > "$temporario/saida.txt" 2> "$temporario/execucao.log"; then
+            echo "FALHA: $nome ($modo) terminou com erro"
+            falhas=$((falhas + 1))
+        elif ! cmp -s "$temporario/saida.txt" "$esperado"; then
+            echo "FALHA: $nome ($modo) produziu saida diferente da esperada"
+            diff "$esperado" "$temporario/saida.txt" | head -20
+            falhas=$((falhas + 1))
+        fi
+    done
+done
+
+# Compila 'antes' com --incremental, troca o fonte por 'depois' e compara a
+# recompilação com uma compilação completa de 'depois'.
+testar_edicao() {
+    rotulo=$1
+    total=$((total + 1))
+    if ! (cd "$temporario" && rm -rf incremental saida.s completo.s \
+          && printf '%s\n' "$2" > edicao.g \
+          && "$COMPILADOR" --incremental=incremental edicao.g > compilacao.log 2>&1 \
+          && printf '%s\n' "$3" > edicao.g && rm -f saida.s \
+          && "$COMPILADOR" --no-inline --no-specialize --no-partial-eval edicao.g > /dev/null 2> completo.err \
+          && { [ ! -f saida.s ] || mv saida.s completo.s; } \
+          && "$COMPILADOR" --incremental=incremental edicao.g > compilacao.log 2> incremental.err \
+          && cmp -s incremental.err completo.err \
+          && if [ -f completo.s ]; then cmp -s saida.s completo.s; else [ ! -f saida.s ]; fi); then
+        echo "FALHA: --incremental apos edicao ($rotulo)"
+        falhas=$((falhas + 1))
+    fi
+}
+
+testar_edicao "funcoes trocadas de lugar" \
+'int g(int x) { retorne x * 2; }
+int h(int x) { retorne x + 1; }
+programa { escreva g(3) + h(4); novalinha; }' \
+'int h(int x) { retorne x + 1; }
+int g(int x) { retorne x * 2; }
+programa { escreva g(3) + h(4); novalinha; }'
+testar_edicao "funcao chamada movida para depois de quem chama" \
+'int g(int x) { retorne x * 2; }
+int f(int x) { retorne g(x); }
+programa { escreva f(3); novalinha; }' \
+'int f(int x) { retorne g(x); }
+int g(int x) { retorne x * 2; }
+programa { escreva f(3); novalinha; }'
+testar_edicao "global movida para depois da funcao que a usa" \
+'int n;
+int f(int x) { retorne x + n; }
+programa { n = 1; escreva f(3); novalinha; }' \
+'int f(int x) { retorne x + n; }
+int n;
+programa { n = 1; escreva f(3); novalinha; }'
+
+# Compila 'programa' com as opções padrão e com cada conjunto de opções
+# seguinte, executa no simulador com 'entrada' e exige um erro de execução
+# depois de o programa escrever exatamente 'esperada'.
+testar_erro_execucao() {
+    rotulo=$1
+    printf '%s\n' "$2" > "$temporario/erro.g"
+    printf '%s\n' "$3" > "$temporario/erro.entrada"
+    printf '%s' "$4" > "$temporario/erro.esperada"
+    shift 4
+    for opcoes in "" "$@"; do
+        total=$((total + 1))
+        if ! (cd "$temporario" && "$COMPILADOR" $opcoes erro.g > compilacao.log 2>&1); then
+            echo "FALHA: $rotulo (${opcoes:-opcoes padrao}) nao compilou"
+            falhas=$((falhas + 1))
+        elif "$SIMULADOR" --limite $LIMITE "$temporario/saida.s" < "$temporario/erro.entrada" \
+                > "$temporario/saida.txt" 2> /dev/null; then
+            echo "FALHA: $rotulo (${opcoes:-opcoes padrao}) terminou sem erro de execucao"
+            falhas=$((falhas + 1))
+        elif ! cmp -s "$temporario/saida.txt" "$temporario/erro.esperada"; then
+            echo "FALHA: $rotulo (${opcoes:-opcoes padrao}) escreveu saida diferente da esperada antes do erro"
+            diff "$temporario/erro.esperada" "$temporario/saida.txt" | head -20
+            falhas=$((falhas + 1))
+        fi
+    done
+}
+
+testar_erro_execucao "overflow em soma com constante" \
+'int f(int x) { retorne x + 1; }
+programa { int y; leia y; escreva f(y); novalinha; }' 2147483647 '' --no-peephole "$SEM_OTIMIZACOES"
+testar_erro_execucao "overflow em subtracao de constante" \
+'int f(int x) { retorne x - 1; }
+programa { int y; leia y; escreva f(y); novalinha; }' -2147483648 '' --no-peephole "$SEM_OTIMIZACOES"
+testar_erro_execucao "divisao por zero depois de escrever" \
+'programa { int i; int z; escreva "a"; novalinha; leia z; i = 5 / z; escreva i; }' 0 'a
+' --no-io-buffer "$SEM_OTIMIZACOES"
+testar_erro_execucao "divisao por zero sem leitura" \
+'programa { int i; int z; z = 0; escreva "a"; novalinha; i = 5 / z; escreva i; }' '' 'a
+' --no-io-buffer --no-partial-eval "$SEM_OTIMIZACOES"
+
+echo "Programas corretos: $((total - falhas)) de $total execucoes OK."
+[ "$falhas" -eq 0 ]
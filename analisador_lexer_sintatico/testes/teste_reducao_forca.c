@@ -0,0 +1,142 @@
+/*
+ * Teste diferencial da redução de força: as sequências geradas por
+ * modulo_reducao_forca.c são interpretadas e comparadas com o resultado
+ * da lowering ingênua (mult/mflo e div/mflo) para valores de borda.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "../modulo_reducao_forca.h"
+
+typedef struct Registradores {
+    int32_t v0, t0, t1, hi, lo;
+} Registradores;
+
+static int32_t *registrador(Registradores *r, const char *nome) {
+    static int32_t zero;
+    if (strcmp(nome, "$v0") == 0) return &r->v0;
+    if (strcmp(nome, "$t0") == 0) return &r->t0;
+    if (strcmp(nome, "$t1") == 0) return &r->t1;
+    if (strcmp(nome, "$zero") == 0) { zero = 0; return &zero; }
+    fprintf(stderr, "Registrador inesperado na sequencia: %s\n", nome);
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Executa a sequência gerada com $v0 = x e devolve o $v0 final.
+ */
+static int32_t executar_sequencia(const ListaInstrucoes *lista, int32_t x) {
+    Registradores r = {x, 0x1111, 0x2222, 0x3333, 0x4444};
+    for (int i = 0; i < lista->tamanho; i++) {
+        const InstrucaoMIPS *in = &lista->itens[i];
+        if (in->tipo != LINHA_INSTRUCAO) continue;
+        const char *op = in->opcode;
+        if (strcmp(op, "li") == 0) {
+            *registrador(&r, in->operandos[0]) = (int32_t)strtoll(in->operandos[1], NULL, 10);
+        } else if (strcmp(op, "sll") == 0 || strcmp(op, "srl") == 0 || strcmp(op, "sra") == 0) {
+            uint32_t fonte = (uint32_t)*registrador(&r, in->operandos[1]);
+            int k = atoi(in->operandos[2]);
+            int32_t resultado;
+            if (op[2] == 'l' && op[1] == 'l') resultado = (int32_t)(fonte << k);
+            else if (op[1] == 'r' && op[2] == 'l') resultado = (int32_t)(fonte >> k);
+            else resultado = (int32_t)fonte < 0 ? (int32_t)~(~fonte >> k) : (int32_t)(fonte >> k);
+            *registrador(&r, in->operandos[0]) = resultado;
+        } else if (strcmp(op, "addu") == 0 || strcmp(op, "subu") == 0) {
+            uint32_t a = (uint32_t)*registrador(&r, in->operandos[1]);
+            uint32_t b = (uint32_t)*registrador(&r, in->operandos[2]);
+            *registrador(&r, in->operandos[0]) = (int32_t)(op[0] == 'a' ? a + b : a - b);
+        } else if (strcmp(op, "mult") == 0) {
+            int64_t produto = (int64_t)*registrador(&r, in->operandos[0]) * *registrador(&r, in->operandos[1]);
+            r.lo = (int32_t)(uint32_t)produto;
+            r.hi = (int32_t)(produto >> 32);
+        } else if (strcmp(op, "mfhi") == 0) {
+            *registrador(&r, in->operandos[0]) = r.hi;
+        } else if (strcmp(op, "mflo") == 0) {
+            *registrador(&r, in->operandos[0]) = r.lo;
+        } else {
+            fprintf(stderr, "Instrucao inesperada na sequencia: %s\n", op);
+            exit(EXIT_FAILURE);
+        }
+    }
+    return r.v0;
+}
+
+static int32_t multiplicacao_ingenua(int32_t x, int32_t c) {
+    return (int32_t)((uint32_t)x * (uint32_t)c);
+}
+
+static int32_t divisao_ingenua(int32_t x, int32_t c) {
+    if (x == INT_MIN && c == -1) return INT_MIN;
+    return x / c;
+}
+
+static int falhas = 0;
+static int verificacoes = 0;
+
+static void verificar(const char *operacao, int32_t x, int32_t c, int32_t obtido, int32_t esperado) {
+    verificacoes++;
+    if (obtido != esperado) {
+        if (falhas < 20) {
+            printf("FALHA: %d %s %d = %d (esperado %d)\n", x, operacao, c, obtido, esperado);
+        }
+        falhas++;
+    }
+}
+
+int main(void) {
+    int32_t valores[256];
+    int num_valores = 0;
+    const int32_t bordas[] = {
+        0, 1, -1, 2, -2, 3, -3, 7, -7, 100, -100, 12345, -12345,
+        INT_MAX, INT_MAX - 1, INT_MIN, INT_MIN + 1, INT_MAX / 2, INT_MIN / 2,
+        0x55555555, -0x55555555, 1 << 30, -(1 << 30), 65535, -65536
+    };
+    for (size_t i = 0; i < sizeof(bordas) / sizeof(bordas[0]); i++) valores[num_valores++] = bordas[i];
+    uint32_t semente = 12345;
+    while (num_valores < 256) {
+        semente = semente * 1103515245u + 12345u;
+        valores[num_valores++] = (int32_t)(semente ^ (semente >> 13));
+    }
+
+    int32_t constantes[1200];
+    int num_constantes = 0;
+    for (int c = -512; c <= 512; c++) constantes[num_constantes++] = c;
+    const int32_t especiais[] = {
+        INT_MAX, INT_MIN, INT_MIN + 1, INT_MAX - 1, 641, 1000, 1 << 30, -(1 << 30),
+        0x55555555, 0x7ffffff0, 1000000007, -1000000007, 65537, 6700417, 0x40000001
+    };
+    for (size_t i = 0; i < sizeof(especiais) / sizeof(especiais[0]); i++) constantes[num_constantes++] = especiais[i];
+
+    int multiplicacoes_reduzidas = 0, divisoes_reduzidas = 0;
+    for (int k = 0; k < num_constantes; k++) {
+        int32_t c = constantes[k];
+        ListaInstrucoes lista;
+
+        iniciar_lista_instrucoes(&lista);
+        if (gerar_multiplicacao_constante(&lista, c)) {
+            multiplicacoes_reduzidas++;
+            for (int i = 0; i < num_valores; i++) {
+                verificar("*", valores[i], c, executar_sequencia(&lista, valores[i]), multiplicacao_ingenua(valores[i], c));
+            }
+        }
+        liberar_lista_instrucoes(&lista);
+
+        iniciar_lista_instrucoes(&lista);
+        if (gerar_divisao_constante(&lista, c)) {
+            divisoes_reduzidas++;
+            for (int i = 0; i < num_valores; i++) {
+                verificar("/", valores[i], c, executar_sequencia(&lista, valores[i]), divisao_ingenua(valores[i], c));
+            }
+        } else if (c != 0) {
+            printf("FALHA: divisao por %d nao foi reduzida\n", c);
+            falhas++;
+        }
+        liberar_lista_instrucoes(&lista);
+    }
+
+    printf("Reducao de forca: %d multiplicacoes e %d divisoes reduzidas, %d verificacoes, %d falhas.\n",
+           multiplicacoes_reduzidas, divisoes_reduzidas, verificacoes, falhas);
+    return falhas == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -2,6 +2,94 @@
 
 TabelaSimbolos *pilha_tabelas = NULL;
 
+/*
+ * Entradas de escopos já encerrados. A AST guarda ponteiros para elas
+ * (campo 'entrada_tabela'), usados depois pelo gerador de código, por isso
+ * só são liberadas em eliminar_pilha_tabela_simbolos() (ou antes, com
+ * liberar_entradas_descartadas(), quando a AST que as usa já foi liberada).
+ */
+static EntradaTabela *entradas_descartadas = NULL;
+
+/**
+ * @brief Libera uma entrada e a sua lista de argumentos.
+ */
+static void liberar_entrada(EntradaTabela *entrada) {
+    free(entrada->lexema);
+
+    if (entrada->tipo == TIPO_FUNCAO) {
+        ArgumentoFuncao *arg_atual = entrada->argumentos;
+        while (arg_atual != NULL) {
+            ArgumentoFuncao *temp_arg = arg_atual;
+            arg_atual = arg_atual->proximo;
+            free(temp_arg->nome_arg);
+            free(temp_arg);
+        }
+    }
+    free(entrada);
+}
+
+/* ---------- Índice por nome de cada escopo ---------- */
+
+static unsigned espalhar_nome(const char *nome, int capacidade) {
+    unsigned valor = 2166136261u;
+    for (; *nome != '\0'; nome++) valor = (valor ^ (unsigned char)*nome) * 16777619u;
+    return valor & (unsigned)(capacidade - 1);
+}
+
+/**
+ * @brief Procura o nome no escopo, entre as funções (tipo TIPO_FUNCAO), as
+ * variáveis (qualquer outro tipo) ou ambas (tipo -1).
+ * @return A entrada inserida por último com o nome, ou NULL.
+ */
+static EntradaTabela *buscar_no_escopo(const TabelaSimbolos *escopo, const char *nome, int tipo) {
+    if (escopo->indice == NULL) return NULL;
+    int encontrada = -1;
+    unsigned h = espalhar_nome(nome, escopo->capacidade_indice);
+    for (; escopo->indice[h] != 0; h = (h + 1) & (unsigned)(escopo->capacidade_indice - 1)) {
+        int posicao = escopo->indice[h] - 1;
+        const EntradaTabela *entrada = escopo->entradas[posicao];
+        if (posicao < encontrada || strcmp(entrada->lexema, nome) != 0) continue;
+        if (tipo == -1 || (tipo == TIPO_FUNCAO) == (entrada->tipo == TIPO_FUNCAO)) encontrada = posicao;
+    }
+    return encontrada < 0 ? NULL : escopo->entradas[encontrada];
+}
+
+static void posicionar_no_indice(TabelaSimbolos *escopo, int posicao) {
+    unsigned h = espalhar_nome(escopo->entradas[posicao]->lexema, escopo->capacidade_indice);
+    while (escopo->indice[h] != 0) h = (h + 1) & (unsigned)(escopo->capacidade_indice - 1);
+    escopo->indice[h] = posicao + 1;
+}
+
+/**
+ * @brief Acrescenta a entrada (já na lista do escopo) ao índice.
+ */
+static void indexar_entrada(TabelaSimbolos *escopo, EntradaTabela *entrada) {
+    if (escopo->num_entradas == escopo->capacidade_entradas) {
+        escopo->capacidade_entradas = escopo->capacidade_entradas == 0 ? 16 : escopo->capacidade_entradas * 2;
+        EntradaTabela **novas = realloc(escopo->entradas, escopo->capacidade_entradas * sizeof(EntradaTabela *));
+        if (novas == NULL) {
+            perror("Erro ao alocar memoria para o indice da tabela de simbolos");
+            exit(EXIT_FAILURE);
+        }
+        escopo->entradas = novas;
+    }
+    escopo->entradas[escopo->num_entradas++] = entrada;
+
+    // Mantém o índice no máximo meio cheio.
+    if (2 * escopo->num_entradas > escopo->capacidade_indice) {
+        free(escopo->indice);
+        escopo->capacidade_indice = escopo->capacidade_indice == 0 ? 32 : escopo->capacidade_indice * 2;
+        escopo->indice = calloc(escopo->capacidade_indice, sizeof(int));
+        if (escopo->indice == NULL) {
+            perror("Erro ao alocar memoria para o indice da tabela de simbolos");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < escopo->num_entradas; i++) posicionar_no_indice(escopo, i);
+    } else {
+        posicionar_no_indice(escopo, escopo->num_entradas - 1);
+    }
+}
+
 /**
  * @brief Inicializa a pilha de tabelas de símbolos, tornando-a vazia.
  */
@@ -21,6 +109,11 @@ void criar_novo_escopo_e_empilhar() {
     }
     nova_tabela->primeira_entrada = NULL; 
     nova_tabela->proximo = pilha_tabelas; 
+    nova_tabela->entradas = NULL;
+    nova_tabela->num_entradas = 0;
+    nova_tabela->capacidade_entradas = 0;
+    nova_tabela->indice = NULL;
+    nova_tabela->capacidade_indice = 0;
     pilha_tabelas = nova_tabela;       
     printf("Novo escopo criado e empilhado.\n");
 }
@@ -33,12 +126,9 @@ void criar_novo_escopo_e_empilhar() {
 EntradaTabela *pesquisar_nome_na_pilha(const char *nome) {
     TabelaSimbolos *escopo_atual = pilha_tabelas;
     while (escopo_atual != NULL) {
-        EntradaTabela *entrada_atual = escopo_atual->primeira_entrada;
-        while (entrada_atual != NULL) {
-            if (strcmp(entrada_atual->lexema, nome) == 0) {
-                return entrada_atual; 
-            }
-            entrada_atual = entrada_atual->proximo;
+        EntradaTabela *entrada = buscar_no_escopo(escopo_atual, nome, -1);
+        if (entrada != NULL) {
+            return entrada;
         }
         escopo_atual = escopo_atual->proximo;
     }
@@ -61,19 +151,11 @@ void remover_escopo_atual() {
     while (entrada_atual != NULL) {
         EntradaTabela *temp_entrada = entrada_atual;
         entrada_atual = entrada_atual->proximo;
-        free(temp_entrada->lexema); 
-        
-        if (temp_entrada->tipo == TIPO_FUNCAO) {
-            ArgumentoFuncao *arg_atual = temp_entrada->argumentos;
-            while (arg_atual != NULL) {
-                ArgumentoFuncao *temp_arg = arg_atual;
-                arg_atual = arg_atual->proximo;
-                free(temp_arg->nome_arg);
-                free(temp_arg);
-            }
-        }
-        free(temp_entrada);
+        temp_entrada->proximo = entradas_descartadas;
+        entradas_descartadas = temp_entrada;
     }
+    free(escopo_a_remover->entradas);
+    free(escopo_a_remover->indice);
     free(escopo_a_remover);
     printf("Escopo atual removido.\n");
 }
@@ -99,6 +181,7 @@ static EntradaTabela *criar_entrada(const char *lexema, TipoDado tipo, int posic
     }
     nova_entrada->tipo = tipo;
     nova_entrada->posicao = posicao;
+    nova_entrada->endereco_global = -1;
     nova_entrada->num_argumentos = 0;
     nova_entrada->tipo_retorno = TIPO_VOID;
     nova_entrada->argumentos = NULL;
@@ -119,13 +202,10 @@ EntradaTabela *inserir_funcao_na_tabela_atual(const char *nome_funcao, TipoDado
         return NULL;
     }
 
-    EntradaTabela *temp_entrada = pilha_tabelas->primeira_entrada;
-    while (temp_entrada != NULL) {
-        if (strcmp(temp_entrada->lexema, nome_funcao) == 0 && temp_entrada->tipo == TIPO_FUNCAO) {
-            printf("Aviso: Funcao '%s' ja declarada neste escopo.\n", nome_funcao);
-            return temp_entrada;
-        }
-        temp_entrada = temp_entrada->proximo;
+    EntradaTabela *temp_entrada = buscar_no_escopo(pilha_tabelas, nome_funcao, TIPO_FUNCAO);
+    if (temp_entrada != NULL) {
+        printf("Aviso: Funcao '%s' ja declarada neste escopo.\n", nome_funcao);
+        return temp_entrada;
     }
 
     EntradaTabela *nova_entrada = criar_entrada(nome_funcao, TIPO_FUNCAO, -1); 
@@ -133,6 +213,7 @@ EntradaTabela *inserir_funcao_na_tabela_atual(const char *nome_funcao, TipoDado
     nova_entrada->num_argumentos = num_argumentos;
     nova_entrada->proximo = pilha_tabelas->primeira_entrada;
     pilha_tabelas->primeira_entrada = nova_entrada;
+    indexar_entrada(pilha_tabelas, nova_entrada);
     printf("Funcao '%s' (retorno: %d, args: %d) inserida no escopo atual.\n", nome_funcao, tipo_retorno, num_argumentos);
     return nova_entrada;
 }
@@ -187,19 +268,16 @@ void inserir_variavel_na_tabela_atual(const char *nome_variavel, TipoDado tipo_v
         return;
     }
 
-    EntradaTabela *temp_entrada = pilha_tabelas->primeira_entrada;
-    while (temp_entrada != NULL) {
-        if (strcmp(temp_entrada->lexema, nome_variavel) == 0 && temp_entrada->tipo != TIPO_FUNCAO) {
-            printf("Aviso: Variavel '%s' ja declarada neste escopo.\n", nome_variavel);
-            return;
-        }
-        temp_entrada = temp_entrada->proximo;
+    if (buscar_no_escopo(pilha_tabelas, nome_variavel, TIPO_INT) != NULL) {
+        printf("Aviso: Variavel '%s' ja declarada neste escopo.\n", nome_variavel);
+        return;
     }
 
     EntradaTabela *nova_entrada = criar_entrada(nome_variavel, tipo_variavel, posicao);
 
     nova_entrada->proximo = pilha_tabelas->primeira_entrada;
     pilha_tabelas->primeira_entrada = nova_entrada;
+    indexar_entrada(pilha_tabelas, nova_entrada);
     printf("Variavel '%s' (tipo: %d, pos: %d) inserida no escopo atual.\n", nome_variavel, tipo_variavel, posicao);
 }
 
@@ -217,10 +295,19 @@ void inserir_parametro_na_tabela_atual(const char *nome_parametro, TipoDado tipo
 /**
  * @brief Elimina toda a pilha de tabelas de símbolos e libera a memória alocada.
  */
+void liberar_entradas_descartadas() {
+    while (entradas_descartadas != NULL) {
+        EntradaTabela *temp_entrada = entradas_descartadas;
+        entradas_descartadas = entradas_descartadas->proximo;
+        liberar_entrada(temp_entrada);
+    }
+}
+
 void eliminar_pilha_tabela_simbolos() {
     while (pilha_tabelas != NULL) {
         remover_escopo_atual(); 
     }
+    liberar_entradas_descartadas();
     printf("Pilha de tabelas de simbolos eliminada e memoria liberada.\n");
 }
 
@@ -22,6 +22,7 @@ typedef struct EntradaTabela {
     char *lexema;         
     TipoDado tipo;        
     int posicao;         
+    int endereco_global;  // Deslocamento na área de variáveis globais (-1 se não é global)
     int num_argumentos;
     TipoDado tipo_retorno;
     ArgumentoFuncao *argumentos;
@@ -32,6 +33,14 @@ typedef struct EntradaTabela {
 typedef struct TabelaSimbolos {
     EntradaTabela *primeira_entrada; 
     struct TabelaSimbolos *proximo; 
+
+    // Índice por nome: as buscas e as verificações de redeclaração não
+    // percorrem o escopo (o global de um programa grande tem milhares de nomes).
+    EntradaTabela **entradas;   // Na ordem de inserção
+    int num_entradas;
+    int capacidade_entradas;
+    int *indice;                // Posição em 'entradas' + 1 (0 = posição vazia)
+    int capacidade_indice;
 } TabelaSimbolos;
 
 extern TabelaSimbolos *pilha_tabelas;
@@ -55,6 +64,8 @@ EntradaTabela *pesquisar_nome_na_pilha(const char *nome);
 
 /**
  * @brief Remove a tabela de símbolos que está no topo da pilha, encerrando o escopo atual.
+ * As entradas do escopo continuam válidas (a AST aponta para elas) até
+ * eliminar_pilha_tabela_simbolos().
  */
 void remover_escopo_atual();
 
@@ -94,7 +105,15 @@ void inserir_variavel_na_tabela_atual(const char *nome_variavel, TipoDado tipo_v
 void inserir_parametro_na_tabela_atual(const char *nome_parametro, TipoDado tipo_parametro, int posicao);
 
 /**
- * @brief Elimina toda a pilha de tabelas de símbolos e libera a memória alocada.
+ * @brief Libera as entradas dos escopos já removidos. Só pode ser chamada
+ * quando nenhum nó da AST aponta mais para elas (na compilação em fluxo,
+ * depois que cada função é gerada e a sua AST, liberada).
+ */
+void liberar_entradas_descartadas();
+
+/**
+ * @brief Elimina toda a pilha de tabelas de símbolos e libera a memória alocada,
+ * inclusive as entradas de escopos já removidos.
  */
 void eliminar_pilha_tabela_simbolos();
 